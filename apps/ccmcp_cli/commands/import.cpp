@@ -0,0 +1,106 @@
+#include "import.h"
+
+#include "ccmcp/core/clock.h"
+#include "ccmcp/core/id_generator.h"
+#include "ccmcp/core/services.h"
+#include "ccmcp/embedding/embedding_provider.h"
+#include "ccmcp/ingest/bulk_import.h"
+#include "ccmcp/storage/sqlite/sqlite_atom_repository.h"
+#include "ccmcp/storage/sqlite/sqlite_audit_log.h"
+#include "ccmcp/storage/sqlite/sqlite_db.h"
+#include "ccmcp/storage/sqlite/sqlite_interaction_repository.h"
+#include "ccmcp/storage/sqlite/sqlite_opportunity_repository.h"
+#include "ccmcp/vector/null_embedding_index.h"
+
+#include "import_logic.h"
+#include "shared/arg_parser.h"
+#include "shared/sqlite_tuning_options.h"
+#include <cstddef>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct ImportCliConfig {
+  std::optional<std::string> db_path;
+  ccmcp::storage::SqliteTuningConfig sqlite_tuning{
+      ccmcp::storage::SqliteTuningProfile::kBalanced};  // --sqlite-profile default
+  std::size_t batch_size{ccmcp::ingest::kDefaultBulkImportBatchSize};
+  bool args_valid{true};
+};
+
+}  // namespace
+
+int cmd_import(int argc, char* argv[]) {  // NOLINT(modernize-avoid-c-arrays)
+  if (argc < 3) {
+    std::cerr << "Usage: ccmcp_cli import <file.jsonl> [--db <db-path>] [--batch-size <n>]\n";
+    return 1;
+  }
+
+  const std::string file_path = argv[2];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+  std::vector<ccmcp::apps::Option<ImportCliConfig>> options = {
+      {"--db", true, "Path to SQLite database file",
+       [](ImportCliConfig& c, const std::string& v) {
+         c.db_path = v;
+         return true;
+       }},
+      {"--batch-size", true, "Records written per transaction (default 1000)",
+       [](ImportCliConfig& c, const std::string& v) {
+         const auto parsed = ccmcp::apps::parse_size(v);
+         if (!parsed.has_value() || parsed.value() == 0) {
+           std::cerr << "Invalid --batch-size: " << v << " (must be an integer >= 1)\n";
+           c.args_valid = false;
+           return false;
+         }
+         c.batch_size = parsed.value();
+         return true;
+       }},
+  };
+  for (auto& option : ccmcp::apps::sqlite_tuning_options(&ImportCliConfig::sqlite_tuning)) {
+    options.push_back(std::move(option));
+  }
+  auto config = ccmcp::apps::parse_options(argc, argv, options, 3);
+
+  if (!config.args_valid) {
+    return 1;
+  }
+
+  const std::string db_path = config.db_path.value_or("data/ccmcp.db");
+  if (!config.db_path.has_value()) {
+    std::cout << "No --db specified, using default: " << db_path << "\n";
+  }
+
+  const ccmcp::storage::SqliteTuning sqlite_tuning = ccmcp::storage::resolve(config.sqlite_tuning);
+  auto db_result = ccmcp::storage::sqlite::SqliteDb::open(db_path, sqlite_tuning);
+  if (!db_result.has_value()) {
+    std::cerr << "Failed to open database: " << db_result.error() << "\n";
+    return 1;
+  }
+
+  auto db = db_result.value();
+  auto schema_result = db->ensure_schema_v10();
+  if (!schema_result.has_value()) {
+    std::cerr << "Failed to initialize schema: " << schema_result.error() << "\n";
+    return 1;
+  }
+
+  ccmcp::storage::sqlite::SqliteAtomRepository atom_repo(db);
+  ccmcp::storage::sqlite::SqliteOpportunityRepository opp_repo(db);
+  ccmcp::storage::sqlite::SqliteInteractionRepository interaction_repo(db);
+  ccmcp::storage::sqlite::SqliteAuditLog audit_log(db);
+  ccmcp::vector::NullEmbeddingIndex vector_index;
+  ccmcp::embedding::NullEmbeddingProvider embedding_provider;
+
+  ccmcp::core::Services services{atom_repo, opp_repo,     interaction_repo,
+                                 audit_log, vector_index, embedding_provider};
+
+  // Audit events persist across runs, so ids must be unique per run (not deterministic).
+  ccmcp::core::SystemIdGenerator id_gen;
+  ccmcp::core::SystemClock clock;
+
+  return execute_import(file_path, services, id_gen, clock, config.batch_size);
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+// cmd_import: bulk-import experience atoms and opportunities from a JSONL file.
+// Usage: ccmcp_cli import <file.jsonl> [--db <db-path>] [--batch-size <n>] [--sqlite-* ...]
+int cmd_import(int argc, char* argv[]);  // NOLINT(modernize-avoid-c-arrays)
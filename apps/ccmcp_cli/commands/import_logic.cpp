@@ -0,0 +1,40 @@
+#include "import_logic.h"
+
+#include "ccmcp/app/app_service.h"
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+int execute_import(const std::string& file_path, ccmcp::core::Services& services,
+                   ccmcp::core::IIdGenerator& id_gen, ccmcp::core::IClock& clock,
+                   std::size_t batch_size) {
+  std::cout << "Importing from: " << file_path << " (batch size " << batch_size << ")\n";
+
+  ccmcp::app::BulkImportPipelineRequest request;
+  request.input_path = file_path;
+  request.batch_size = batch_size;
+
+  ccmcp::app::BulkImportPipelineResponse response;
+  try {
+    response = ccmcp::app::run_bulk_import_pipeline(request, services, id_gen, clock);
+  } catch (const std::runtime_error& e) {
+    std::cerr << e.what() << "\n";
+    return 1;
+  }
+  const auto& result = response.result;
+
+  std::cout << "  Lines read: " << result.lines_read << "\n";
+  std::cout << "  Atoms imported: " << result.atoms_imported << "\n";
+  std::cout << "  Opportunities imported: " << result.opportunities_imported << "\n";
+  std::cout << "  Errors: " << result.error_count << "\n";
+  for (const auto& error : result.errors) {
+    std::cerr << "  " << error << "\n";
+  }
+  if (result.errors.size() < result.error_count) {
+    std::cerr << "  ... " << (result.error_count - result.errors.size()) << " more\n";
+  }
+  std::cout << "  Trace: " << response.trace_id << "\n";
+
+  return result.error_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "ccmcp/core/clock.h"
+#include "ccmcp/core/id_generator.h"
+#include "ccmcp/core/services.h"
+
+#include <cstddef>
+#include <string>
+
+// execute_import: stream the JSONL file at file_path into services.atoms and
+// services.opportunities through app::run_bulk_import_pipeline (batch_size records per
+// upsert_many call, BulkImportStarted/BulkImportCompleted audit events), and print counts
+// and rejected lines.
+// Returns 1 if the file cannot be read or any record was rejected, 0 otherwise.
+// Takes only interface types — no concrete storage headers may be included in this TU.
+int execute_import(const std::string& file_path, ccmcp::core::Services& services,
+                   ccmcp::core::IIdGenerator& id_gen, ccmcp::core::IClock& clock,
+                   std::size_t batch_size);
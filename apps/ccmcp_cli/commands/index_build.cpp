@@ -2,24 +2,35 @@
 
 #include "ccmcp/core/clock.h"
 #include "ccmcp/core/id_generator.h"
+#include "ccmcp/embedding/caching_embedding_provider.h"
 #include "ccmcp/embedding/embedding_provider.h"
+#include "ccmcp/indexing/index_build_pipeline.h"
 #include "ccmcp/storage/sqlite/sqlite_atom_repository.h"
 #include "ccmcp/storage/sqlite/sqlite_audit_log.h"
 #include "ccmcp/storage/sqlite/sqlite_db.h"
+#include "ccmcp/storage/sqlite/sqlite_embedding_cache_store.h"
 #include "ccmcp/storage/sqlite/sqlite_index_run_store.h"
 #include "ccmcp/storage/sqlite/sqlite_opportunity_repository.h"
 #include "ccmcp/storage/sqlite/sqlite_resume_store.h"
+#include "ccmcp/vector/hnsw_embedding_index.h"
 #include "ccmcp/vector/inmemory_embedding_index.h"
+#include "ccmcp/vector/mmap_embedding_index.h"
 #include "ccmcp/vector/sqlite_embedding_index.h"
 #include "ccmcp/vector/vector_backend.h"
+#include "ccmcp/vector/vector_quantization.h"
 
 #include "index_build_logic.h"
 #include "shared/arg_parser.h"
+#include "shared/hnsw_options.h"
+#include "shared/quantization_options.h"
+#include "shared/sqlite_tuning_options.h"
+#include <cstddef>
 #include <filesystem>
 #include <iostream>
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace {
@@ -28,25 +39,32 @@ struct IndexBuildCliConfig {
   std::string db_path{"data/ccmcp.db"};
   ccmcp::vector::VectorBackend vector_backend{ccmcp::vector::VectorBackend::kInMemory};
   std::optional<std::string> vector_db_path;
+  ccmcp::vector::HnswConfig hnsw;
+  ccmcp::vector::QuantizationConfig quantization;
+  ccmcp::storage::SqliteTuningConfig sqlite_tuning{
+      ccmcp::storage::SqliteTuningProfile::kBalanced};  // --sqlite-profile default
   std::string scope{"all"};
+  std::size_t batch_size{ccmcp::indexing::kDefaultIndexBatchSize};
+  std::size_t jobs{1};
+  std::size_t retain_runs{0};
   bool args_valid{true};
 };
 
 }  // namespace
 
 int cmd_index_build(int argc, char* argv[]) {  // NOLINT(modernize-avoid-c-arrays)
-  const std::vector<ccmcp::apps::Option<IndexBuildCliConfig>> options = {
+  std::vector<ccmcp::apps::Option<IndexBuildCliConfig>> options = {
       {"--db", true, "Path to SQLite database file",
        [](IndexBuildCliConfig& c, const std::string& v) {
          c.db_path = v;
          return true;
        }},
-      {"--vector-backend", true, "Vector backend (inmemory|sqlite)",
+      {"--vector-backend", true, "Vector backend (inmemory|sqlite|hnsw|mmap)",
        [](IndexBuildCliConfig& c, const std::string& v) {
          auto backend = ccmcp::vector::parse_vector_backend(v);
          if (!backend.has_value()) {
            std::cerr << "Invalid --vector-backend: " << v
-                     << " (valid: inmemory, sqlite; lancedb is reserved and not yet "
+                     << " (valid: inmemory, sqlite, hnsw, mmap; lancedb is reserved and not yet "
                         "implemented)\n";
            c.args_valid = false;
            return false;
@@ -60,7 +78,7 @@ int cmd_index_build(int argc, char* argv[]) {  // NOLINT(modernize-avoid-c-array
          c.vector_backend = backend.value();
          return true;
        }},
-      {"--vector-db-path", true, "Directory for SQLite-backed vector index",
+      {"--vector-db-path", true, "Directory for the persistent vector index (sqlite|hnsw|mmap)",
        [](IndexBuildCliConfig& c, const std::string& v) {
          c.vector_db_path = v;
          return true;
@@ -75,26 +93,82 @@ int cmd_index_build(int argc, char* argv[]) {  // NOLINT(modernize-avoid-c-array
          c.args_valid = false;
          return false;
        }},
+      {"--batch-size", true, "Embeddings written per vector index batch (default 256)",
+       [](IndexBuildCliConfig& c, const std::string& v) {
+         const auto parsed = ccmcp::apps::parse_size(v);
+         if (!parsed.has_value() || parsed.value() == 0) {
+           std::cerr << "Invalid --batch-size: " << v << " (must be an integer >= 1)\n";
+           c.args_valid = false;
+           return false;
+         }
+         c.batch_size = parsed.value();
+         return true;
+       }},
+      {"--jobs", true, "Threads computing embeddings (default 1, max 64)",
+       [](IndexBuildCliConfig& c, const std::string& v) {
+         const auto parsed = ccmcp::apps::parse_size(v);
+         if (!parsed.has_value() || parsed.value() == 0 ||
+             parsed.value() > ccmcp::indexing::kMaxIndexBuildJobs) {
+           std::cerr << "Invalid --jobs: " << v << " (must be an integer 1.."
+                     << ccmcp::indexing::kMaxIndexBuildJobs << ")\n";
+           c.args_valid = false;
+           return false;
+         }
+         c.jobs = parsed.value();
+         return true;
+       }},
+      {"--retain-runs", true,
+       "Keep index entries of the N most recent completed runs (default 0 = keep all)",
+       [](IndexBuildCliConfig& c, const std::string& v) {
+         const auto parsed = ccmcp::apps::parse_size(v);
+         if (!parsed.has_value()) {
+           std::cerr << "Invalid --retain-runs: " << v << " (must be an integer >= 0)\n";
+           c.args_valid = false;
+           return false;
+         }
+         c.retain_runs = parsed.value();
+         return true;
+       }},
   };
+  for (auto& option : ccmcp::apps::hnsw_options(&IndexBuildCliConfig::hnsw)) {
+    options.push_back(std::move(option));
+  }
+  for (auto& option : ccmcp::apps::quantization_options(&IndexBuildCliConfig::quantization)) {
+    options.push_back(std::move(option));
+  }
+  for (auto& option : ccmcp::apps::sqlite_tuning_options(&IndexBuildCliConfig::sqlite_tuning)) {
+    options.push_back(std::move(option));
+  }
   auto config = ccmcp::apps::parse_options(argc, argv, options, 2);
 
   if (!config.args_valid) {
     return 1;
   }
-  if (config.vector_backend == ccmcp::vector::VectorBackend::kSqlite &&
+  if ((config.vector_backend == ccmcp::vector::VectorBackend::kSqlite ||
+       config.vector_backend == ccmcp::vector::VectorBackend::kHnsw ||
+       config.vector_backend == ccmcp::vector::VectorBackend::kMmap) &&
       !config.vector_db_path.has_value()) {
-    std::cerr << "Error: --vector-db-path <dir> is required when --vector-backend sqlite\n";
+    std::cerr << "Error: --vector-db-path <dir> is required when --vector-backend "
+              << ccmcp::vector::to_string(config.vector_backend) << "\n";
+    return 1;
+  }
+  if (config.quantization.mode != ccmcp::vector::VectorQuantization::kNone &&
+      config.vector_backend != ccmcp::vector::VectorBackend::kSqlite) {
+    std::cerr << "Error: --vector-quantization "
+              << ccmcp::vector::to_string(config.quantization.mode)
+              << " requires --vector-backend sqlite\n";
     return 1;
   }
 
-  auto db_result = ccmcp::storage::sqlite::SqliteDb::open(config.db_path);
+  const ccmcp::storage::SqliteTuning sqlite_tuning = ccmcp::storage::resolve(config.sqlite_tuning);
+  auto db_result = ccmcp::storage::sqlite::SqliteDb::open(config.db_path, sqlite_tuning);
   if (!db_result.has_value()) {
     std::cerr << "Failed to open database: " << db_result.error() << "\n";
     return 1;
   }
 
   auto db = db_result.value();
-  auto schema_result = db->ensure_schema_v6();
+  auto schema_result = db->ensure_schema_v10();
   if (!schema_result.has_value()) {
     std::cerr << "Failed to initialize schema: " << schema_result.error() << "\n";
     return 1;
@@ -105,16 +179,52 @@ int cmd_index_build(int argc, char* argv[]) {  // NOLINT(modernize-avoid-c-array
   ccmcp::storage::sqlite::SqliteResumeStore resume_store(db);
   ccmcp::storage::sqlite::SqliteIndexRunStore run_store(db);
   ccmcp::storage::sqlite::SqliteAuditLog audit_log(db);
+  ccmcp::storage::sqlite::SqliteEmbeddingCacheStore embedding_cache_store(db);
 
   std::unique_ptr<ccmcp::vector::IEmbeddingIndex> vector_index_owner;
+  ccmcp::vector::HnswEmbeddingIndex* hnsw_index = nullptr;  // saved explicitly after the build
+  ccmcp::vector::MmapEmbeddingIndex* mmap_index = nullptr;  // compacted explicitly after the build
   switch (config.vector_backend) {
     case ccmcp::vector::VectorBackend::kSqlite: {
       const std::string& dir = config.vector_db_path.value();
       std::filesystem::create_directories(dir);
       const std::string db_file = dir + "/vectors.db";
       try {
-        vector_index_owner = std::make_unique<ccmcp::vector::SqliteEmbeddingIndex>(db_file);
-        std::cout << "Using SQLite-backed vector index: " << db_file << "\n";
+        vector_index_owner = std::make_unique<ccmcp::vector::SqliteEmbeddingIndex>(
+            db_file, config.quantization, sqlite_tuning);
+        std::cout << "Using SQLite-backed vector index: " << db_file << " (quantization="
+                  << ccmcp::vector::to_string(config.quantization.mode) << ")\n";
+      } catch (const std::exception& e) {
+        std::cerr << "Error: failed to open vector index: " << e.what() << "\n";
+        return 1;
+      }
+      break;
+    }
+    case ccmcp::vector::VectorBackend::kHnsw: {
+      const std::string& dir = config.vector_db_path.value();
+      std::filesystem::create_directories(dir);
+      const std::string index_file = dir + "/vectors.hnsw";
+      try {
+        auto index = std::make_unique<ccmcp::vector::HnswEmbeddingIndex>(config.hnsw, index_file);
+        hnsw_index = index.get();
+        vector_index_owner = std::move(index);
+        std::cout << "Using HNSW vector index: " << index_file << " (m=" << config.hnsw.m
+                  << " ef_construction=" << config.hnsw.ef_construction << ")\n";
+      } catch (const std::exception& e) {
+        std::cerr << "Error: failed to open vector index: " << e.what() << "\n";
+        return 1;
+      }
+      break;
+    }
+    case ccmcp::vector::VectorBackend::kMmap: {
+      const std::string& dir = config.vector_db_path.value();
+      std::filesystem::create_directories(dir);
+      const std::string index_file = dir + "/vectors.mmap";
+      try {
+        auto index = std::make_unique<ccmcp::vector::MmapEmbeddingIndex>(index_file);
+        mmap_index = index.get();
+        vector_index_owner = std::move(index);
+        std::cout << "Using mmap vector index: " << index_file << "\n";
       } catch (const std::exception& e) {
         std::cerr << "Error: failed to open vector index: " << e.what() << "\n";
         return 1;
@@ -128,15 +238,42 @@ int cmd_index_build(int argc, char* argv[]) {  // NOLINT(modernize-avoid-c-array
       break;  // unreachable — rejected during argument parsing above
   }
 
-  ccmcp::embedding::DeterministicStubEmbeddingProvider embedding_provider(128);
+  // Rebuilds (--scope all after a backend switch, or a fresh vector dir) reuse embeddings
+  // cached in the career database instead of re-running inference.
+  ccmcp::embedding::DeterministicStubEmbeddingProvider stub_provider(128);
+  ccmcp::embedding::CachingEmbeddingProvider embedding_provider(stub_provider, "deterministic-stub",
+                                                                "", &embedding_cache_store);
   ccmcp::core::DeterministicIdGenerator id_gen;
   ccmcp::core::SystemClock clock;
 
-  const ccmcp::indexing::IndexBuildConfig build_config{config.scope, "deterministic-stub", "", ""};
+  const ccmcp::indexing::IndexBuildConfig build_config{config.scope, "deterministic-stub", "", "",
+                                                       config.batch_size, config.jobs,
+                                                       config.retain_runs};
 
   std::cout << "Starting index-build: db=" << config.db_path << " scope=" << config.scope
             << " backend=" << ccmcp::vector::to_string(config.vector_backend) << "\n";
 
-  return execute_index_build(atom_repo, opp_repo, resume_store, run_store, *vector_index_owner,
-                             embedding_provider, audit_log, id_gen, clock, build_config);
+  const int rc = execute_index_build(atom_repo, opp_repo, resume_store, run_store,
+                                    *vector_index_owner, embedding_provider, audit_log, id_gen,
+                                    clock, build_config);
+
+  // The HNSW graph is built and persisted, and the mmap tail compacted, here rather than on
+  // destruction so that I/O errors reach the exit code.
+  if (hnsw_index != nullptr) {
+    try {
+      hnsw_index->save();
+    } catch (const std::exception& e) {
+      std::cerr << "Error: failed to save vector index: " << e.what() << "\n";
+      return 1;
+    }
+  }
+  if (mmap_index != nullptr) {
+    try {
+      mmap_index->compact();
+    } catch (const std::exception& e) {
+      std::cerr << "Error: failed to compact vector index: " << e.what() << "\n";
+      return 1;
+    }
+  }
+  return rc;
 }
@@ -1,7 +1,9 @@
 #pragma once
 
 // cmd_index_build: build or rebuild the embedding vector index.
-// Usage: ccmcp_cli index-build [--db <path>] [--vector-backend inmemory|sqlite]
-//                              [--vector-db-path <dir>]  (required when --vector-backend sqlite)
+// Usage: ccmcp_cli index-build [--db <path>] [--vector-backend inmemory|sqlite|hnsw|mmap]
+//                              [--vector-db-path <dir>]  (required for sqlite, hnsw, mmap)
+//                              [--hnsw-m <n>] [--hnsw-ef-construction <n>]
+//                              [--vector-quantization none|int8] [--vector-rerank-factor <n>]
 //                              [--scope atoms|resumes|opportunities|all]
 int cmd_index_build(int argc, char* argv[]);  // NOLINT(modernize-avoid-c-arrays)
@@ -20,6 +20,9 @@ int execute_index_build(ccmcp::storage::IAtomRepository& atom_repo,
   std::cout << "  indexed: " << result.indexed_count << "\n";
   std::cout << "  skipped: " << result.skipped_count << "\n";
   std::cout << "  stale:   " << result.stale_count << "\n";
+  if (build_config.retain_runs > 0) {
+    std::cout << "  pruned:  " << result.pruned_count << "\n";
+  }
 
   return 0;
 }
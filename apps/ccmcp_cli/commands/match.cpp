@@ -17,17 +17,24 @@
 #include "ccmcp/storage/sqlite/sqlite_db.h"
 #include "ccmcp/storage/sqlite/sqlite_interaction_repository.h"
 #include "ccmcp/storage/sqlite/sqlite_opportunity_repository.h"
+#include "ccmcp/vector/hnsw_embedding_index.h"
 #include "ccmcp/vector/inmemory_embedding_index.h"
+#include "ccmcp/vector/mmap_embedding_index.h"
 #include "ccmcp/vector/null_embedding_index.h"
 #include "ccmcp/vector/sqlite_embedding_index.h"
+#include "ccmcp/vector/vector_quantization.h"
 
 #include "match_logic.h"
 #include "shared/arg_parser.h"
+#include "shared/hnsw_options.h"
+#include "shared/quantization_options.h"
+#include "shared/sqlite_tuning_options.h"
 #include <filesystem>
 #include <iostream>
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace {
@@ -38,6 +45,10 @@ struct MatchCliConfig {
       ccmcp::matching::MatchingStrategy::kDeterministicLexicalV01};
   std::string vector_backend{"inmemory"};
   std::optional<std::string> vector_db_path;
+  ccmcp::vector::HnswConfig hnsw;
+  ccmcp::vector::QuantizationConfig quantization;
+  ccmcp::storage::SqliteTuningConfig sqlite_tuning{
+      ccmcp::storage::SqliteTuningProfile::kBalanced};  // --sqlite-profile default
   // Override rail — all three flags are required together (fail-fast if partial).
   std::optional<std::string> override_rule_id;
   std::optional<std::string> override_operator_id;
@@ -47,7 +58,7 @@ struct MatchCliConfig {
 }  // namespace
 
 int cmd_match(int argc, char* argv[]) {  // NOLINT(modernize-avoid-c-arrays)
-  const std::vector<ccmcp::apps::Option<MatchCliConfig>> options = {
+  std::vector<ccmcp::apps::Option<MatchCliConfig>> options = {
       {"--db", true, "Path to SQLite database file",
        [](MatchCliConfig& c, const std::string& v) {
          c.db_path = v;
@@ -66,16 +77,17 @@ int cmd_match(int argc, char* argv[]) {  // NOLINT(modernize-avoid-c-arrays)
          std::cerr << "Invalid --matching-strategy: " << v << " (valid: lexical, hybrid)\n";
          return false;
        }},
-      {"--vector-backend", true, "Vector backend (inmemory|sqlite)",
+      {"--vector-backend", true, "Vector backend (inmemory|sqlite|hnsw|mmap)",
        [](MatchCliConfig& c, const std::string& v) {
-         if (v == "inmemory" || v == "sqlite") {
+         if (v == "inmemory" || v == "sqlite" || v == "hnsw" || v == "mmap") {
            c.vector_backend = v;
            return true;
          }
-         std::cerr << "Invalid --vector-backend: " << v << " (valid: inmemory, sqlite)\n";
+         std::cerr << "Invalid --vector-backend: " << v
+                   << " (valid: inmemory, sqlite, hnsw, mmap)\n";
          return false;
        }},
-      {"--vector-db-path", true, "Directory for SQLite-backed vector index",
+      {"--vector-db-path", true, "Directory for the persistent vector index (sqlite|hnsw|mmap)",
        [](MatchCliConfig& c, const std::string& v) {
          c.vector_db_path = v;
          return true;
@@ -96,6 +108,15 @@ int cmd_match(int argc, char* argv[]) {  // NOLINT(modernize-avoid-c-arrays)
          return true;
        }},
   };
+  for (auto& option : ccmcp::apps::hnsw_options(&MatchCliConfig::hnsw)) {
+    options.push_back(std::move(option));
+  }
+  for (auto& option : ccmcp::apps::quantization_options(&MatchCliConfig::quantization)) {
+    options.push_back(std::move(option));
+  }
+  for (auto& option : ccmcp::apps::sqlite_tuning_options(&MatchCliConfig::sqlite_tuning)) {
+    options.push_back(std::move(option));
+  }
   auto config = ccmcp::apps::parse_options(argc, argv, options, 2);
 
   // Fail-fast: --override-rule, --operator, and --reason are an all-or-nothing set.
@@ -135,19 +156,53 @@ int cmd_match(int argc, char* argv[]) {  // NOLINT(modernize-avoid-c-arrays)
               << " operator=" << override_req->operator_id << "\n";
   }
 
-  if (config.vector_backend == "sqlite" && !config.vector_db_path.has_value()) {
-    std::cerr << "Error: --vector-db-path <dir> is required when --vector-backend sqlite\n";
+  if ((config.vector_backend == "sqlite" || config.vector_backend == "hnsw" ||
+       config.vector_backend == "mmap") &&
+      !config.vector_db_path.has_value()) {
+    std::cerr << "Error: --vector-db-path <dir> is required when --vector-backend "
+              << config.vector_backend << "\n";
+    return 1;
+  }
+  if (config.quantization.mode != ccmcp::vector::VectorQuantization::kNone &&
+      config.vector_backend != "sqlite") {
+    std::cerr << "Error: --vector-quantization "
+              << ccmcp::vector::to_string(config.quantization.mode)
+              << " requires --vector-backend sqlite\n";
     return 1;
   }
 
+  const ccmcp::storage::SqliteTuning sqlite_tuning = ccmcp::storage::resolve(config.sqlite_tuning);
   std::unique_ptr<ccmcp::vector::IEmbeddingIndex> vector_index_owner;
   if (config.vector_backend == "sqlite") {
     const std::string& dir = config.vector_db_path.value();
     std::filesystem::create_directories(dir);
     const std::string db_file = dir + "/vectors.db";
     try {
-      vector_index_owner = std::make_unique<ccmcp::vector::SqliteEmbeddingIndex>(db_file);
-      std::cout << "Using SQLite-backed vector index: " << db_file << "\n";
+      vector_index_owner = std::make_unique<ccmcp::vector::SqliteEmbeddingIndex>(
+          db_file, config.quantization, sqlite_tuning);
+      std::cout << "Using SQLite-backed vector index: " << db_file << " (quantization="
+                << ccmcp::vector::to_string(config.quantization.mode) << ")\n";
+    } catch (const std::exception& e) {
+      std::cerr << "Error: failed to open vector index: " << e.what() << "\n";
+      return 1;
+    }
+  } else if (config.vector_backend == "hnsw") {
+    const std::string index_file = config.vector_db_path.value() + "/vectors.hnsw";
+    try {
+      vector_index_owner =
+          std::make_unique<ccmcp::vector::HnswEmbeddingIndex>(config.hnsw, index_file);
+      std::cout << "Using HNSW vector index: " << index_file << "\n";
+    } catch (const std::exception& e) {
+      std::cerr << "Error: failed to open vector index: " << e.what() << "\n";
+      return 1;
+    }
+  } else if (config.vector_backend == "mmap") {
+    const std::string index_file = config.vector_db_path.value() + "/vectors.mmap";
+    try {
+      // match only queries: never repair, create or compact files another process writes.
+      vector_index_owner = std::make_unique<ccmcp::vector::MmapEmbeddingIndex>(
+          index_file, ccmcp::vector::MmapEmbeddingIndex::OpenMode::kReadOnly);
+      std::cout << "Using mmap vector index: " << index_file << "\n";
     } catch (const std::exception& e) {
       std::cerr << "Error: failed to open vector index: " << e.what() << "\n";
       return 1;
@@ -161,7 +216,7 @@ int cmd_match(int argc, char* argv[]) {  // NOLINT(modernize-avoid-c-arrays)
   ccmcp::core::FixedClock clock("2026-01-01T00:00:00Z");
 
   if (config.db_path.has_value()) {
-    auto db_result = ccmcp::storage::sqlite::SqliteDb::open(config.db_path.value());
+    auto db_result = ccmcp::storage::sqlite::SqliteDb::open(config.db_path.value(), sqlite_tuning);
     if (!db_result.has_value()) {
       std::cerr << "Failed to open database: " << db_result.error() << "\n";
       return 1;
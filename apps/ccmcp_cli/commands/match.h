@@ -2,7 +2,10 @@
 
 // cmd_match: run a demo match against a hardcoded ExampleCo opportunity.
 // Usage: ccmcp_cli match [--db <db-path>] [--matching-strategy lexical|hybrid]
-//                        [--vector-backend inmemory|sqlite] [--vector-db-path <dir>]
+//                        [--vector-backend inmemory|sqlite|hnsw|mmap]
+//                        [--vector-db-path <dir>]
+//                        [--hnsw-m <n>] [--hnsw-ef-construction <n>] [--hnsw-ef-search <n>]
+//                        [--vector-quantization none|int8] [--vector-rerank-factor <n>]
 //                        [--override-rule <rule_id> --operator <id> --reason "<text>"]
 // Override flags are all-or-nothing: providing a partial set is a usage error.
 int cmd_match(int argc, char* argv[]);  // NOLINT(modernize-avoid-c-arrays)
@@ -1,4 +1,5 @@
 #include "commands/decision.h"
+#include "commands/import.h"
 #include "commands/index_build.h"
 #include "commands/ingest_resume.h"
 #include "commands/match.h"
@@ -17,9 +18,10 @@ struct Command {
                  char*[]);  // NOLINT(readability-identifier-naming,modernize-avoid-c-arrays)
 };
 
-const std::array<Command, 7> kCommands = {{
+const std::array<Command, 8> kCommands = {{
     {"ingest-resume", "Ingest a resume file into the database", cmd_ingest_resume},
     {"tokenize-resume", "Tokenize an ingested resume into a token IR", cmd_tokenize_resume},
+    {"import", "Bulk-import atoms and opportunities from a JSONL file", cmd_import},
     {"index-build", "Build or rebuild the embedding vector index", cmd_index_build},
     {"match", "Run a demo match against a hardcoded ExampleCo opportunity", cmd_match},
     {"get-decision", "Fetch a match decision record by decision ID", cmd_get_decision},
@@ -3,8 +3,12 @@
 #include "ccmcp/vector/vector_backend.h"
 
 #include "shared/arg_parser.h"
+#include "shared/hnsw_options.h"
+#include "shared/quantization_options.h"
+#include "shared/sqlite_tuning_options.h"
 #include <iostream>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace ccmcp::mcp {
@@ -29,7 +33,8 @@ bool handle_vector_backend(McpServerConfig& config, const std::string& value) {
   auto backend = vector::parse_vector_backend(value);
   if (!backend.has_value()) {
     std::cerr << "Invalid --vector-backend: " << value
-              << " (valid: inmemory, sqlite; lancedb is reserved and not yet implemented)\n";
+              << " (valid: inmemory, sqlite, hnsw, mmap; lancedb is reserved and not yet "
+                 "implemented)\n";
     return false;
   }
   config.vector_backend = backend.value();
@@ -54,6 +59,16 @@ bool handle_matching_strategy(McpServerConfig& config, const std::string& value)
   return false;
 }
 
+bool handle_sqlite_readers(McpServerConfig& config, const std::string& value) {
+  const auto parsed = apps::parse_size(value);
+  if (!parsed.has_value()) {
+    std::cerr << "Invalid --sqlite-readers: " << value << " (must be an integer >= 0)\n";
+    return false;
+  }
+  config.sqlite_readers = parsed.value();
+  return true;
+}
+
 bool handle_audit_chain_verify(McpServerConfig& config, const std::string& value) {
   if (value == "off") {
     config.audit_chain_verify = AuditChainVerifyMode::kOff;
@@ -76,17 +91,31 @@ bool handle_audit_chain_verify(McpServerConfig& config, const std::string& value
 // ────────────────────────────────────────────────────────────────
 
 std::vector<apps::Option<McpServerConfig>> build_option_registry() {
-  return {
+  std::vector<apps::Option<McpServerConfig>> options = {
       {"--db", true, "Path to SQLite database file", handle_db},
       {"--redis", true, "Redis URI for interaction coordination", handle_redis},
-      {"--vector-backend", true, "Vector backend (inmemory|sqlite)", handle_vector_backend},
+      {"--vector-backend", true, "Vector backend (inmemory|sqlite|hnsw|mmap)",
+       handle_vector_backend},
       {"--vector-db-path", true,
-       "Directory for SQLite-backed vector index (required with --vector-backend sqlite)",
+       "Directory for the persistent vector index "
+       "(required with --vector-backend sqlite|hnsw|mmap)",
        handle_vector_db_path},
       {"--matching-strategy", true, "Matching strategy (lexical|hybrid)", handle_matching_strategy},
       {"--audit-chain-verify", true, "Startup audit chain verification mode (off|warn|fail)",
        handle_audit_chain_verify},
+      {"--sqlite-readers", true, "Read-only SQLite connections next to the writer (default 4)",
+       handle_sqlite_readers},
   };
+  for (auto& option : apps::hnsw_options(&McpServerConfig::hnsw)) {
+    options.push_back(std::move(option));
+  }
+  for (auto& option : apps::quantization_options(&McpServerConfig::quantization)) {
+    options.push_back(std::move(option));
+  }
+  for (auto& option : apps::sqlite_tuning_options(&McpServerConfig::sqlite_tuning)) {
+    options.push_back(std::move(option));
+  }
+  return options;
 }
 
 }  // namespace
@@ -1,8 +1,12 @@
 #pragma once
 
 #include "ccmcp/matching/matcher.h"
+#include "ccmcp/storage/sqlite_tuning.h"
+#include "ccmcp/vector/hnsw_embedding_index.h"
 #include "ccmcp/vector/vector_backend.h"
+#include "ccmcp/vector/vector_quantization.h"
 
+#include <cstddef>
 #include <optional>
 #include <string>
 
@@ -25,8 +29,22 @@ struct McpServerConfig {
   std::optional<std::string> redis_uri;  // NOLINT(readability-identifier-naming)
   vector::VectorBackend vector_backend{  // NOLINT(readability-identifier-naming)
                                        vector::VectorBackend::kInMemory};
-  // Path for the SQLite-backed vector index; required when vector_backend == kSqlite.
+  // Directory for the persistent vector index; required when vector_backend is kSqlite
+  // (vectors.db), kHnsw (vectors.hnsw) or kMmap (vectors.mmap + vectors.mmap.wal).
   std::optional<std::string> vector_db_path;  // NOLINT(readability-identifier-naming)
+  // Graph parameters for vector_backend == kHnsw (--hnsw-m, --hnsw-ef-*).
+  vector::HnswConfig hnsw;  // NOLINT(readability-identifier-naming)
+  // Resident representation for vector_backend == kSqlite (--vector-quantization,
+  // --vector-rerank-factor).
+  vector::QuantizationConfig quantization;  // NOLINT(readability-identifier-naming)
+  // PRAGMA profile for the --db database and the sqlite vector index (--sqlite-profile and
+  // the --sqlite-* overrides); resolved with storage::resolve() at startup. The profile
+  // defaults to balanced.
+  storage::SqliteTuningConfig sqlite_tuning{// NOLINT(readability-identifier-naming)
+                                            storage::SqliteTuningProfile::kBalanced};
+  // Read-only connections serving repository reads next to the single writer connection
+  // (--sqlite-readers); 0 serializes all access on the writer. Only used with --db and WAL.
+  std::size_t sqlite_readers{4};  // NOLINT(readability-identifier-naming)
   matching::MatchingStrategy default_strategy{// NOLINT(readability-identifier-naming)
                                               matching::MatchingStrategy::kDeterministicLexicalV01};
   AuditChainVerifyMode audit_chain_verify{// NOLINT(readability-identifier-naming)
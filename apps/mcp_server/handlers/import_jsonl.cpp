@@ -0,0 +1,53 @@
+#include "import_jsonl.h"
+
+#include "ccmcp/app/app_service.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace ccmcp::mcp::handlers {
+
+using json = nlohmann::json;
+
+json handle_import_jsonl(const json& params, ServerContext& ctx) {
+  try {
+    if (!params.contains("input_path") || !params["input_path"].is_string()) {
+      throw std::invalid_argument("input_path (string) is required");
+    }
+
+    app::BulkImportPipelineRequest request;
+    request.input_path = params["input_path"].get<std::string>();
+    if (params.contains("batch_size")) {
+      const auto& batch_size = params["batch_size"];
+      if (!batch_size.is_number_unsigned() || batch_size.get<size_t>() == 0) {
+        throw std::invalid_argument("Invalid batch_size: " + batch_size.dump() +
+                                    " (must be an integer >= 1)");
+      }
+      request.batch_size = batch_size.get<size_t>();
+    }
+    if (params.contains("trace_id") && params["trace_id"].is_string()) {
+      request.trace_id = params["trace_id"].get<std::string>();
+    }
+
+    const auto response =
+        app::run_bulk_import_pipeline(request, ctx.services, ctx.id_gen, ctx.clock);
+    const auto& result = response.result;
+
+    return json{
+        {"counts",
+         {
+             {"lines", result.lines_read},
+             {"atoms", result.atoms_imported},
+             {"opportunities", result.opportunities_imported},
+             {"errors", result.error_count},
+         }},
+        {"errors", result.errors},
+        {"trace_id", response.trace_id},
+    };
+
+  } catch (const std::exception& e) {
+    return json{{"error", e.what()}};
+  }
+}
+
+}  // namespace ccmcp::mcp::handlers
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include "../server_context.h"
+
+namespace ccmcp::mcp::handlers {
+
+nlohmann::json handle_import_jsonl(const nlohmann::json& params, ServerContext& ctx);
+
+}  // namespace ccmcp::mcp::handlers
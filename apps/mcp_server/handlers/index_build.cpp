@@ -1,6 +1,7 @@
 #include "index_build.h"
 
 #include "ccmcp/app/app_service.h"
+#include "ccmcp/indexing/index_build_pipeline.h"
 
 #include <stdexcept>
 #include <string>
@@ -25,6 +26,15 @@ json handle_index_build(const json& params, ServerContext& ctx) {
     if (params.contains("trace_id") && params["trace_id"].is_string()) {
       request.trace_id = params["trace_id"].get<std::string>();
     }
+    if (params.contains("jobs")) {
+      const auto& jobs = params["jobs"];
+      if (!jobs.is_number_unsigned() || jobs.get<size_t>() == 0 ||
+          jobs.get<size_t>() > indexing::kMaxIndexBuildJobs) {
+        throw std::invalid_argument("Invalid jobs: " + jobs.dump() + " (must be an integer 1.." +
+                                    std::to_string(indexing::kMaxIndexBuildJobs) + ")");
+      }
+      request.jobs = jobs.get<size_t>();
+    }
 
     const auto response =
         app::run_index_build_pipeline(request, ctx.resume_store, ctx.index_run_store, ctx.services,
@@ -66,7 +66,8 @@ json handle_match_opportunity(const json& params, ServerContext& ctx) {
     }
 
     // Run pipeline
-    auto response = app::run_match_pipeline(request, ctx.services, ctx.id_gen, ctx.clock);
+    auto response = app::run_match_pipeline(request, ctx.services, ctx.id_gen, ctx.clock,
+                                            &ctx.corpus_cache);
 
     // Persist decision record (non-fatal: record the "why" but do not block the response)
     const std::string decision_id = app::record_match_decision(response, ctx.decision_store,
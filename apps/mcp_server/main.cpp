@@ -5,10 +5,12 @@
 #include "ccmcp/core/sha256.h"
 #include "ccmcp/core/version.h"
 #include "ccmcp/domain/runtime_config_snapshot.h"
+#include "ccmcp/embedding/caching_embedding_provider.h"
 #include "ccmcp/embedding/embedding_provider.h"
 #include "ccmcp/ingest/resume_ingestor.h"
 #include "ccmcp/interaction/redis_config.h"
 #include "ccmcp/interaction/redis_interaction_coordinator.h"
+#include "ccmcp/matching/corpus_snapshot.h"
 #include "ccmcp/storage/audit_chain.h"
 #include "ccmcp/storage/audit_log.h"
 #include "ccmcp/storage/inmemory_atom_repository.h"
@@ -16,14 +18,19 @@
 #include "ccmcp/storage/inmemory_opportunity_repository.h"
 #include "ccmcp/storage/sqlite/sqlite_atom_repository.h"
 #include "ccmcp/storage/sqlite/sqlite_audit_log.h"
+#include "ccmcp/storage/sqlite/sqlite_connection_pool.h"
 #include "ccmcp/storage/sqlite/sqlite_db.h"
 #include "ccmcp/storage/sqlite/sqlite_decision_store.h"
+#include "ccmcp/storage/sqlite/sqlite_embedding_cache_store.h"
 #include "ccmcp/storage/sqlite/sqlite_index_run_store.h"
 #include "ccmcp/storage/sqlite/sqlite_interaction_repository.h"
 #include "ccmcp/storage/sqlite/sqlite_opportunity_repository.h"
 #include "ccmcp/storage/sqlite/sqlite_resume_store.h"
 #include "ccmcp/storage/sqlite/sqlite_runtime_snapshot_store.h"
+#include "ccmcp/storage/sqlite_tuning.h"
+#include "ccmcp/vector/hnsw_embedding_index.h"
 #include "ccmcp/vector/inmemory_embedding_index.h"
+#include "ccmcp/vector/mmap_embedding_index.h"
 #include "ccmcp/vector/sqlite_embedding_index.h"
 #include "ccmcp/vector/vector_backend.h"
 
@@ -33,6 +40,7 @@
 #include "server_context.h"
 #include "server_loop.h"
 #include "startup_guard.h"
+#include <cstddef>
 #include <filesystem>
 #include <iostream>
 #include <memory>
@@ -40,6 +48,47 @@
 
 using namespace ccmcp;
 
+namespace {
+
+// ────────────────────────────────────────────────────────────────
+// Runtime config snapshot
+// ────────────────────────────────────────────────────────────────
+
+// Records the configuration this server instance runs with: backends, Redis target, and the
+// build parameters that change results or durability (HNSW, quantization, resolved SQLite
+// tuning) as feature flags.
+domain::RuntimeConfigSnapshot make_runtime_config_snapshot(
+    const mcp::McpServerConfig& config, const storage::SqliteTuning& sqlite_tuning) {
+  const auto redis_cfg = interaction::parse_redis_uri(config.redis_uri.value()).value();
+  domain::RuntimeConfigSnapshot snap;
+  snap.snapshot_format_version = 2;
+  snap.db_schema_version = 10;
+  snap.vector_backend = std::string(vector::to_string(config.vector_backend));
+  snap.redis_host = redis_cfg.host;
+  snap.redis_port = redis_cfg.port;
+  snap.redis_db = redis_cfg.redis_db;
+  snap.build_version = core::kBuildVersion;
+  if (config.vector_backend == vector::VectorBackend::kHnsw) {
+    snap.feature_flags["hnsw.m"] = std::to_string(config.hnsw.m);
+    snap.feature_flags["hnsw.ef_construction"] = std::to_string(config.hnsw.ef_construction);
+    snap.feature_flags["hnsw.ef_search"] = std::to_string(config.hnsw.ef_search);
+    snap.feature_flags["hnsw.seed"] = std::to_string(config.hnsw.seed);
+  }
+  if (config.vector_backend == vector::VectorBackend::kSqlite) {
+    snap.feature_flags["vector.quantization"] =
+        std::string(vector::to_string(config.quantization.mode));
+    snap.feature_flags["vector.rerank_factor"] = std::to_string(config.quantization.rerank_factor);
+  }
+  snap.feature_flags["sqlite.profile"] =
+      std::string(storage::to_string(config.sqlite_tuning.profile));
+  for (const auto& [pragma, value] : storage::sqlite_tuning_settings(sqlite_tuning)) {
+    snap.feature_flags["sqlite." + pragma] = value;
+  }
+  return snap;
+}
+
+}  // namespace
+
 // ────────────────────────────────────────────────────────────────
 // Main
 // ────────────────────────────────────────────────────────────────
@@ -61,7 +110,8 @@ int main(int argc, char* argv[]) {
   std::cerr << "career-coordination-mcp MCP Server v0.4\n";
 
   if (config.db_path.has_value()) {
-    std::cerr << "Storage:     SQLite -- " << config.db_path.value() << "\n";
+    std::cerr << "Storage:     SQLite -- " << config.db_path.value() << " (profile "
+              << storage::to_string(config.sqlite_tuning.profile) << ")\n";
   } else {
     std::cerr << "WARNING: No --db path specified. Running with EPHEMERAL in-memory storage.\n"
                  "         All career data (atoms, opportunities, interactions, audit log)\n"
@@ -77,7 +127,20 @@ int main(int argc, char* argv[]) {
 
   switch (config.vector_backend) {
     case vector::VectorBackend::kSqlite:
-      std::cerr << "Vector:      SQLite -- " << config.vector_db_path.value() << "/vectors.db\n";
+      std::cerr << "Vector:      SQLite -- " << config.vector_db_path.value() << "/vectors.db";
+      if (config.quantization.mode == vector::VectorQuantization::kInt8) {
+        std::cerr << " (int8 mirror, rerank_factor=" << config.quantization.rerank_factor << ")";
+      }
+      std::cerr << "\n";
+      break;
+    case vector::VectorBackend::kHnsw:
+      std::cerr << "Vector:      HNSW -- " << config.vector_db_path.value()
+                << "/vectors.hnsw (m=" << config.hnsw.m
+                << " ef_construction=" << config.hnsw.ef_construction
+                << " ef_search=" << config.hnsw.ef_search << ")\n";
+      break;
+    case vector::VectorBackend::kMmap:
+      std::cerr << "Vector:      mmap -- " << config.vector_db_path.value() << "/vectors.mmap\n";
       break;
     case vector::VectorBackend::kInMemory:
       std::cerr << "WARNING: No --vector-backend sqlite specified. Running with EPHEMERAL "
@@ -98,7 +161,12 @@ int main(int argc, char* argv[]) {
   auto ingestor_owner = ingest::create_resume_ingestor();
   ingest::IResumeIngestor& ingestor = *ingestor_owner;
 
-  // Construct the vector index. The vector_db_path was validated above when kSqlite is selected.
+  // One PRAGMA profile for every SQLite file this process opens.
+  const storage::SqliteTuning sqlite_tuning = storage::resolve(config.sqlite_tuning);
+
+  // Construct the vector index. The vector_db_path was validated above for the persistent
+  // backends. The HNSW index is saved, and the mmap tail compacted, when vector_index_owner
+  // is destroyed on shutdown.
   std::unique_ptr<vector::IEmbeddingIndex> vector_index_owner;
   switch (config.vector_backend) {
     case vector::VectorBackend::kSqlite: {
@@ -106,7 +174,31 @@ int main(int argc, char* argv[]) {
       std::filesystem::create_directories(dir);
       const std::string db_file = dir + "/vectors.db";
       try {
-        vector_index_owner = std::make_unique<vector::SqliteEmbeddingIndex>(db_file);
+        vector_index_owner = std::make_unique<vector::SqliteEmbeddingIndex>(
+            db_file, config.quantization, sqlite_tuning);
+      } catch (const std::exception& e) {
+        std::cerr << "Error: failed to open vector index: " << e.what() << "\n";
+        return 1;
+      }
+      break;
+    }
+    case vector::VectorBackend::kHnsw: {
+      const std::string& dir = config.vector_db_path.value();
+      std::filesystem::create_directories(dir);
+      try {
+        vector_index_owner =
+            std::make_unique<vector::HnswEmbeddingIndex>(config.hnsw, dir + "/vectors.hnsw");
+      } catch (const std::exception& e) {
+        std::cerr << "Error: failed to open vector index: " << e.what() << "\n";
+        return 1;
+      }
+      break;
+    }
+    case vector::VectorBackend::kMmap: {
+      const std::string& dir = config.vector_db_path.value();
+      std::filesystem::create_directories(dir);
+      try {
+        vector_index_owner = std::make_unique<vector::MmapEmbeddingIndex>(dir + "/vectors.mmap");
       } catch (const std::exception& e) {
         std::cerr << "Error: failed to open vector index: " << e.what() << "\n";
         return 1;
@@ -125,34 +217,51 @@ int main(int argc, char* argv[]) {
   core::SystemIdGenerator id_gen;
   core::SystemClock clock;
 
+  // Pre-tokenized verified-atom corpus, shared across match requests and rebuilt only
+  // when the atom repository's corpus_version() changes.
+  matching::CorpusSnapshotCache corpus_cache;
+
   // Initialize repositories based on --db flag.
   // Redis coordinator is always used — validated at startup; uri is guaranteed present.
   if (config.db_path.has_value()) {
-    // SQLite persistence path
-    auto db_result = storage::sqlite::SqliteDb::open(config.db_path.value());
-    if (!db_result.has_value()) {
-      std::cerr << "Failed to open database: " << db_result.error() << "\n";
+    // SQLite persistence path: one writer connection plus read-only reader connections.
+    // Readers only run alongside the writer in WAL mode; otherwise reads share the writer.
+    std::size_t sqlite_readers = config.sqlite_readers;
+    if (sqlite_readers > 0 && sqlite_tuning.journal_mode != storage::SqliteJournalMode::kWal) {
+      std::cerr << "Note: journal_mode " << storage::to_string(sqlite_tuning.journal_mode)
+                << " does not support reader connections; reads share the writer.\n";
+      sqlite_readers = 0;
+    }
+    auto pool_result = storage::sqlite::SqliteConnectionPool::open(
+        config.db_path.value(), sqlite_readers, sqlite_tuning);
+    if (!pool_result.has_value()) {
+      std::cerr << "Failed to open database: " << pool_result.error() << "\n";
       return 1;
     }
 
-    auto db = db_result.value();
-    // ensure_schema_v7 chains v1→v6; all schema migrations are idempotent.
-    auto schema_result = db->ensure_schema_v8();
+    auto pool = pool_result.value();
+    // ensure_schema_v10 chains v1→v9; all schema migrations are idempotent.
+    auto schema_result = pool->writer()->ensure_schema_v10();
     if (!schema_result.has_value()) {
       std::cerr << "Failed to initialize schema: " << schema_result.error() << "\n";
       return 1;
     }
 
-    storage::sqlite::SqliteAtomRepository atom_repo(db);
-    storage::sqlite::SqliteOpportunityRepository opportunity_repo(db);
-    storage::sqlite::SqliteInteractionRepository interaction_repo(db);
-    storage::sqlite::SqliteAuditLog audit_log(db);
-    storage::sqlite::SqliteResumeStore resume_store(db);
-    storage::sqlite::SqliteIndexRunStore index_run_store(db);
-    storage::sqlite::SqliteDecisionStore decision_store(db);
-    storage::sqlite::SqliteRuntimeSnapshotStore snapshot_store(db);
-
-    embedding::DeterministicStubEmbeddingProvider embedding_provider;
+    storage::sqlite::SqliteAtomRepository atom_repo(pool);
+    storage::sqlite::SqliteOpportunityRepository opportunity_repo(pool);
+    storage::sqlite::SqliteInteractionRepository interaction_repo(pool);
+    storage::sqlite::SqliteAuditLog audit_log(pool);
+    storage::sqlite::SqliteResumeStore resume_store(pool);
+    storage::sqlite::SqliteIndexRunStore index_run_store(pool);
+    storage::sqlite::SqliteDecisionStore decision_store(pool);
+    storage::sqlite::SqliteRuntimeSnapshotStore snapshot_store(pool);
+    storage::sqlite::SqliteEmbeddingCacheStore embedding_cache_store(pool);
+
+    // Embeddings are cached by content in the database, so restarts and repeated matches
+    // of the same opportunity skip inference.
+    embedding::DeterministicStubEmbeddingProvider stub_provider;
+    embedding::CachingEmbeddingProvider embedding_provider(stub_provider, "deterministic-stub",
+                                                           "", &embedding_cache_store);
 
     core::Services services{atom_repo, opportunity_repo, interaction_repo,
                             audit_log, vector_index,     embedding_provider};
@@ -160,15 +269,8 @@ int main(int argc, char* argv[]) {
     try {
       interaction::RedisInteractionCoordinator coordinator(config.redis_uri.value());
 
-      const auto redis_cfg = interaction::parse_redis_uri(config.redis_uri.value()).value();
-      domain::RuntimeConfigSnapshot snap;
-      snap.snapshot_format_version = 2;
-      snap.db_schema_version = 8;
-      snap.vector_backend = std::string(vector::to_string(config.vector_backend));
-      snap.redis_host = redis_cfg.host;
-      snap.redis_port = redis_cfg.port;
-      snap.redis_db = redis_cfg.redis_db;
-      snap.build_version = core::kBuildVersion;
+      auto snap = make_runtime_config_snapshot(config, sqlite_tuning);
+      snap.feature_flags["sqlite.readers"] = std::to_string(pool->reader_count());
       const std::string snap_json = domain::to_json(snap);
       const std::string snap_hash = core::sha256_hex(snap_json);
       snapshot_store.save(id_gen.next("snapshot"), snap_json, snap_hash, clock.now_iso8601());
@@ -193,7 +295,7 @@ int main(int argc, char* argv[]) {
       }
 
       mcp::ServerContext ctx{services,       coordinator, ingestor, resume_store, index_run_store,
-                             decision_store, id_gen,      clock,    config};
+                             decision_store, id_gen,      clock,    config,       corpus_cache};
       mcp::run_server_loop(ctx);
     } catch (const std::exception& e) {
       std::cerr << "Failed to connect to Redis: " << e.what() << "\n";
@@ -206,14 +308,14 @@ int main(int argc, char* argv[]) {
     // There is no InMemoryResumeStore or InMemoryIndexRunStore. SqliteResumeStore and
     // SqliteIndexRunStore are the only implementations of those interfaces. A dedicated
     // in-memory SQLite database provides the same interface contract without disk I/O.
-    auto mem_db_result = storage::sqlite::SqliteDb::open(":memory:");
+    auto mem_db_result = storage::sqlite::SqliteDb::open(":memory:", sqlite_tuning);
     if (!mem_db_result.has_value()) {
       std::cerr << "Failed to open in-memory database: " << mem_db_result.error() << "\n";
       return 1;
     }
 
     auto mem_db = mem_db_result.value();
-    auto mem_schema_result = mem_db->ensure_schema_v8();
+    auto mem_schema_result = mem_db->ensure_schema_v10();
     if (!mem_schema_result.has_value()) {
       std::cerr << "Failed to initialize in-memory schema: " << mem_schema_result.error() << "\n";
       return 1;
@@ -227,8 +329,11 @@ int main(int argc, char* argv[]) {
     storage::sqlite::SqliteIndexRunStore index_run_store(mem_db);
     storage::sqlite::SqliteDecisionStore decision_store(mem_db);
     storage::sqlite::SqliteRuntimeSnapshotStore snapshot_store(mem_db);
+    storage::sqlite::SqliteEmbeddingCacheStore embedding_cache_store(mem_db);
 
-    embedding::DeterministicStubEmbeddingProvider embedding_provider;
+    embedding::DeterministicStubEmbeddingProvider stub_provider;
+    embedding::CachingEmbeddingProvider embedding_provider(stub_provider, "deterministic-stub",
+                                                           "", &embedding_cache_store);
 
     core::Services services{atom_repo, opportunity_repo, interaction_repo,
                             audit_log, vector_index,     embedding_provider};
@@ -236,15 +341,7 @@ int main(int argc, char* argv[]) {
     try {
       interaction::RedisInteractionCoordinator coordinator(config.redis_uri.value());
 
-      const auto redis_cfg = interaction::parse_redis_uri(config.redis_uri.value()).value();
-      domain::RuntimeConfigSnapshot snap;
-      snap.snapshot_format_version = 2;
-      snap.db_schema_version = 8;
-      snap.vector_backend = std::string(vector::to_string(config.vector_backend));
-      snap.redis_host = redis_cfg.host;
-      snap.redis_port = redis_cfg.port;
-      snap.redis_db = redis_cfg.redis_db;
-      snap.build_version = core::kBuildVersion;
+      auto snap = make_runtime_config_snapshot(config, sqlite_tuning);
       const std::string snap_json = domain::to_json(snap);
       const std::string snap_hash = core::sha256_hex(snap_json);
       snapshot_store.save(id_gen.next("snapshot"), snap_json, snap_hash, clock.now_iso8601());
@@ -269,7 +366,7 @@ int main(int argc, char* argv[]) {
       }
 
       mcp::ServerContext ctx{services,       coordinator, ingestor, resume_store, index_run_store,
-                             decision_store, id_gen,      clock,    config};
+                             decision_store, id_gen,      clock,    config,       corpus_cache};
       run_server_loop(ctx);
     } catch (const std::exception& e) {
       std::cerr << "Failed to connect to Redis: " << e.what() << "\n";
@@ -104,11 +104,36 @@ json handle_tools_list(const JsonRpcRequest& /*req*/, ServerContext& /*ctx*/) {
                  {{"type", "string"},
                   {"enum", json::array({"atoms", "resumes", "opps", "all"})},
                   {"description", "Which artifact types to index (default: all)"}}},
+                {"jobs",
+                 {{"type", "integer"},
+                  {"minimum", 1},
+                  {"description", "Threads computing embeddings (default: 1)"}}},
                 {"trace_id", {{"type", "string"}}},
             }},
        }},
   });
 
+  tools.push_back({
+      {"name", "import_jsonl"},
+      {"description",
+       "Bulk-import experience atoms and opportunities from a JSONL file, one record per line"},
+      {"inputSchema",
+       {
+           {"type", "object"},
+           {"properties",
+            {
+                {"input_path",
+                 {{"type", "string"}, {"description", "Absolute path to JSONL file"}}},
+                {"batch_size",
+                 {{"type", "integer"},
+                  {"minimum", 1},
+                  {"description", "Records written per transaction (default: 1000)"}}},
+                {"trace_id", {{"type", "string"}}},
+            }},
+           {"required", json::array({"input_path"})},
+       }},
+  });
+
   tools.push_back({
       {"name", "get_decision"},
       {"description", "Fetch a match decision record by decision_id"},
@@ -7,6 +7,7 @@
 #include "ccmcp/ingest/resume_ingestor.h"
 #include "ccmcp/ingest/resume_store.h"
 #include "ccmcp/interaction/interaction_coordinator.h"
+#include "ccmcp/matching/corpus_snapshot.h"
 #include "ccmcp/storage/decision_store.h"
 
 #include "config.h"
@@ -25,6 +26,7 @@ struct ServerContext {
   core::IIdGenerator& id_gen;                         // NOLINT(readability-identifier-naming)
   core::IClock& clock;                                // NOLINT(readability-identifier-naming)
   McpServerConfig& config;                            // NOLINT(readability-identifier-naming)
+  matching::CorpusSnapshotCache& corpus_cache;        // NOLINT(readability-identifier-naming)
 };
 
 }  // namespace ccmcp::mcp
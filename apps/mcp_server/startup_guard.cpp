@@ -2,6 +2,9 @@
 
 #include "ccmcp/interaction/redis_config.h"
 #include "ccmcp/vector/vector_backend.h"
+#include "ccmcp/vector/vector_quantization.h"
+
+#include <string>
 
 namespace ccmcp::mcp {
 
@@ -29,6 +32,16 @@ std::string validate_mcp_server_config(const McpServerConfig& config) {
         return "Error: --vector-db-path <dir> is required when --vector-backend sqlite";
       }
       break;
+    case vector::VectorBackend::kHnsw:
+      if (!config.vector_db_path.has_value()) {
+        return "Error: --vector-db-path <dir> is required when --vector-backend hnsw";
+      }
+      break;
+    case vector::VectorBackend::kMmap:
+      if (!config.vector_db_path.has_value()) {
+        return "Error: --vector-db-path <dir> is required when --vector-backend mmap";
+      }
+      break;
     case vector::VectorBackend::kLanceDb:
       return "Error: --vector-backend lancedb is reserved and not yet implemented.\n"
              "       Use --vector-backend sqlite for persistent vector storage.";
@@ -36,6 +49,15 @@ std::string validate_mcp_server_config(const McpServerConfig& config) {
       break;
   }
 
+  // int8 quantization reranks from the float32 vectors kept in vectors.db; no other
+  // backend stores a second copy to rerank from.
+  if (config.quantization.mode != vector::VectorQuantization::kNone &&
+      config.vector_backend != vector::VectorBackend::kSqlite) {
+    return "Error: --vector-quantization " +
+           std::string(vector::to_string(config.quantization.mode)) +
+           " requires --vector-backend sqlite";
+  }
+
   return "";
 }
 
@@ -14,8 +14,9 @@ namespace ccmcp::mcp {
 // - redis_uri is present (required — InMemoryInteractionCoordinator is not
 //   permitted in production startup paths)
 // - if redis_uri is present, parse_redis_uri() must succeed (format valid)
-// - if vector_backend == kSqlite, vector_db_path must be present
+// - if vector_backend == kSqlite, kHnsw or kMmap, vector_db_path must be present
 // - vector_backend != kLanceDb (reserved, not yet implemented)
+// - quantization.mode == kNone unless vector_backend == kSqlite
 [[nodiscard]] std::string validate_mcp_server_config(const McpServerConfig& config);
 
 }  // namespace ccmcp::mcp
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <charconv>
+#include <cstddef>
 #include <functional>
 #include <iostream>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -62,4 +65,16 @@ Config parse_options(int argc, char* argv[],  // NOLINT(modernize-avoid-c-arrays
   return config;
 }
 
+// parse_size parses a non-negative decimal integer flag value.
+// Returns std::nullopt for empty input, signs, trailing characters, or overflow.
+[[nodiscard]] inline std::optional<std::size_t> parse_size(const std::string& value) {
+  std::size_t result = 0;
+  const char* end = value.data() + value.size();
+  const auto [ptr, ec] = std::from_chars(value.data(), end, result);
+  if (value.empty() || ec != std::errc{} || ptr != end) {
+    return std::nullopt;
+  }
+  return result;
+}
+
 }  // namespace ccmcp::apps
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "ccmcp/vector/hnsw_embedding_index.h"
+
+#include "shared/arg_parser.h"
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ccmcp::apps {
+
+// hnsw_options returns the --hnsw-m / --hnsw-ef-construction / --hnsw-ef-search flags,
+// shared by every app that can open --vector-backend hnsw. Values are written into the
+// HnswConfig member `field` of Config; invalid values are reported and leave the default.
+template <typename Config>
+std::vector<Option<Config>> hnsw_options(vector::HnswConfig Config::*field) {
+  const auto size_option = [field](std::string name, std::string description,
+                                   std::size_t vector::HnswConfig::*target,
+                                   std::size_t min_value) {
+    return Option<Config>{
+        name, true, std::move(description),
+        [field, target, min_value, name](Config& c, const std::string& v) {
+          const auto parsed = parse_size(v);
+          if (!parsed.has_value() || parsed.value() < min_value) {
+            std::cerr << "Invalid " << name << ": " << v << " (must be an integer >= "
+                      << min_value << ")\n";
+            return false;
+          }
+          (c.*field).*target = parsed.value();
+          return true;
+        }};
+  };
+  return {
+      size_option("--hnsw-m", "HNSW max neighbours per node (default 16)",
+                  &vector::HnswConfig::m, 2),
+      size_option("--hnsw-ef-construction", "HNSW build candidate list size (default 200)",
+                  &vector::HnswConfig::ef_construction, 1),
+      size_option("--hnsw-ef-search", "HNSW query candidate list size (default 64)",
+                  &vector::HnswConfig::ef_search, 1),
+  };
+}
+
+}  // namespace ccmcp::apps
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "ccmcp/vector/vector_quantization.h"
+
+#include "shared/arg_parser.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace ccmcp::apps {
+
+// quantization_options returns the --vector-quantization / --vector-rerank-factor flags,
+// shared by every app that can open --vector-backend sqlite. Values are written into the
+// QuantizationConfig member `field` of Config; invalid values are reported and rejected.
+template <typename Config>
+std::vector<Option<Config>> quantization_options(vector::QuantizationConfig Config::*field) {
+  return {
+      Option<Config>{"--vector-quantization", true,
+                     "Resident vector representation for --vector-backend sqlite "
+                     "(none|int8, default none)",
+                     [field](Config& c, const std::string& v) {
+                       const auto mode = vector::parse_vector_quantization(v);
+                       if (!mode.has_value()) {
+                         std::cerr << "Invalid --vector-quantization: " << v
+                                   << " (valid: none, int8)\n";
+                         return false;
+                       }
+                       (c.*field).mode = mode.value();
+                       return true;
+                     }},
+      Option<Config>{"--vector-rerank-factor", true,
+                     "Candidates reranked exactly per result in int8 mode (default 4)",
+                     [field](Config& c, const std::string& v) {
+                       const auto parsed = parse_size(v);
+                       if (!parsed.has_value() || parsed.value() < 1) {
+                         std::cerr << "Invalid --vector-rerank-factor: " << v
+                                   << " (must be an integer >= 1)\n";
+                         return false;
+                       }
+                       (c.*field).rerank_factor = parsed.value();
+                       return true;
+                     }},
+  };
+}
+
+}  // namespace ccmcp::apps
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "ccmcp/storage/sqlite_tuning.h"
+
+#include "shared/arg_parser.h"
+#include <cstddef>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ccmcp::apps {
+
+// sqlite_tuning_options returns the --sqlite-profile flag and the per-setting --sqlite-*
+// overrides, shared by every app that opens SQLite files. Values are written into the
+// SqliteTuningConfig member `field` of Config; invalid values are reported and rejected.
+template <typename Config>
+std::vector<Option<Config>> sqlite_tuning_options(storage::SqliteTuningConfig Config::*field) {
+  // An enumerated setting: parse(value) must succeed, and the result goes into `target`.
+  const auto enum_option = [field](std::string name, std::string description,
+                                   std::string valid, auto target, auto parse) {
+    return Option<Config>{
+        name, true, std::move(description),
+        [field, target, parse, name, valid](Config& c, const std::string& v) {
+          const auto parsed = parse(v);
+          if (!parsed.has_value()) {
+            std::cerr << "Invalid " << name << ": " << v << " (valid: " << valid << ")\n";
+            return false;
+          }
+          (c.*field).*target = parsed.value();
+          return true;
+        }};
+  };
+  using SizeField = std::optional<std::size_t> storage::SqliteTuningConfig::*;
+  const auto size_option = [field](std::string name, std::string description, SizeField target) {
+    return Option<Config>{name, true, std::move(description),
+                          [field, target, name](Config& c, const std::string& v) {
+                            const auto parsed = parse_size(v);
+                            if (!parsed.has_value()) {
+                              std::cerr << "Invalid " << name << ": " << v
+                                        << " (must be an integer >= 0)\n";
+                              return false;
+                            }
+                            (c.*field).*target = parsed.value();
+                            return true;
+                          }};
+  };
+
+  using storage::SqliteTuningConfig;
+  return {
+      enum_option("--sqlite-profile",
+                  "SQLite performance profile (durable|balanced|bulk-load, default balanced)",
+                  "durable, balanced, bulk-load", &SqliteTuningConfig::profile,
+                  storage::parse_sqlite_tuning_profile),
+      enum_option("--sqlite-journal-mode",
+                  "Override the profile's journal mode (delete|truncate|persist|memory|wal)",
+                  "delete, truncate, persist, memory, wal", &SqliteTuningConfig::journal_mode,
+                  storage::parse_sqlite_journal_mode),
+      enum_option("--sqlite-synchronous",
+                  "Override the profile's synchronous level (off|normal|full|extra)",
+                  "off, normal, full, extra", &SqliteTuningConfig::synchronous,
+                  storage::parse_sqlite_synchronous),
+      size_option("--sqlite-mmap-size", "Override the profile's mmap_size in bytes (0 = off)",
+                  &SqliteTuningConfig::mmap_size),
+      size_option("--sqlite-cache-size", "Override the profile's page cache size in KiB",
+                  &SqliteTuningConfig::cache_size_kib),
+      enum_option("--sqlite-temp-store",
+                  "Override the profile's temp store (default|file|memory)",
+                  "default, file, memory", &SqliteTuningConfig::temp_store,
+                  storage::parse_sqlite_temp_store),
+      size_option("--sqlite-busy-timeout",
+                  "Override the profile's busy timeout in milliseconds",
+                  &SqliteTuningConfig::busy_timeout_ms),
+      size_option("--sqlite-wal-autocheckpoint",
+                  "Override the profile's WAL auto-checkpoint interval in pages (0 = off)",
+                  &SqliteTuningConfig::wal_autocheckpoint),
+  };
+}
+
+}  // namespace ccmcp::apps
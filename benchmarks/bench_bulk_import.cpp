@@ -0,0 +1,137 @@
+// bench_bulk_import: time to load n atoms and n/10 opportunities into a file database, per-item
+// upsert versus upsert_many, under the balanced SqliteTuning profile. Each run uses a fresh
+// database file in the system temp directory.
+//
+// Usage: bench_bulk_import [--n 30000] [--batch 1000] [--requirements 8]
+//
+// Modes:
+//   upsert       IAtomRepository::upsert / IOpportunityRepository::upsert, one transaction each
+//   upsert_many  upsert_many in batches of --batch, one transaction per batch
+
+#include "ccmcp/storage/sqlite/sqlite_atom_repository.h"
+#include "ccmcp/storage/sqlite/sqlite_db.h"
+#include "ccmcp/storage/sqlite/sqlite_opportunity_repository.h"
+#include "ccmcp/storage/sqlite_tuning.h"
+
+#include "bench_util.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace ccmcp;
+
+std::shared_ptr<storage::sqlite::SqliteDb> open_db(const std::string& name) {
+  const auto dir = std::filesystem::temp_directory_path() / "ccmcp_bench_bulk_import" / name;
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  auto result = storage::sqlite::SqliteDb::open(
+      (dir / "ccmcp.db").string(),
+      storage::sqlite_tuning_for(storage::SqliteTuningProfile::kBalanced));
+  if (!result.has_value() || !result.value()->ensure_schema_v10().has_value()) {
+    std::fprintf(stderr, "failed to open benchmark database\n");
+    std::exit(1);
+  }
+  return result.value();
+}
+
+std::vector<domain::ExperienceAtom> make_atoms(std::size_t n) {
+  std::vector<domain::ExperienceAtom> atoms;
+  atoms.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    atoms.push_back({core::AtomId{bench::bench_key(i)}, "cpp", "Title", "Claim",
+                     {"systems", "latency"}, true, {"https://example.com"}});
+  }
+  return atoms;
+}
+
+std::vector<domain::Opportunity> make_opportunities(std::size_t n, std::size_t requirements) {
+  std::vector<domain::Opportunity> opportunities;
+  opportunities.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    domain::Opportunity opp{core::OpportunityId{bench::bench_key(i)}, "Acme", "Engineer", {}, ""};
+    for (std::size_t r = 0; r < requirements; ++r) {
+      opp.requirements.push_back({"Requirement " + std::to_string(r), {"cpp"}, r % 2 == 0});
+    }
+    opportunities.push_back(std::move(opp));
+  }
+  return opportunities;
+}
+
+// Calls write(first, last) on consecutive slices of at most batch items.
+template <typename T, typename Write>
+void in_batches(const std::vector<T>& items, std::size_t batch, Write write) {
+  for (std::size_t first = 0; first < items.size(); first += batch) {
+    const std::size_t last = std::min(items.size(), first + batch);
+    write(std::vector<T>(items.begin() + static_cast<std::ptrdiff_t>(first),
+                         items.begin() + static_cast<std::ptrdiff_t>(last)));
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {  // NOLINT(modernize-avoid-c-arrays)
+  const std::size_t n = std::max<std::size_t>(bench::size_arg(argc, argv, "--n", 30000), 1);
+  const std::size_t batch = std::max<std::size_t>(bench::size_arg(argc, argv, "--batch", 1000), 1);
+  const std::size_t requirements = bench::size_arg(argc, argv, "--requirements", 8);
+
+  const auto atoms = make_atoms(n);
+  const auto opportunities = make_opportunities(std::max<std::size_t>(n / 10, 1), requirements);
+
+  std::printf("atoms=%zu opportunities=%zu requirements/opp=%zu batch=%zu\n", atoms.size(),
+              opportunities.size(), requirements, batch);
+  std::printf("%-12s %-12s %12s %12s\n", "entity", "mode", "total_ms", "speedup");
+
+  double single_atoms_ms = 0;
+  double single_opps_ms = 0;
+  {
+    auto db = open_db("upsert");
+    storage::sqlite::SqliteAtomRepository atom_repo(db);
+    storage::sqlite::SqliteOpportunityRepository opp_repo(db);
+    auto start = bench::Clock::now();
+    for (const auto& atom : atoms) {
+      atom_repo.upsert(atom);
+    }
+    single_atoms_ms = bench::micros_since(start) / 1000.0;
+    start = bench::Clock::now();
+    for (const auto& opp : opportunities) {
+      opp_repo.upsert(opp);
+    }
+    single_opps_ms = bench::micros_since(start) / 1000.0;
+  }
+
+  double bulk_atoms_ms = 0;
+  double bulk_opps_ms = 0;
+  {
+    auto db = open_db("upsert_many");
+    storage::sqlite::SqliteAtomRepository atom_repo(db);
+    storage::sqlite::SqliteOpportunityRepository opp_repo(db);
+    std::size_t written = 0;
+    auto start = bench::Clock::now();
+    in_batches(atoms, batch, [&](const auto& slice) { written += atom_repo.upsert_many(slice); });
+    bulk_atoms_ms = bench::micros_since(start) / 1000.0;
+    start = bench::Clock::now();
+    in_batches(opportunities, batch,
+               [&](const auto& slice) { written += opp_repo.upsert_many(slice); });
+    bulk_opps_ms = bench::micros_since(start) / 1000.0;
+    if (written != atoms.size() + opportunities.size()) {
+      std::fprintf(stderr, "upsert_many: %zu of %zu records written\n", written,
+                   atoms.size() + opportunities.size());
+    }
+  }
+
+  std::printf("%-12s %-12s %12.1f %11.2fx\n", "atom", "upsert", single_atoms_ms, 1.0);
+  std::printf("%-12s %-12s %12.1f %11.2fx\n", "atom", "upsert_many", bulk_atoms_ms,
+              single_atoms_ms / bulk_atoms_ms);
+  std::printf("%-12s %-12s %12.1f %11.2fx\n", "opportunity", "upsert", single_opps_ms, 1.0);
+  std::printf("%-12s %-12s %12.1f %11.2fx\n", "opportunity", "upsert_many", bulk_opps_ms,
+              single_opps_ms / bulk_opps_ms);
+  return 0;
+}
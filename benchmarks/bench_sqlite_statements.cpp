@@ -0,0 +1,115 @@
+// bench_sqlite_statements: per-call latency of SQLite repository methods with SqliteDb's
+// statement cache disabled (capacity 0: every call parses and plans its SQL, as before the
+// cache) and enabled (the default). Each mode runs on a fresh in-memory database.
+//
+// Usage: bench_sqlite_statements [--n 20000]
+//
+// Operations:
+//   get           SqliteAtomRepository::get on n stored atoms (1 statement per call)
+//   append        SqliteAuditLog::append over 64 traces (2-3 statements per call)
+//   upsert_entry  SqliteIndexRunStore::upsert_entry into a running run (2 statements per call)
+
+#include "ccmcp/indexing/index_run.h"
+#include "ccmcp/storage/audit_event.h"
+#include "ccmcp/storage/sqlite/sqlite_atom_repository.h"
+#include "ccmcp/storage/sqlite/sqlite_audit_log.h"
+#include "ccmcp/storage/sqlite/sqlite_db.h"
+#include "ccmcp/storage/sqlite/sqlite_index_run_store.h"
+
+#include "bench_util.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace ccmcp;
+
+std::shared_ptr<storage::sqlite::SqliteDb> open_db(std::size_t cache_capacity) {
+  auto result = storage::sqlite::SqliteDb::open(":memory:");
+  if (!result.has_value() || !result.value()->ensure_schema_v10().has_value()) {
+    std::fprintf(stderr, "failed to open benchmark database\n");
+    std::exit(1);
+  }
+  result.value()->set_statement_cache_capacity(cache_capacity);
+  return result.value();
+}
+
+template <typename Op>
+bench::LatencyStats time_calls(std::size_t n, Op op) {
+  std::vector<double> samples;
+  samples.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto start = bench::Clock::now();
+    op(i);
+    samples.push_back(bench::micros_since(start));
+  }
+  return bench::summarize(std::move(samples));
+}
+
+bench::LatencyStats bench_get(std::size_t n, std::size_t cache_capacity) {
+  auto db = open_db(cache_capacity);
+  storage::sqlite::SqliteAtomRepository repo(db);
+  for (std::size_t i = 0; i < n; ++i) {
+    repo.upsert({core::AtomId{bench::bench_key(i)}, "cpp", "Title", "Claim", {"a", "b"}, true,
+                 {}});
+  }
+  std::size_t found = 0;
+  const auto stats = time_calls(n, [&](std::size_t i) {
+    found += repo.get(core::AtomId{bench::bench_key((i * 7919) % n)}).has_value() ? 1 : 0;
+  });
+  if (found != n) {
+    std::fprintf(stderr, "get: %zu of %zu atoms found\n", found, n);
+  }
+  return stats;
+}
+
+bench::LatencyStats bench_append(std::size_t n, std::size_t cache_capacity) {
+  auto db = open_db(cache_capacity);
+  storage::sqlite::SqliteAuditLog log(db);
+  return time_calls(n, [&](std::size_t i) {
+    log.append({"evt-" + std::to_string(i), "trace-" + std::to_string(i % 64), "Benchmark",
+                "{}", "2026-01-01T00:00:00Z", {}});
+  });
+}
+
+bench::LatencyStats bench_upsert_entry(std::size_t n, std::size_t cache_capacity) {
+  auto db = open_db(cache_capacity);
+  storage::sqlite::SqliteIndexRunStore store(db);
+  store.upsert_run({"run-1", "2026-01-01T00:00:00Z", std::nullopt, "deterministic-stub", "", "",
+                    indexing::IndexRunStatus::kRunning, "{}"});
+  return time_calls(n, [&](std::size_t i) {
+    store.upsert_entry({"run-1", "atom", bench::bench_key(i), "source-hash", "vector-hash",
+                        "2026-01-01T00:00:00Z"});
+  });
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {  // NOLINT(modernize-avoid-c-arrays)
+  const std::size_t n = std::max<std::size_t>(bench::size_arg(argc, argv, "--n", 20000), 1);
+
+  std::printf("n=%zu\n", n);
+  std::printf("%-14s %-10s %10s %10s %10s %10s\n", "op", "mode", "mean_us", "p50_us", "p99_us",
+              "speedup");
+
+  struct Operation {
+    const char* name;
+    bench::LatencyStats (*run)(std::size_t, std::size_t);
+  };
+  for (const Operation& op : {Operation{"get", bench_get}, Operation{"append", bench_append},
+                              Operation{"upsert_entry", bench_upsert_entry}}) {
+    const auto uncached = op.run(n, 0);
+    const auto cached = op.run(n, storage::sqlite::kDefaultStatementCacheCapacity);
+    std::printf("%-14s %-10s %10.2f %10.2f %10.2f %10s\n", op.name, "uncached", uncached.mean_us,
+                uncached.p50_us, uncached.p99_us, "1.00x");
+    std::printf("%-14s %-10s %10.2f %10.2f %10.2f %9.2fx\n", op.name, "cached", cached.mean_us,
+                cached.p50_us, cached.p99_us, uncached.mean_us / cached.mean_us);
+  }
+  return 0;
+}
@@ -0,0 +1,124 @@
+// bench_sqlite_tuning: per-call latency of SQLite repository methods on a file database under
+// each SqliteTuning profile. Each profile runs on a fresh database file in the system temp
+// directory, so synchronous/journal settings pay their real fsync cost.
+//
+// Usage: bench_sqlite_tuning [--n 5000]
+//
+// Operations:
+//   upsert        SqliteAtomRepository::upsert of n atoms, one autocommit transaction each
+//   upsert_entry  SqliteIndexRunStore::upsert_entry into a running run (2 statements per call)
+//   get           SqliteAtomRepository::get on the n stored atoms
+
+#include "ccmcp/indexing/index_run.h"
+#include "ccmcp/storage/sqlite/sqlite_atom_repository.h"
+#include "ccmcp/storage/sqlite/sqlite_db.h"
+#include "ccmcp/storage/sqlite/sqlite_index_run_store.h"
+#include "ccmcp/storage/sqlite_tuning.h"
+
+#include "bench_util.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace ccmcp;
+
+std::shared_ptr<storage::sqlite::SqliteDb> open_db(storage::SqliteTuningProfile profile) {
+  const auto dir = std::filesystem::temp_directory_path() / "ccmcp_bench_sqlite_tuning" /
+                   std::string(storage::to_string(profile));
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  auto result = storage::sqlite::SqliteDb::open((dir / "ccmcp.db").string(),
+                                                storage::sqlite_tuning_for(profile));
+  if (!result.has_value() || !result.value()->ensure_schema_v10().has_value()) {
+    std::fprintf(stderr, "failed to open benchmark database\n");
+    std::exit(1);
+  }
+  return result.value();
+}
+
+template <typename Op>
+bench::LatencyStats time_calls(std::size_t n, Op op) {
+  std::vector<double> samples;
+  samples.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto start = bench::Clock::now();
+    op(i);
+    samples.push_back(bench::micros_since(start));
+  }
+  return bench::summarize(std::move(samples));
+}
+
+struct ProfileResult {
+  bench::LatencyStats upsert;
+  bench::LatencyStats upsert_entry;
+  bench::LatencyStats get;
+};
+
+ProfileResult run_profile(std::size_t n, storage::SqliteTuningProfile profile) {
+  auto db = open_db(profile);
+  storage::sqlite::SqliteAtomRepository atoms(db);
+  storage::sqlite::SqliteIndexRunStore runs(db);
+
+  ProfileResult result;
+  result.upsert = time_calls(n, [&](std::size_t i) {
+    atoms.upsert({core::AtomId{bench::bench_key(i)}, "cpp", "Title", "Claim", {"a", "b"}, true,
+                  {}});
+  });
+  runs.upsert_run({"run-1", "2026-01-01T00:00:00Z", std::nullopt, "deterministic-stub", "", "",
+                   indexing::IndexRunStatus::kRunning, "{}"});
+  result.upsert_entry = time_calls(n, [&](std::size_t i) {
+    runs.upsert_entry({"run-1", "atom", bench::bench_key(i), "source-hash", "vector-hash",
+                       "2026-01-01T00:00:00Z"});
+  });
+  std::size_t found = 0;
+  result.get = time_calls(n, [&](std::size_t i) {
+    found += atoms.get(core::AtomId{bench::bench_key((i * 7919) % n)}).has_value() ? 1 : 0;
+  });
+  if (found != n) {
+    std::fprintf(stderr, "get: %zu of %zu atoms found\n", found, n);
+  }
+  return result;
+}
+
+void print_row(const char* op, storage::SqliteTuningProfile profile,
+               const bench::LatencyStats& stats, const bench::LatencyStats& baseline) {
+  std::printf("%-14s %-10s %10.2f %10.2f %10.2f %9.2fx\n", op,
+              std::string(storage::to_string(profile)).c_str(), stats.mean_us, stats.p50_us,
+              stats.p99_us, baseline.mean_us / stats.mean_us);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {  // NOLINT(modernize-avoid-c-arrays)
+  const std::size_t n = std::max<std::size_t>(bench::size_arg(argc, argv, "--n", 5000), 1);
+
+  std::printf("n=%zu  (speedup relative to durable)\n", n);
+  std::printf("%-14s %-10s %10s %10s %10s %10s\n", "op", "profile", "mean_us", "p50_us", "p99_us",
+              "speedup");
+
+  const storage::SqliteTuningProfile profiles[] = {  // NOLINT(modernize-avoid-c-arrays)
+      storage::SqliteTuningProfile::kDurable, storage::SqliteTuningProfile::kBalanced,
+      storage::SqliteTuningProfile::kBulkLoad};
+  std::vector<ProfileResult> results;
+  for (const auto profile : profiles) {
+    results.push_back(run_profile(n, profile));
+  }
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    print_row("upsert", profiles[i], results[i].upsert, results[0].upsert);
+  }
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    print_row("upsert_entry", profiles[i], results[i].upsert_entry, results[0].upsert_entry);
+  }
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    print_row("get", profiles[i], results[i].get, results[0].get);
+  }
+  return 0;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+// Shared helpers for the benchmark executables in this directory.
+//
+// Benchmarks are plain executables (no framework dependency) that print one table to stdout.
+// All inputs are generated from fixed seeds so runs are comparable across machines and
+// commits; only the timings vary.
+
+#include "ccmcp/vector/embedding_index.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ccmcp::bench {
+
+using Clock = std::chrono::steady_clock;
+
+// Elapsed microseconds since start.
+[[nodiscard]] inline double micros_since(Clock::time_point start) {
+  return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+// LatencyStats summarises a set of per-operation latencies (microseconds).
+struct LatencyStats {
+  double mean_us{0.0};  // NOLINT(readability-identifier-naming)
+  double p50_us{0.0};   // NOLINT(readability-identifier-naming)
+  double p99_us{0.0};   // NOLINT(readability-identifier-naming)
+};
+
+[[nodiscard]] inline LatencyStats summarize(std::vector<double> samples_us) {
+  LatencyStats stats;
+  if (samples_us.empty()) {
+    return stats;
+  }
+  std::sort(samples_us.begin(), samples_us.end());
+  double total = 0.0;
+  for (const double s : samples_us) {
+    total += s;
+  }
+  const auto at = [&samples_us](double q) {
+    const auto i = static_cast<std::size_t>(q * static_cast<double>(samples_us.size() - 1));
+    return samples_us[i];
+  };
+  stats.mean_us = total / static_cast<double>(samples_us.size());
+  stats.p50_us = at(0.50);
+  stats.p99_us = at(0.99);
+  return stats;
+}
+
+// random_vectors returns count vectors of dimension dim with components uniform in
+// [-1, 1), generated from seed.
+[[nodiscard]] inline std::vector<vector::Vector> random_vectors(std::size_t count, std::size_t dim,
+                                                                std::uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<vector::Vector> out(count, vector::Vector(dim));
+  for (auto& v : out) {
+    for (auto& x : v) {
+      x = dist(rng);
+    }
+  }
+  return out;
+}
+
+// bench_key returns a zero-padded key so lexicographic order equals numeric order.
+[[nodiscard]] inline std::string bench_key(std::size_t i) {
+  std::string digits = std::to_string(i);
+  return "atom-" + std::string(digits.size() < 8 ? 8 - digits.size() : 0, '0') + digits;
+}
+
+// size_arg returns the value following flag in argv, or fallback when absent/invalid.
+[[nodiscard]] inline std::size_t size_arg(int argc, char* argv[],  // NOLINT(modernize-avoid-c-arrays)
+                                          const std::string& flag, std::size_t fallback) {
+  for (int i = 1; i + 1 < argc; ++i) {
+    if (flag == argv[i]) {  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      char* end = nullptr;
+      const auto value = std::strtoull(argv[i + 1], &end, 10);  // NOLINT
+      if (end != nullptr && *end == '\0') {
+        return static_cast<std::size_t>(value);
+      }
+    }
+  }
+  return fallback;
+}
+
+}  // namespace ccmcp::bench
@@ -0,0 +1,73 @@
+// bench_vector_batch: exact top-k for a batch of queries, query() in a loop against
+// query_batch(), on InMemoryEmbeddingIndex (FlatVectorStore). query_batch() scores blocks of
+// queries against each tile of stored rows, so the matrix is streamed from memory once per
+// query block instead of once per query; both paths must return identical results.
+//
+// Usage: bench_vector_batch [--n 50000] [--queries 64] [--k 10] [--reps 5]
+//
+// Runs dimensions 128 and 1536.
+
+#include "ccmcp/vector/inmemory_embedding_index.h"
+
+#include "bench_util.h"
+#include <cstdio>
+#include <vector>
+
+int main(int argc, char* argv[]) {  // NOLINT(modernize-avoid-c-arrays)
+  using namespace ccmcp;
+
+  const std::size_t n = bench::size_arg(argc, argv, "--n", 50000);
+  const std::size_t num_queries = bench::size_arg(argc, argv, "--queries", 64);
+  const std::size_t k = bench::size_arg(argc, argv, "--k", 10);
+  const std::size_t reps = bench::size_arg(argc, argv, "--reps", 5);
+
+  std::printf("n=%zu queries=%zu k=%zu reps=%zu\n", n, num_queries, k, reps);
+  std::printf("%-6s %-8s %12s %12s %10s %10s\n", "dim", "mode", "batch_ms", "us_per_query",
+              "speedup", "mismatch");
+
+  for (const std::size_t dim : {std::size_t{128}, std::size_t{1536}}) {
+    const auto corpus = bench::random_vectors(n, dim, 1);
+    const auto queries = bench::random_vectors(num_queries, dim, 2);
+    vector::InMemoryEmbeddingIndex index;
+    for (std::size_t i = 0; i < n; ++i) {
+      index.upsert(bench::bench_key(i), corpus[i], "{}");
+    }
+
+    std::vector<double> loop_us;
+    std::vector<double> batch_us;
+    std::size_t mismatches = 0;
+    for (std::size_t r = 0; r < reps; ++r) {
+      auto start = bench::Clock::now();
+      std::vector<std::vector<vector::VectorSearchResult>> looped;
+      looped.reserve(queries.size());
+      for (const auto& q : queries) {
+        looped.push_back(index.query(q, k));
+      }
+      loop_us.push_back(bench::micros_since(start));
+
+      start = bench::Clock::now();
+      const auto batched = index.query_batch(queries, k);
+      batch_us.push_back(bench::micros_since(start));
+
+      for (std::size_t q = 0; q < queries.size(); ++q) {
+        for (std::size_t i = 0; i < looped[q].size(); ++i) {
+          const auto& a = looped[q][i];
+          const auto& b = batched[q][i];
+          mismatches += (a.key != b.key || a.score != b.score) ? 1 : 0;
+        }
+      }
+    }
+
+    const auto loop_stats = bench::summarize(loop_us);
+    const auto batch_stats = bench::summarize(batch_us);
+    const auto per_query = [num_queries](double us) {
+      return us / static_cast<double>(num_queries);
+    };
+    std::printf("%-6zu %-8s %12.2f %12.1f %10s %10s\n", dim, "loop", loop_stats.mean_us / 1000.0,
+                per_query(loop_stats.mean_us), "1.00x", "-");
+    std::printf("%-6zu %-8s %12.2f %12.1f %9.2fx %10zu\n", dim, "batch",
+                batch_stats.mean_us / 1000.0, per_query(batch_stats.mean_us),
+                loop_stats.mean_us / batch_stats.mean_us, mismatches);
+  }
+  return 0;
+}
@@ -0,0 +1,63 @@
+// bench_vector_math: throughput of the vector_math dot-product kernels per instruction set,
+// scoring one query against a matrix of rows (the FlatVectorStore inner loop).
+//
+// Usage: bench_vector_math [--rows 20000] [--reps 20]
+//
+// Runs dimensions 128 and 1536 for every ISA this CPU supports and checks that each ISA's
+// scores are bit-identical to the scalar kernel's.
+
+#include "ccmcp/vector/vector_math.h"
+
+#include "bench_util.h"
+#include <cstdio>
+#include <vector>
+
+int main(int argc, char* argv[]) {  // NOLINT(modernize-avoid-c-arrays)
+  using namespace ccmcp;
+  using vector::math::Isa;
+
+  const std::size_t num_rows = bench::size_arg(argc, argv, "--rows", 20000);
+  const std::size_t reps = bench::size_arg(argc, argv, "--reps", 20);
+
+  std::printf("active=%s rows=%zu reps=%zu\n",
+              vector::math::to_string(vector::math::kernels().isa).data(), num_rows, reps);
+  std::printf("%-6s %-8s %10s %10s %12s %10s\n", "dim", "isa", "mean_us", "p99_us", "ns_per_row",
+              "mismatch");
+
+  for (const std::size_t dim : {std::size_t{128}, std::size_t{1536}}) {
+    const auto corpus = bench::random_vectors(num_rows, dim, 1);
+    const auto query = bench::random_vectors(1, dim, 2).front();
+    std::vector<float> rows;
+    rows.reserve(num_rows * dim);
+    for (const auto& v : corpus) {
+      rows.insert(rows.end(), v.begin(), v.end());
+    }
+
+    std::vector<double> reference(num_rows);
+    const auto& scalar = *vector::math::kernels_for(Isa::kScalar);
+    scalar.dot_many(query.data(), rows.data(), dim, num_rows, dim, reference.data());
+
+    for (const Isa isa : {Isa::kScalar, Isa::kSse42, Isa::kAvx2, Isa::kAvx512}) {
+      const auto* kernels = vector::math::kernels_for(isa);
+      if (kernels == nullptr) {
+        continue;
+      }
+      std::vector<double> out(num_rows);
+      std::vector<double> samples_us;
+      for (std::size_t r = 0; r < reps; ++r) {
+        const auto start = bench::Clock::now();
+        kernels->dot_many(query.data(), rows.data(), dim, num_rows, dim, out.data());
+        samples_us.push_back(bench::micros_since(start));
+      }
+      std::size_t mismatches = 0;
+      for (std::size_t i = 0; i < num_rows; ++i) {
+        mismatches += out[i] != reference[i] ? 1 : 0;
+      }
+      const auto stats = bench::summarize(samples_us);
+      std::printf("%-6zu %-8s %10.1f %10.1f %12.2f %10zu\n", dim,
+                  vector::math::to_string(isa).data(), stats.mean_us, stats.p99_us,
+                  stats.mean_us * 1000.0 / static_cast<double>(num_rows), mismatches);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,94 @@
+// bench_vector_quantized: resident memory, recall@k and query latency of SqliteEmbeddingIndex
+// with the float32 mirror against the int8 mirror (--vector-quantization int8), swept over
+// rerank_factor. The int8 rows report exact scores; recall@k counts how many of the exact
+// top-k survive the int8 candidate cut.
+//
+// Vectors are uniform random; the vectors.db file is written once per dimension in a
+// temporary directory and every index variant is opened on it.
+//
+// Usage: bench_vector_quantized [--n 20000] [--queries 200] [--k 10]
+//
+// Runs dimensions 128 and 1536.
+
+#include "ccmcp/vector/flat_vector_store.h"
+#include "ccmcp/vector/quantized_vector_store.h"
+#include "ccmcp/vector/sqlite_embedding_index.h"
+
+#include "bench_util.h"
+#include <cstdio>
+#include <filesystem>
+#include <set>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[]) {  // NOLINT(modernize-avoid-c-arrays)
+  using namespace ccmcp;
+
+  const std::size_t n = bench::size_arg(argc, argv, "--n", 20000);
+  const std::size_t num_queries = bench::size_arg(argc, argv, "--queries", 200);
+  const std::size_t k = bench::size_arg(argc, argv, "--k", 10);
+
+  const auto dir = std::filesystem::temp_directory_path() / "ccmcp_bench_vector_quantized";
+  std::printf("n=%zu queries=%zu k=%zu\n", n, num_queries, k);
+  std::printf("%-6s %-10s %12s %10s %10s %10s %10s\n", "dim", "mirror", "mirror_MiB", "recall@k",
+              "mean_us", "p50_us", "p99_us");
+
+  for (const std::size_t dim : {std::size_t{128}, std::size_t{1536}}) {
+    const auto corpus = bench::random_vectors(n, dim, 1);
+    const auto queries = bench::random_vectors(num_queries, dim, 2);
+
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    const std::string db_file = (dir / "vectors.db").string();
+
+    // Mirror footprints, measured on the stores the index holds in each mode.
+    vector::FlatVectorStore flat;
+    vector::QuantizedVectorStore quantized;
+    std::vector<vector::VectorRecord> records;
+    records.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      flat.upsert(bench::bench_key(i), corpus[i], "{}");
+      quantized.upsert(bench::bench_key(i), corpus[i], "{}");
+      records.push_back({bench::bench_key(i), corpus[i], "{}"});
+    }
+    const auto mib = [](std::size_t bytes) {
+      return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    };
+
+    std::vector<std::set<std::string>> truth(num_queries);
+    const auto run = [&](const vector::SqliteEmbeddingIndex& index, const char* label,
+                         std::size_t bytes, bool record_truth) {
+      std::size_t hits = 0;
+      std::vector<double> latencies;
+      for (std::size_t q = 0; q < num_queries; ++q) {
+        const auto start = bench::Clock::now();
+        const auto results = index.query(queries[q], k);
+        latencies.push_back(bench::micros_since(start));
+        for (const auto& r : results) {
+          if (record_truth) {
+            truth[q].insert(r.key);
+          }
+          hits += truth[q].count(r.key);
+        }
+      }
+      const auto stats = bench::summarize(latencies);
+      std::printf("%-6zu %-10s %12.1f %10.4f %10.1f %10.1f %10.1f\n", dim, label, mib(bytes),
+                  static_cast<double>(hits) / static_cast<double>(num_queries * k), stats.mean_us,
+                  stats.p50_us, stats.p99_us);
+    };
+
+    {
+      vector::SqliteEmbeddingIndex exact(db_file);
+      exact.upsert_many(records);
+      run(exact, "float32", flat.vector_bytes(), true);
+    }
+    for (const std::size_t factor : {1, 2, 4, 8}) {
+      const vector::SqliteEmbeddingIndex index(
+          db_file, {.mode = vector::VectorQuantization::kInt8, .rerank_factor = factor});
+      const std::string label = "int8 x" + std::to_string(factor);
+      run(index, label.c_str(), quantized.vector_bytes(), false);
+    }
+  }
+  std::filesystem::remove_all(dir);
+  return 0;
+}
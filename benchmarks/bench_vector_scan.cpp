@@ -0,0 +1,84 @@
+// bench_vector_scan: exact top-k scan latency of InMemoryEmbeddingIndex (FlatVectorStore)
+// against the previous std::map layout that recomputed both norms per comparison. Both use
+// the same vector_math kernels, so any result mismatch is a layout bug.
+//
+// Usage: bench_vector_scan [--n 100000] [--dim 128] [--queries 50] [--k 10]
+
+#include "ccmcp/vector/inmemory_embedding_index.h"
+#include "ccmcp/vector/top_k.h"
+#include "ccmcp/vector/vector_math.h"
+
+#include "bench_util.h"
+#include <cstdio>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using ccmcp::vector::Vector;
+using ccmcp::vector::VectorSearchResult;
+
+// The map-of-vectors scan InMemoryEmbeddingIndex used before FlatVectorStore.
+std::vector<VectorSearchResult> legacy_query(
+    const std::map<std::string, std::pair<Vector, std::string>>& vectors, const Vector& q,
+    std::size_t top_k) {
+  ccmcp::vector::TopKSelector selector(top_k);
+  for (const auto& [key, pair] : vectors) {
+    const double score = ccmcp::vector::math::cosine_similarity(q, pair.first);
+    if (selector.accepts(score, key)) {
+      selector.push(VectorSearchResult{.key = key, .score = score, .metadata = pair.second});
+    }
+  }
+  return selector.take_sorted();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {  // NOLINT(modernize-avoid-c-arrays)
+  using namespace ccmcp;
+
+  const std::size_t n = bench::size_arg(argc, argv, "--n", 100000);
+  const std::size_t dim = bench::size_arg(argc, argv, "--dim", 128);
+  const std::size_t num_queries = bench::size_arg(argc, argv, "--queries", 50);
+  const std::size_t k = bench::size_arg(argc, argv, "--k", 10);
+
+  const auto corpus = bench::random_vectors(n, dim, 1);
+  const auto queries = bench::random_vectors(num_queries, dim, 2);
+
+  vector::InMemoryEmbeddingIndex flat;
+  std::map<std::string, std::pair<Vector, std::string>> legacy;
+  for (std::size_t i = 0; i < n; ++i) {
+    flat.upsert(bench::bench_key(i), corpus[i], "{}");
+    legacy[bench::bench_key(i)] = {corpus[i], "{}"};
+  }
+
+  std::vector<double> flat_us;
+  std::vector<double> legacy_us;
+  std::size_t mismatches = 0;
+  for (const auto& q : queries) {
+    auto start = bench::Clock::now();
+    const auto a = flat.query(q, k);
+    flat_us.push_back(bench::micros_since(start));
+
+    start = bench::Clock::now();
+    const auto b = legacy_query(legacy, q, k);
+    legacy_us.push_back(bench::micros_since(start));
+
+    for (std::size_t i = 0; i < a.size(); ++i) {
+      mismatches += (a[i].key != b[i].key || a[i].score != b[i].score) ? 1 : 0;
+    }
+  }
+
+  const auto flat_stats = bench::summarize(flat_us);
+  const auto legacy_stats = bench::summarize(legacy_us);
+  std::printf("n=%zu dim=%zu queries=%zu k=%zu result_mismatches=%zu\n", n, dim, num_queries, k,
+              mismatches);
+  std::printf("%-10s %10s %10s %10s\n", "layout", "mean_us", "p50_us", "p99_us");
+  std::printf("%-10s %10.1f %10.1f %10.1f\n", "map", legacy_stats.mean_us, legacy_stats.p50_us,
+              legacy_stats.p99_us);
+  std::printf("%-10s %10.1f %10.1f %10.1f\n", "flat", flat_stats.mean_us, flat_stats.p50_us,
+              flat_stats.p99_us);
+  return 0;
+}
@@ -7,14 +7,17 @@
 #include "ccmcp/core/id_generator.h"
 #include "ccmcp/core/ids.h"
 #include "ccmcp/core/services.h"
+#include "ccmcp/core/thread_pool.h"
 #include "ccmcp/domain/decision_record.h"
 #include "ccmcp/domain/interaction.h"
 #include "ccmcp/domain/match_report.h"
 #include "ccmcp/domain/opportunity.h"
 #include "ccmcp/indexing/index_run_store.h"
+#include "ccmcp/ingest/bulk_import.h"
 #include "ccmcp/ingest/resume_ingestor.h"
 #include "ccmcp/ingest/resume_store.h"
 #include "ccmcp/interaction/interaction_coordinator.h"
+#include "ccmcp/matching/corpus_snapshot.h"
 #include "ccmcp/matching/matcher.h"
 #include "ccmcp/storage/audit_event.h"
 #include "ccmcp/storage/decision_store.h"
@@ -67,10 +70,53 @@ struct MatchPipelineResponse {
 
 // Run matching + validation pipeline
 // Emits audit events: RunStarted, MatchCompleted, ValidationCompleted, RunCompleted
-[[nodiscard]] MatchPipelineResponse run_match_pipeline(const MatchPipelineRequest& req,
-                                                       core::Services& services,
-                                                       core::IIdGenerator& id_gen,
-                                                       core::IClock& clock);
+//
+// corpus_cache (optional): when neither atoms nor atom_ids are provided, the default
+// "all verified atoms" corpus is taken from the cache instead of re-listing and
+// re-tokenizing services.atoms on every call. Output is identical either way.
+[[nodiscard]] MatchPipelineResponse run_match_pipeline(
+    const MatchPipelineRequest& req, core::Services& services, core::IIdGenerator& id_gen,
+    core::IClock& clock, matching::CorpusSnapshotCache* corpus_cache = nullptr);
+
+// ────────────────────────────────────────────────────────────────
+// Batch Match Pipeline
+// ────────────────────────────────────────────────────────────────
+
+struct MatchBatchPipelineRequest {
+  // Opportunities to match (empty = all opportunities in the repository)
+  std::vector<core::OpportunityId> opportunity_ids;  // NOLINT(readability-identifier-naming)
+
+  // Matching configuration (applied to every opportunity in the batch)
+  matching::MatchingStrategy strategy{
+      matching::MatchingStrategy::
+          kDeterministicLexicalV01};  // NOLINT(readability-identifier-naming)
+  size_t k_lex{25};                   // NOLINT(readability-identifier-naming)
+  size_t k_emb{25};                   // NOLINT(readability-identifier-naming)
+
+  // Optional trace_id (if not provided, will be generated). One trace covers the batch.
+  std::optional<std::string> trace_id;  // NOLINT(readability-identifier-naming)
+};
+
+struct MatchBatchPipelineResponse {
+  std::string trace_id;  // NOLINT(readability-identifier-naming)
+  // One entry per opportunity, in request order (or repository order when defaulted).
+  // Every entry carries the batch trace_id.
+  std::vector<MatchPipelineResponse> results;  // NOLINT(readability-identifier-naming)
+};
+
+// Match many opportunities against the verified-atom corpus in one pass
+// (Matcher::evaluate_batch), then validate each report.
+// Emits audit events under a single trace: RunStarted, then MatchCompleted and
+// ValidationCompleted per opportunity (in result order), then RunCompleted.
+// Throws std::invalid_argument if any requested opportunity does not exist (before any
+// matching is done).
+//
+// corpus_cache (optional): see run_match_pipeline().
+// pool (optional): parallelizes scoring across cores; results are identical without it.
+[[nodiscard]] MatchBatchPipelineResponse run_match_batch_pipeline(
+    const MatchBatchPipelineRequest& req, core::Services& services, core::IIdGenerator& id_gen,
+    core::IClock& clock, matching::CorpusSnapshotCache* corpus_cache = nullptr,
+    core::ThreadPool* pool = nullptr);
 
 // ────────────────────────────────────────────────────────────────
 // Validation Pipeline (standalone)
@@ -164,6 +210,31 @@ struct IngestResumePipelineResponse {
     ingest::IResumeStore& resume_store, core::Services& services, core::IIdGenerator& id_gen,
     core::IClock& clock);
 
+// ────────────────────────────────────────────────────────────────
+// Bulk Import Pipeline
+// ────────────────────────────────────────────────────────────────
+
+struct BulkImportPipelineRequest {
+  // JSONL file in the format read by ingest::import_jsonl
+  std::string input_path;                                  // NOLINT(readability-identifier-naming)
+  size_t batch_size{ingest::kDefaultBulkImportBatchSize};  // NOLINT(readability-identifier-naming)
+  std::optional<std::string> trace_id;                     // NOLINT(readability-identifier-naming)
+};
+
+struct BulkImportPipelineResponse {
+  ingest::BulkImportResult result;  // NOLINT(readability-identifier-naming)
+  std::string trace_id;             // NOLINT(readability-identifier-naming)
+};
+
+// Stream a JSONL file of atoms and opportunities into services.atoms and
+// services.opportunities, batch_size records per upsert_many call.
+// Invalid lines are reported in the response, not thrown.
+// Emits audit events: BulkImportStarted, BulkImportCompleted
+// Throws std::runtime_error if the input file cannot be opened.
+[[nodiscard]] BulkImportPipelineResponse run_bulk_import_pipeline(
+    const BulkImportPipelineRequest& req, core::Services& services, core::IIdGenerator& id_gen,
+    core::IClock& clock);
+
 // ────────────────────────────────────────────────────────────────
 // Index Build Pipeline
 // ────────────────────────────────────────────────────────────────
@@ -172,6 +243,7 @@ struct IndexBuildPipelineRequest {
   std::string scope{
       "all"};  // "atoms"|"resumes"|"opps"|"all"  // NOLINT(readability-identifier-naming)
   std::optional<std::string> trace_id;  // NOLINT(readability-identifier-naming)
+  size_t jobs{1};  // embedding threads  // NOLINT(readability-identifier-naming)
 };
 
 struct IndexBuildPipelineResponse {
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace ccmcp::core {
+
+// AlignedAllocator is a std::allocator replacement whose allocations start on an Alignment-byte
+// boundary (e.g. 64 = one cache line / one AVX-512 register), for contiguous numeric buffers
+// such as std::vector<float, AlignedAllocator<float, 64>>.
+template <typename T, std::size_t Alignment>
+class AlignedAllocator {
+ public:
+  static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0,
+                "Alignment must be a power of two no smaller than alignof(T)");
+
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() noexcept = default;
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment>& /*other*/) noexcept {}  // NOLINT
+
+  [[nodiscard]] T* allocate(std::size_t n) {
+    return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+  }
+
+  void deallocate(T* p, std::size_t /*n*/) noexcept {
+    ::operator delete(p, std::align_val_t{Alignment});
+  }
+
+  template <typename U>
+  bool operator==(const AlignedAllocator<U, Alignment>& /*other*/) const noexcept {
+    return true;
+  }
+};
+
+}  // namespace ccmcp::core
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace ccmcp::core {
+
+// SnapshotCell publishes immutable snapshots of T to concurrent readers (read-copy-update).
+//
+// A reader calls load() and works on the returned snapshot for as long as it likes; the
+// snapshot never changes underneath it. A writer builds a new T and store()s it; readers
+// that loaded the old snapshot keep it alive through their shared_ptr, and it is freed when
+// the last of them lets go. Writers must be serialized by the caller.
+//
+// Where the standard library provides std::atomic<std::shared_ptr> (C++20,
+// __cpp_lib_atomic_shared_ptr) load() and store() are atomic pointer operations. Otherwise
+// a mutex guards the pointer copy only — a reference-count increment, never a scan.
+template <typename T>
+class SnapshotCell {
+ public:
+  explicit SnapshotCell(std::shared_ptr<const T> initial = std::make_shared<const T>())
+      : current_(std::move(initial)) {}
+
+  SnapshotCell(const SnapshotCell&) = delete;
+  SnapshotCell& operator=(const SnapshotCell&) = delete;
+  SnapshotCell(SnapshotCell&&) = delete;
+  SnapshotCell& operator=(SnapshotCell&&) = delete;
+
+  [[nodiscard]] std::shared_ptr<const T> load() const noexcept {
+#if defined(__cpp_lib_atomic_shared_ptr)
+    return current_.load(std::memory_order_acquire);
+#else
+    std::lock_guard<std::mutex> lock(mutex_);
+    return current_;
+#endif
+  }
+
+  void store(std::shared_ptr<const T> next) noexcept {
+#if defined(__cpp_lib_atomic_shared_ptr)
+    current_.store(std::move(next), std::memory_order_release);
+#else
+    std::lock_guard<std::mutex> lock(mutex_);
+    current_.swap(next);  // the old snapshot (now in next) is released after unlocking
+#endif
+  }
+
+ private:
+#if defined(__cpp_lib_atomic_shared_ptr)
+  std::atomic<std::shared_ptr<const T>> current_;
+#else
+  mutable std::mutex mutex_;
+  std::shared_ptr<const T> current_;
+#endif
+};
+
+}  // namespace ccmcp::core
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ccmcp::core {
+
+// ThreadPool is a fixed-size work-stealing thread pool.
+//
+// Each worker owns a task deque: it pops its own newest task (LIFO, cache-friendly) and,
+// when empty, steals the oldest task from another worker (FIFO). Tasks submitted from
+// outside the pool are distributed round-robin across worker deques.
+//
+// The pool schedules work but never decides results: callers that need deterministic
+// output (e.g. Matcher) write per-task results into pre-sized slots and reduce them in a
+// fixed order after parallel_for() returns.
+class ThreadPool {
+ public:
+  // num_threads == 0 selects std::thread::hardware_concurrency() (at least 1).
+  explicit ThreadPool(std::size_t num_threads = 0);
+
+  // Drains queued tasks, then joins all workers.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+
+  [[nodiscard]] std::size_t size() const noexcept { return workers_.size(); }
+
+  // submit enqueues a fire-and-forget task. Exceptions escaping task are swallowed;
+  // use parallel_for() when errors must reach the caller.
+  void submit(std::function<void()> task);
+
+  // parallel_for invokes body(begin, end) over [0, count) in chunks of at most grain
+  // items and blocks until every chunk has finished. The calling thread executes queued
+  // tasks while it waits, so nested parallel_for() calls from inside a task cannot
+  // deadlock, and sleeps once none are left. The first exception thrown by body is
+  // rethrown after all chunks finish.
+  void parallel_for(std::size_t count, std::size_t grain,
+                    const std::function<void(std::size_t, std::size_t)>& body);
+
+ private:
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void worker_loop(std::size_t index);
+  [[nodiscard]] bool try_pop(std::size_t preferred, std::function<void()>& task);
+  [[nodiscard]] bool run_one(std::size_t preferred);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> workers_;
+
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  std::atomic<std::size_t> pending_{0};  // queued, not yet popped
+  std::atomic<std::size_t> next_queue_{0};
+  bool stopping_{false};  // guarded by sleep_mutex_
+};
+
+}  // namespace ccmcp::core
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "ccmcp/embedding/embedding_cache_store.h"
+#include "ccmcp/embedding/embedding_provider.h"
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace ccmcp::embedding {
+
+// Default number of vectors held in the in-memory LRU.
+inline constexpr std::size_t kDefaultEmbeddingCacheCapacity = 4096;
+
+// CachingEmbeddingProviderStats counts where embed_text() found its vectors; misses is the
+// number of calls that reached the inner provider.
+struct CachingEmbeddingProviderStats {
+  std::size_t memory_hits{0};  // NOLINT(readability-identifier-naming)
+  std::size_t store_hits{0};   // NOLINT(readability-identifier-naming)
+  std::size_t misses{0};       // NOLINT(readability-identifier-naming)
+};
+
+// CachingEmbeddingProvider decorates an IEmbeddingProvider with a content-addressed cache.
+//
+// Vectors are keyed by (provider_id, model_id, sha256_hex(text)). A lookup consults an
+// in-memory LRU of `capacity` vectors first, then the optional persistent store; only a
+// miss in both calls the inner provider, and the result is written to both. A stored vector
+// whose dimension differs from inner.dimension() is treated as a miss and replaced, so a
+// reconfigured provider never returns stale vectors under an unchanged id.
+//
+// Providers are deterministic, so caching never changes the returned vector — only whether
+// inference runs. Index builds re-embedding unchanged text and hybrid matches re-embedding
+// the same opportunity's query text are served from the cache.
+//
+// Thread safety: embed_text() and embed_batch() may be called concurrently. The lock guards
+// only the LRU and the stats; inference and store I/O run outside it, so the store must be
+// thread-safe. embed_batch() writes its misses to the store with one put_many() call.
+class CachingEmbeddingProvider final : public IEmbeddingProvider {
+ public:
+  // inner and store (may be null) must outlive this provider.
+  CachingEmbeddingProvider(const IEmbeddingProvider& inner, std::string provider_id,
+                           std::string model_id, IEmbeddingCacheStore* store = nullptr,
+                           std::size_t capacity = kDefaultEmbeddingCacheCapacity);
+
+  [[nodiscard]] vector::Vector embed_text(std::string_view text) const override;
+
+  // Serves cached rows and sends the misses to inner.embed_batch() as one batch.
+  void embed_batch(std::span<const std::string_view> texts, std::span<float> out) const override;
+
+  [[nodiscard]] size_t dimension() const override { return inner_.dimension(); }
+
+  [[nodiscard]] CachingEmbeddingProviderStats stats() const;
+
+ private:
+  using LruList = std::list<std::pair<std::string, vector::Vector>>;  // most recent first
+
+  // Looks text_hash up in the LRU, counting a hit. Caller holds mutex_.
+  [[nodiscard]] std::optional<vector::Vector> lookup_memory_locked(
+      const std::string& text_hash) const;
+
+  // Reads key from the store, if any; a vector of the wrong dimension is a miss. Unlocked.
+  [[nodiscard]] std::optional<vector::Vector> load_stored(const EmbeddingCacheKey& key) const;
+
+  // Inserts or refreshes text_hash in the LRU, evicting the least recently used entry.
+  void remember(const std::string& text_hash, const vector::Vector& embedding) const;
+
+  const IEmbeddingProvider& inner_;
+  std::string provider_id_;
+  std::string model_id_;
+  IEmbeddingCacheStore* store_;
+  std::size_t capacity_;
+
+  mutable std::mutex mutex_;
+  mutable LruList lru_;
+  mutable std::unordered_map<std::string, LruList::iterator> lru_index_;
+  mutable CachingEmbeddingProviderStats stats_;
+};
+
+}  // namespace ccmcp::embedding
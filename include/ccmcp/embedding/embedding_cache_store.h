@@ -0,0 +1,55 @@
+#pragma once
+
+#include "ccmcp/vector/embedding_index.h"
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+
+namespace ccmcp::embedding {
+
+// EmbeddingCacheKey addresses a cached vector by content: the provider and model that
+// produced it and the SHA-256 hex digest of the embedded text.
+struct EmbeddingCacheKey {
+  std::string provider_id;  // NOLINT(readability-identifier-naming)
+  std::string model_id;     // NOLINT(readability-identifier-naming)
+  std::string text_hash;    // NOLINT(readability-identifier-naming)
+};
+
+// IEmbeddingCacheStore persists embeddings across process restarts for
+// CachingEmbeddingProvider.
+//
+// Entries are immutable in practice: the same key always maps to the same vector because
+// providers are deterministic, so put() may overwrite without changing observable state.
+//
+// Implementations must be safe to call from several threads: CachingEmbeddingProvider does
+// its store I/O outside its own lock.
+class IEmbeddingCacheStore {
+ public:
+  virtual ~IEmbeddingCacheStore() = default;
+
+  // Returns the cached vector for key, or nullopt if none is stored.
+  [[nodiscard]] virtual std::optional<vector::Vector> get(const EmbeddingCacheKey& key) const = 0;
+
+  // Stores embedding under key, replacing any previous entry.
+  virtual void put(const EmbeddingCacheKey& key, const vector::Vector& embedding) = 0;
+
+  // Stores embeddings[i] under keys[i] (the spans have equal length). The default calls
+  // put() per entry; persistent stores override it to write the batch in one transaction.
+  virtual void put_many(std::span<const EmbeddingCacheKey> keys,
+                        std::span<const vector::Vector> embeddings) {
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      put(keys[i], embeddings[i]);
+    }
+  }
+
+ protected:
+  IEmbeddingCacheStore() = default;
+  IEmbeddingCacheStore(const IEmbeddingCacheStore&) = default;
+  IEmbeddingCacheStore& operator=(const IEmbeddingCacheStore&) = default;
+  IEmbeddingCacheStore(IEmbeddingCacheStore&&) = default;
+  IEmbeddingCacheStore& operator=(IEmbeddingCacheStore&&) = default;
+};
+
+}  // namespace ccmcp::embedding
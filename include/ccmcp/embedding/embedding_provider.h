@@ -2,6 +2,7 @@
 
 #include "ccmcp/vector/embedding_index.h"
 
+#include <span>
 #include <string_view>
 
 namespace ccmcp::embedding {
@@ -17,6 +18,15 @@ class IEmbeddingProvider {
   // Determinism: for the same text, must return the same vector.
   [[nodiscard]] virtual vector::Vector embed_text(std::string_view text) const = 0;
 
+  // embed_batch writes the embedding of texts[i] to row i of out, a row-major
+  // texts.size() × dimension() buffer; each row equals embed_text(texts[i]).
+  // Throws std::invalid_argument if out.size() != texts.size() * dimension().
+  // The default embeds one text at a time and throws std::runtime_error if embed_text()
+  // returns other than dimension() floats for any text (e.g. an empty vector for a text the
+  // provider cannot embed); callers that skip such texts fall back to embed_text().
+  // Providers override it to batch inference or to write rows without allocating.
+  virtual void embed_batch(std::span<const std::string_view> texts, std::span<float> out) const;
+
   // dimension returns the embedding vector dimension.
   [[nodiscard]] virtual size_t dimension() const = 0;
 };
@@ -31,14 +41,20 @@ class NullEmbeddingProvider final : public IEmbeddingProvider {
 // DeterministicStubEmbeddingProvider generates stable vectors for testing.
 // Strategy: Hash-based vector generation from token counts and character frequencies.
 // Guarantees: Same text always produces same vector (deterministic).
+// Tokens are hashed straight into dimensions as they are scanned, so embed_batch() writes
+// rows without allocating (after a per-thread scratch buffer has grown to dimension()).
 class DeterministicStubEmbeddingProvider final : public IEmbeddingProvider {
  public:
   explicit DeterministicStubEmbeddingProvider(size_t dim = 128);
 
   [[nodiscard]] vector::Vector embed_text(std::string_view text) const override;
+  void embed_batch(std::span<const std::string_view> texts, std::span<float> out) const override;
   [[nodiscard]] size_t dimension() const override { return dimension_; }
 
  private:
+  // Writes the embedding of text to out (dimension_ floats).
+  void embed_into(std::string_view text, float* out) const;
+
   size_t dimension_;
 };
 
@@ -14,15 +14,34 @@
 
 namespace ccmcp::indexing {
 
+// Default number of embeddings written per IEmbeddingIndex::upsert_many() call.
+inline constexpr std::size_t kDefaultIndexBatchSize = 256;
+
+// Upper bound on IndexBuildConfig::jobs. Each job beyond the first is an OS thread, so the
+// CLI and the index_build MCP tool reject larger values and run_index_build clamps to it.
+inline constexpr std::size_t kMaxIndexBuildJobs = 64;
+
 // Configuration for an index build run.
 // scope controls which artifact types are indexed.
 // provider_id, model_id, and prompt_version are recorded in the run for
 // drift detection: a change in any of these values forces full re-indexing.
+// batch_size bounds how many embeddings are buffered per vector-index write (0 is treated
+// as 1); it changes write cost only, never the run's entries, events or ids.
+// jobs is the number of threads embedding each batch (0 is treated as 1, values above
+// kMaxIndexBuildJobs as kMaxIndexBuildJobs). With jobs > 1 the embedding provider is called
+// concurrently from several threads and must be thread-safe.
+// Like batch_size it never changes the run's vectors, entries, events or ids.
+// retain_runs, when > 0, prunes the index entries of all but the retain_runs most recently
+// completed runs once this run completes (0 keeps every run's entries). Drift detection reads
+// the artifact states, so pruning never forces re-indexing.
 struct IndexBuildConfig {
   std::string scope;           // "atoms" | "resumes" | "opportunities" | "all"
   std::string provider_id;     // e.g. "deterministic-stub"
   std::string model_id;        // e.g. "" for stub
   std::string prompt_version;  // e.g. "" for stub
+  std::size_t batch_size{kDefaultIndexBatchSize};
+  std::size_t jobs{1};
+  std::size_t retain_runs{0};
 };
 
 // Result of a completed index build run.
@@ -30,21 +49,27 @@ struct IndexBuildConfig {
 // skipped_count: source_hash unchanged since last completed run
 // stale_count: source_hash changed — artifact was re-indexed (subset of indexed_count)
 // run_id: the IndexRun.run_id for this build
+// pruned_count: index entries of older runs deleted under config.retain_runs
 struct IndexBuildResult {
   size_t indexed_count{0};
   size_t skipped_count{0};
   size_t stale_count{0};
   std::string run_id;
+  size_t pruned_count{0};
 };
 
 // run_index_build executes a full index build for the given scope.
 // For each in-scope artifact:
 //   1. Computes canonical text and its source_hash.
-//   2. Checks run_store for a prior source_hash (drift detection).
+//   2. Looks up its prior source_hash in the artifact states that run_store loaded once,
+//      up front, for the whole run (drift detection).
 //   3. If hash is unchanged: skips embedding computation.
-//   4. If hash changed or absent: computes embedding, upserts into vector_index,
-//      writes an IndexEntry, and emits an IndexedArtifact audit event.
+//   4. If hash changed or absent: buffers the artifact. Each full batch (and the remainder
+//      at the end) is embedded — split across config.jobs threads — and written with
+//      vector_index.upsert_many(); then an IndexEntry and an IndexedArtifact audit event
+//      are recorded per artifact, on the calling thread, in artifact order.
 //   5. NullEmbeddingProvider (empty vector) suppresses indexing without error.
+// Once the run completes, config.retain_runs > 0 prunes older runs' entries.
 // Emits IndexRunStarted, IndexedArtifact, and IndexRunCompleted audit events
 // using the run_id as trace_id.
 IndexBuildResult run_index_build(storage::IAtomRepository& atoms, ingest::IResumeStore& resumes,
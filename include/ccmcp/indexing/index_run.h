@@ -2,6 +2,8 @@
 
 #include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 namespace ccmcp::indexing {
 
@@ -39,6 +41,30 @@ struct IndexEntry {
   std::optional<std::string> indexed_at;
 };
 
+// ArtifactIndexState is the latest completed indexing of one artifact under one
+// (provider_id, model_id, prompt_version) — a row of the artifact_index_state table
+// (schema v10). run_id is the completed run that produced it.
+struct ArtifactIndexState {
+  std::string artifact_type;
+  std::string artifact_id;
+  std::string source_hash;
+  std::string vector_hash;
+  std::string run_id;
+};
+
+// ArtifactStateMap holds prefetched states keyed by artifact_state_key().
+using ArtifactStateMap = std::unordered_map<std::string, ArtifactIndexState>;
+
+// artifact_state_key joins artifact_type and artifact_id into one map key. Artifact types
+// never contain ':', so keys are unique.
+inline std::string artifact_state_key(std::string_view artifact_type,
+                                      std::string_view artifact_id) {
+  std::string key;
+  key.reserve(artifact_type.size() + 1 + artifact_id.size());
+  key.append(artifact_type).append(1, ':').append(artifact_id);
+  return key;
+}
+
 // Status string conversion helpers.
 // index_run_status_from_string throws std::invalid_argument for unknown values.
 std::string index_run_status_to_string(IndexRunStatus s);
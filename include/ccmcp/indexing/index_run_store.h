@@ -2,6 +2,7 @@
 
 #include "ccmcp/indexing/index_run.h"
 
+#include <cstddef>
 #include <optional>
 #include <string>
 #include <vector>
@@ -15,6 +16,11 @@ namespace ccmcp::indexing {
 // recent completed run for a given (artifact_id, artifact_type, provider_id,
 // model_id, prompt_version) combination, enabling the pipeline to determine
 // whether an artifact's canonical text has changed since it was last indexed.
+// load_artifact_states() returns the same information for every artifact at once, so a
+// build needs one lookup per run rather than one per artifact.
+//
+// Retention: entries are only needed for provenance once their state is recorded;
+// prune_entries() drops those of older completed runs without affecting drift detection.
 class IIndexRunStore {
  public:
   virtual ~IIndexRunStore() = default;
@@ -42,6 +48,18 @@ class IIndexRunStore {
       const std::string& provider_id, const std::string& model_id,
       const std::string& prompt_version) const = 0;
 
+  // Returns the latest completed state of every artifact whose type is in artifact_types
+  // (all types if empty) for the given provider_id / model_id / prompt_version, keyed by
+  // artifact_state_key().
+  [[nodiscard]] virtual ArtifactStateMap load_artifact_states(
+      const std::vector<std::string>& artifact_types, const std::string& provider_id,
+      const std::string& model_id, const std::string& prompt_version) const = 0;
+
+  // Deletes the entries of every completed run except the keep_runs most recently
+  // completed ones. Entries of runs that have not completed are kept. Returns the number of
+  // entries deleted.
+  virtual std::size_t prune_entries(std::size_t keep_runs) = 0;
+
   // Atomically allocate the next run_id from the persistent monotonic counter.
   // Returns "run-N" where N is a 1-based integer that increments with each call.
   // The counter is backed by the id_counters table (schema v6) and survives
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "ccmcp/storage/repositories.h"
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace ccmcp::ingest {
+
+/// Records per upsert_many call when options do not say otherwise
+inline constexpr std::size_t kDefaultBulkImportBatchSize = 1000;
+
+/// Options for bulk JSONL import
+struct BulkImportOptions {
+  std::size_t batch_size{kDefaultBulkImportBatchSize};  // Records per upsert_many call (min 1)
+  std::size_t max_errors{100};  // Messages kept in BulkImportResult::errors (all are counted)
+};
+
+/// Outcome of a bulk JSONL import
+struct BulkImportResult {
+  std::size_t lines_read{0};              // Including blank lines
+  std::size_t atoms_imported{0};          // Atoms written through IAtomRepository::upsert_many
+  std::size_t opportunities_imported{0};  // Opportunities written likewise
+  std::size_t error_count{0};             // Records rejected or lost to a failed batch write
+  std::vector<std::string> errors;        // "line N: message", the first max_errors of them
+};
+
+/// Import atoms and opportunities from a JSONL stream into the repositories.
+///
+/// Each non-blank line is one JSON object with a "kind" of "atom" or "opportunity":
+///   {"kind":"atom","atom_id":"...","domain":"...","title":"...","claim":"...",
+///    "tags":[...],"verified":true,"evidence_refs":[...]}
+///   {"kind":"opportunity","opportunity_id":"...","company":"...","role_title":"...",
+///    "source":"...","requirements":[{"text":"...","tags":[...],"required":true}]}
+/// Ids and the fields that validate() requires must be present; the rest default to empty.
+///
+/// The stream is read one line at a time, so memory use is bounded by batch_size records
+/// rather than by the input size. Records are normalized (normalize_atom /
+/// normalize_opportunity) and validated; invalid lines are reported and skipped, and the
+/// import continues. Valid records are written batch_size at a time via upsert_many, so each
+/// batch is one transaction on SQLite. A later record with the same id replaces an earlier one.
+[[nodiscard]] BulkImportResult import_jsonl(std::istream& input, storage::IAtomRepository& atoms,
+                                            storage::IOpportunityRepository& opportunities,
+                                            const BulkImportOptions& options = {});
+
+}  // namespace ccmcp::ingest
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "ccmcp/domain/experience_atom.h"
+#include "ccmcp/matching/token_dictionary.h"
+#include "ccmcp/storage/repositories.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace ccmcp::matching {
+
+// CorpusSnapshot is an immutable, pre-tokenized view of an atom corpus.
+//
+// Every atom's token set (claim ∪ title ∪ tags, interned in the global TokenDictionary)
+// is computed once at construction and stored in a single contiguous arena; tokens(i)
+// returns a slice of that arena. An inverted index (token → verified atoms) lets candidate
+// retrieval touch only atoms that share a query token. A snapshot never changes after
+// construction, so one instance can be shared (via shared_ptr<const CorpusSnapshot>) by any
+// number of concurrent Matcher::evaluate() calls.
+//
+// Two construction modes:
+// - Owning: takes the atom vector by value (e.g. IAtomRepository::list_verified()) and
+//   records the repository corpus_version() it was built from.
+// - Borrowing: tokenizes caller-owned atoms without copying them. The atoms must outlive
+//   the snapshot. Used by the legacy Matcher::evaluate(opportunity, atoms) overload.
+class CorpusSnapshot {
+ public:
+  CorpusSnapshot(std::vector<domain::ExperienceAtom> atoms, std::uint64_t version);
+  explicit CorpusSnapshot(const std::vector<domain::ExperienceAtom>& atoms);
+  explicit CorpusSnapshot(std::vector<domain::ExperienceAtom>&& atoms) = delete;  // would dangle
+
+  ~CorpusSnapshot() = default;
+
+  CorpusSnapshot(const CorpusSnapshot&) = delete;
+  CorpusSnapshot& operator=(const CorpusSnapshot&) = delete;
+  CorpusSnapshot(CorpusSnapshot&&) = delete;
+  CorpusSnapshot& operator=(CorpusSnapshot&&) = delete;
+
+  // version is the IAtomRepository::corpus_version() this snapshot was built from
+  // (0 for borrowing snapshots).
+  [[nodiscard]] std::uint64_t version() const noexcept { return version_; }
+
+  [[nodiscard]] std::size_t size() const noexcept { return atoms_->size(); }
+  [[nodiscard]] const std::vector<domain::ExperienceAtom>& atoms() const noexcept {
+    return *atoms_;
+  }
+  [[nodiscard]] const domain::ExperienceAtom& atom(std::size_t index) const {
+    return (*atoms_)[index];
+  }
+
+  // tokens returns the sorted interned token set of atom(index).
+  [[nodiscard]] TokenIdSpan tokens(std::size_t index) const {
+    return TokenIdSpan(token_arena_).subspan(token_offsets_[index],
+                                             token_offsets_[index + 1] - token_offsets_[index]);
+  }
+
+  // postings returns the indices (ascending) of VERIFIED atoms whose token set contains
+  // token. Tokens interned after the snapshot was built have empty postings.
+  [[nodiscard]] std::span<const std::uint32_t> postings(TokenId token) const {
+    if (static_cast<std::size_t>(token) + 1 >= posting_offsets_.size()) {
+      return {};
+    }
+    return std::span<const std::uint32_t>(posting_atoms_)
+        .subspan(posting_offsets_[token], posting_offsets_[token + 1] - posting_offsets_[token]);
+  }
+
+  // verified_by_id returns the indices of verified atoms ordered by atom_id ascending.
+  [[nodiscard]] std::span<const std::uint32_t> verified_by_id() const noexcept {
+    return verified_by_id_;
+  }
+
+  // id_rank returns the position of atom(index) in atom_id order, so callers can apply the
+  // deterministic atom_id tie-break with an integer compare.
+  [[nodiscard]] std::uint32_t id_rank(std::size_t index) const { return id_rank_[index]; }
+
+ private:
+  void build_token_arena();
+  void build_postings();
+
+  std::uint64_t version_{0};
+  std::vector<domain::ExperienceAtom> owned_atoms_;   // empty for borrowing snapshots
+  const std::vector<domain::ExperienceAtom>* atoms_;  // owned_atoms_ or the borrowed vector
+  std::vector<TokenId> token_arena_;                  // all token sets, back to back
+  std::vector<std::size_t> token_offsets_;            // size() + 1 entries into token_arena_
+
+  // Inverted index (CSR layout): posting_atoms_[posting_offsets_[t] .. posting_offsets_[t+1]]
+  // lists the verified atoms containing token t. Indexed directly by TokenId.
+  std::vector<std::uint32_t> posting_atoms_;
+  std::vector<std::size_t> posting_offsets_;
+  std::vector<std::uint32_t> verified_by_id_;
+  std::vector<std::uint32_t> id_rank_;
+};
+
+// CorpusSnapshotCache hands out the current CorpusSnapshot of an atom repository,
+// rebuilding it only when IAtomRepository::corpus_version() changes.
+//
+// Readers receive a shared_ptr and keep using their snapshot even if a newer one is
+// published concurrently; the old snapshot is released when its last reader finishes.
+// At most one rebuild runs at a time. Thread-safe.
+class CorpusSnapshotCache {
+ public:
+  CorpusSnapshotCache() = default;
+  ~CorpusSnapshotCache() = default;
+
+  CorpusSnapshotCache(const CorpusSnapshotCache&) = delete;
+  CorpusSnapshotCache& operator=(const CorpusSnapshotCache&) = delete;
+  CorpusSnapshotCache(CorpusSnapshotCache&&) = delete;
+  CorpusSnapshotCache& operator=(CorpusSnapshotCache&&) = delete;
+
+  // get returns a snapshot of atoms.list_verified() at atoms.corpus_version().
+  [[nodiscard]] std::shared_ptr<const CorpusSnapshot> get(const storage::IAtomRepository& atoms);
+
+ private:
+  std::mutex mutex_;        // guards current_
+  std::mutex build_mutex_;  // serializes rebuilds
+  std::shared_ptr<const CorpusSnapshot> current_;
+};
+
+}  // namespace ccmcp::matching
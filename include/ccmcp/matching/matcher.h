@@ -1,12 +1,16 @@
 #pragma once
 
+#include "ccmcp/core/thread_pool.h"
 #include "ccmcp/domain/experience_atom.h"
 #include "ccmcp/domain/match_report.h"
 #include "ccmcp/domain/opportunity.h"
 #include "ccmcp/embedding/embedding_provider.h"
 #include "ccmcp/matching/scorer.h"
+#include "ccmcp/matching/corpus_snapshot.h"
+#include "ccmcp/matching/token_dictionary.h"
 #include "ccmcp/vector/embedding_index.h"
 
+#include <span>
 #include <vector>
 
 namespace ccmcp::matching {
@@ -17,6 +21,10 @@ enum class MatchingStrategy {
   kHybridLexicalEmbeddingV02,  // v0.2: Lexical + embedding recall expansion
 };
 
+// RequirementTokens points at one QueryTokenIds per requirement, in requirement order.
+// The pointed-to sets are owned by the caller.
+using RequirementTokens = std::vector<const QueryTokenIds*>;
+
 // HybridConfig controls hybrid retrieval parameters.
 struct HybridConfig {
   size_t k_lexical{25};    // Top K candidates from lexical pre-scoring
@@ -26,11 +34,15 @@ struct HybridConfig {
 // Matcher is a class (not struct) per C++ Core Guidelines C.2:
 // It encapsulates matching logic with private configuration (weights_).
 // The invariant is that weights must remain constant after construction for determinism.
+//
+// Parallel mode (opt-in): pass a ThreadPool to fan requirement × candidate scoring across
+// its workers. Reports are bit-identical to the serial path (pool == nullptr). The pool is
+// not owned and must outlive the Matcher.
 class Matcher {
  public:
   explicit Matcher(ScoreWeights weights = ScoreWeights{},
                    MatchingStrategy strategy = MatchingStrategy::kDeterministicLexicalV01,
-                   HybridConfig hybrid_config = HybridConfig{});
+                   HybridConfig hybrid_config = HybridConfig{}, core::ThreadPool* pool = nullptr);
 
   // Con.2: evaluate() is const - matching is deterministic and doesn't modify matcher state.
   // This enables thread-safe, concurrent evaluations with a single Matcher instance.
@@ -43,14 +55,41 @@ class Matcher {
       const embedding::IEmbeddingProvider* embedding_provider = nullptr,
       const vector::IEmbeddingIndex* vector_index = nullptr) const;
 
+  // Same as above, but scores a pre-tokenized CorpusSnapshot. Results are identical to
+  // evaluate(opportunity, corpus.atoms(), ...); only the per-call tokenization is skipped.
+  [[nodiscard]] domain::MatchReport evaluate(
+      const domain::Opportunity& opportunity, const CorpusSnapshot& corpus,
+      const embedding::IEmbeddingProvider* embedding_provider = nullptr,
+      const vector::IEmbeddingIndex* vector_index = nullptr) const;
+
+  // evaluate_batch scores many opportunities against one corpus in a single pass.
+  // Returns one report per opportunity (same order), each identical to evaluate().
+  //
+  // The corpus is tokenized once and requirement texts are deduplicated across the batch.
+  // In v0.1 mode every distinct requirement text is scored exactly once; in hybrid mode
+  // retrieval runs per opportunity on the calling thread and scoring is spread across the
+  // thread pool (when one was supplied).
+  [[nodiscard]] std::vector<domain::MatchReport> evaluate_batch(
+      std::span<const domain::Opportunity> opportunities,
+      const std::vector<domain::ExperienceAtom>& atoms,
+      const embedding::IEmbeddingProvider* embedding_provider = nullptr,
+      const vector::IEmbeddingIndex* vector_index = nullptr) const;
+
+  [[nodiscard]] std::vector<domain::MatchReport> evaluate_batch(
+      std::span<const domain::Opportunity> opportunities, const CorpusSnapshot& corpus,
+      const embedding::IEmbeddingProvider* embedding_provider = nullptr,
+      const vector::IEmbeddingIndex* vector_index = nullptr) const;
+
  private:
   ScoreWeights weights_;
   MatchingStrategy strategy_;
   HybridConfig hybrid_config_;
+  core::ThreadPool* pool_;  // nullptr = serial scoring
 
-  // Helper: Select candidate atoms for scoring
-  [[nodiscard]] std::vector<const domain::ExperienceAtom*> select_candidates(
-      const domain::Opportunity& opportunity, const std::vector<domain::ExperienceAtom>& atoms,
+  // Helper: Select candidate atoms for scoring (returns indices into corpus.atoms())
+  [[nodiscard]] std::vector<size_t> select_candidates(
+      const domain::Opportunity& opportunity, const RequirementTokens& req_tokens,
+      const CorpusSnapshot& corpus,
       const embedding::IEmbeddingProvider* embedding_provider,
       const vector::IEmbeddingIndex* vector_index, domain::RetrievalStats& stats) const;
 };
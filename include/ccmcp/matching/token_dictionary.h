@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ccmcp::matching {
+
+// TokenId is a dense integer handle for a normalized token.
+using TokenId = std::uint32_t;
+
+// TokenIdSet is a sorted (ascending by id), deduplicated set of token ids.
+// Id order is interning order, NOT lexicographic order: only counts and membership are
+// meaningful. Use to_sorted_strings() to recover the lexicographic token list.
+using TokenIdSet = std::vector<TokenId>;
+
+// TokenIdSpan is a read-only view of a TokenIdSet (e.g. a slice of a CorpusSnapshot arena).
+using TokenIdSpan = std::span<const TokenId>;
+
+// TokenDictionary maps normalized tokens to dense TokenIds.
+//
+// Ids are assigned in first-seen order and never change or get reused for the lifetime of
+// the dictionary, so a TokenIdSet stays valid across requests. Only corpus text (atoms, via
+// CorpusSnapshot) is interned; requirement text is looked up with lookup_token_ids(). Matching output never
+// exposes ids directly; evidence tokens are converted back to strings (and sorted
+// lexicographically) before they reach a MatchReport.
+//
+// Thread safety: all member functions are safe to call concurrently. Lookups take a
+// shared lock; interning a previously unseen token takes an exclusive lock.
+class TokenDictionary {
+ public:
+  TokenDictionary() = default;
+  ~TokenDictionary() = default;
+
+  TokenDictionary(const TokenDictionary&) = delete;
+  TokenDictionary& operator=(const TokenDictionary&) = delete;
+  TokenDictionary(TokenDictionary&&) = delete;
+  TokenDictionary& operator=(TokenDictionary&&) = delete;
+
+  // global returns the process-wide dictionary shared by all Matcher instances.
+  [[nodiscard]] static TokenDictionary& global();
+
+  // intern returns the id for token, assigning the next free id if it is new.
+  [[nodiscard]] TokenId intern(std::string_view token);
+
+  // find returns the id for token without interning it.
+  [[nodiscard]] std::optional<TokenId> find(std::string_view token) const;
+
+  // token returns the string for an id previously returned by intern().
+  // The returned reference stays valid for the lifetime of the dictionary.
+  [[nodiscard]] const std::string& token(TokenId id) const;
+
+  [[nodiscard]] std::size_t size() const;
+
+ private:
+  mutable std::shared_mutex mutex_;
+  std::deque<std::string> tokens_;  // deque: element references survive push_back
+  std::unordered_map<std::string_view, TokenId> ids_;  // views into tokens_
+};
+
+// QueryTokenIds is a query text's distinct tokens split by whether the dictionary holds
+// them: known as a TokenIdSet, the rest only counted. A token the dictionary has never seen
+// cannot overlap any corpus token set, so its id is never needed.
+struct QueryTokenIds {
+  TokenIdSet known;        // ids of the tokens the dictionary holds
+  std::size_t unknown{0};  // distinct tokens it does not hold
+
+  // Number of distinct tokens in the text (the overlap-score denominator).
+  [[nodiscard]] std::size_t size() const noexcept { return known.size() + unknown; }
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+};
+
+// tokenize_to_ids tokenizes text with core::tokenize_ascii and interns every token.
+// Returns a sorted, deduplicated TokenIdSet. Use for corpus text only: interned tokens are
+// never evicted.
+[[nodiscard]] TokenIdSet tokenize_to_ids(std::string_view text, TokenDictionary& dictionary);
+
+// lookup_token_ids tokenizes query text like tokenize_to_ids but only looks tokens up, so
+// untrusted query text never grows the dictionary.
+[[nodiscard]] QueryTokenIds lookup_token_ids(std::string_view text,
+                                             const TokenDictionary& dictionary);
+
+// intern_tokens interns pre-normalized tokens (e.g. atom tags) verbatim.
+// Returns a sorted, deduplicated TokenIdSet.
+[[nodiscard]] TokenIdSet intern_tokens(const std::vector<std::string>& tokens,
+                                       TokenDictionary& dictionary);
+
+// merge_token_sets returns the union of two TokenIdSets.
+[[nodiscard]] TokenIdSet merge_token_sets(TokenIdSpan a, TokenIdSpan b);
+
+// intersection_size returns |a ∩ b| without materializing the intersection.
+[[nodiscard]] std::size_t intersection_size(TokenIdSpan a, TokenIdSpan b);
+
+// intersect returns a ∩ b as a TokenIdSet.
+[[nodiscard]] TokenIdSet intersect(TokenIdSpan a, TokenIdSpan b);
+
+// to_sorted_strings converts ids back to tokens, sorted lexicographically.
+// This is the representation used for MatchReport evidence tokens.
+[[nodiscard]] std::vector<std::string> to_sorted_strings(TokenIdSpan ids,
+                                                         const TokenDictionary& dictionary);
+
+}  // namespace ccmcp::matching
@@ -12,12 +12,15 @@ namespace ccmcp::storage {
 class InMemoryAtomRepository final : public IAtomRepository {
  public:
   void upsert(const domain::ExperienceAtom& atom) override;
+  std::size_t upsert_many(const std::vector<domain::ExperienceAtom>& atoms) override;
   [[nodiscard]] std::optional<domain::ExperienceAtom> get(const core::AtomId& id) const override;
   [[nodiscard]] std::vector<domain::ExperienceAtom> list_verified() const override;
   [[nodiscard]] std::vector<domain::ExperienceAtom> list_all() const override;
+  [[nodiscard]] std::uint64_t corpus_version() const override { return version_; }
 
  private:
   std::map<core::AtomId, domain::ExperienceAtom> atoms_;
+  std::uint64_t version_{0};  // bumped on every upsert / upsert_many
 };
 
 }  // namespace ccmcp::storage
@@ -12,8 +12,11 @@ namespace ccmcp::storage {
 class InMemoryOpportunityRepository final : public IOpportunityRepository {
  public:
   void upsert(const domain::Opportunity& opportunity) override;
+  std::size_t upsert_many(const std::vector<domain::Opportunity>& opportunities) override;
   [[nodiscard]] std::optional<domain::Opportunity> get(
       const core::OpportunityId& id) const override;
+  [[nodiscard]] std::vector<std::optional<domain::Opportunity>> get_many(
+      const std::vector<core::OpportunityId>& ids) const override;
   [[nodiscard]] std::vector<domain::Opportunity> list_all() const override;
 
  private:
@@ -4,6 +4,8 @@
 #include "ccmcp/domain/interaction.h"
 #include "ccmcp/domain/opportunity.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <vector>
 
@@ -14,17 +16,31 @@ class IAtomRepository {
  public:
   virtual ~IAtomRepository() = default;
   virtual void upsert(const domain::ExperienceAtom& atom) = 0;
+  // Upsert every atom as one write (later duplicates of an atom_id win). Returns the number
+  // of atoms written: atoms.size() on success, 0 if the write failed and nothing was stored.
+  virtual std::size_t upsert_many(const std::vector<domain::ExperienceAtom>& atoms) = 0;
   [[nodiscard]] virtual std::optional<domain::ExperienceAtom> get(const core::AtomId& id) const = 0;
   [[nodiscard]] virtual std::vector<domain::ExperienceAtom> list_verified() const = 0;
   [[nodiscard]] virtual std::vector<domain::ExperienceAtom> list_all() const = 0;
+
+  // corpus_version changes whenever the stored atom set may have changed (e.g. after any
+  // upsert). Equal values guarantee list_verified() returns the same atoms, which lets
+  // callers cache derived data such as matching::CorpusSnapshot.
+  [[nodiscard]] virtual std::uint64_t corpus_version() const = 0;
 };
 
 class IOpportunityRepository {
  public:
   virtual ~IOpportunityRepository() = default;
   virtual void upsert(const domain::Opportunity& opportunity) = 0;
+  // Upsert every opportunity (with its requirements) as one write; same contract as
+  // IAtomRepository::upsert_many.
+  virtual std::size_t upsert_many(const std::vector<domain::Opportunity>& opportunities) = 0;
   [[nodiscard]] virtual std::optional<domain::Opportunity> get(
       const core::OpportunityId& id) const = 0;
+  // Look up many ids at once. result[i] is get(ids[i]); missing ids yield nullopt.
+  [[nodiscard]] virtual std::vector<std::optional<domain::Opportunity>> get_many(
+      const std::vector<core::OpportunityId>& ids) const = 0;
   [[nodiscard]] virtual std::vector<domain::Opportunity> list_all() const = 0;
 };
 
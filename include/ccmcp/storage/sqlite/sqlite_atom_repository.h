@@ -5,8 +5,11 @@
 #endif
 
 #include "ccmcp/storage/repositories.h"
-#include "ccmcp/storage/sqlite/sqlite_db.h"
+#include "ccmcp/storage/sqlite/sqlite_connection_pool.h"
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 
 namespace ccmcp::storage::sqlite {
@@ -16,15 +19,25 @@ namespace ccmcp::storage::sqlite {
 // Guarantees deterministic ordering (ORDER BY atom_id).
 class SqliteAtomRepository final : public IAtomRepository {
  public:
+  // Reads and writes share db's single connection.
   explicit SqliteAtomRepository(std::shared_ptr<SqliteDb> db);
+  // Reads go to pool's reader connections, writes to its writer.
+  explicit SqliteAtomRepository(std::shared_ptr<SqliteConnectionPool> pool);
 
   void upsert(const domain::ExperienceAtom& atom) override;
+  // All atoms in one BEGIN IMMEDIATE transaction, rolled back entirely on any failure.
+  std::size_t upsert_many(const std::vector<domain::ExperienceAtom>& atoms) override;
   [[nodiscard]] std::optional<domain::ExperienceAtom> get(const core::AtomId& id) const override;
   [[nodiscard]] std::vector<domain::ExperienceAtom> list_verified() const override;
   [[nodiscard]] std::vector<domain::ExperienceAtom> list_all() const override;
 
+  // Combines a local write counter (bumped by successful upserts through this repository)
+  // with PRAGMA data_version (which changes when any OTHER connection commits).
+  [[nodiscard]] std::uint64_t corpus_version() const override;
+
  private:
-  std::shared_ptr<SqliteDb> db_;
+  std::shared_ptr<SqliteConnectionPool> pool_;
+  std::atomic<std::uint64_t> local_writes_{0};
 
   // Helper to deserialize atom from prepared statement row
   [[nodiscard]] domain::ExperienceAtom row_to_atom(sqlite3_stmt* stmt) const;
@@ -5,7 +5,7 @@
 #endif
 
 #include "ccmcp/storage/audit_log.h"
-#include "ccmcp/storage/sqlite/sqlite_db.h"
+#include "ccmcp/storage/sqlite/sqlite_connection_pool.h"
 
 #include <map>
 #include <memory>
@@ -19,14 +19,17 @@ namespace ccmcp::storage::sqlite {
 // Thread-safe append operations using mutex for idx counter and hash state.
 class SqliteAuditLog final : public IAuditLog {
  public:
+  // Reads and writes share db's single connection.
   explicit SqliteAuditLog(std::shared_ptr<SqliteDb> db);
+  // Reads go to pool's reader connections, writes to its writer.
+  explicit SqliteAuditLog(std::shared_ptr<SqliteConnectionPool> pool);
 
   void append(const AuditEvent& event) override;
   [[nodiscard]] std::vector<AuditEvent> query(const std::string& trace_id) const override;
   [[nodiscard]] std::vector<std::string> list_trace_ids() const override;
 
  private:
-  std::shared_ptr<SqliteDb> db_;
+  std::shared_ptr<SqliteConnectionPool> pool_;
 
   // Per-trace append state: next index and last event_hash.
   // Both are fetched atomically under mutex_ to ensure chain consistency.
@@ -39,7 +42,8 @@ class SqliteAuditLog final : public IAuditLog {
     std::string previous_hash{};
   };
 
-  AppendState get_append_state(const std::string& trace_id);
+  // Reads through db, which must be the writer connection leased by append().
+  AppendState get_append_state(const SqliteDb& db, const std::string& trace_id);
 };
 
 }  // namespace ccmcp::storage::sqlite
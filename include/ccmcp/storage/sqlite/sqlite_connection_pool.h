@@ -0,0 +1,129 @@
+#pragma once
+
+#ifdef CCMCP_TRANSPORT_BOUNDARY_GUARD
+#error "Concrete storage/redis header included in a guarded translation unit — use interfaces only."
+#endif
+
+#include "ccmcp/core/result.h"
+#include "ccmcp/storage/sqlite/sqlite_db.h"
+#include "ccmcp/storage/sqlite_tuning.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace ccmcp::storage::sqlite {
+
+class ConnectionLease;
+
+// SqliteConnectionPool hands out connections to one database file per operation:
+// one writer connection and N read-only reader connections.
+//
+// - write() leases the writer exclusively. Writes (and reads that must see the caller's own
+//   uncommitted changes, e.g. inside a transaction) go through it, so at most one thread
+//   writes at a time. The lock is recursive: a thread holding a write lease may take another.
+// - read() leases an idle reader, waiting for one if all are busy. Readers are opened with
+//   PRAGMA query_only and, in WAL mode, read the last committed snapshot without blocking or
+//   being blocked by the writer.
+//
+// A pool built from a single SqliteDb has no readers: read() then leases the writer, so all
+// operations are serialized on that connection.
+//
+// Each connection keeps its own statement cache. Leases must not outlive the pool, and a
+// thread must not wait for a second read lease while holding one (the pool may be exhausted).
+class SqliteConnectionPool {
+ public:
+  // Open the writer and reader_count readers on path with tuning (see SqliteDb::open).
+  // Readers require a tuning with journal_mode=wal (so that they run alongside the writer)
+  // and a file database.
+  [[nodiscard]] static core::Result<std::shared_ptr<SqliteConnectionPool>, std::string> open(
+      const std::string& path, std::size_t reader_count,
+      const std::optional<SqliteTuning>& tuning = std::nullopt);
+
+  // A pool of one connection: writer serves both reads and writes.
+  explicit SqliteConnectionPool(std::shared_ptr<SqliteDb> writer);
+
+  ~SqliteConnectionPool() = default;
+
+  SqliteConnectionPool(const SqliteConnectionPool&) = delete;
+  SqliteConnectionPool& operator=(const SqliteConnectionPool&) = delete;
+  SqliteConnectionPool(SqliteConnectionPool&&) = delete;
+  SqliteConnectionPool& operator=(SqliteConnectionPool&&) = delete;
+
+  // Lease a reader connection (the writer if the pool has no readers).
+  [[nodiscard]] ConnectionLease read() const;
+
+  // Lease the writer connection exclusively.
+  [[nodiscard]] ConnectionLease write() const;
+
+  // The writer connection, for schema migrations and callers that manage their own locking.
+  [[nodiscard]] const std::shared_ptr<SqliteDb>& writer() const { return writer_; }
+
+  [[nodiscard]] std::size_t reader_count() const { return readers_.size(); }
+
+  // PRAGMA data_version of the writer connection: it changes when any OTHER connection
+  // commits, but not on the writer's own commits. Read through a statement of its own under
+  // SQLite's connection mutex, so it does not wait for a write lease held across a long
+  // transaction. Takes a write lease only if SQLite is not in serialized threading mode.
+  // Returns 0 if the pragma fails.
+  [[nodiscard]] std::uint64_t writer_data_version() const;
+
+  // Number of readers not currently leased.
+  [[nodiscard]] std::size_t idle_reader_count() const;
+
+ private:
+  friend class ConnectionLease;
+
+  SqliteConnectionPool(std::shared_ptr<SqliteDb> writer,
+                       std::vector<std::shared_ptr<SqliteDb>> readers);
+
+  void release(const ConnectionLease& lease) const;
+
+  std::shared_ptr<SqliteDb> writer_;
+  std::vector<std::shared_ptr<SqliteDb>> readers_;
+  // PRAGMA data_version on the writer; nullptr unless the connection is serialized.
+  // Declared after writer_: finalized before the connection can close.
+  std::unique_ptr<PreparedStatement> data_version_stmt_;
+  mutable std::mutex data_version_mutex_;
+  mutable std::recursive_mutex writer_mutex_;
+  mutable std::mutex readers_mutex_;
+  mutable std::condition_variable reader_released_;
+  mutable std::vector<std::size_t> idle_readers_;  // indices into readers_
+};
+
+// ConnectionLease is an RAII handle on one connection of a SqliteConnectionPool.
+// It is used like a SqliteDb pointer; on destruction the connection returns to the pool.
+// Statement leases taken from it must end first (declare them after the connection lease).
+class ConnectionLease {
+ public:
+  ~ConnectionLease();
+
+  ConnectionLease(const ConnectionLease&) = delete;
+  ConnectionLease& operator=(const ConnectionLease&) = delete;
+  ConnectionLease(ConnectionLease&&) = delete;
+  ConnectionLease& operator=(ConnectionLease&&) = delete;
+
+  [[nodiscard]] SqliteDb& operator*() const { return *db_; }
+  [[nodiscard]] SqliteDb* operator->() const { return db_; }
+
+  // True if this lease holds the writer connection.
+  [[nodiscard]] bool is_writer() const { return reader_index_ == kWriter; }
+
+ private:
+  friend class SqliteConnectionPool;
+
+  static constexpr std::size_t kWriter = static_cast<std::size_t>(-1);
+
+  ConnectionLease(const SqliteConnectionPool& pool, SqliteDb* db, std::size_t reader_index);
+
+  const SqliteConnectionPool& pool_;
+  SqliteDb* db_;
+  std::size_t reader_index_;  // kWriter: db_ is the writer and the writer lock is held
+};
+
+}  // namespace ccmcp::storage::sqlite
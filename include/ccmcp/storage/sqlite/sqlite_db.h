@@ -5,9 +5,13 @@
 #endif
 
 #include "ccmcp/core/result.h"
+#include "ccmcp/storage/sqlite_tuning.h"
 
+#include <cstddef>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 
 // Forward declare sqlite3 to avoid exposing SQLite header in public API
 struct sqlite3;
@@ -15,12 +19,18 @@ struct sqlite3_stmt;
 
 namespace ccmcp::storage::sqlite {
 
+class StatementLease;
+struct CachedStatementSlot;
+
+// Default number of distinct SQL texts kept by SqliteDb's statement cache.
+inline constexpr std::size_t kDefaultStatementCacheCapacity = 256;
+
 // SqliteDb manages a SQLite database connection and schema versioning.
 // Responsibilities:
 // - Open/close database connection
 // - Initialize schema (migrations)
-// - Provide prepared statement helpers
-// - Enable foreign keys
+// - Provide prepared statement helpers, including a statement cache (prepare())
+// - Enable foreign keys and apply the SqliteTuning performance profile
 //
 // Design principles:
 // - RAII: connection managed via unique_ptr with custom deleter
@@ -28,12 +38,14 @@ namespace ccmcp::storage::sqlite {
 // - Thread-safe: one connection per instance (no sharing)
 class SqliteDb {
  public:
-  // Open or create database at path.
+  // Open or create database at path and apply tuning. Without tuning no PRAGMA beyond
+  // foreign_keys is issued: the connection keeps SQLite's defaults (synchronous=full) and the
+  // file keeps its journal mode (rollback journal for a new file).
   // If path is ":memory:", creates in-memory database.
   [[nodiscard]] static core::Result<std::shared_ptr<SqliteDb>, std::string> open(
-      const std::string& path);
+      const std::string& path, const std::optional<SqliteTuning>& tuning = std::nullopt);
 
-  ~SqliteDb() = default;
+  ~SqliteDb();
 
   // Disable copy/move (unique ownership)
   SqliteDb(const SqliteDb&) = delete;
@@ -68,9 +80,31 @@ class SqliteDb {
   // Apply schema v8 if not already applied (adds previous_hash + event_hash to audit_events)
   [[nodiscard]] core::Result<bool, std::string> ensure_schema_v8();
 
+  // Apply schema v9 if not already applied (adds embedding_cache table)
+  [[nodiscard]] core::Result<bool, std::string> ensure_schema_v9();
+
+  // Apply schema v10 if not already applied (adds artifact_index_state table)
+  [[nodiscard]] core::Result<bool, std::string> ensure_schema_v10();
+
   // Execute SQL statement (for non-query operations)
   [[nodiscard]] core::Result<bool, std::string> exec(const std::string& sql);
 
+  // Lease a prepared statement for sql from the statement cache.
+  // The statement is prepared on first use of a given SQL text and reused afterwards; the
+  // lease resets it and clears its bindings when it goes out of scope. Leasing the same SQL
+  // again while a lease is outstanding yields a second statement, so nested use is safe.
+  // Check is_valid() on the lease; error() holds the prepare error otherwise.
+  // Leases must not outlive this SqliteDb.
+  [[nodiscard]] StatementLease prepare(std::string_view sql) const;
+
+  // Number of prepared statements currently idle in the statement cache.
+  [[nodiscard]] std::size_t cached_statement_count() const;
+
+  // Bound the number of distinct SQL texts the statement cache keeps (default
+  // kDefaultStatementCacheCapacity). Statements for texts beyond the bound are finalized when
+  // their lease ends; 0 disables caching, so every prepare() parses the SQL afresh.
+  void set_statement_cache_capacity(std::size_t capacity);
+
   // Get raw connection (for prepared statements)
   // Should be used only by repository implementations
   [[nodiscard]] sqlite3* connection() const { return db_.get(); }
@@ -80,9 +114,50 @@ class SqliteDb {
     void operator()(sqlite3* db) const;
   };
 
+  friend class StatementLease;
+  struct StatementCache;
+
   explicit SqliteDb(sqlite3* db);
 
   std::unique_ptr<sqlite3, SqliteDeleter> db_;
+  // Declared after db_: cached statements are finalized before the connection closes.
+  std::unique_ptr<StatementCache> statements_;
+};
+
+// StatementLease is an RAII handle on a statement from SqliteDb's statement cache.
+// It is used like PreparedStatement; on destruction the statement is reset, its bindings
+// are cleared, and it is returned to the cache for the next caller with the same SQL.
+class StatementLease {
+ public:
+  ~StatementLease();
+
+  StatementLease(const StatementLease&) = delete;
+  StatementLease& operator=(const StatementLease&) = delete;
+  StatementLease(StatementLease&&) = delete;
+  StatementLease& operator=(StatementLease&&) = delete;
+
+  // Returns true if the statement was prepared successfully
+  [[nodiscard]] bool is_valid() const { return stmt_ != nullptr; }
+
+  // Get error message if preparation failed
+  [[nodiscard]] std::string error() const { return error_; }
+
+  // Get raw statement (for binding/stepping)
+  [[nodiscard]] sqlite3_stmt* get() const { return stmt_; }
+
+  // Reset statement for reuse within the lease
+  void reset();
+
+ private:
+  friend class SqliteDb;
+
+  StatementLease(const SqliteDb& db, CachedStatementSlot* slot, sqlite3_stmt* stmt,
+                 std::string error);
+
+  const SqliteDb& db_;
+  CachedStatementSlot* slot_;  // where the statement returns; nullptr = finalize on release
+  sqlite3_stmt* stmt_;
+  std::string error_;
 };
 
 // RAII wrapper for prepared statements
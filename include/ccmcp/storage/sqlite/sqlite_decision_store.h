@@ -5,7 +5,7 @@
 #endif
 
 #include "ccmcp/storage/decision_store.h"
-#include "ccmcp/storage/sqlite/sqlite_db.h"
+#include "ccmcp/storage/sqlite/sqlite_connection_pool.h"
 
 #include <memory>
 
@@ -21,7 +21,10 @@ namespace ccmcp::storage::sqlite {
 // NULL created_at columns map to std::nullopt.
 class SqliteDecisionStore final : public IDecisionStore {
  public:
+  // Reads and writes share db's single connection.
   explicit SqliteDecisionStore(std::shared_ptr<SqliteDb> db);
+  // Reads go to pool's reader connections, writes to its writer.
+  explicit SqliteDecisionStore(std::shared_ptr<SqliteConnectionPool> pool);
 
   void upsert(const domain::DecisionRecord& record) override;
 
@@ -32,7 +35,7 @@ class SqliteDecisionStore final : public IDecisionStore {
       const std::string& trace_id) const override;
 
  private:
-  std::shared_ptr<SqliteDb> db_;
+  std::shared_ptr<SqliteConnectionPool> pool_;
 
   // Deserialize a row from a prepared statement into a DecisionRecord.
   // Column order: decision_id(0), trace_id(1), opportunity_id(2),
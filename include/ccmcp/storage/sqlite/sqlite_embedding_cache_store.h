@@ -0,0 +1,41 @@
+#pragma once
+
+#ifdef CCMCP_TRANSPORT_BOUNDARY_GUARD
+#error "Concrete storage/redis header included in a guarded translation unit — use interfaces only."
+#endif
+
+#include "ccmcp/embedding/embedding_cache_store.h"
+#include "ccmcp/storage/sqlite/sqlite_connection_pool.h"
+
+#include <memory>
+#include <span>
+
+namespace ccmcp::storage::sqlite {
+
+// SqliteEmbeddingCacheStore persists CachingEmbeddingProvider entries to the
+// embedding_cache table (schema v9).
+//
+// Vectors are stored as raw float32 BLOBs with their dimension; a row whose BLOB size
+// disagrees with its dimension is treated as absent.
+class SqliteEmbeddingCacheStore final : public embedding::IEmbeddingCacheStore {
+ public:
+  // Reads and writes share db's single connection.
+  explicit SqliteEmbeddingCacheStore(std::shared_ptr<SqliteDb> db);
+  // Reads go to pool's reader connections, writes to its writer.
+  explicit SqliteEmbeddingCacheStore(std::shared_ptr<SqliteConnectionPool> pool);
+
+  [[nodiscard]] std::optional<vector::Vector> get(
+      const embedding::EmbeddingCacheKey& key) const override;
+
+  void put(const embedding::EmbeddingCacheKey& key, const vector::Vector& embedding) override;
+
+  // Writes the whole batch in one BEGIN IMMEDIATE transaction; on failure it is rolled back
+  // and std::runtime_error is thrown, as put() throws.
+  void put_many(std::span<const embedding::EmbeddingCacheKey> keys,
+                std::span<const vector::Vector> embeddings) override;
+
+ private:
+  std::shared_ptr<SqliteConnectionPool> pool_;
+};
+
+}  // namespace ccmcp::storage::sqlite
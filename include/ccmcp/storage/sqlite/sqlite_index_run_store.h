@@ -5,7 +5,7 @@
 #endif
 
 #include "ccmcp/indexing/index_run_store.h"
-#include "ccmcp/storage/sqlite/sqlite_db.h"
+#include "ccmcp/storage/sqlite/sqlite_connection_pool.h"
 
 #include <memory>
 
@@ -17,11 +17,20 @@ namespace ccmcp::storage::sqlite {
 // SqliteIndexRunStore persists IndexRun and IndexEntry records to the
 // index_runs and index_entries tables (schema v4).
 //
+// artifact_index_state (schema v10) materializes the latest completed state per artifact:
+// upsert_run() promotes a run's entries when it is stored as completed, and upsert_entry()
+// updates the state directly when its run has already completed. get_last_source_hash() and
+// load_artifact_states() read only this table, so they cost the same however many runs
+// index_entries holds. Callers must apply ensure_schema_v10().
+//
 // All queries use deterministic ORDER BY clauses to guarantee reproducible
 // test output. NULL timestamp columns are mapped to std::nullopt.
 class SqliteIndexRunStore final : public indexing::IIndexRunStore {
  public:
+  // Reads and writes share db's single connection.
   explicit SqliteIndexRunStore(std::shared_ptr<SqliteDb> db);
+  // Reads go to pool's reader connections, writes to its writer.
+  explicit SqliteIndexRunStore(std::shared_ptr<SqliteConnectionPool> pool);
 
   void upsert_run(const indexing::IndexRun& run) override;
   void upsert_entry(const indexing::IndexEntry& entry) override;
@@ -35,10 +44,15 @@ class SqliteIndexRunStore final : public indexing::IIndexRunStore {
       const std::string& provider_id, const std::string& model_id,
       const std::string& prompt_version) const override;
 
+  [[nodiscard]] indexing::ArtifactStateMap load_artifact_states(
+      const std::vector<std::string>& artifact_types, const std::string& provider_id,
+      const std::string& model_id, const std::string& prompt_version) const override;
+  std::size_t prune_entries(std::size_t keep_runs) override;
+
   [[nodiscard]] std::string next_index_run_id() override;
 
  private:
-  std::shared_ptr<SqliteDb> db_;
+  std::shared_ptr<SqliteConnectionPool> pool_;
 
   // Deserialize helpers — move data from a prepared statement row into a struct.
   [[nodiscard]] indexing::IndexRun row_to_run(sqlite3_stmt* stmt) const;
@@ -5,7 +5,7 @@
 #endif
 
 #include "ccmcp/storage/repositories.h"
-#include "ccmcp/storage/sqlite/sqlite_db.h"
+#include "ccmcp/storage/sqlite/sqlite_connection_pool.h"
 
 #include <memory>
 
@@ -15,7 +15,10 @@ namespace ccmcp::storage::sqlite {
 // Stores interaction state as INTEGER.
 class SqliteInteractionRepository final : public IInteractionRepository {
  public:
+  // Reads and writes share db's single connection.
   explicit SqliteInteractionRepository(std::shared_ptr<SqliteDb> db);
+  // Reads go to pool's reader connections, writes to its writer.
+  explicit SqliteInteractionRepository(std::shared_ptr<SqliteConnectionPool> pool);
 
   void upsert(const domain::Interaction& interaction) override;
   [[nodiscard]] std::optional<domain::Interaction> get(
@@ -25,7 +28,7 @@ class SqliteInteractionRepository final : public IInteractionRepository {
   [[nodiscard]] std::vector<domain::Interaction> list_all() const override;
 
  private:
-  std::shared_ptr<SqliteDb> db_;
+  std::shared_ptr<SqliteConnectionPool> pool_;
 
   // Helper to deserialize interaction from prepared statement row
   [[nodiscard]] domain::Interaction row_to_interaction(sqlite3_stmt* stmt) const;
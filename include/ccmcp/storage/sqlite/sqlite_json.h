@@ -0,0 +1,22 @@
+#pragma once
+
+#ifdef CCMCP_TRANSPORT_BOUNDARY_GUARD
+#error "Concrete storage/redis header included in a guarded translation unit — use interfaces only."
+#endif
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ccmcp::storage::sqlite {
+
+// parse_string_array parses a JSON array of strings, as stored in *_json columns such as
+// requirements.tags_json (written with nlohmann::json::dump()).
+//
+// Arrays of plain strings (no escape sequences), the common case, are split in one pass
+// without building a JSON DOM. Anything else (escapes, or input that is not a flat array of
+// strings) goes through nlohmann::json, which throws nlohmann::json::exception on
+// malformed input, exactly as the repositories' previous parse-then-get did.
+[[nodiscard]] std::vector<std::string> parse_string_array(std::string_view json);
+
+}  // namespace ccmcp::storage::sqlite
@@ -5,8 +5,9 @@
 #endif
 
 #include "ccmcp/storage/repositories.h"
-#include "ccmcp/storage/sqlite/sqlite_db.h"
+#include "ccmcp/storage/sqlite/sqlite_connection_pool.h"
 
+#include <cstddef>
 #include <memory>
 
 namespace ccmcp::storage::sqlite {
@@ -14,21 +15,28 @@ namespace ccmcp::storage::sqlite {
 // SqliteOpportunityRepository implements IOpportunityRepository with SQLite backend.
 // Handles opportunities and requirements (one-to-many relationship).
 // Requirements order is preserved via idx column.
+// Reads (get, get_many, list_all) hydrate opportunities from a single opportunities JOIN
+// requirements statement rather than one requirements query per opportunity.
 class SqliteOpportunityRepository final : public IOpportunityRepository {
  public:
+  // Reads and writes share db's single connection.
   explicit SqliteOpportunityRepository(std::shared_ptr<SqliteDb> db);
+  // Reads go to pool's reader connections, writes to its writer.
+  explicit SqliteOpportunityRepository(std::shared_ptr<SqliteConnectionPool> pool);
 
   void upsert(const domain::Opportunity& opportunity) override;
+  // All opportunities in one BEGIN IMMEDIATE transaction, rolled back entirely on any
+  // failure. Requirement rows are inserted through multi-row INSERTs.
+  std::size_t upsert_many(const std::vector<domain::Opportunity>& opportunities) override;
   [[nodiscard]] std::optional<domain::Opportunity> get(
       const core::OpportunityId& id) const override;
+  // Distinct ids are looked up in chunks of 64 per statement.
+  [[nodiscard]] std::vector<std::optional<domain::Opportunity>> get_many(
+      const std::vector<core::OpportunityId>& ids) const override;
   [[nodiscard]] std::vector<domain::Opportunity> list_all() const override;
 
  private:
-  std::shared_ptr<SqliteDb> db_;
-
-  // Load requirements for an opportunity (ordered by idx)
-  [[nodiscard]] std::vector<domain::Requirement> load_requirements(
-      const core::OpportunityId& id) const;
+  std::shared_ptr<SqliteConnectionPool> pool_;
 };
 
 }  // namespace ccmcp::storage::sqlite
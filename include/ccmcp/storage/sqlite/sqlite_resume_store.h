@@ -5,7 +5,7 @@
 #endif
 
 #include "ccmcp/ingest/resume_store.h"
-#include "ccmcp/storage/sqlite/sqlite_db.h"
+#include "ccmcp/storage/sqlite/sqlite_connection_pool.h"
 
 #include <memory>
 
@@ -16,7 +16,10 @@ namespace ccmcp::storage::sqlite {
 // Guarantees deterministic ordering (ORDER BY resume_id).
 class SqliteResumeStore final : public ingest::IResumeStore {
  public:
+  // Reads and writes share db's single connection.
   explicit SqliteResumeStore(std::shared_ptr<SqliteDb> db);
+  // Reads go to pool's reader connections, writes to its writer.
+  explicit SqliteResumeStore(std::shared_ptr<SqliteConnectionPool> pool);
 
   void upsert(const ingest::IngestedResume& resume) override;
   [[nodiscard]] std::optional<ingest::IngestedResume> get(const core::ResumeId& id) const override;
@@ -25,13 +28,15 @@ class SqliteResumeStore final : public ingest::IResumeStore {
   [[nodiscard]] std::vector<ingest::IngestedResume> list_all() const override;
 
  private:
-  std::shared_ptr<SqliteDb> db_;
+  std::shared_ptr<SqliteConnectionPool> pool_;
 
-  // Helper to deserialize resume from prepared statement row
-  [[nodiscard]] ingest::IngestedResume row_to_resume(sqlite3_stmt* stmt) const;
+  // Helper to deserialize resume from prepared statement row (meta is read through db)
+  [[nodiscard]] ingest::IngestedResume row_to_resume(const SqliteDb& db,
+                                                     sqlite3_stmt* stmt) const;
 
   // Helper to get resume_meta for a given resume_id
-  [[nodiscard]] ingest::ResumeMeta get_meta(const std::string& resume_id) const;
+  [[nodiscard]] ingest::ResumeMeta get_meta(const SqliteDb& db,
+                                              const std::string& resume_id) const;
 };
 
 }  // namespace ccmcp::storage::sqlite
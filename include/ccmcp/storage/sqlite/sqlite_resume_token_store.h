@@ -4,7 +4,7 @@
 #error "Concrete storage/redis header included in a guarded translation unit — use interfaces only."
 #endif
 
-#include "ccmcp/storage/sqlite/sqlite_db.h"
+#include "ccmcp/storage/sqlite/sqlite_connection_pool.h"
 #include "ccmcp/tokenization/resume_token_store.h"
 
 #include <memory>
@@ -16,7 +16,10 @@ namespace ccmcp::storage::sqlite {
 // Guarantees deterministic ordering (ORDER BY token_ir_id).
 class SqliteResumeTokenStore final : public tokenization::IResumeTokenStore {
  public:
+  // Reads and writes share db's single connection.
   explicit SqliteResumeTokenStore(std::shared_ptr<SqliteDb> db);
+  // Reads go to pool's reader connections, writes to its writer.
+  explicit SqliteResumeTokenStore(std::shared_ptr<SqliteConnectionPool> pool);
 
   void upsert(const std::string& token_ir_id, const core::ResumeId& resume_id,
               const domain::ResumeTokenIR& token_ir) override;
@@ -30,7 +33,7 @@ class SqliteResumeTokenStore final : public tokenization::IResumeTokenStore {
   [[nodiscard]] std::vector<domain::ResumeTokenIR> list_all() const override;
 
  private:
-  std::shared_ptr<SqliteDb> db_;
+  std::shared_ptr<SqliteConnectionPool> pool_;
 
   // Helper to deserialize token IR from JSON
   [[nodiscard]] domain::ResumeTokenIR row_to_token_ir(sqlite3_stmt* stmt) const;
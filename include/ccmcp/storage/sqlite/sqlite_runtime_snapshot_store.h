@@ -5,7 +5,7 @@
 #endif
 
 #include "ccmcp/storage/runtime_snapshot_store.h"
-#include "ccmcp/storage/sqlite/sqlite_db.h"
+#include "ccmcp/storage/sqlite/sqlite_connection_pool.h"
 
 #include <memory>
 
@@ -18,7 +18,10 @@ namespace ccmcp::storage::sqlite {
 // run_id PRIMARY KEY guarantees at-most-once storage per run.
 class SqliteRuntimeSnapshotStore final : public IRuntimeSnapshotStore {
  public:
+  // Reads and writes share db's single connection.
   explicit SqliteRuntimeSnapshotStore(std::shared_ptr<SqliteDb> db);
+  // Reads go to pool's reader connections, writes to its writer.
+  explicit SqliteRuntimeSnapshotStore(std::shared_ptr<SqliteConnectionPool> pool);
 
   void save(const std::string& run_id, const std::string& snapshot_json,
             const std::string& snapshot_hash, const std::string& created_at) override;
@@ -27,7 +30,7 @@ class SqliteRuntimeSnapshotStore final : public IRuntimeSnapshotStore {
       const std::string& run_id) const override;
 
  private:
-  std::shared_ptr<SqliteDb> db_;
+  std::shared_ptr<SqliteConnectionPool> pool_;
 };
 
 }  // namespace ccmcp::storage::sqlite
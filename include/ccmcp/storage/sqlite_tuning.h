@@ -0,0 +1,114 @@
+#pragma once
+
+// SqliteTuning — connection-level performance settings for every SQLite file the apps open
+// (the canonical database through SqliteDb and the vector index through SqliteEmbeddingIndex).
+//
+// CLI flags: --sqlite-profile <durable|balanced|bulk-load>, then per-setting overrides
+//   --sqlite-journal-mode, --sqlite-synchronous, --sqlite-mmap-size, --sqlite-cache-size,
+//   --sqlite-temp-store, --sqlite-busy-timeout, --sqlite-wal-autocheckpoint
+//
+// Each setting maps to the SQLite PRAGMA of the same name and is applied when the
+// connection opens. In-memory databases ignore journal_mode (always "memory") and mmap_size.
+//
+// Library callers that pass no tuning get SQLite's own defaults (rollback journal,
+// synchronous=full). The apps choose the balanced profile unless --sqlite-profile says
+// otherwise.
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace ccmcp::storage {
+
+// uint8_t base types: the enumerators fit in one byte; no reason to pay for int.
+enum class SqliteJournalMode : uint8_t {
+  kDelete,    // "delete"   — rollback journal, deleted at commit (SQLite default)
+  kTruncate,  // "truncate" — rollback journal, truncated at commit
+  kPersist,   // "persist"  — rollback journal, header zeroed at commit
+  kMemory,    // "memory"   — rollback journal kept in memory (not crash-safe)
+  kWal,       // "wal"      — write-ahead log; readers never block the writer
+};
+
+enum class SqliteSynchronous : uint8_t {
+  kOff,     // "off"    — no fsync; a power loss can corrupt the database
+  kNormal,  // "normal" — fsync at checkpoints; in WAL mode the last commits may roll back
+  kFull,    // "full"   — fsync at every commit (SQLite default)
+  kExtra,   // "extra"  — full, plus fsync of the directory after journal deletes
+};
+
+enum class SqliteTempStore : uint8_t {
+  kDefault,  // "default" — compile-time default (usually file)
+  kFile,     // "file"
+  kMemory,   // "memory"
+};
+
+// Named presets; each is a complete SqliteTuning (see sqlite_tuning_for()).
+enum class SqliteTuningProfile : uint8_t {
+  kDurable,   // "durable"   — WAL, synchronous=full, no mmap: every commit is on disk
+  kBalanced,  // "balanced"  — WAL, synchronous=normal, 256 MiB mmap, 64 MiB cache (app default)
+  kBulkLoad,  // "bulk-load" — WAL, synchronous=off, 1 GiB mmap, 256 MiB cache, rare checkpoints
+};
+
+// SqliteTuning is the resolved set of PRAGMA values for one connection.
+// The member defaults are SQLite's own, so a default-constructed SqliteTuning leaves a
+// connection as an untuned sqlite3_open() would (rollback journal, synchronous=full, no mmap,
+// no busy timeout). mmap_size is in bytes, cache_size_kib in KiB, busy_timeout_ms in
+// milliseconds and wal_autocheckpoint in pages (0 disables it).
+struct SqliteTuning {
+  SqliteJournalMode journal_mode{SqliteJournalMode::kDelete};  // NOLINT
+  SqliteSynchronous synchronous{SqliteSynchronous::kFull};     // NOLINT
+  std::size_t mmap_size{0};                                    // NOLINT
+  std::size_t cache_size_kib{2000};                            // NOLINT
+  SqliteTempStore temp_store{SqliteTempStore::kDefault};       // NOLINT
+  std::size_t busy_timeout_ms{0};                              // NOLINT
+  std::size_t wal_autocheckpoint{1000};                        // NOLINT
+};
+
+// SqliteTuningConfig is what the --sqlite-* flags collect: a profile plus per-setting
+// overrides. Overrides win over the profile regardless of flag order. Apps initialise
+// profile to their --sqlite-profile default.
+struct SqliteTuningConfig {
+  SqliteTuningProfile profile{SqliteTuningProfile::kDurable};  // NOLINT
+  std::optional<SqliteJournalMode> journal_mode;  // NOLINT(readability-identifier-naming)
+  std::optional<SqliteSynchronous> synchronous;   // NOLINT(readability-identifier-naming)
+  std::optional<std::size_t> mmap_size;           // NOLINT(readability-identifier-naming)
+  std::optional<std::size_t> cache_size_kib;      // NOLINT(readability-identifier-naming)
+  std::optional<SqliteTempStore> temp_store;      // NOLINT(readability-identifier-naming)
+  std::optional<std::size_t> busy_timeout_ms;     // NOLINT(readability-identifier-naming)
+  std::optional<std::size_t> wal_autocheckpoint;  // NOLINT(readability-identifier-naming)
+};
+
+// sqlite_tuning_for returns the settings of a named profile.
+[[nodiscard]] SqliteTuning sqlite_tuning_for(SqliteTuningProfile profile);
+
+// resolve applies config's overrides on top of its profile.
+[[nodiscard]] SqliteTuning resolve(const SqliteTuningConfig& config);
+
+// sqlite_tuning_settings returns (pragma name, value) pairs in the order they are applied:
+// busy_timeout first, so that switching journal_mode waits out a concurrent writer.
+// cache_size is given in SQLite's negative-KiB form.
+[[nodiscard]] std::vector<std::pair<std::string, std::string>> sqlite_tuning_settings(
+    const SqliteTuning& tuning);
+
+// sqlite_tuning_pragmas returns the settings as one SQL script of PRAGMA statements.
+[[nodiscard]] std::string sqlite_tuning_pragmas(const SqliteTuning& tuning);
+
+// Flag parsers: return std::nullopt for unrecognised values (including empty string).
+// Case-sensitive.
+[[nodiscard]] std::optional<SqliteTuningProfile> parse_sqlite_tuning_profile(
+    const std::string& s);
+[[nodiscard]] std::optional<SqliteJournalMode> parse_sqlite_journal_mode(const std::string& s);
+[[nodiscard]] std::optional<SqliteSynchronous> parse_sqlite_synchronous(const std::string& s);
+[[nodiscard]] std::optional<SqliteTempStore> parse_sqlite_temp_store(const std::string& s);
+
+// to_string returns the canonical flag string for an enumerator.
+[[nodiscard]] std::string_view to_string(SqliteTuningProfile profile);
+[[nodiscard]] std::string_view to_string(SqliteJournalMode mode);
+[[nodiscard]] std::string_view to_string(SqliteSynchronous mode);
+[[nodiscard]] std::string_view to_string(SqliteTempStore mode);
+
+}  // namespace ccmcp::storage
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace ccmcp::vector {
@@ -15,24 +17,105 @@ struct VectorSearchResult {
   std::string metadata;  // NOLINT(readability-identifier-naming)
 };
 
+// VectorRecord is one entry of a batched upsert_many().
+struct VectorRecord {
+  VectorKey key;         // NOLINT(readability-identifier-naming)
+  Vector embedding;      // NOLINT(readability-identifier-naming)
+  std::string metadata;  // NOLINT(readability-identifier-naming)
+};
+
+// VectorNamespace names one partition of an index. Every backend keeps each namespace in a
+// physically separate segment, and a query scans only the namespace it names. Keys are
+// unique within a namespace; the same key may exist in several namespaces.
+using VectorNamespace = std::string_view;
+
+// The partition used by the overloads without a namespace argument.
+inline constexpr VectorNamespace kDefaultNamespace = "";
+
+// Partitions written by the index build, one per artifact type (see run_index_build).
+inline constexpr VectorNamespace kAtomNamespace = "atom";
+inline constexpr VectorNamespace kResumeNamespace = "resume";
+inline constexpr VectorNamespace kOpportunityNamespace = "opportunity";
+
+// NamespacedKey is a key together with the partition it belongs to.
+struct NamespacedKey {
+  VectorNamespace ns;    // NOLINT(readability-identifier-naming)
+  std::string_view key;  // NOLINT(readability-identifier-naming)
+};
+
+// split_legacy_key maps a key of a pre-namespace index, where the index build kept every
+// artifact in one keyspace, to its partition: "resume:<id>" → (resume, <id>),
+// "opp:<id>" → (opportunity, <id>), anything else → (atom, key). Used by the persistent
+// backends to migrate files written before namespaces existed.
+[[nodiscard]] inline NamespacedKey split_legacy_key(std::string_view key) {
+  constexpr std::string_view kResumePrefix = "resume:";
+  constexpr std::string_view kOpportunityPrefix = "opp:";
+  if (key.starts_with(kResumePrefix)) {
+    return {kResumeNamespace, key.substr(kResumePrefix.size())};
+  }
+  if (key.starts_with(kOpportunityPrefix)) {
+    return {kOpportunityNamespace, key.substr(kOpportunityPrefix.size())};
+  }
+  return {kAtomNamespace, key};
+}
+
 // IEmbeddingIndex defines the interface for vector similarity search.
 // Implementations may use in-memory storage (for testing), LanceDB (for production),
 // or other vector databases.
+//
+// Every operation addresses one namespace. The overloads without a namespace argument use
+// kDefaultNamespace; implementations bring them into scope with using-declarations.
 class IEmbeddingIndex {
  public:
   virtual ~IEmbeddingIndex() = default;
 
   // upsert inserts or updates a vector with associated metadata.
-  virtual void upsert(const VectorKey& key, const Vector& embedding,
+  virtual void upsert(VectorNamespace ns, const VectorKey& key, const Vector& embedding,
                       const std::string& metadata) = 0;
 
-  // query performs similarity search and returns top_k results.
+  // upsert_many upserts every record, in order; the result is the same as calling upsert()
+  // for each. Backends amortise per-call costs (one transaction, one reservation, one write).
+  virtual void upsert_many(VectorNamespace ns, std::span<const VectorRecord> records) = 0;
+
+  // query performs similarity search over namespace ns and returns top_k results.
   // Results are sorted by score (descending), with deterministic tie-breaking.
-  [[nodiscard]] virtual std::vector<VectorSearchResult> query(const Vector& query_vector,
+  [[nodiscard]] virtual std::vector<VectorSearchResult> query(VectorNamespace ns,
+                                                              const Vector& query_vector,
                                                               size_t top_k) const = 0;
 
-  // get retrieves the stored embedding for a given key.
-  [[nodiscard]] virtual std::optional<Vector> get(const VectorKey& key) const = 0;
+  // query_batch runs query() for every query vector and returns the result lists in the
+  // same order; each list is identical to query() for that vector alone. Exact backends
+  // score blocks of queries against each block of stored vectors in one pass.
+  [[nodiscard]] virtual std::vector<std::vector<VectorSearchResult>> query_batch(
+      VectorNamespace ns, std::span<const Vector> queries, size_t top_k) const = 0;
+
+  // get retrieves the stored embedding for key in namespace ns.
+  [[nodiscard]] virtual std::optional<Vector> get(VectorNamespace ns,
+                                                  const VectorKey& key) const = 0;
+
+  // ── kDefaultNamespace shorthands ──────────────────────────────────────────
+
+  void upsert(const VectorKey& key, const Vector& embedding, const std::string& metadata) {
+    upsert(kDefaultNamespace, key, embedding, metadata);
+  }
+
+  void upsert_many(std::span<const VectorRecord> records) {
+    upsert_many(kDefaultNamespace, records);
+  }
+
+  [[nodiscard]] std::vector<VectorSearchResult> query(const Vector& query_vector,
+                                                      size_t top_k) const {
+    return query(kDefaultNamespace, query_vector, top_k);
+  }
+
+  [[nodiscard]] std::vector<std::vector<VectorSearchResult>> query_batch(
+      std::span<const Vector> queries, size_t top_k) const {
+    return query_batch(kDefaultNamespace, queries, top_k);
+  }
+
+  [[nodiscard]] std::optional<Vector> get(const VectorKey& key) const {
+    return get(kDefaultNamespace, key);
+  }
 };
 
 }  // namespace ccmcp::vector
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "ccmcp/core/aligned_allocator.h"
+#include "ccmcp/vector/embedding_index.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ccmcp::vector {
+
+// FlatVectorStore keeps embeddings in a structure-of-arrays layout for fast exact scans.
+//
+// All vectors of one dimension live in a single contiguous float matrix whose rows start on
+// 64-byte boundaries (rows are zero-padded to a multiple of 16 floats). Each row's L2 norm
+// is computed once at upsert time and stored alongside, so a query is one streaming dot
+// product per row. Keys and metadata live in parallel arrays indexed by entry id and are
+// only copied for results that enter the top-k.
+//
+// Rows are stored as given rather than pre-normalized: dividing by the cached norms yields
+// scores bit-identical to math::cosine_similarity(), so this layout ranks exactly like the
+// SQLite and HNSW backends. Dot products use the SIMD kernels in vector_math.h.
+//
+// Not thread-safe; callers serialize access (as with every IEmbeddingIndex).
+class FlatVectorStore {
+ public:
+  // Floats per padding unit: 16 × 4 bytes = one 64-byte cache line.
+  static constexpr std::size_t kRowAlignmentFloats = 16;
+
+  // Inserts or replaces the vector for key.
+  void upsert(const VectorKey& key, const Vector& embedding, const std::string& metadata);
+
+  // Reserves room for `count` more keys whose vectors have dimension dim, so a batch of
+  // upserts grows each array at most once. Keys that already exist only waste the slack.
+  void reserve(std::size_t count, std::size_t dim);
+
+  [[nodiscard]] std::optional<Vector> get(const VectorKey& key) const;
+
+  // Metadata stored with key, or nullptr if absent. Invalidated by the next upsert().
+  [[nodiscard]] const std::string* metadata(const VectorKey& key) const;
+
+  // Exact cosine top-k: score desc, key asc within 1e-9 (ranks_before). Vectors whose
+  // dimension differs from the query's score 0.0, as in math::cosine_similarity().
+  [[nodiscard]] std::vector<VectorSearchResult> query(const Vector& query_vector,
+                                                      std::size_t top_k) const;
+
+  // query() for every query vector, in order. Queries are scored in blocks with
+  // math::dot_block(), so each stored row is read from memory once per block of queries.
+  // Each result list is identical to query() for that vector alone.
+  [[nodiscard]] std::vector<std::vector<VectorSearchResult>> query_batch(
+      std::span<const Vector> queries, std::size_t top_k) const;
+
+  [[nodiscard]] std::size_t size() const noexcept { return keys_.size(); }
+
+  // Bytes held by row matrices and norms (keys and metadata excluded).
+  [[nodiscard]] std::size_t vector_bytes() const noexcept;
+
+  // Every stored key, in first-insertion order.
+  [[nodiscard]] const std::vector<VectorKey>& keys() const noexcept { return keys_; }
+
+ private:
+  using AlignedFloats = std::vector<float, core::AlignedAllocator<float, 64>>;
+
+  // One matrix per dimension.
+  struct Block {
+    std::size_t stride{0};               // dim rounded up to kRowAlignmentFloats
+    AlignedFloats rows;                  // row r at rows[r * stride], padding zeroed
+    std::vector<double> norms;           // L2 norm of row r
+    std::vector<std::uint32_t> entries;  // entry id of row r
+  };
+
+  struct Location {
+    std::size_t dim;
+    std::size_t row;
+  };
+
+  void write_row(Block& block, std::size_t row, const Vector& embedding);
+  void remove_row(std::size_t dim, std::size_t row);
+
+  // Parallel arrays indexed by entry id.
+  std::vector<VectorKey> keys_;
+  std::vector<std::string> metadata_;
+  std::vector<Location> locations_;
+  std::unordered_map<VectorKey, std::uint32_t> ids_;
+
+  std::map<std::size_t, Block> blocks_;  // keyed by dimension
+};
+
+}  // namespace ccmcp::vector
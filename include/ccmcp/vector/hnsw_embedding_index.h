@@ -0,0 +1,191 @@
+#pragma once
+
+#include "ccmcp/vector/embedding_index.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace ccmcp::vector {
+
+// HnswConfig holds the tunables of HnswEmbeddingIndex.
+struct HnswConfig {
+  // Maximum neighbours per node on layers >= 1; layer 0 allows 2 * m.
+  std::size_t m{16};  // NOLINT(readability-identifier-naming)
+  // Candidate list size while inserting. Larger → better graph, slower build.
+  std::size_t ef_construction{200};  // NOLINT(readability-identifier-naming)
+  // Candidate list size while querying (raised to top_k if smaller). Larger → better
+  // recall, slower queries. Not part of the persisted graph; may change between runs.
+  std::size_t ef_search{64};  // NOLINT(readability-identifier-naming)
+  // Seed of the level generator.
+  std::uint64_t seed{0x6363'6d63'7068'6e73ULL};  // NOLINT(readability-identifier-naming)
+};
+
+// HnswEmbeddingIndex is an approximate-nearest-neighbour index built on a Hierarchical
+// Navigable Small World graph (Malkov & Yashunin). It is selected via
+// --vector-backend hnsw (with --vector-db-path specifying the directory).
+//
+// Namespaces: each namespace has its own entries and its own graph, so a query walks only
+// the graph of the namespace it names.
+//
+// Determinism: each graph is a pure function of its namespace's (key, vector) set and the
+// HnswConfig. Upserts only record content; the graph is (re)built lazily, before the next
+// query or save(), by inserting nodes in ascending key order with node levels drawn from a
+// std::mt19937_64 seeded with HnswConfig::seed. Every search breaks similarity ties by node
+// order, and results are ordered by ranks_before() exactly like the exact backends, so the
+// same corpus and config always yield the same results for the audit trail.
+//
+// Scores are the same cosine similarity InMemoryEmbeddingIndex computes; only the set of
+// vectors visited is approximate.
+//
+// Persistence (optional): entries and graphs of every namespace are written to a single
+// binary file by save() (write to "<path>.tmp", then rename) and loaded by the constructor.
+// A format-1 file (one graph over the pre-namespace keyspace) is split into namespaces with
+// split_legacy_key(), rebuilt on first use and rewritten in the current format by save().
+// A file built with a different m / ef_construction / seed is loaded and its graphs rebuilt
+// on first use; save() rewrites it with the current parameters. The destructor saves on a
+// best-effort basis only if this instance upserted something, so opening a file just to
+// query never rewrites it; call save() to observe errors.
+//
+// Thread safety: concurrent query()/get() calls are safe; upsert(), save() and
+// set_ef_search() must not run concurrently with other calls.
+class HnswEmbeddingIndex final : public IEmbeddingIndex {
+ public:
+  using IEmbeddingIndex::get;
+  using IEmbeddingIndex::query;
+  using IEmbeddingIndex::query_batch;
+  using IEmbeddingIndex::upsert;
+  using IEmbeddingIndex::upsert_many;
+
+  // In-memory index (no file).
+  explicit HnswEmbeddingIndex(HnswConfig config = {});
+
+  // Persistent index at file_path. Loads the file if it exists.
+  // Throws std::runtime_error if the file exists but cannot be read or is malformed.
+  HnswEmbeddingIndex(HnswConfig config, std::string file_path);
+
+  ~HnswEmbeddingIndex() override;
+
+  HnswEmbeddingIndex(const HnswEmbeddingIndex&) = delete;
+  HnswEmbeddingIndex& operator=(const HnswEmbeddingIndex&) = delete;
+  HnswEmbeddingIndex(HnswEmbeddingIndex&&) = delete;
+  HnswEmbeddingIndex& operator=(HnswEmbeddingIndex&&) = delete;
+
+  // Inserts or replaces the vector for key. Re-upserting an identical vector keeps the graph.
+  void upsert(VectorNamespace ns, const VectorKey& key, const Vector& embedding,
+              const std::string& metadata) override;
+
+  // Records every upsert under one lock; the graph is rebuilt once, on the next query.
+  void upsert_many(VectorNamespace ns, std::span<const VectorRecord> records) override;
+
+  // Returns up to top_k approximate nearest neighbours, sorted by cosine similarity (desc),
+  // tie-broken by key (asc).
+  [[nodiscard]] std::vector<VectorSearchResult> query(VectorNamespace ns,
+                                                      const Vector& query_vector,
+                                                      size_t top_k) const override;
+
+  // Runs one graph search per query (there is no shared scan to block).
+  [[nodiscard]] std::vector<std::vector<VectorSearchResult>> query_batch(
+      VectorNamespace ns, std::span<const Vector> queries, size_t top_k) const override;
+
+  // Returns the stored embedding for key, or nullopt if not found.
+  [[nodiscard]] std::optional<Vector> get(VectorNamespace ns,
+                                          const VectorKey& key) const override;
+
+  // Writes entries and graphs to the file given at construction. No-op for in-memory
+  // indexes or when nothing changed since the last save/load and the file is current.
+  // Throws std::runtime_error on I/O failure.
+  void save();
+
+  // Changes the query-time candidate list size; the graph is unaffected.
+  void set_ef_search(std::size_t ef_search) noexcept { config_.ef_search = ef_search; }
+
+  // Number of entries across all namespaces.
+  [[nodiscard]] std::size_t size() const;
+  [[nodiscard]] const HnswConfig& config() const noexcept { return config_; }
+
+ private:
+  struct Entry {
+    Vector embedding;
+    std::string metadata;
+  };
+  using EntryMap = std::map<VectorKey, Entry>;
+
+  // Neighbour found during a graph search.
+  struct Candidate {
+    double similarity;
+    std::uint32_t node;
+  };
+
+  // Epoch-stamped visited marks, reused across searches without clearing.
+  class VisitedSet;
+
+  // Checked reads from an index file.
+  class FileReader;
+
+  // Graph over one partition's entries, nodes numbered in key order. Rebuilt as a whole.
+  struct Graph {
+    std::vector<const EntryMap::value_type*> nodes;
+    std::vector<double> norms;                                 // ||nodes[i].embedding||
+    std::vector<std::vector<std::vector<std::uint32_t>>> links;  // node → layer → neighbours
+    std::uint32_t entry_point{0};
+    int max_level{-1};  // -1 when empty
+  };
+
+  // Entries of one namespace and the graph over them. The graph is rebuilt lazily, so it
+  // is mutable; graph.nodes points into entries.
+  struct Partition {
+    EntryMap entries;                 // NOLINT(readability-identifier-naming)
+    mutable Graph graph;              // NOLINT(readability-identifier-naming)
+    mutable bool graph_dirty{false};  // NOLINT(readability-identifier-naming)
+  };
+
+  // Records one upsert; requires graph_mutex_ held exclusively.
+  void upsert_entry(Partition& partition, const VectorKey& key, const Vector& embedding,
+                    const std::string& metadata);
+
+  // Partition of namespace ns, or nullptr if nothing was ever written to it.
+  [[nodiscard]] const Partition* find_partition(VectorNamespace ns) const;
+
+  // The graph members below require graph_mutex_: exclusive for build, shared for search.
+  void ensure_graph(const Partition& partition) const;
+  void build_graph(const Partition& partition) const;
+  void insert_node(Graph& graph, std::uint32_t node, int level, VisitedSet& visited) const;
+  [[nodiscard]] std::vector<VectorSearchResult> search(const Graph& graph,
+                                                       const Vector& query_vector,
+                                                       std::size_t top_k) const;
+
+  [[nodiscard]] double similarity(const Graph& graph, const Vector& query, double query_norm,
+                                  std::uint32_t node) const;
+  [[nodiscard]] std::vector<Candidate> search_layer(const Graph& graph, const Vector& query,
+                                                    double query_norm,
+                                                    const std::vector<Candidate>& entry_points,
+                                                    std::size_t ef, int level,
+                                                    VisitedSet& visited) const;
+  [[nodiscard]] std::vector<std::uint32_t> select_neighbours(
+      const Graph& graph, const std::vector<Candidate>& candidates, std::size_t max_count) const;
+  void shrink_links(Graph& graph, std::uint32_t node, int level) const;
+  [[nodiscard]] std::size_t max_links(int level) const noexcept;
+
+  void load();
+  // Reads one partition's entries and graph (validated) from the file.
+  static void read_partition(FileReader& reader, std::ifstream& in, Partition& partition);
+  void write_file() const;
+
+  HnswConfig config_;
+  std::optional<std::string> file_path_;
+  std::map<std::string, Partition, std::less<>> partitions_;
+  bool file_dirty_{false};  // upserts not yet saved
+  bool file_stale_{false};  // loaded file has an old format or other build parameters
+
+  mutable std::shared_mutex graph_mutex_;
+};
+
+}  // namespace ccmcp::vector
@@ -1,30 +1,88 @@
 #pragma once
 
+#include "ccmcp/core/snapshot_cell.h"
 #include "ccmcp/vector/embedding_index.h"
+#include "ccmcp/vector/flat_vector_store.h"
 
+#include <cstddef>
+#include <functional>
 #include <map>
-#include <utility>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
 
 namespace ccmcp::vector {
 
-// InMemoryEmbeddingIndex stores vectors in-memory using std::map.
-// Uses cosine similarity for query operations with deterministic tie-breaking.
-// Suitable for testing and small-scale v0.2 development.
+// InMemoryEmbeddingIndex stores vectors in-memory in FlatVectorStores (contiguous,
+// cache-line-aligned rows with cached norms). Uses cosine similarity for query operations with
+// deterministic tie-breaking; query keeps only the running top_k in a bounded heap.
+// Each namespace has its own segments, so a query never touches other namespaces.
+//
+// Snapshots: the index is an immutable snapshot published through a core::SnapshotCell.
+// A namespace is a list of immutable segments, oldest first; a key replaced by a newer
+// segment is recorded as shadowed in the older one and skipped by queries. Writers build a
+// new segment from their records and publish a new snapshot; readers load the current
+// snapshot without locking and never block on, or observe part of, a concurrent write.
+// Segments a snapshot no longer references are freed when the last reader holding them
+// releases its snapshot.
+//
+// Segments are merged on write, size-tiered: the newest segment is merged into its
+// predecessor while it holds at least half as many live rows, so a namespace keeps
+// O(log n) segments and a row is copied O(log n) times. A segment more than half shadowed
+// is rewritten without its shadowed rows. Results never depend on the segment layout:
+// every row is scored exactly as by one FlatVectorStore and merged in ranks_before() order.
+//
+// Thread safety: query(), query_batch() and get() may run concurrently with each other
+// and with upsert()/upsert_many(); writers are serialized internally.
 class InMemoryEmbeddingIndex final : public IEmbeddingIndex {
  public:
-  void upsert(const VectorKey& key, const Vector& embedding, const std::string& metadata) override;
+  using IEmbeddingIndex::get;
+  using IEmbeddingIndex::query;
+  using IEmbeddingIndex::query_batch;
+  using IEmbeddingIndex::upsert;
+  using IEmbeddingIndex::upsert_many;
 
-  [[nodiscard]] std::vector<VectorSearchResult> query(const Vector& query_vector,
+  void upsert(VectorNamespace ns, const VectorKey& key, const Vector& embedding,
+              const std::string& metadata) override;
+
+  // Writes every record into one new segment and publishes it with a single snapshot.
+  void upsert_many(VectorNamespace ns, std::span<const VectorRecord> records) override;
+
+  [[nodiscard]] std::vector<VectorSearchResult> query(VectorNamespace ns,
+                                                      const Vector& query_vector,
                                                       size_t top_k) const override;
 
-  [[nodiscard]] std::optional<Vector> get(const VectorKey& key) const override;
+  [[nodiscard]] std::vector<std::vector<VectorSearchResult>> query_batch(
+      VectorNamespace ns, std::span<const Vector> queries, size_t top_k) const override;
+
+  [[nodiscard]] std::optional<Vector> get(VectorNamespace ns,
+                                          const VectorKey& key) const override;
+
+  // Number of segments currently published for namespace ns.
+  [[nodiscard]] std::size_t segment_count(VectorNamespace ns) const;
 
  private:
-  std::map<VectorKey, std::pair<Vector, std::string>> vectors_;
+  using KeySet = std::unordered_set<VectorKey>;
+
+  // One immutable segment; shadowed holds its keys replaced by newer segments (may be null).
+  struct Segment {
+    std::shared_ptr<const FlatVectorStore> store;  // NOLINT(readability-identifier-naming)
+    std::shared_ptr<const KeySet> shadowed;        // NOLINT(readability-identifier-naming)
+  };
+  using Partition = std::vector<Segment>;  // oldest first
+  using PartitionMap = std::map<std::string, Partition, std::less<>>;
+
+  struct Snapshot {
+    PartitionMap partitions;  // NOLINT(readability-identifier-naming)
+  };
+
+  // Publishes segment as the newest of namespace ns; serialized by write_mutex_.
+  void publish(VectorNamespace ns, std::shared_ptr<const FlatVectorStore> segment);
 
-  // Compute cosine similarity between two vectors.
-  // Returns 0.0 if either vector has zero magnitude.
-  [[nodiscard]] static double cosine_similarity(const Vector& a, const Vector& b);
+  core::SnapshotCell<Snapshot> snapshot_;
+  std::mutex write_mutex_;
 };
 
 }  // namespace ccmcp::vector
@@ -15,12 +15,26 @@ namespace ccmcp::vector {
 // All methods throw std::runtime_error to make accidental use immediately visible.
 class LanceDBEmbeddingIndex final : public IEmbeddingIndex {
  public:
-  void upsert(const VectorKey& key, const Vector& embedding, const std::string& metadata) override;
+  using IEmbeddingIndex::get;
+  using IEmbeddingIndex::query;
+  using IEmbeddingIndex::query_batch;
+  using IEmbeddingIndex::upsert;
+  using IEmbeddingIndex::upsert_many;
 
-  [[nodiscard]] std::vector<VectorSearchResult> query(const Vector& query_vector,
+  void upsert(VectorNamespace ns, const VectorKey& key, const Vector& embedding,
+              const std::string& metadata) override;
+
+  void upsert_many(VectorNamespace ns, std::span<const VectorRecord> records) override;
+
+  [[nodiscard]] std::vector<VectorSearchResult> query(VectorNamespace ns,
+                                                      const Vector& query_vector,
                                                       size_t top_k) const override;
 
-  [[nodiscard]] std::optional<Vector> get(const VectorKey& key) const override;
+  [[nodiscard]] std::vector<std::vector<VectorSearchResult>> query_batch(
+      VectorNamespace ns, std::span<const Vector> queries, size_t top_k) const override;
+
+  [[nodiscard]] std::optional<Vector> get(VectorNamespace ns,
+                                          const VectorKey& key) const override;
 };
 
 }  // namespace ccmcp::vector
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "ccmcp/vector/embedding_index.h"
+#include "ccmcp/vector/flat_vector_store.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace ccmcp::vector {
+
+// MmapEmbeddingIndex is an exact vector index whose bulk data lives in a memory-mapped,
+// read-only file. It is selected via --vector-backend mmap (with --vector-db-path specifying
+// the directory; files vectors.mmap and vectors.mmap.wal).
+//
+// Base file (versioned, native byte order): a 64-byte header (magic, format version,
+// dimension, count, section offsets), a key table sorted by "<namespace>\0<key>" — so each
+// namespace is one contiguous range of rows and a query scores only its own — the
+// key/metadata bytes, the cached L2 norm of every row, and a page-aligned float matrix
+// whose rows are padded to 64 bytes like FlatVectorStore. Opening maps the file and
+// validates the header and key table only; rows are paged in on first query and shared
+// between processes through the OS page cache.
+//
+// Tail: upsert() appends a checksummed record to the write-ahead tail file and applies it
+// to an in-memory FlatVectorStore overlay (one per namespace) that shadows the base row of
+// the same key. The tail is replayed on open; a torn final record (crash mid-append) is
+// dropped. compact() merges base and tail into a new base file (write "<path>.tmp", rename)
+// and empties the tail. The base holds one non-zero dimension — the most common one at
+// compaction — and vectors of any other dimension stay in the tail, including old base rows
+// when the most common dimension changes. Empty vectors always stay in the tail.
+//
+// Format-1 files (written before namespaces, keyed by the bare key) are migrated at open:
+// every row moves to the namespace split_legacy_key() assigns and, in kReadWrite mode, both
+// files are rewritten.
+//
+// Scores are bit-identical to InMemoryEmbeddingIndex (same kernels, same cached norms) and
+// results follow ranks_before(): score desc, key asc within 1e-9.
+//
+// Thread safety: single-threaded, like every IEmbeddingIndex. One process opens the index
+// kReadWrite; other processes open it kReadOnly and see it as of their open.
+class MmapEmbeddingIndex final : public IEmbeddingIndex {
+ public:
+  using IEmbeddingIndex::get;
+  using IEmbeddingIndex::query;
+  using IEmbeddingIndex::query_batch;
+  using IEmbeddingIndex::upsert;
+  using IEmbeddingIndex::upsert_many;
+
+  // kReadWrite is the single writer: it creates a missing tail, cuts a torn final record,
+  // and migrates and compacts format-1 files. kReadOnly never creates, truncates or rewrites
+  // either file, so it is safe next to a writer: a torn or half-written final record is
+  // ignored, a format-1 file is migrated in memory only, upserts are dropped and compact()
+  // is a no-op.
+  enum class OpenMode { kReadWrite, kReadOnly };
+
+  // Opens the index at file_path (tail at file_path + ".wal"); kReadWrite creates it if
+  // absent, kReadOnly opens a missing index as empty.
+  // Throws std::runtime_error if an existing file is malformed or cannot be mapped.
+  // In kReadWrite mode a format-1 base or tail is migrated and compacted before the
+  // constructor returns.
+  explicit MmapEmbeddingIndex(std::string file_path, OpenMode mode = OpenMode::kReadWrite);
+
+  // Compacts a non-empty tail on a best-effort basis; call compact() to observe errors.
+  ~MmapEmbeddingIndex() override;
+
+  MmapEmbeddingIndex(const MmapEmbeddingIndex&) = delete;
+  MmapEmbeddingIndex& operator=(const MmapEmbeddingIndex&) = delete;
+  MmapEmbeddingIndex(MmapEmbeddingIndex&&) = delete;
+  MmapEmbeddingIndex& operator=(MmapEmbeddingIndex&&) = delete;
+
+  // Appends the vector to the tail. Silent on I/O failure (matches in-memory semantics);
+  // the index is only updated once the record is written. Dropped in kReadOnly mode.
+  void upsert(VectorNamespace ns, const VectorKey& key, const Vector& embedding,
+              const std::string& metadata) override;
+
+  // Appends every record with a single write and flush. All or nothing: on I/O failure the
+  // tail is cut back and none of the records are applied.
+  void upsert_many(VectorNamespace ns, std::span<const VectorRecord> records) override;
+
+  // Returns top_k results sorted by cosine similarity (desc), tie-broken by key (asc).
+  [[nodiscard]] std::vector<VectorSearchResult> query(VectorNamespace ns,
+                                                      const Vector& query_vector,
+                                                      size_t top_k) const override;
+
+  // Scores blocks of queries against each chunk of the namespace's base rows, then merges
+  // the tail.
+  [[nodiscard]] std::vector<std::vector<VectorSearchResult>> query_batch(
+      VectorNamespace ns, std::span<const Vector> queries, size_t top_k) const override;
+
+  // Returns the stored embedding for key, or nullopt if not found.
+  [[nodiscard]] std::optional<Vector> get(VectorNamespace ns,
+                                          const VectorKey& key) const override;
+
+  // Merges the tail into a new base file and remaps it. No-op when the tail is empty or the
+  // index was opened kReadOnly.
+  // Throws std::runtime_error on I/O failure; the index stays usable on the old files.
+  void compact();
+
+  // Number of distinct (namespace, key) pairs stored.
+  [[nodiscard]] std::size_t size() const noexcept;
+
+  // Number of records in the tail (appends since the last compaction).
+  [[nodiscard]] std::size_t tail_records() const noexcept { return tail_records_; }
+
+ private:
+  // Read-only mapping of the base file; unmapped on destruction.
+  class Mapping;
+  // One key-table entry of the base file.
+  struct KeyEntry;
+
+  // Pointers into the mapping, validated at open.
+  struct Base {
+    std::size_t dimension{0};
+    std::size_t count{0};
+    std::size_t stride{0};          // floats per row
+    const KeyEntry* keys{nullptr};  // count entries, ascending by composite key
+    const char* strings{nullptr};   // key and metadata bytes
+    const double* norms{nullptr};   // count norms
+    const float* rows{nullptr};     // count × stride floats
+  };
+
+  [[nodiscard]] std::string_view base_key(std::size_t row) const;
+  [[nodiscard]] std::string_view base_metadata(std::size_t row) const;
+  // The lookups below take composite keys ("<namespace>\0<key>").
+  [[nodiscard]] std::size_t lower_bound_row(std::string_view key) const;
+  [[nodiscard]] std::optional<std::size_t> find_base_row(std::string_view key) const;
+  // Half-open range of base rows that belong to namespace ns.
+  [[nodiscard]] std::pair<std::size_t, std::size_t> namespace_rows(VectorNamespace ns) const;
+
+  void map_base();
+  void replay_tail();
+  void open_tail_for_append();
+  // Writes encoded records to the tail and flushes; false (tail cut back) on failure.
+  [[nodiscard]] bool append_records(const std::string& records);
+  void apply(VectorNamespace ns, const VectorKey& key, const Vector& embedding,
+             const std::string& metadata);
+
+  std::string file_path_;
+  std::string tail_path_;
+  OpenMode mode_;
+
+  std::unique_ptr<Mapping> mapping_;  // nullptr when there is no base file
+  Base base_;
+  std::vector<bool> shadowed_;  // base rows replaced by the tail (sized lazily)
+  std::size_t shadowed_count_{0};
+
+  std::map<std::string, FlatVectorStore, std::less<>> tail_;  // by namespace
+  std::size_t tail_records_{0};
+  std::size_t appended_{0};      // records appended since the last compaction
+  std::uint64_t tail_bytes_{0};  // length of the valid tail prefix
+  std::ofstream tail_out_;
+  bool needs_migration_{false};  // a format-1 base or tail was read
+};
+
+}  // namespace ccmcp::vector
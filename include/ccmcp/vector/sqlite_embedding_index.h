@@ -4,9 +4,18 @@
 #error "Concrete storage/redis header included in a guarded translation unit — use interfaces only."
 #endif
 
+#include "ccmcp/storage/sqlite_tuning.h"
 #include "ccmcp/vector/embedding_index.h"
+#include "ccmcp/vector/flat_vector_store.h"
+#include "ccmcp/vector/quantized_vector_store.h"
+#include "ccmcp/vector/vector_quantization.h"
 
+#include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
 
 // Forward-declare sqlite3 to avoid exposing the SQLite header in the public API.
@@ -23,13 +32,31 @@ namespace ccmcp::vector {
 // wired as --vector-backend lancedb; SqliteEmbeddingIndex remains available as a fallback.
 //
 // Storage: a standalone SQLite database at a caller-supplied file path.
-//   Schema: embedding_vectors(key TEXT PK, vector_blob BLOB, dimension INT,
-//                             metadata_json TEXT, created_at TEXT)
+//   Schema: embedding_vectors(namespace TEXT, key TEXT, vector_blob BLOB, dimension INT,
+//                             metadata_json TEXT, created_at TEXT,
+//                             PRIMARY KEY (namespace, key))
+//   Versioned with PRAGMA user_version (currently 1). A pre-namespace database (version 0,
+//   key TEXT PK) is migrated in place at open: "resume:<id>" rows move to the resume
+//   namespace, "opp:<id>" rows to opportunity and every other row to atom, with the
+//   prefix dropped from the key.
 //
 // Vectors are serialised as raw float32 bytes (native byte order) in the BLOB column.
 // The database is a derived, rebuildable store — canonical truth stays in atoms/SQLite.
 //
-// Query: full-scan cosine similarity, identical algorithm to InMemoryEmbeddingIndex.
+// Resident mirror: the table is loaded once at open into one FlatVectorStore per namespace
+// (the layout InMemoryEmbeddingIndex uses) and kept coherent by upsert(); query() and get()
+// read the namespace's mirror and never scan the table or other namespaces. SQLite stays
+// the source of truth: before each read the connection's PRAGMA data_version is checked,
+// and a commit by any other connection or process triggers a full reload. Memory cost is
+// one copy of every stored vector.
+//
+// Quantized mirror (QuantizationConfig::mode == kInt8, --vector-quantization int8): the
+// mirror holds int8 codes instead (QuantizedVectorStore, about 4× smaller). query() scans
+// the codes for rerank_factor · top_k candidates, reads their float32 vectors from the
+// table by primary key and reranks them with exact cosine similarity, so reported scores
+// and tie-breaking are unchanged; get() reads the table.
+//
+// Query: exact math::cosine_similarity(), identical scores to InMemoryEmbeddingIndex.
 //   Tie-breaking: |score_a - score_b| <= 1e-9 → lexicographic key order (ascending).
 //
 // Thread safety: single-threaded (one connection per instance), same model as all
@@ -38,7 +65,17 @@ class SqliteEmbeddingIndex final : public IEmbeddingIndex {
  public:
   // Opens or creates the SQLite database at db_path and ensures the schema is applied.
   // Throws std::runtime_error if the database cannot be opened or schema setup fails.
-  explicit SqliteEmbeddingIndex(const std::string& db_path);
+  using IEmbeddingIndex::get;
+  using IEmbeddingIndex::query;
+  using IEmbeddingIndex::query_batch;
+  using IEmbeddingIndex::upsert;
+  using IEmbeddingIndex::upsert_many;
+
+  // tuning is applied to the connection before the schema; without it the connection keeps
+  // SQLite's defaults, as in storage::sqlite::SqliteDb::open().
+  explicit SqliteEmbeddingIndex(const std::string& db_path,
+                                QuantizationConfig quantization = {},
+                                const std::optional<storage::SqliteTuning>& tuning = std::nullopt);
 
   // Defined in the .cpp so that the sqlite3 destructor is invoked where the type is complete.
   ~SqliteEmbeddingIndex();
@@ -48,15 +85,29 @@ class SqliteEmbeddingIndex final : public IEmbeddingIndex {
   SqliteEmbeddingIndex(SqliteEmbeddingIndex&&) = delete;
   SqliteEmbeddingIndex& operator=(SqliteEmbeddingIndex&&) = delete;
 
-  // Inserts or replaces the vector for key. Silent on failure (matches in-memory semantics).
-  void upsert(const VectorKey& key, const Vector& embedding, const std::string& metadata) override;
+  // Inserts or replaces the vector for key, then updates the mirror.
+  // Silent on failure (matches in-memory semantics); the mirror is only updated on success.
+  void upsert(VectorNamespace ns, const VectorKey& key, const Vector& embedding,
+              const std::string& metadata) override;
+
+  // Writes every record in one transaction through a single prepared statement, then
+  // updates the mirror. All or nothing: on any failure the transaction is rolled back and
+  // the mirror is left untouched (silent, like upsert()).
+  void upsert_many(VectorNamespace ns, std::span<const VectorRecord> records) override;
 
   // Returns top_k results sorted by cosine similarity (desc), tie-broken by key (asc).
-  [[nodiscard]] std::vector<VectorSearchResult> query(const Vector& query_vector,
+  [[nodiscard]] std::vector<VectorSearchResult> query(VectorNamespace ns,
+                                                      const Vector& query_vector,
                                                       size_t top_k) const override;
 
+  // Refreshes the mirror once, then scores every query against it (one query() per vector
+  // in int8 mode).
+  [[nodiscard]] std::vector<std::vector<VectorSearchResult>> query_batch(
+      VectorNamespace ns, std::span<const Vector> queries, size_t top_k) const override;
+
   // Returns the stored embedding for key, or nullopt if not found.
-  [[nodiscard]] std::optional<Vector> get(const VectorKey& key) const override;
+  [[nodiscard]] std::optional<Vector> get(VectorNamespace ns,
+                                          const VectorKey& key) const override;
 
  private:
   struct DbDeleter {
@@ -64,18 +115,56 @@ class SqliteEmbeddingIndex final : public IEmbeddingIndex {
   };
 
   std::unique_ptr<sqlite3, DbDeleter> db_;
+  QuantizationConfig quantization_;
+
+  // Resident copy of one namespace. Exactly one of the two is populated, according to
+  // quantization_.mode.
+  struct Segment {
+    FlatVectorStore flat;             // NOLINT(readability-identifier-naming)
+    QuantizedVectorStore quantized;  // NOLINT(readability-identifier-naming)
+  };
+  using SegmentMap = std::map<std::string, Segment, std::less<>>;
+
+  // Resident copy of embedding_vectors, by namespace; every read is served from it.
+  mutable SegmentMap segments_;
+  // PRAGMA data_version observed when the mirror was loaded.
+  mutable std::int64_t data_version_{-1};
 
-  // Creates the embedding_vectors table if absent.
+  // Creates the embedding_vectors table if absent and migrates a pre-namespace table.
+  // Throws std::runtime_error on failure or on a newer schema version.
   void ensure_schema();
 
-  // Cosine similarity; returns 0.0 on dimension mismatch or zero-magnitude vector.
-  [[nodiscard]] static double cosine_similarity(const Vector& a, const Vector& b);
+  // Runs a statement without results (BEGIN / COMMIT / ROLLBACK). Returns true on success.
+  [[nodiscard]] bool exec(const char* sql) const;
+
+  // Applies a committed row to whichever store of segment is in use.
+  void apply(Segment& segment, const VectorKey& key, const Vector& embedding,
+             const std::string& metadata) const;
+
+  // Mirror of namespace ns, or nullptr if it holds no rows.
+  [[nodiscard]] const Segment* find_segment(VectorNamespace ns) const;
+
+  // int8 mode: exact rerank of the quantized scan's candidates within namespace ns.
+  [[nodiscard]] std::vector<VectorSearchResult> query_quantized(VectorNamespace ns,
+                                                                const Segment& segment,
+                                                                const Vector& query_vector,
+                                                                size_t top_k) const;
+
+  // Reads the stored float32 vector of (ns, key) from the table.
+  [[nodiscard]] std::optional<Vector> read_vector(VectorNamespace ns, const VectorKey& key) const;
+
+  // Reloads the mirror if another connection committed since it was loaded.
+  void refresh_mirror() const;
+
+  // Replaces the mirror with the table contents (scanned in key order). Returns false,
+  // leaving it untouched, if the scan fails.
+  [[nodiscard]] bool load_mirror() const;
 
-  // Serialise a Vector to raw float32 bytes (native byte order).
-  [[nodiscard]] static std::vector<std::byte> to_blob(const Vector& v);
+  // PRAGMA data_version of this connection, or -1 if it cannot be read.
+  [[nodiscard]] std::int64_t read_data_version() const;
 
-  // Deserialise raw float32 bytes to a Vector.
-  [[nodiscard]] static Vector from_blob(const void* data, int size_bytes);
+  // Deserialise raw float32 bytes into out, reusing its capacity.
+  static void decode_blob_into(const void* data, int size_bytes, Vector& out);
 };
 
 }  // namespace ccmcp::vector
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "ccmcp/vector/embedding_index.h"
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace ccmcp::vector {
+
+// Scores closer than this are treated as equal and ordered by key instead.
+inline constexpr double kScoreTieEpsilon = 1e-9;
+
+// ranks_before is the result order shared by every IEmbeddingIndex implementation:
+// score descending, then key ascending when |score_a - score_b| <= kScoreTieEpsilon.
+[[nodiscard]] inline bool ranks_before(double score_a, std::string_view key_a, double score_b,
+                                       std::string_view key_b) noexcept {
+  if (score_a - score_b > kScoreTieEpsilon || score_b - score_a > kScoreTieEpsilon) {
+    return score_a > score_b;
+  }
+  return key_a < key_b;
+}
+
+// TopKSelector keeps the best top_k results of a streaming scan in a bounded heap.
+//
+// Callers test a candidate with accepts() using borrowed key storage and only build (copy)
+// a VectorSearchResult when it would survive, so a scan over n vectors allocates O(top_k)
+// strings instead of O(n). The heap root is always the worst kept result.
+class TopKSelector {
+ public:
+  explicit TopKSelector(std::size_t top_k);
+
+  // accepts returns true if a candidate with (score, key) would enter the current top-k.
+  [[nodiscard]] bool accepts(double score, std::string_view key) const noexcept;
+
+  // push inserts result, evicting the worst kept result when full. Results that accepts()
+  // would reject are ignored.
+  void push(VectorSearchResult result);
+
+  // take_sorted returns the kept results in ranks_before() order and empties the selector.
+  [[nodiscard]] std::vector<VectorSearchResult> take_sorted();
+
+ private:
+  std::size_t top_k_;
+  std::vector<VectorSearchResult> heap_;  // max-heap under ranks_before: root ranks last
+};
+
+}  // namespace ccmcp::vector
@@ -10,7 +10,7 @@
 // update all switch sites or receive a compile-time diagnostic.
 //
 // CLI flag: --vector-backend <value>
-// Valid runtime values: "inmemory", "sqlite"
+// Valid runtime values: "inmemory", "sqlite", "hnsw", "mmap"
 // Reserved (fail-fast): "lancedb"
 
 #include <cstdint>
@@ -26,10 +26,12 @@ namespace ccmcp::vector {
 // Requesting --vector-backend lancedb fails fast at startup with an actionable message.
 // Use kSqlite for persistent vector storage.
 //
-// uint8_t base type: three enumerators fit in one byte; no reason to pay for int.
+// uint8_t base type: the enumerators fit in one byte; no reason to pay for int.
 enum class VectorBackend : uint8_t {
   kInMemory,  // "inmemory" — InMemoryEmbeddingIndex (ephemeral, default)
   kSqlite,    // "sqlite"   — SqliteEmbeddingIndex   (persistent, requires --vector-db-path)
+  kHnsw,      // "hnsw"     — HnswEmbeddingIndex     (approximate, requires --vector-db-path)
+  kMmap,      // "mmap"     — MmapEmbeddingIndex     (memory-mapped, requires --vector-db-path)
   kLanceDb,   // "lancedb"  — RESERVED: not yet implemented; process exits on startup
 };
 
@@ -43,6 +45,12 @@ enum class VectorBackend : uint8_t {
   if (s == "sqlite") {
     return VectorBackend::kSqlite;
   }
+  if (s == "hnsw") {
+    return VectorBackend::kHnsw;
+  }
+  if (s == "mmap") {
+    return VectorBackend::kMmap;
+  }
   if (s == "lancedb") {
     return VectorBackend::kLanceDb;
   }
@@ -57,6 +65,10 @@ enum class VectorBackend : uint8_t {
       return "inmemory";
     case VectorBackend::kSqlite:
       return "sqlite";
+    case VectorBackend::kHnsw:
+      return "hnsw";
+    case VectorBackend::kMmap:
+      return "mmap";
     case VectorBackend::kLanceDb:
       return "lancedb";
   }
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "ccmcp/vector/embedding_index.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace ccmcp::vector::math {
+
+// Vector-math kernels shared by every exact and approximate backend.
+//
+// Each kernel multiplies in float, widens the product to double and accumulates it into
+// one of kLanes double lanes (element i goes to lane i % kLanes); the lanes are then summed
+// in a fixed pairwise tree. The SSE4.2, AVX2 and AVX-512 kernels implement exactly that
+// order with wider registers, so every ISA returns bit-identical results and a score never
+// depends on which CPU served the query.
+//
+// The int8 kernels (dot_i8, dot_i8_many) serve the quantized index: products of int8 codes
+// are summed exactly in int32, so their result is independent of order and ISA by
+// construction. Sums stay exact while n · 127² < 2³¹, i.e. up to 133,000 elements.
+//
+// The kernel set is selected once, on first use, from cpuid; the scalar kernels are the
+// fallback on other architectures and compilers.
+
+// Accumulator lanes of the fixed reduction order.
+inline constexpr std::size_t kLanes = 16;
+
+enum class Isa : std::uint8_t {
+  kScalar,
+  kSse42,
+  kAvx2,
+  kAvx512,
+};
+
+[[nodiscard]] std::string_view to_string(Isa isa) noexcept;
+
+// Σ a[i]·b[i] over n elements.
+using DotFn = double (*)(const float* a, const float* b, std::size_t n);
+// out[r] = dot(query, rows + r·stride, dim) for r in [0, count).
+using DotManyFn = void (*)(const float* query, const float* rows, std::size_t stride,
+                           std::size_t count, std::size_t dim, double* out);
+
+// Σ a[i]·b[i] over n int8 elements, exact in int32.
+using DotI8Fn = std::int32_t (*)(const std::int8_t* a, const std::int8_t* b, std::size_t n);
+// out[r] = dot_i8(query, rows + r·stride, dim) for r in [0, count); stride in bytes.
+using DotI8ManyFn = void (*)(const std::int8_t* query, const std::int8_t* rows,
+                             std::size_t stride, std::size_t count, std::size_t dim,
+                             std::int32_t* out);
+
+// Function table of one instruction set.
+struct Kernels {
+  Isa isa;                  // NOLINT(readability-identifier-naming)
+  DotFn dot;                // NOLINT(readability-identifier-naming)
+  DotManyFn dot_many;       // NOLINT(readability-identifier-naming)
+  DotI8Fn dot_i8;           // NOLINT(readability-identifier-naming)
+  DotI8ManyFn dot_i8_many;  // NOLINT(readability-identifier-naming)
+};
+
+// The best kernel set this CPU supports (selected once, thread-safe).
+[[nodiscard]] const Kernels& kernels() noexcept;
+
+// The kernel set of one ISA, or nullptr when this build or CPU cannot run it.
+// Used by tests and benchmarks to compare ISAs against the scalar reference.
+[[nodiscard]] const Kernels* kernels_for(Isa isa) noexcept;
+
+[[nodiscard]] inline double dot(const float* a, const float* b, std::size_t n) {
+  return kernels().dot(a, b, n);
+}
+
+// Euclidean norm, sqrt(dot(v, v, n)).
+[[nodiscard]] double l2_norm(const float* v, std::size_t n);
+
+inline void dot_many(const float* query, const float* rows, std::size_t stride,
+                     std::size_t count, std::size_t dim, double* out) {
+  kernels().dot_many(query, rows, stride, count, dim, out);
+}
+
+[[nodiscard]] inline std::int32_t dot_i8(const std::int8_t* a, const std::int8_t* b,
+                                         std::size_t n) {
+  return kernels().dot_i8(a, b, n);
+}
+
+inline void dot_i8_many(const std::int8_t* query, const std::int8_t* rows, std::size_t stride,
+                        std::size_t count, std::size_t dim, std::int32_t* out) {
+  kernels().dot_i8_many(query, rows, stride, count, dim, out);
+}
+
+// Row bytes per tile of dot_block(): small enough that a tile stays in L2 while every query
+// of the block is scored against it.
+inline constexpr std::size_t kBlockTileBytes = std::size_t{128} * 1024;
+
+// Scores a block of queries against a block of rows:
+//   out[q·count + r] = dot(queries[q], rows + r·stride, dim)
+// for q in [0, num_queries) and r in [0, count). Rows are visited in tiles of at most
+// kBlockTileBytes and every query is scored against a tile before the next one is read, so
+// each row is loaded from memory once per call instead of once per query. Each value is
+// bit-identical to dot_many() for that query alone.
+void dot_block(const float* const* queries, std::size_t num_queries, const float* rows,
+               std::size_t stride, std::size_t count, std::size_t dim, double* out);
+
+// dot / (norm_a · norm_b); 0.0 when either norm is zero.
+[[nodiscard]] inline double cosine_from_dot(double dot_product, double norm_a, double norm_b) {
+  if (norm_a == 0.0 || norm_b == 0.0) {
+    return 0.0;
+  }
+  return dot_product / (norm_a * norm_b);
+}
+
+// Cosine similarity of two vectors; 0.0 for empty vectors, mismatched dimensions or a zero
+// vector. This is the score every IEmbeddingIndex backend reports.
+[[nodiscard]] double cosine_similarity(const Vector& a, const Vector& b);
+
+}  // namespace ccmcp::vector::math
@@ -0,0 +1,65 @@
+#pragma once
+
+// VectorQuantization — vocabulary for the --vector-quantization flag.
+//
+// CLI flags: --vector-quantization <value>, --vector-rerank-factor <n>
+// Valid values: "none", "int8"
+//
+// Quantization applies to --vector-backend sqlite only: the resident mirror holds int8 codes
+// (QuantizedVectorStore) and the exact float32 vectors stay in the database, where the rerank
+// reads them. Backends whose only copy of a vector is in memory have nothing to rerank from,
+// so startup rejects the combination.
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace ccmcp::vector {
+
+// uint8_t base type: the enumerators fit in one byte; no reason to pay for int.
+enum class VectorQuantization : uint8_t {
+  kNone,  // "none" — float32 mirror, exact scan (default)
+  kInt8,  // "int8" — int8 mirror, approximate scan, exact rerank of the candidates
+};
+
+// Default multiple of top_k reranked with exact cosine in int8 mode.
+inline constexpr std::size_t kDefaultRerankFactor = 4;
+
+// QuantizationConfig selects the resident representation of a vector index.
+//
+// In int8 mode a query scans the int8 codes for the best rerank_factor · top_k candidates,
+// rescores them with exact math::cosine_similarity() on the stored float32 vectors, and
+// returns the best top_k in ranks_before() order. Scores are therefore exact; only a true
+// neighbour that the int8 scan ranks below the candidate cut can be missed.
+struct QuantizationConfig {
+  VectorQuantization mode{VectorQuantization::kNone};  // NOLINT(readability-identifier-naming)
+  std::size_t rerank_factor{kDefaultRerankFactor};     // NOLINT(readability-identifier-naming)
+};
+
+// parse_vector_quantization parses a --vector-quantization flag value.
+// Returns std::nullopt for unrecognised values (including empty string). Case-sensitive.
+[[nodiscard]] inline std::optional<VectorQuantization> parse_vector_quantization(
+    const std::string& s) {
+  if (s == "none") {
+    return VectorQuantization::kNone;
+  }
+  if (s == "int8") {
+    return VectorQuantization::kInt8;
+  }
+  return std::nullopt;
+}
+
+// to_string returns the canonical flag string for a VectorQuantization enumerator.
+[[nodiscard]] inline std::string_view to_string(VectorQuantization q) {
+  switch (q) {
+    case VectorQuantization::kNone:
+      return "none";
+    case VectorQuantization::kInt8:
+      return "int8";
+  }
+  return "unknown";  // unreachable — all enumerators covered above
+}
+
+}  // namespace ccmcp::vector
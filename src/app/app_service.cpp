@@ -10,14 +10,19 @@
 #include "ccmcp/ingest/ingest_result.h"
 
 #include <algorithm>
+#include <fstream>
+#include <memory>
 #include <optional>
 #include <set>
 #include <stdexcept>
+#include <string>
+#include <utility>
 
 namespace ccmcp::app {
 
 MatchPipelineResponse run_match_pipeline(const MatchPipelineRequest& req, core::Services& services,
-                                         core::IIdGenerator& id_gen, core::IClock& clock) {
+                                         core::IIdGenerator& id_gen, core::IClock& clock,
+                                         matching::CorpusSnapshotCache* corpus_cache) {
   // Generate or use provided trace_id
   const std::string trace_id = req.trace_id.value_or(core::TraceId{id_gen.next("trace")}.value);
 
@@ -46,11 +51,13 @@ MatchPipelineResponse run_match_pipeline(const MatchPipelineRequest& req, core::
     throw std::invalid_argument("Must provide either opportunity or opportunity_id");
   }
 
-  // Resolve atoms
-  std::vector<domain::ExperienceAtom> atoms;
+  // Resolve atoms into a corpus snapshot
+  std::shared_ptr<const matching::CorpusSnapshot> corpus;
   if (req.atoms.has_value()) {
-    atoms = req.atoms.value();
+    // Borrowing snapshot: req outlives this call, so the atoms are not copied
+    corpus = std::make_shared<const matching::CorpusSnapshot>(req.atoms.value());
   } else if (req.atom_ids.has_value()) {
+    std::vector<domain::ExperienceAtom> atoms;
     for (const auto& atom_id : req.atom_ids.value()) {
       auto opt_atom = services.atoms.get(atom_id);
       if (!opt_atom.has_value()) {
@@ -58,15 +65,20 @@ MatchPipelineResponse run_match_pipeline(const MatchPipelineRequest& req, core::
       }
       atoms.push_back(opt_atom.value());
     }
+    corpus = std::make_shared<const matching::CorpusSnapshot>(std::move(atoms), 0);
+  } else if (corpus_cache != nullptr) {
+    // Default: all verified atoms, shared across requests until the corpus version changes
+    corpus = corpus_cache->get(services.atoms);
   } else {
     // Default: use all verified atoms
-    atoms = services.atoms.list_verified();
+    corpus = std::make_shared<const matching::CorpusSnapshot>(services.atoms.list_verified(),
+                                                              services.atoms.corpus_version());
   }
 
   // Run matcher
   matching::Matcher matcher(matching::ScoreWeights{}, req.strategy);
   const auto match_report =
-      matcher.evaluate(opportunity, atoms, &services.embedding_provider, &services.vector_index);
+      matcher.evaluate(opportunity, *corpus, &services.embedding_provider, &services.vector_index);
 
   // Emit MatchCompleted event
   services.audit_log.append({id_gen.next("evt"),
@@ -97,6 +109,85 @@ MatchPipelineResponse run_match_pipeline(const MatchPipelineRequest& req, core::
   };
 }
 
+MatchBatchPipelineResponse run_match_batch_pipeline(const MatchBatchPipelineRequest& req,
+                                                    core::Services& services,
+                                                    core::IIdGenerator& id_gen,
+                                                    core::IClock& clock,
+                                                    matching::CorpusSnapshotCache* corpus_cache,
+                                                    core::ThreadPool* pool) {
+  // Generate or use provided trace_id
+  const std::string trace_id = req.trace_id.value_or(core::TraceId{id_gen.next("trace")}.value);
+
+  // Resolve opportunities before emitting anything, so a bad id fails the whole batch
+  std::vector<domain::Opportunity> opportunities;
+  if (req.opportunity_ids.empty()) {
+    opportunities = services.opportunities.list_all();
+  } else {
+    auto found = services.opportunities.get_many(req.opportunity_ids);
+    opportunities.reserve(found.size());
+    for (std::size_t i = 0; i < found.size(); ++i) {
+      if (!found[i].has_value()) {
+        throw std::invalid_argument("Opportunity not found: " + req.opportunity_ids[i].value);
+      }
+      opportunities.push_back(std::move(found[i].value()));
+    }
+  }
+
+  services.audit_log.append({id_gen.next("evt"),
+                             trace_id,
+                             "RunStarted",
+                             R"({"source":"app_service","operation":"match_batch_pipeline",)"
+                             R"("opportunity_count":)" +
+                                 std::to_string(opportunities.size()) + "}",
+                             clock.now_iso8601(),
+                             {}});
+
+  // Resolve the verified-atom corpus once for the whole batch
+  const std::shared_ptr<const matching::CorpusSnapshot> corpus =
+      corpus_cache != nullptr
+          ? corpus_cache->get(services.atoms)
+          : std::make_shared<const matching::CorpusSnapshot>(services.atoms.list_verified(),
+                                                             services.atoms.corpus_version());
+
+  // Run matcher
+  const matching::HybridConfig hybrid_config{.k_lexical = req.k_lex, .k_embedding = req.k_emb};
+  matching::Matcher matcher(matching::ScoreWeights{}, req.strategy, hybrid_config, pool);
+  auto reports = matcher.evaluate_batch(opportunities, *corpus, &services.embedding_provider,
+                                        &services.vector_index);
+
+  MatchBatchPipelineResponse response;
+  response.trace_id = trace_id;
+  response.results.reserve(reports.size());
+  for (auto& match_report : reports) {
+    services.audit_log.append({id_gen.next("evt"),
+                               trace_id,
+                               "MatchCompleted",
+                               R"({"opportunity_id":")" + match_report.opportunity_id.value +
+                                   R"(","overall_score":)" +
+                                   std::to_string(match_report.overall_score) + "}",
+                               clock.now_iso8601(),
+                               {match_report.opportunity_id.value}});
+
+    auto validation_report =
+        run_validation_pipeline(match_report, services, id_gen, clock, trace_id);
+
+    response.results.push_back(MatchPipelineResponse{
+        .trace_id = trace_id,
+        .match_report = std::move(match_report),
+        .validation_report = std::move(validation_report),
+    });
+  }
+
+  services.audit_log.append({id_gen.next("evt"),
+                             trace_id,
+                             "RunCompleted",
+                             R"({"status":"success"})",
+                             clock.now_iso8601(),
+                             {}});
+
+  return response;
+}
+
 constitution::ValidationReport run_validation_pipeline(
     const domain::MatchReport& report, core::Services& services, core::IIdGenerator& id_gen,
     core::IClock& clock, const std::string& trace_id,
@@ -400,6 +491,47 @@ IngestResumePipelineResponse run_ingest_resume_pipeline(const IngestResumePipeli
   };
 }
 
+BulkImportPipelineResponse run_bulk_import_pipeline(const BulkImportPipelineRequest& req,
+                                                    core::Services& services,
+                                                    core::IIdGenerator& id_gen,
+                                                    core::IClock& clock) {
+  const std::string trace_id = req.trace_id.value_or(core::TraceId{id_gen.next("trace")}.value);
+
+  std::ifstream input(req.input_path);
+  if (!input) {
+    throw std::runtime_error("Cannot open bulk import file: " + req.input_path);
+  }
+
+  services.audit_log.append(
+      {id_gen.next("evt"),
+       trace_id,
+       "BulkImportStarted",
+       R"({"source":"app_service","operation":"bulk_import","batch_size":)" +
+           std::to_string(req.batch_size) + "}",
+       clock.now_iso8601(),
+       {}});
+
+  ingest::BulkImportOptions options;
+  options.batch_size = req.batch_size;
+  auto result = ingest::import_jsonl(input, services.atoms, services.opportunities, options);
+
+  services.audit_log.append({id_gen.next("evt"),
+                             trace_id,
+                             "BulkImportCompleted",
+                             R"({"lines_read":)" + std::to_string(result.lines_read) +
+                                 R"(,"atoms_imported":)" + std::to_string(result.atoms_imported) +
+                                 R"(,"opportunities_imported":)" +
+                                 std::to_string(result.opportunities_imported) +
+                                 R"(,"error_count":)" + std::to_string(result.error_count) + "}",
+                             clock.now_iso8601(),
+                             {}});
+
+  return BulkImportPipelineResponse{
+      .result = std::move(result),
+      .trace_id = trace_id,
+  };
+}
+
 IndexBuildPipelineResponse run_index_build_pipeline(
     const IndexBuildPipelineRequest& req, ingest::IResumeStore& resume_store,
     indexing::IIndexRunStore& index_run_store, core::Services& services,
@@ -414,7 +546,8 @@ IndexBuildPipelineResponse run_index_build_pipeline(
        clock.now_iso8601(),
        {}});
 
-  const indexing::IndexBuildConfig build_config{req.scope, provider_id, "", ""};
+  const indexing::IndexBuildConfig build_config{req.scope, provider_id, "", "",
+                                                indexing::kDefaultIndexBatchSize, req.jobs};
   const auto result =
       indexing::run_index_build(services.atoms, resume_store, services.opportunities,
                                 index_run_store, services.vector_index, services.embedding_provider,
@@ -0,0 +1,184 @@
+#include "ccmcp/core/thread_pool.h"
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+namespace ccmcp::core {
+
+namespace {
+
+// Index of the pool worker running on this thread (npos outside any pool).
+constexpr std::size_t kNotAWorker = static_cast<std::size_t>(-1);
+thread_local const ThreadPool* tls_pool = nullptr;
+thread_local std::size_t tls_worker_index = kNotAWorker;
+
+}  // namespace
+
+ThreadPool::ThreadPool(std::size_t num_threads) {
+  if (num_threads == 0) {
+    num_threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  }
+
+  queues_.reserve(num_threads);
+  for (std::size_t i = 0; i < num_threads; ++i) {
+    queues_.push_back(std::make_unique<WorkerQueue>());
+  }
+  workers_.reserve(num_threads);
+  for (std::size_t i = 0; i < num_threads; ++i) {
+    workers_.emplace_back([this, i]() { worker_loop(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+  // Workers push onto their own deque; external threads spread tasks round-robin.
+  const std::size_t target = (tls_pool == this && tls_worker_index != kNotAWorker)
+                                 ? tls_worker_index
+                                 : next_queue_.fetch_add(1, std::memory_order_relaxed) %
+                                       queues_.size();
+  {
+    // Count the task before it becomes visible so pending_ never underflows, and do it
+    // under sleep_mutex_ so a worker between its predicate check and wait() cannot miss
+    // the notification.
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    pending_.fetch_add(1, std::memory_order_release);
+  }
+  {
+    std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+    queues_[target]->tasks.push_back(std::move(task));
+  }
+  wake_.notify_one();
+}
+
+bool ThreadPool::try_pop(const std::size_t preferred, std::function<void()>& task) {
+  const std::size_t n = queues_.size();
+
+  // Own queue first (newest task), then steal the oldest task from the others.
+  if (preferred < n) {
+    auto& own = *queues_[preferred];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+      pending_.fetch_sub(1, std::memory_order_acq_rel);
+      return true;
+    }
+  }
+  const std::size_t start = preferred < n ? preferred + 1 : 0;
+  for (std::size_t k = 0; k < n; ++k) {
+    auto& victim = *queues_[(start + k) % n];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      pending_.fetch_sub(1, std::memory_order_acq_rel);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ThreadPool::run_one(const std::size_t preferred) {
+  std::function<void()> task;
+  if (!try_pop(preferred, task)) {
+    return false;
+  }
+  try {
+    task();
+  } catch (...) {
+    // submit() contract: fire-and-forget tasks must not take down the worker.
+  }
+  return true;
+}
+
+void ThreadPool::worker_loop(const std::size_t index) {
+  tls_pool = this;
+  tls_worker_index = index;
+
+  for (;;) {
+    if (run_one(index)) {
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    wake_.wait(lock, [this]() {
+      return stopping_ || pending_.load(std::memory_order_acquire) > 0;
+    });
+    if (stopping_ && pending_.load(std::memory_order_acquire) == 0) {
+      return;
+    }
+  }
+}
+
+void ThreadPool::parallel_for(const std::size_t count, std::size_t grain,
+                              const std::function<void(std::size_t, std::size_t)>& body) {
+  if (count == 0) {
+    return;
+  }
+  grain = std::max<std::size_t>(1, grain);
+  const std::size_t chunks = (count + grain - 1) / grain;
+  if (chunks == 1) {
+    body(0, count);
+    return;
+  }
+
+  struct Shared {
+    std::atomic<std::size_t> remaining;
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    std::mutex done_mutex;
+    std::condition_variable done;  // signalled when remaining reaches 0
+  };
+  auto shared = std::make_shared<Shared>();
+  shared->remaining.store(chunks, std::memory_order_relaxed);
+
+  for (std::size_t c = 0; c < chunks; ++c) {
+    const std::size_t begin = c * grain;
+    const std::size_t end = std::min(count, begin + grain);
+    submit([shared, &body, begin, end]() {
+      try {
+        body(begin, end);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(shared->error_mutex);
+        if (!shared->error) {
+          shared->error = std::current_exception();
+        }
+      }
+      if (shared->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        // Notify under the lock so a caller between its predicate check and wait() cannot
+        // miss the last chunk.
+        std::lock_guard<std::mutex> lock(shared->done_mutex);
+        shared->done.notify_all();
+      }
+    });
+  }
+
+  // Help while there is queued work (ours or anyone's). Once the queues are empty our
+  // remaining chunks are running on other threads, so sleep until the last one finishes;
+  // nested parallel_for() calls inside them run their own chunks if nobody else does.
+  const std::size_t self = (tls_pool == this) ? tls_worker_index : kNotAWorker;
+  while (shared->remaining.load(std::memory_order_acquire) > 0) {
+    if (run_one(self)) {
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(shared->done_mutex);
+    shared->done.wait(lock,
+                      [&]() { return shared->remaining.load(std::memory_order_acquire) == 0; });
+  }
+
+  if (shared->error) {
+    std::rethrow_exception(shared->error);
+  }
+}
+
+}  // namespace ccmcp::core
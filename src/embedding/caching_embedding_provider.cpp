@@ -0,0 +1,186 @@
+#include "ccmcp/embedding/caching_embedding_provider.h"
+
+#include "ccmcp/core/sha256.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace ccmcp::embedding {
+
+CachingEmbeddingProvider::CachingEmbeddingProvider(const IEmbeddingProvider& inner,
+                                                   std::string provider_id, std::string model_id,
+                                                   IEmbeddingCacheStore* store,
+                                                   std::size_t capacity)
+    : inner_(inner),
+      provider_id_(std::move(provider_id)),
+      model_id_(std::move(model_id)),
+      store_(store),
+      capacity_(capacity) {}
+
+vector::Vector CachingEmbeddingProvider::embed_text(std::string_view text) const {
+  if (inner_.dimension() == 0) {
+    return inner_.embed_text(text);  // nothing worth caching
+  }
+
+  const EmbeddingCacheKey key{provider_id_, model_id_, core::sha256_hex(text)};
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto cached = lookup_memory_locked(key.text_hash);
+    if (cached.has_value()) {
+      return std::move(*cached);
+    }
+  }
+
+  // Store I/O and inference run unlocked; concurrent misses on the same text compute the
+  // same vector.
+  if (auto stored = load_stored(key)) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.store_hits;
+    remember(key.text_hash, *stored);
+    return std::move(*stored);
+  }
+
+  vector::Vector embedding = inner_.embed_text(text);
+  if (store_ != nullptr) {
+    store_->put(key, embedding);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++stats_.misses;
+  remember(key.text_hash, embedding);
+  return embedding;
+}
+
+void CachingEmbeddingProvider::embed_batch(std::span<const std::string_view> texts,
+                                           std::span<float> out) const {
+  const std::size_t dim = inner_.dimension();
+  if (dim == 0) {
+    inner_.embed_batch(texts, out);
+    return;
+  }
+  if (out.size() != texts.size() * dim) {
+    throw std::invalid_argument("embed_batch: output size does not match texts x dimension");
+  }
+
+  std::vector<EmbeddingCacheKey> keys;
+  keys.reserve(texts.size());
+  for (const auto text : texts) {
+    keys.push_back(EmbeddingCacheKey{provider_id_, model_id_, core::sha256_hex(text)});
+  }
+
+  std::vector<std::size_t> pending;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (std::size_t i = 0; i < texts.size(); ++i) {
+      const auto cached = lookup_memory_locked(keys[i].text_hash);
+      if (cached.has_value()) {
+        std::copy(cached->begin(), cached->end(), out.begin() + i * dim);
+      } else {
+        pending.push_back(i);
+      }
+    }
+  }
+  if (pending.empty()) {
+    return;
+  }
+
+  // The store is read unlocked; only the LRU update takes the lock.
+  std::vector<std::size_t> misses;
+  std::vector<std::pair<std::size_t, vector::Vector>> stored_hits;
+  for (const std::size_t i : pending) {
+    if (auto stored = load_stored(keys[i])) {
+      std::copy(stored->begin(), stored->end(), out.begin() + i * dim);
+      stored_hits.emplace_back(i, std::move(*stored));
+    } else {
+      misses.push_back(i);
+    }
+  }
+  if (!stored_hits.empty()) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.store_hits += stored_hits.size();
+    for (const auto& [i, embedding] : stored_hits) {
+      remember(keys[i].text_hash, embedding);
+    }
+  }
+  if (misses.empty()) {
+    return;
+  }
+
+  std::vector<std::string_view> miss_texts;
+  miss_texts.reserve(misses.size());
+  for (const std::size_t i : misses) {
+    miss_texts.push_back(texts[i]);
+  }
+  std::vector<float> computed(misses.size() * dim);
+  inner_.embed_batch(miss_texts, computed);  // unlocked, as in embed_text()
+
+  std::vector<EmbeddingCacheKey> miss_keys;
+  std::vector<vector::Vector> embeddings;
+  miss_keys.reserve(misses.size());
+  embeddings.reserve(misses.size());
+  for (std::size_t m = 0; m < misses.size(); ++m) {
+    const auto row = computed.begin() + m * dim;
+    std::copy(row, row + dim, out.begin() + misses[m] * dim);
+    miss_keys.push_back(std::move(keys[misses[m]]));
+    embeddings.emplace_back(row, row + dim);
+  }
+  if (store_ != nullptr) {
+    store_->put_many(miss_keys, embeddings);  // one write for the whole batch
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.misses += misses.size();
+  for (std::size_t m = 0; m < misses.size(); ++m) {
+    remember(miss_keys[m].text_hash, embeddings[m]);
+  }
+}
+
+CachingEmbeddingProviderStats CachingEmbeddingProvider::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+std::optional<vector::Vector> CachingEmbeddingProvider::lookup_memory_locked(
+    const std::string& text_hash) const {
+  const auto it = lru_index_.find(text_hash);
+  if (it == lru_index_.end()) {
+    return std::nullopt;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second);
+  ++stats_.memory_hits;
+  return it->second->second;
+}
+
+std::optional<vector::Vector> CachingEmbeddingProvider::load_stored(
+    const EmbeddingCacheKey& key) const {
+  if (store_ == nullptr) {
+    return std::nullopt;
+  }
+  auto stored = store_->get(key);
+  if (!stored.has_value() || stored->size() != inner_.dimension()) {
+    return std::nullopt;
+  }
+  return stored;
+}
+
+void CachingEmbeddingProvider::remember(const std::string& text_hash,
+                                        const vector::Vector& embedding) const {
+  if (capacity_ == 0) {
+    return;
+  }
+  const auto it = lru_index_.find(text_hash);
+  if (it != lru_index_.end()) {
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return;
+  }
+  lru_.emplace_front(text_hash, embedding);
+  lru_index_.emplace(text_hash, lru_.begin());
+  if (lru_.size() > capacity_) {
+    lru_index_.erase(lru_.back().first);
+    lru_.pop_back();
+  }
+}
+
+}  // namespace ccmcp::embedding
@@ -1,13 +1,52 @@
-#include "ccmcp/core/hashing.h"
-#include "ccmcp/core/normalization.h"
 #include "ccmcp/embedding/embedding_provider.h"
+#include "ccmcp/vector/vector_math.h"
 
 #include <algorithm>
-#include <cmath>
-#include <map>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace ccmcp::embedding {
 
+namespace {
+
+// Tokens shorter than this are dropped, as by core::tokenize_ascii().
+constexpr std::size_t kMinTokenLength = 2;
+
+// Share of a token's count spread to each adjacent dimension.
+constexpr float kNeighbourWeight = 0.3f;
+
+// FNV-1a 64-bit, identical to core::stable_hash64() but fed one character at a time.
+constexpr std::uint64_t kFnvOffset = 14695981039346656037ull;
+constexpr std::uint64_t kFnvPrime = 1099511628211ull;
+
+void check_batch_shape(const std::size_t texts, const std::size_t dim, const std::size_t out) {
+  if (out != texts * dim) {
+    throw std::invalid_argument("embed_batch: output holds " + std::to_string(out) +
+                                " floats, expected " + std::to_string(texts) + " x " +
+                                std::to_string(dim));
+  }
+}
+
+}  // namespace
+
+void IEmbeddingProvider::embed_batch(std::span<const std::string_view> texts,
+                                     std::span<float> out) const {
+  const std::size_t dim = dimension();
+  check_batch_shape(texts.size(), dim, out.size());
+  for (std::size_t i = 0; i < texts.size(); ++i) {
+    const vector::Vector embedding = embed_text(texts[i]);
+    if (embedding.size() != dim) {
+      // A partial row would leave stale floats from the caller's buffer in place.
+      throw std::runtime_error("embed_batch: embed_text returned " +
+                               std::to_string(embedding.size()) + " floats for text " +
+                               std::to_string(i) + ", expected " + std::to_string(dim));
+    }
+    std::copy(embedding.begin(), embedding.end(), out.begin() + i * dim);
+  }
+}
+
 vector::Vector NullEmbeddingProvider::embed_text(std::string_view /* text */) const {
   return {};  // Empty vector disables embedding retrieval
 }
@@ -19,59 +58,73 @@ vector::Vector DeterministicStubEmbeddingProvider::embed_text(std::string_view t
   if (dimension_ == 0) {
     return {};
   }
+  vector::Vector embedding(dimension_);
+  embed_into(text, embedding.data());
+  return embedding;
+}
 
-  // Strategy: Generate deterministic vector from text statistics
-  // 1. Tokenize text
-  // 2. Compute token frequency histogram
-  // 3. Hash tokens to vector indices
-  // 4. Normalize to unit vector
-
-  vector::Vector embedding(dimension_, 0.0f);
-
-  // Tokenize
-  std::string text_str(text);
-  auto tokens = core::tokenize_ascii(text_str);
-
-  if (tokens.empty()) {
-    return embedding;  // Zero vector for empty text
+void DeterministicStubEmbeddingProvider::embed_batch(std::span<const std::string_view> texts,
+                                                     std::span<float> out) const {
+  check_batch_shape(texts.size(), dimension_, out.size());
+  for (std::size_t i = 0; i < texts.size(); ++i) {
+    embed_into(texts[i], out.data() + i * dimension_);
   }
+}
 
-  // Count token frequencies
-  std::map<std::string, int> token_counts;
-  for (const auto& token : tokens) {
-    token_counts[token]++;
+void DeterministicStubEmbeddingProvider::embed_into(std::string_view text, float* out) const {
+  // Strategy: Generate deterministic vector from text statistics
+  // 1. Tokenize text (lower-cased ASCII alphanumeric runs, as core::tokenize_ascii())
+  // 2. Hash each token to a vector index while scanning it
+  // 3. Add its occurrence there and kNeighbourWeight of it at the adjacent indices
+  // 4. Normalize to unit vector
+  //
+  // Occurrences are counted, not summed as weighted floats, so the result does not depend
+  // on token order and repeated tokens need no histogram: out holds the exact per-index
+  // count and `spread` the exact neighbour count until they are combined once at the end.
+  thread_local std::vector<float> spread;
+  spread.assign(dimension_, 0.0f);
+  std::fill_n(out, dimension_, 0.0f);
+
+  const auto count_token = [&](const std::uint64_t hash) {
+    const std::size_t idx = hash % dimension_;
+    out[idx] += 1.0f;
+    spread[(idx + dimension_ - 1) % dimension_] += 1.0f;
+    spread[(idx + 1) % dimension_] += 1.0f;
+  };
+
+  std::uint64_t hash = kFnvOffset;
+  std::size_t length = 0;
+  for (const char ch : text) {
+    char lower = ch;
+    if (ch >= 'A' && ch <= 'Z') {
+      lower = static_cast<char>(ch + ('a' - 'A'));
+    } else if (!((ch >= 'a' && ch <= 'z') || (ch >= '0' && ch <= '9'))) {
+      if (length >= kMinTokenLength) {
+        count_token(hash);
+      }
+      hash = kFnvOffset;
+      length = 0;
+      continue;
+    }
+    hash ^= static_cast<std::uint64_t>(static_cast<unsigned char>(lower));
+    hash *= kFnvPrime;
+    ++length;
   }
-
-  // Hash each token to vector indices and accumulate counts
-  for (const auto& [token, count] : token_counts) {
-    // Use deterministic hash to get vector index
-    uint64_t hash = core::stable_hash64(token);
-    size_t idx = hash % dimension_;
-
-    // Accumulate count at hashed position
-    embedding[idx] += static_cast<float>(count);
-
-    // Also spread to adjacent indices for smoothing (deterministic)
-    size_t idx_prev = (idx + dimension_ - 1) % dimension_;
-    size_t idx_next = (idx + 1) % dimension_;
-    embedding[idx_prev] += static_cast<float>(count) * 0.3f;
-    embedding[idx_next] += static_cast<float>(count) * 0.3f;
+  if (length >= kMinTokenLength) {
+    count_token(hash);
   }
 
-  // Normalize to unit vector (L2 norm)
-  float norm = 0.0f;
-  for (float val : embedding) {
-    norm += val * val;
+  for (std::size_t i = 0; i < dimension_; ++i) {
+    out[i] += spread[i] * kNeighbourWeight;
   }
 
+  // Normalize to unit vector (L2 norm); text without tokens stays the zero vector.
+  const auto norm = static_cast<float>(vector::math::l2_norm(out, dimension_));
   if (norm > 0.0f) {
-    norm = std::sqrt(norm);
-    for (float& val : embedding) {
-      val /= norm;
+    for (std::size_t i = 0; i < dimension_; ++i) {
+      out[i] /= norm;
     }
   }
-
-  return embedding;
 }
 
 }  // namespace ccmcp::embedding
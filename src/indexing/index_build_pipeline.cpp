@@ -1,11 +1,20 @@
 #include "ccmcp/indexing/index_build_pipeline.h"
 
 #include "ccmcp/core/hashing.h"
+#include "ccmcp/core/thread_pool.h"
 #include "ccmcp/storage/audit_event.h"
 
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <span>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace ccmcp::indexing {
 
@@ -46,6 +55,223 @@ void emit_audit(storage::IAuditLog& audit_log, core::IIdGenerator& id_gen,
   audit_log.append({id_gen.next("evt"), run_id, event_type, payload, timestamp, {}});
 }
 
+// Artifact types indexed by a scope; empty means every type ("all").
+std::vector<std::string> scope_artifact_types(const std::string& scope) {
+  if (scope == "atoms") {
+    return {"atom"};
+  }
+  if (scope == "resumes") {
+    return {"resume"};
+  }
+  if (scope == "opportunities") {
+    return {"opportunity"};
+  }
+  return {};
+}
+
+// Canonical form of one in-scope artifact.
+struct ArtifactSource {
+  std::string artifact_type;
+  std::string artifact_id;  // also the key in the vector index
+  vector::VectorNamespace vector_namespace;
+  std::string canonical_text;
+};
+
+// ArtifactIndexer runs drift detection per artifact against prior_states — the artifact states
+// prefetched once per run — and buffers the stale ones in batches of
+// config.batch_size. Each batch is embedded with IEmbeddingProvider::embed_batch() — one
+// call, or one per contiguous slice on the pool when config.jobs > 1 — and written with one
+// IEmbeddingIndex::upsert_many() call. A batch holds one namespace; the first artifact of
+// another namespace flushes it. Every write stays on the calling thread.
+// Index entries and IndexedArtifact events are recorded once an artifact's batch has been
+// written, in artifact order, so ids and audit order match an unbatched build. An artifact
+// whose text does not embed at full dimension (e.g. an empty vector) is skipped without an
+// entry, as in an unbatched build.
+class ArtifactIndexer {
+ public:
+  ArtifactIndexer(IIndexRunStore& run_store, vector::IEmbeddingIndex& vector_index,
+                  embedding::IEmbeddingProvider& embedding_provider,
+                  storage::IAuditLog& audit_log, core::IIdGenerator& id_gen, core::IClock& clock,
+                  const IndexBuildConfig& config, std::string run_id, core::ThreadPool* pool,
+                  ArtifactStateMap prior_states)
+      : run_store_(run_store),
+        vector_index_(vector_index),
+        embedding_provider_(embedding_provider),
+        audit_log_(audit_log),
+        id_gen_(id_gen),
+        clock_(clock),
+        config_(config),
+        batch_size_(std::max<std::size_t>(config.batch_size, 1)),
+        run_id_(std::move(run_id)),
+        pool_(pool),
+        prior_states_(std::move(prior_states)) {}
+
+  void add(const ArtifactSource& source) {
+    const std::string src_hash = core::stable_hash64_hex(source.canonical_text);
+
+    const auto prior =
+        prior_states_.find(artifact_state_key(source.artifact_type, source.artifact_id));
+    const bool has_prior = prior != prior_states_.end();
+
+    if (has_prior && prior->second.source_hash == src_hash) {
+      ++skipped_count_;
+      return;
+    }
+
+    if (embedding_provider_.dimension() == 0) {
+      // NullEmbeddingProvider: skip without recording an entry.
+      return;
+    }
+    if (source.vector_namespace != batch_namespace_) {
+      flush();
+      batch_namespace_ = source.vector_namespace;
+    }
+
+    pending_.push_back({source.artifact_type, source.artifact_id, src_hash, source.canonical_text,
+                        "", has_prior});
+    if (pending_.size() >= batch_size_) {
+      flush();
+    }
+  }
+
+  // Embeds and writes the buffered artifacts, then records their entries and audit events.
+  void flush() {
+    if (pending_.empty()) {
+      return;
+    }
+
+    const std::size_t dim = embedding_provider_.dimension();
+    texts_.clear();
+    for (const auto& artifact : pending_) {
+      texts_.push_back(artifact.canonical_text);
+    }
+    embeddings_.resize(pending_.size() * dim);
+    embedded_.assign(pending_.size(), true);
+    try {
+      embed_batch(dim);
+    } catch (const std::exception&) {
+      // Some text did not embed at full dimension (the default embed_batch() throws rather
+      // than leave a partial row). Embed one at a time and skip just those artifacts, as an
+      // empty embedding always has; an error that recurs here propagates.
+      embed_each(dim);
+    }
+
+    records_.clear();
+    for (std::size_t i = 0; i < pending_.size(); ++i) {
+      if (!embedded_[i]) {
+        continue;  // no entry or event is recorded, as for NullEmbeddingProvider
+      }
+      auto& artifact = pending_[i];
+      const auto row = embeddings_.begin() + static_cast<std::ptrdiff_t>(i * dim);
+      vector::Vector embedding(row, row + static_cast<std::ptrdiff_t>(dim));
+      artifact.vector_hash = vector_hash(embedding);
+
+      nlohmann::json metadata;
+      metadata["artifact_type"] = artifact.artifact_type;
+      metadata["artifact_id"] = artifact.artifact_id;
+      metadata["source_hash"] = artifact.source_hash;
+      records_.push_back({artifact.artifact_id, std::move(embedding), metadata.dump()});
+    }
+    if (!records_.empty()) {
+      vector_index_.upsert_many(batch_namespace_, records_);
+    }
+
+    for (std::size_t i = 0; i < pending_.size(); ++i) {
+      if (!embedded_[i]) {
+        continue;
+      }
+      const auto& artifact = pending_[i];
+      const std::string indexed_at = clock_.now_iso8601();
+      run_store_.upsert_entry({run_id_, artifact.artifact_type, artifact.artifact_id,
+                               artifact.source_hash, artifact.vector_hash, indexed_at});
+
+      nlohmann::json event_payload;
+      event_payload["artifact_type"] = artifact.artifact_type;
+      event_payload["artifact_id"] = artifact.artifact_id;
+      event_payload["source_hash"] = artifact.source_hash;
+      event_payload["stale"] = artifact.stale;
+      emit_audit(audit_log_, id_gen_, run_id_, "IndexedArtifact", event_payload.dump(),
+                 indexed_at);
+
+      ++indexed_count_;
+      if (artifact.stale) {
+        ++stale_count_;
+      }
+    }
+    records_.clear();
+    pending_.clear();
+  }
+
+  [[nodiscard]] size_t indexed_count() const noexcept { return indexed_count_; }
+  [[nodiscard]] size_t skipped_count() const noexcept { return skipped_count_; }
+  [[nodiscard]] size_t stale_count() const noexcept { return stale_count_; }
+
+ private:
+  // Fills embeddings_ from texts_ with embed_batch(), split across the pool if there is one.
+  void embed_batch(const std::size_t dim) {
+    if (pool_ == nullptr) {
+      embedding_provider_.embed_batch(texts_, embeddings_);
+      return;
+    }
+    // Every slice writes its own rows, so the buffer matches a single call exactly.
+    const std::size_t jobs = pool_->size() + 1;
+    const std::size_t grain = (texts_.size() + jobs - 1) / jobs;
+    const std::span<const std::string_view> texts(texts_);
+    const std::span<float> rows(embeddings_);
+    pool_->parallel_for(texts_.size(), grain, [&](std::size_t begin, std::size_t end) {
+      embedding_provider_.embed_batch(texts.subspan(begin, end - begin),
+                                      rows.subspan(begin * dim, (end - begin) * dim));
+    });
+  }
+
+  // Fills embeddings_ one embed_text() call at a time, clearing embedded_[i] for every text
+  // whose vector is not dim floats.
+  void embed_each(const std::size_t dim) {
+    for (std::size_t i = 0; i < texts_.size(); ++i) {
+      const vector::Vector embedding = embedding_provider_.embed_text(texts_[i]);
+      if (embedding.size() != dim) {
+        embedded_[i] = false;
+        continue;
+      }
+      std::copy(embedding.begin(), embedding.end(),
+                embeddings_.begin() + static_cast<std::ptrdiff_t>(i * dim));
+    }
+  }
+
+  // A stale artifact waiting to be embedded and written by the next flush().
+  struct PendingArtifact {
+    std::string artifact_type;
+    std::string artifact_id;
+    std::string source_hash;
+    std::string canonical_text;
+    std::string vector_hash;  // set by flush()
+    bool stale;
+  };
+
+  IIndexRunStore& run_store_;
+  vector::IEmbeddingIndex& vector_index_;
+  embedding::IEmbeddingProvider& embedding_provider_;
+  storage::IAuditLog& audit_log_;
+  core::IIdGenerator& id_gen_;
+  core::IClock& clock_;
+  const IndexBuildConfig& config_;
+  const std::size_t batch_size_;
+  const std::string run_id_;
+  core::ThreadPool* pool_;  // nullptr = embed on the calling thread
+  const ArtifactStateMap prior_states_;
+
+  vector::VectorNamespace batch_namespace_;  // namespace of every artifact in pending_
+  std::vector<PendingArtifact> pending_;
+  // Per-flush buffers, reused across batches.
+  std::vector<std::string_view> texts_;
+  std::vector<float> embeddings_;
+  std::vector<bool> embedded_;  // false: the text did not embed at full dimension; skipped
+  std::vector<vector::VectorRecord> records_;
+  size_t indexed_count_{0};
+  size_t skipped_count_{0};
+  size_t stale_count_{0};
+};
+
 }  // namespace
 
 IndexBuildResult run_index_build(storage::IAtomRepository& atoms, ingest::IResumeStore& resumes,
@@ -75,160 +301,48 @@ IndexBuildResult run_index_build(storage::IAtomRepository& atoms, ingest::IResum
   started_payload["provider_id"] = config.provider_id;
   emit_audit(audit_log, id_gen, run_id, "IndexRunStarted", started_payload.dump(), started_at);
 
-  size_t indexed_count = 0;
-  size_t skipped_count = 0;
-  size_t stale_count = 0;
+  // The calling thread runs chunks while it waits, so jobs threads need jobs - 1 workers.
+  const std::size_t jobs = std::min(config.jobs, kMaxIndexBuildJobs);
+  std::unique_ptr<core::ThreadPool> pool;
+  if (jobs > 1) {
+    pool = std::make_unique<core::ThreadPool>(jobs - 1);
+  }
+  // One query loads every prior state the drift checks below need.
+  ArtifactIndexer indexer(run_store, vector_index, embedding_provider, audit_log, id_gen, clock,
+                          config, run_id, pool.get(),
+                          run_store.load_artifact_states(scope_artifact_types(config.scope),
+                                                         config.provider_id, config.model_id,
+                                                         config.prompt_version));
 
   // Process atoms.
   if (config.scope == "atoms" || config.scope == "all") {
     for (const auto& atom : atoms.list_all()) {
-      const std::string artifact_id = atom.atom_id.value;
-      const std::string artifact_type = "atom";
-      const std::string canonical_text = atom_canonical_text(atom);
-      const std::string src_hash = core::stable_hash64_hex(canonical_text);
-
-      const auto prior_hash =
-          run_store.get_last_source_hash(artifact_id, artifact_type, config.provider_id,
-                                         config.model_id, config.prompt_version);
-
-      if (prior_hash.has_value() && prior_hash.value() == src_hash) {
-        ++skipped_count;
-        continue;
-      }
-
-      const bool is_stale = prior_hash.has_value();
-
-      const auto embedding = embedding_provider.embed_text(canonical_text);
-      if (embedding.empty()) {
-        // NullEmbeddingProvider: skip without recording an entry.
-        continue;
-      }
-
-      const std::string vec_hash = vector_hash(embedding);
-      nlohmann::json metadata;
-      metadata["artifact_type"] = artifact_type;
-      metadata["artifact_id"] = artifact_id;
-      metadata["source_hash"] = src_hash;
-
-      vector_index.upsert(artifact_id, embedding, metadata.dump());
-
-      const std::string indexed_at = clock.now_iso8601();
-      run_store.upsert_entry({run_id, artifact_type, artifact_id, src_hash, vec_hash, indexed_at});
-
-      nlohmann::json event_payload;
-      event_payload["artifact_type"] = artifact_type;
-      event_payload["artifact_id"] = artifact_id;
-      event_payload["source_hash"] = src_hash;
-      event_payload["stale"] = is_stale;
-      emit_audit(audit_log, id_gen, run_id, "IndexedArtifact", event_payload.dump(), indexed_at);
-
-      ++indexed_count;
-      if (is_stale) {
-        ++stale_count;
-      }
+      indexer.add(
+          {"atom", atom.atom_id.value, vector::kAtomNamespace, atom_canonical_text(atom)});
     }
   }
 
   // Process resumes.
   if (config.scope == "resumes" || config.scope == "all") {
     for (const auto& resume : resumes.list_all()) {
-      const std::string artifact_id = resume.resume_id.value;
-      const std::string artifact_type = "resume";
-      const std::string& canonical_text = resume.resume_md;
-      const std::string src_hash = core::stable_hash64_hex(canonical_text);
-
-      const auto prior_hash =
-          run_store.get_last_source_hash(artifact_id, artifact_type, config.provider_id,
-                                         config.model_id, config.prompt_version);
-
-      if (prior_hash.has_value() && prior_hash.value() == src_hash) {
-        ++skipped_count;
-        continue;
-      }
-
-      const bool is_stale = prior_hash.has_value();
-
-      const auto embedding = embedding_provider.embed_text(canonical_text);
-      if (embedding.empty()) {
-        continue;
-      }
-
-      const std::string vec_hash = vector_hash(embedding);
-      nlohmann::json metadata;
-      metadata["artifact_type"] = artifact_type;
-      metadata["artifact_id"] = artifact_id;
-      metadata["source_hash"] = src_hash;
-
-      const std::string vector_key = "resume:" + artifact_id;
-      vector_index.upsert(vector_key, embedding, metadata.dump());
-
-      const std::string indexed_at = clock.now_iso8601();
-      run_store.upsert_entry({run_id, artifact_type, artifact_id, src_hash, vec_hash, indexed_at});
-
-      nlohmann::json event_payload;
-      event_payload["artifact_type"] = artifact_type;
-      event_payload["artifact_id"] = artifact_id;
-      event_payload["source_hash"] = src_hash;
-      event_payload["stale"] = is_stale;
-      emit_audit(audit_log, id_gen, run_id, "IndexedArtifact", event_payload.dump(), indexed_at);
-
-      ++indexed_count;
-      if (is_stale) {
-        ++stale_count;
-      }
+      indexer.add(
+          {"resume", resume.resume_id.value, vector::kResumeNamespace, resume.resume_md});
     }
   }
 
   // Process opportunities.
   if (config.scope == "opportunities" || config.scope == "all") {
     for (const auto& opp : opps.list_all()) {
-      const std::string artifact_id = opp.opportunity_id.value;
-      const std::string artifact_type = "opportunity";
-      const std::string canonical_text = opportunity_canonical_text(opp);
-      const std::string src_hash = core::stable_hash64_hex(canonical_text);
-
-      const auto prior_hash =
-          run_store.get_last_source_hash(artifact_id, artifact_type, config.provider_id,
-                                         config.model_id, config.prompt_version);
-
-      if (prior_hash.has_value() && prior_hash.value() == src_hash) {
-        ++skipped_count;
-        continue;
-      }
-
-      const bool is_stale = prior_hash.has_value();
-
-      const auto embedding = embedding_provider.embed_text(canonical_text);
-      if (embedding.empty()) {
-        continue;
-      }
-
-      const std::string vec_hash = vector_hash(embedding);
-      nlohmann::json metadata;
-      metadata["artifact_type"] = artifact_type;
-      metadata["artifact_id"] = artifact_id;
-      metadata["source_hash"] = src_hash;
-
-      const std::string vector_key = "opp:" + artifact_id;
-      vector_index.upsert(vector_key, embedding, metadata.dump());
-
-      const std::string indexed_at = clock.now_iso8601();
-      run_store.upsert_entry({run_id, artifact_type, artifact_id, src_hash, vec_hash, indexed_at});
-
-      nlohmann::json event_payload;
-      event_payload["artifact_type"] = artifact_type;
-      event_payload["artifact_id"] = artifact_id;
-      event_payload["source_hash"] = src_hash;
-      event_payload["stale"] = is_stale;
-      emit_audit(audit_log, id_gen, run_id, "IndexedArtifact", event_payload.dump(), indexed_at);
-
-      ++indexed_count;
-      if (is_stale) {
-        ++stale_count;
-      }
+      indexer.add({"opportunity", opp.opportunity_id.value, vector::kOpportunityNamespace,
+                   opportunity_canonical_text(opp)});
     }
   }
 
+  indexer.flush();
+  const size_t indexed_count = indexer.indexed_count();
+  const size_t skipped_count = indexer.skipped_count();
+  const size_t stale_count = indexer.stale_count();
+
   // Build summary and complete the run.
   nlohmann::json summary;
   summary["indexed"] = indexed_count;
@@ -250,7 +364,11 @@ IndexBuildResult run_index_build(storage::IAtomRepository& atoms, ingest::IResum
   emit_audit(audit_log, id_gen, run_id, "IndexRunCompleted", completed_payload.dump(),
              completed_at);
 
-  return {indexed_count, skipped_count, stale_count, run_id};
+  // The completed run's entries are now the artifact states; older entries can go.
+  const size_t pruned_count =
+      config.retain_runs > 0 ? run_store.prune_entries(config.retain_runs) : 0;
+
+  return {indexed_count, skipped_count, stale_count, run_id, pruned_count};
 }
 
 }  // namespace ccmcp::indexing
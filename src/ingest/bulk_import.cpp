@@ -0,0 +1,207 @@
+#include "ccmcp/ingest/bulk_import.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <utility>
+
+namespace ccmcp::ingest {
+
+namespace {
+
+using json = nlohmann::json;
+
+std::vector<std::string> string_array(const json& record, const char* key) {
+  if (!record.contains(key)) {
+    return {};
+  }
+  return record.at(key).get<std::vector<std::string>>();
+}
+
+std::string string_field(const json& record, const char* key) {
+  if (!record.contains(key)) {
+    return {};
+  }
+  return record.at(key).get<std::string>();
+}
+
+domain::ExperienceAtom atom_from_json(const json& record) {
+  domain::ExperienceAtom atom;
+  atom.atom_id = core::AtomId{record.at("atom_id").get<std::string>()};
+  atom.domain = string_field(record, "domain");
+  atom.title = string_field(record, "title");
+  atom.claim = string_field(record, "claim");
+  atom.tags = string_array(record, "tags");
+  atom.verified = record.value("verified", false);
+  atom.evidence_refs = string_array(record, "evidence_refs");
+  return domain::normalize_atom(atom);
+}
+
+domain::Opportunity opportunity_from_json(const json& record) {
+  domain::Opportunity opportunity;
+  opportunity.opportunity_id =
+      core::OpportunityId{record.at("opportunity_id").get<std::string>()};
+  opportunity.company = string_field(record, "company");
+  opportunity.role_title = string_field(record, "role_title");
+  opportunity.source = string_field(record, "source");
+  if (record.contains("requirements")) {
+    for (const auto& item : record.at("requirements")) {
+      domain::Requirement requirement;
+      requirement.text = item.at("text").get<std::string>();
+      requirement.tags = string_array(item, "tags");
+      requirement.required = item.value("required", true);
+      opportunity.requirements.push_back(std::move(requirement));
+    }
+  }
+  return domain::normalize_opportunity(opportunity);
+}
+
+bool is_blank(const std::string& line) {
+  return std::all_of(line.begin(), line.end(), [](unsigned char c) { return std::isspace(c); });
+}
+
+// Buffers parsed records per repository and writes each buffer when it reaches batch_size.
+class BatchWriter {
+ public:
+  BatchWriter(storage::IAtomRepository& atoms, storage::IOpportunityRepository& opportunities,
+              const BulkImportOptions& options, BulkImportResult& result)
+      : atoms_(atoms),
+        opportunities_(opportunities),
+        options_(options),
+        batch_size_(std::max<std::size_t>(options.batch_size, 1)),
+        result_(result) {
+    atom_batch_.reserve(batch_size_);
+    opportunity_batch_.reserve(batch_size_);
+  }
+
+  void add(domain::ExperienceAtom atom, std::size_t line) {
+    if (atom_batch_.empty()) {
+      atom_batch_line_ = line;
+    }
+    atom_batch_.push_back(std::move(atom));
+    if (atom_batch_.size() == batch_size_) {
+      flush_atoms();
+    }
+  }
+
+  void add(domain::Opportunity opportunity, std::size_t line) {
+    if (opportunity_batch_.empty()) {
+      opportunity_batch_line_ = line;
+    }
+    opportunity_batch_.push_back(std::move(opportunity));
+    if (opportunity_batch_.size() == batch_size_) {
+      flush_opportunities();
+    }
+  }
+
+  void flush() {
+    flush_atoms();
+    flush_opportunities();
+  }
+
+  void error(std::size_t line, const std::string& message) { record_error(line, message, 1); }
+
+ private:
+  void record_error(std::size_t line, const std::string& message, std::size_t records) {
+    result_.error_count += records;
+    if (result_.errors.size() < options_.max_errors) {
+      result_.errors.push_back("line " + std::to_string(line) + ": " + message);
+    }
+  }
+
+  void flush_atoms() {
+    if (atom_batch_.empty()) {
+      return;
+    }
+    const std::size_t written = atoms_.upsert_many(atom_batch_);
+    result_.atoms_imported += written;
+    if (written < atom_batch_.size()) {
+      record_error(atom_batch_line_,
+                   "failed to write a batch of " + std::to_string(atom_batch_.size()) + " atoms",
+                   atom_batch_.size() - written);
+    }
+    atom_batch_.clear();
+  }
+
+  void flush_opportunities() {
+    if (opportunity_batch_.empty()) {
+      return;
+    }
+    const std::size_t written = opportunities_.upsert_many(opportunity_batch_);
+    result_.opportunities_imported += written;
+    if (written < opportunity_batch_.size()) {
+      record_error(opportunity_batch_line_,
+                   "failed to write a batch of " + std::to_string(opportunity_batch_.size()) +
+                       " opportunities",
+                   opportunity_batch_.size() - written);
+    }
+    opportunity_batch_.clear();
+  }
+
+  storage::IAtomRepository& atoms_;
+  storage::IOpportunityRepository& opportunities_;
+  const BulkImportOptions& options_;
+  std::size_t batch_size_;
+  BulkImportResult& result_;
+
+  std::vector<domain::ExperienceAtom> atom_batch_;
+  std::vector<domain::Opportunity> opportunity_batch_;
+  std::size_t atom_batch_line_{0};         // line of the batch's first record
+  std::size_t opportunity_batch_line_{0};  // likewise
+};
+
+}  // namespace
+
+BulkImportResult import_jsonl(std::istream& input, storage::IAtomRepository& atoms,
+                              storage::IOpportunityRepository& opportunities,
+                              const BulkImportOptions& options) {
+  BulkImportResult result;
+  BatchWriter writer(atoms, opportunities, options, result);
+
+  std::string line;
+  while (std::getline(input, line)) {
+    const std::size_t line_number = ++result.lines_read;
+    if (is_blank(line)) {
+      continue;
+    }
+
+    const json record = json::parse(line, nullptr, /*allow_exceptions=*/false);
+    if (record.is_discarded() || !record.is_object()) {
+      writer.error(line_number, "not a JSON object");
+      continue;
+    }
+
+    try {
+      const std::string kind = string_field(record, "kind");
+      if (kind == "atom") {
+        auto atom = atom_from_json(record);
+        const auto valid = atom.validate();
+        if (!valid.has_value()) {
+          writer.error(line_number, valid.error());
+          continue;
+        }
+        writer.add(std::move(atom), line_number);
+      } else if (kind == "opportunity") {
+        auto opportunity = opportunity_from_json(record);
+        const auto valid = opportunity.validate();
+        if (!valid.has_value()) {
+          writer.error(line_number, valid.error());
+          continue;
+        }
+        writer.add(std::move(opportunity), line_number);
+      } else {
+        writer.error(line_number, "kind must be \"atom\" or \"opportunity\"");
+      }
+    } catch (const json::exception& e) {
+      // Missing required key or a field of the wrong type.
+      writer.error(line_number, e.what());
+    }
+  }
+
+  writer.flush();
+  return result;
+}
+
+}  // namespace ccmcp::ingest
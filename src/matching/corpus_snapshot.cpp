@@ -0,0 +1,117 @@
+#include "ccmcp/matching/corpus_snapshot.h"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace ccmcp::matching {
+
+CorpusSnapshot::CorpusSnapshot(std::vector<domain::ExperienceAtom> atoms,
+                               const std::uint64_t version)
+    : version_(version), owned_atoms_(std::move(atoms)), atoms_(&owned_atoms_) {
+  build_token_arena();
+  build_postings();
+}
+
+CorpusSnapshot::CorpusSnapshot(const std::vector<domain::ExperienceAtom>& atoms)
+    : atoms_(&atoms) {
+  build_token_arena();
+  build_postings();
+}
+
+void CorpusSnapshot::build_token_arena() {
+  auto& dictionary = TokenDictionary::global();
+
+  token_offsets_.reserve(atoms_->size() + 1);
+  token_offsets_.push_back(0);
+  for (const auto& atom : *atoms_) {
+    // Token set = claim ∪ title ∪ tags (tags are interned verbatim; they are already
+    // normalized by the domain layer).
+    TokenIdSet tokens = merge_token_sets(tokenize_to_ids(atom.claim, dictionary),
+                                         tokenize_to_ids(atom.title, dictionary));
+    tokens = merge_token_sets(tokens, intern_tokens(atom.tags, dictionary));
+
+    token_arena_.insert(token_arena_.end(), tokens.begin(), tokens.end());
+    token_offsets_.push_back(token_arena_.size());
+  }
+  token_arena_.shrink_to_fit();
+}
+
+void CorpusSnapshot::build_postings() {
+  const auto& atoms = *atoms_;
+
+  // atom_id order (stable, so duplicate ids keep input order)
+  std::vector<std::uint32_t> by_id(atoms.size());
+  std::iota(by_id.begin(), by_id.end(), 0U);
+  std::stable_sort(by_id.begin(), by_id.end(), [&atoms](std::uint32_t a, std::uint32_t b) {
+    return atoms[a].atom_id.value < atoms[b].atom_id.value;
+  });
+  id_rank_.resize(atoms.size());
+  for (std::size_t rank = 0; rank < by_id.size(); ++rank) {
+    id_rank_[by_id[rank]] = static_cast<std::uint32_t>(rank);
+    if (atoms[by_id[rank]].verify()) {
+      verified_by_id_.push_back(by_id[rank]);
+    }
+  }
+
+  // Counting pass, then fill pass (CSR). Atom indices are appended in ascending order,
+  // so every postings list is sorted.
+  std::size_t token_bound = 0;  // one past the largest token id in the arena
+  for (const TokenId token : token_arena_) {
+    token_bound = std::max(token_bound, static_cast<std::size_t>(token) + 1);
+  }
+  posting_offsets_.assign(token_bound + 1, 0);
+  for (std::size_t i = 0; i < atoms.size(); ++i) {
+    if (!atoms[i].verify()) {
+      continue;
+    }
+    for (const TokenId token : tokens(i)) {
+      ++posting_offsets_[token + 1];
+    }
+  }
+  for (std::size_t t = 1; t < posting_offsets_.size(); ++t) {
+    posting_offsets_[t] += posting_offsets_[t - 1];
+  }
+
+  posting_atoms_.resize(posting_offsets_.back());
+  std::vector<std::size_t> cursor(posting_offsets_.begin(), posting_offsets_.end() - 1);
+  for (std::size_t i = 0; i < atoms.size(); ++i) {
+    if (!atoms[i].verify()) {
+      continue;
+    }
+    for (const TokenId token : tokens(i)) {
+      posting_atoms_[cursor[token]++] = static_cast<std::uint32_t>(i);
+    }
+  }
+}
+
+std::shared_ptr<const CorpusSnapshot> CorpusSnapshotCache::get(
+    const storage::IAtomRepository& atoms) {
+  // Read the version BEFORE listing atoms: if a write lands in between, the snapshot is
+  // labelled with the older version and simply gets rebuilt on the next call.
+  const std::uint64_t version = atoms.corpus_version();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (current_ && current_->version() == version) {
+      return current_;
+    }
+  }
+
+  std::lock_guard<std::mutex> build_lock(build_mutex_);
+  {
+    // Another caller may have rebuilt while we waited for build_mutex_.
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (current_ && current_->version() == version) {
+      return current_;
+    }
+  }
+
+  auto snapshot = std::make_shared<const CorpusSnapshot>(atoms.list_verified(), version);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  current_ = snapshot;
+  return snapshot;
+}
+
+}  // namespace ccmcp::matching
@@ -1,11 +1,16 @@
 #include "ccmcp/matching/matcher.h"
 
-#include "ccmcp/core/normalization.h"
+#include "ccmcp/matching/corpus_snapshot.h"
+#include "ccmcp/matching/token_dictionary.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <map>
+#include <queue>
 #include <set>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 namespace ccmcp::matching {
 
@@ -23,50 +28,195 @@ std::string build_query_text(const domain::Opportunity& opportunity) {
   return query;
 }
 
-// Extract intersection tokens (sorted) using std::set_intersection.
-// Both inputs must be sorted and deduplicated.
-std::vector<std::string> extract_intersection(const std::vector<std::string>& a,
-                                              const std::vector<std::string>& b) {
-  std::vector<std::string> result;
-  std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
-  return result;
+// BestMatch is the running winner for one requirement.
+struct BestMatch {
+  double score{0.0};
+  std::optional<size_t> index;  // index into CorpusSnapshot::atoms()
+};
+
+// Fold one candidate into best: higher score wins; ties go to the lexicographically
+// smaller atom_id (compared through the snapshot's precomputed id rank).
+void consider(BestMatch& best, const double score, const size_t index,
+              const CorpusSnapshot& corpus) {
+  if (score > best.score ||
+      (score == best.score &&
+       (!best.index.has_value() || corpus.id_rank(index) < corpus.id_rank(*best.index)))) {
+    best.score = score;
+    best.index = index;
+  }
 }
 
-// Tokenize and normalize a text field into sorted, deduplicated tokens.
-std::vector<std::string> tokenize_field(const std::string& text) {
-  auto tokens = core::tokenize_ascii(text);
-  // tokenize_ascii already lowercases, but we ensure deduplication and sorting
-  std::set<std::string> unique_tokens(tokens.begin(), tokens.end());
-  return std::vector<std::string>(unique_tokens.begin(), unique_tokens.end());
+// Scan candidates[begin, end) for the best match to one requirement.
+BestMatch scan_candidates(const QueryTokenIds& req_tokens, const CorpusSnapshot& corpus,
+                          const std::vector<size_t>& candidates, const size_t begin,
+                          const size_t end) {
+  BestMatch best;
+  for (size_t c = begin; c < end; ++c) {
+    const size_t index = candidates[c];
+    // Compute overlap: |R ∩ A| / |R| as an integer intersection count
+    const size_t overlap = intersection_size(req_tokens.known, corpus.tokens(index));
+    const double score = static_cast<double>(overlap) / static_cast<double>(req_tokens.size());
+    consider(best, score, index, corpus);
+  }
+  return best;
 }
 
-// Combine multiple token sets into one sorted, deduplicated set.
-std::vector<std::string> combine_token_sets(const std::vector<std::string>& a,
-                                            const std::vector<std::string>& b,
-                                            const std::vector<std::string>& c) {
-  std::set<std::string> combined;
-  combined.insert(a.begin(), a.end());
-  combined.insert(b.begin(), b.end());
-  combined.insert(c.begin(), c.end());
-  return std::vector<std::string>(combined.begin(), combined.end());
+std::vector<BestMatch> score_serial(const RequirementTokens& req_tokens,
+                                    const CorpusSnapshot& corpus,
+                                    const std::vector<size_t>& candidates) {
+  std::vector<BestMatch> best(req_tokens.size());
+  for (size_t r = 0; r < req_tokens.size(); ++r) {
+    if (!req_tokens[r]->empty()) {
+      best[r] = scan_candidates(*req_tokens[r], corpus, candidates, 0, candidates.size());
+    }
+  }
+  return best;
+}
+
+// Candidates scored per task in the parallel path.
+constexpr size_t kCandidatesPerTask = 512;
+
+// Fan requirement × candidate-block tasks across the pool. Each task writes its block's
+// local winner into a dedicated slot; slots are then folded per requirement in block
+// order with the same consider() rule. Because consider() picks the maximum of a total
+// order (score desc, atom_id asc) and ties on equal keys keep the earlier candidate, the
+// fold yields exactly the serial scan's winner regardless of scheduling.
+std::vector<BestMatch> score_parallel(const RequirementTokens& req_tokens,
+                                      const CorpusSnapshot& corpus,
+                                      const std::vector<size_t>& candidates,
+                                      core::ThreadPool& pool) {
+  const size_t blocks = (candidates.size() + kCandidatesPerTask - 1) / kCandidatesPerTask;
+  std::vector<BestMatch> partial(req_tokens.size() * blocks);
+
+  pool.parallel_for(partial.size(), 1, [&](size_t task_begin, size_t task_end) {
+    for (size_t task = task_begin; task < task_end; ++task) {
+      const size_t r = task / blocks;
+      const size_t block = task % blocks;
+      if (req_tokens[r]->empty()) {
+        continue;
+      }
+      const size_t begin = block * kCandidatesPerTask;
+      const size_t end = std::min(candidates.size(), begin + kCandidatesPerTask);
+      partial[task] = scan_candidates(*req_tokens[r], corpus, candidates, begin, end);
+    }
+  });
+
+  std::vector<BestMatch> best(req_tokens.size());
+  for (size_t r = 0; r < req_tokens.size(); ++r) {
+    for (size_t block = 0; block < blocks; ++block) {
+      const BestMatch& local = partial[r * blocks + block];
+      if (local.index.has_value()) {
+        consider(best[r], local.score, *local.index, corpus);
+      }
+    }
+  }
+  return best;
+}
+
+std::string strategy_name(const MatchingStrategy strategy) {
+  if (strategy == MatchingStrategy::kDeterministicLexicalV01) {
+    return "deterministic_lexical_v0.1";
+  }
+  return "hybrid_lexical_embedding_v0.2";
+}
+
+// Assemble the MatchReport from per-requirement winners. Shared by evaluate() and
+// evaluate_batch() so both paths emit identical reports.
+domain::MatchReport build_report(const domain::Opportunity& opportunity,
+                                 const RequirementTokens& req_tokens,
+                                 const std::vector<BestMatch>& best_matches,
+                                 const CorpusSnapshot& corpus, const MatchingStrategy strategy,
+                                 const domain::RetrievalStats& stats,
+                                 const double lexical_weight) {
+  domain::MatchReport report{};
+  report.opportunity_id = opportunity.opportunity_id;
+  report.strategy = strategy_name(strategy);
+  report.retrieval_stats = stats;
+
+  const auto& atoms = corpus.atoms();
+  const auto& dictionary = TokenDictionary::global();
+
+  // Emit results in requirement order (preserving input order)
+  double total_score = 0.0;
+  std::set<std::string> matched_atom_ids;  // Track unique matched atoms
+
+  for (size_t r = 0; r < opportunity.requirements.size(); ++r) {
+    const auto& req = opportunity.requirements[r];
+    domain::RequirementMatch req_match;
+    req_match.requirement_text = req.text;
+
+    // If requirement has no tokens, mark as unmatched
+    if (req_tokens[r]->empty()) {
+      req_match.matched = false;
+      req_match.best_score = 0.0;
+      report.requirement_matches.push_back(req_match);
+      report.missing_requirements.push_back(req.text);
+      continue;
+    }
+
+    // Record match result
+    const BestMatch& best = best_matches[r];
+    req_match.best_score = best.score;
+    if (best.score > 0.0 && best.index.has_value()) {
+      const auto& best_atom = atoms[*best.index];
+      req_match.matched = true;
+      req_match.contributing_atom_id = best_atom.atom_id;
+      // Evidence is materialized as strings only for the winning atom.
+      req_match.evidence_tokens =
+          to_sorted_strings(intersect(req_tokens[r]->known, corpus.tokens(*best.index)),
+                            dictionary);
+      matched_atom_ids.insert(best_atom.atom_id.value);
+    } else {
+      req_match.matched = false;
+      report.missing_requirements.push_back(req.text);
+    }
+
+    report.requirement_matches.push_back(req_match);
+    total_score += best.score;
+  }
+
+  // Calculate overall score (average of per-requirement scores)
+  if (!opportunity.requirements.empty()) {
+    report.overall_score = total_score / static_cast<double>(opportunity.requirements.size());
+  } else {
+    report.overall_score = 0.0;
+  }
+
+  // Populate legacy matched_atoms field (sorted for determinism)
+  for (const auto& atom_id_str : matched_atom_ids) {
+    core::AtomId atom_id;
+    atom_id.value = atom_id_str;
+    report.matched_atoms.push_back(atom_id);
+  }
+
+  // Populate breakdown (v0.1: only lexical scoring)
+  report.breakdown.lexical = report.overall_score;
+  report.breakdown.semantic = 0.0;
+  report.breakdown.bonus = 0.0;
+  report.breakdown.final_score = lexical_weight * report.breakdown.lexical;
+
+  return report;
 }
 
 }  // namespace
 
 Matcher::Matcher(const ScoreWeights weights, const MatchingStrategy strategy,
-                 const HybridConfig hybrid_config)
-    : weights_(weights), strategy_(strategy), hybrid_config_(hybrid_config) {}
+                 const HybridConfig hybrid_config, core::ThreadPool* pool)
+    : weights_(weights), strategy_(strategy), hybrid_config_(hybrid_config), pool_(pool) {}
 
-std::vector<const domain::ExperienceAtom*> Matcher::select_candidates(
-    const domain::Opportunity& opportunity, const std::vector<domain::ExperienceAtom>& atoms,
+std::vector<size_t> Matcher::select_candidates(
+    const domain::Opportunity& opportunity, const RequirementTokens& req_tokens,
+    const CorpusSnapshot& corpus,
     const embedding::IEmbeddingProvider* embedding_provider,
     const vector::IEmbeddingIndex* vector_index, domain::RetrievalStats& stats) const {
+  const auto& atoms = corpus.atoms();
+
   // v0.1 mode: All verified atoms are candidates
   if (strategy_ == MatchingStrategy::kDeterministicLexicalV01) {
-    std::vector<const domain::ExperienceAtom*> candidates;
-    for (const auto& atom : atoms) {
-      if (atom.verify()) {
-        candidates.push_back(&atom);
+    std::vector<size_t> candidates;
+    for (size_t i = 0; i < atoms.size(); ++i) {
+      if (atoms[i].verify()) {
+        candidates.push_back(i);
       }
     }
     stats.lexical_candidates = candidates.size();
@@ -80,31 +230,21 @@ std::vector<const domain::ExperienceAtom*> Matcher::select_candidates(
   std::set<std::string> embedding_atom_ids;
 
   // Stage 1: Lexical candidate selection
-  // Pre-compute lexical overlap scores for all verified atoms
-  struct ScoredAtom {
-    const domain::ExperienceAtom* atom;
-    double score;
-  };
-
-  std::vector<ScoredAtom> lexical_scored;
-
-  // Tokenize all requirements into combined query
-  std::vector<std::string> all_req_tokens;
-  for (const auto& req : opportunity.requirements) {
-    auto req_tokens = tokenize_field(req.text);
-    all_req_tokens.insert(all_req_tokens.end(), req_tokens.begin(), req_tokens.end());
+  // Combine all requirement tokens into one (sorted, deduplicated) query
+  // Tokens unknown to the dictionary have no postings but still count as query tokens.
+  TokenIdSet query_tokens;
+  bool any_tokens = false;
+  for (const QueryTokenIds* tokens : req_tokens) {
+    query_tokens = merge_token_sets(query_tokens, tokens->known);
+    any_tokens = any_tokens || !tokens->empty();
   }
 
-  // Deduplicate and sort query tokens
-  std::set<std::string> unique_tokens(all_req_tokens.begin(), all_req_tokens.end());
-  std::vector<std::string> query_tokens(unique_tokens.begin(), unique_tokens.end());
-
-  if (query_tokens.empty()) {
+  if (!any_tokens) {
     // No query tokens - fallback to all verified atoms
-    std::vector<const domain::ExperienceAtom*> candidates;
-    for (const auto& atom : atoms) {
-      if (atom.verify()) {
-        candidates.push_back(&atom);
+    std::vector<size_t> candidates;
+    for (size_t i = 0; i < atoms.size(); ++i) {
+      if (atoms[i].verify()) {
+        candidates.push_back(i);
       }
     }
     stats.lexical_candidates = candidates.size();
@@ -113,39 +253,63 @@ std::vector<const domain::ExperienceAtom*> Matcher::select_candidates(
     return candidates;
   }
 
-  // Score all verified atoms by lexical overlap
-  for (const auto& atom : atoms) {
-    if (!atom.verify()) {
-      continue;
+  // Accumulate |Q ∩ A| by walking the postings of each query token, so only atoms that
+  // share a query token are touched. Score is |Q ∩ A| / |Q| with a fixed |Q|, hence
+  // ranking by overlap count is ranking by score.
+  thread_local std::vector<std::uint32_t> overlap_counts;
+  if (overlap_counts.size() < atoms.size()) {
+    overlap_counts.resize(atoms.size(), 0);
+  }
+  std::vector<std::uint32_t> touched;
+  for (const TokenId token : query_tokens) {
+    for (const std::uint32_t index : corpus.postings(token)) {
+      if (overlap_counts[index]++ == 0) {
+        touched.push_back(index);
+      }
     }
+  }
 
-    // Tokenize atom
-    std::vector<std::string> claim_tokens = tokenize_field(atom.claim);
-    std::vector<std::string> title_tokens = tokenize_field(atom.title);
-    std::vector<std::string> atom_tokens =
-        combine_token_sets(claim_tokens, title_tokens, atom.tags);
-
-    // Compute overlap score
-    std::vector<std::string> intersection = extract_intersection(query_tokens, atom_tokens);
-    double score =
-        static_cast<double>(intersection.size()) / static_cast<double>(query_tokens.size());
+  // Bounded heap of the best k_lexical atoms by (score desc, atom_id asc). The heap top is
+  // the worst retained atom.
+  struct ScoredAtom {
+    std::uint32_t overlap;
+    std::uint32_t id_rank;
+    std::uint32_t index;
+  };
+  const auto better = [](const ScoredAtom& a, const ScoredAtom& b) {
+    if (a.overlap != b.overlap) {
+      return a.overlap > b.overlap;
+    }
+    return a.id_rank < b.id_rank;
+  };
+  const size_t k_lex = std::min(hybrid_config_.k_lexical, corpus.verified_by_id().size());
+  std::priority_queue<ScoredAtom, std::vector<ScoredAtom>, decltype(better)> top_k(better);
+  for (const std::uint32_t index : touched) {
+    const ScoredAtom scored{overlap_counts[index], corpus.id_rank(index), index};
+    if (top_k.size() < k_lex) {
+      top_k.push(scored);
+    } else if (k_lex > 0 && better(scored, top_k.top())) {
+      top_k.pop();
+      top_k.push(scored);
+    }
+  }
+  for (; !top_k.empty(); top_k.pop()) {
+    lexical_atom_ids.insert(atoms[top_k.top().index].atom_id.value);
+  }
 
-    lexical_scored.push_back({&atom, score});
+  // Fewer than k_lexical atoms overlap the query: fill with zero-score atoms in atom_id
+  // order, exactly as a full (score desc, atom_id asc) sort would.
+  for (const std::uint32_t index : corpus.verified_by_id()) {
+    if (lexical_atom_ids.size() >= k_lex) {
+      break;
+    }
+    if (overlap_counts[index] == 0) {
+      lexical_atom_ids.insert(atoms[index].atom_id.value);
+    }
   }
 
-  // Sort by score descending, then atom_id ascending (deterministic tie-break)
-  std::sort(lexical_scored.begin(), lexical_scored.end(),
-            [](const ScoredAtom& a, const ScoredAtom& b) {
-              if (a.score != b.score) {
-                return a.score > b.score;
-              }
-              return a.atom->atom_id.value < b.atom->atom_id.value;
-            });
-
-  // Select top K_lex
-  size_t k_lex = std::min(hybrid_config_.k_lexical, lexical_scored.size());
-  for (size_t i = 0; i < k_lex; ++i) {
-    lexical_atom_ids.insert(lexical_scored[i].atom->atom_id.value);
+  for (const std::uint32_t index : touched) {
+    overlap_counts[index] = 0;  // leave the thread-local scratch clean for the next call
   }
 
   stats.lexical_candidates = lexical_atom_ids.size();
@@ -158,8 +322,9 @@ std::vector<const domain::ExperienceAtom*> Matcher::select_candidates(
     vector::Vector query_embedding = embedding_provider->embed_text(query_text);
 
     if (!query_embedding.empty()) {
-      // Query vector index for top K_emb
-      auto search_results = vector_index->query(query_embedding, hybrid_config_.k_embedding);
+      // Query the atom partition for top K_emb; resumes and opportunities are never scanned.
+      auto search_results = vector_index->query(vector::kAtomNamespace, query_embedding,
+                                                hybrid_config_.k_embedding);
 
       // Extract atom IDs from search results
       for (const auto& result : search_results) {
@@ -178,13 +343,13 @@ std::vector<const domain::ExperienceAtom*> Matcher::select_candidates(
   stats.merged_candidates = merged_atom_ids.size();
 
   // Build atom map for fast lookup
-  std::map<std::string, const domain::ExperienceAtom*> atom_map;
-  for (const auto& atom : atoms) {
-    atom_map[atom.atom_id.value] = &atom;
+  std::map<std::string, size_t> atom_map;
+  for (size_t i = 0; i < atoms.size(); ++i) {
+    atom_map[atoms[i].atom_id.value] = i;
   }
 
   // Build final candidate list (sorted by atom_id for determinism)
-  std::vector<const domain::ExperienceAtom*> candidates;
+  std::vector<size_t> candidates;
   for (const auto& atom_id : merged_atom_ids) {
     auto it = atom_map.find(atom_id);
     if (it != atom_map.end()) {
@@ -199,112 +364,142 @@ domain::MatchReport Matcher::evaluate(const domain::Opportunity& opportunity,
                                       const std::vector<domain::ExperienceAtom>& atoms,
                                       const embedding::IEmbeddingProvider* embedding_provider,
                                       const vector::IEmbeddingIndex* vector_index) const {
-  domain::MatchReport report{};
-  report.opportunity_id = opportunity.opportunity_id;
+  // Tokenize the caller's atoms once into a borrowing snapshot (no atom copies).
+  const CorpusSnapshot corpus(atoms);
+  return evaluate(opportunity, corpus, embedding_provider, vector_index);
+}
 
-  // Set strategy string based on mode
-  if (strategy_ == MatchingStrategy::kDeterministicLexicalV01) {
-    report.strategy = "deterministic_lexical_v0.1";
-  } else {
-    report.strategy = "hybrid_lexical_embedding_v0.2";
+domain::MatchReport Matcher::evaluate(const domain::Opportunity& opportunity,
+                                      const CorpusSnapshot& corpus,
+                                      const embedding::IEmbeddingProvider* embedding_provider,
+                                      const vector::IEmbeddingIndex* vector_index) const {
+  // Tokenize every requirement up front. Requirement text is only looked up, never
+  // interned, so match requests cannot grow the process-wide dictionary.
+  const auto& dictionary = TokenDictionary::global();
+  std::vector<QueryTokenIds> req_token_sets;
+  req_token_sets.reserve(opportunity.requirements.size());
+  for (const auto& req : opportunity.requirements) {
+    req_token_sets.push_back(lookup_token_ids(req.text, dictionary));
   }
-
-  // Select candidate atoms based on strategy
-  auto candidates = select_candidates(opportunity, atoms, embedding_provider, vector_index,
-                                      report.retrieval_stats);
-
-  // Pre-compute atom token sets for candidates only (avoid redundant tokenization)
-  std::map<std::string, std::vector<std::string>> candidate_token_sets;
-
-  for (const auto* atom_ptr : candidates) {
-    std::vector<std::string> claim_tokens = tokenize_field(atom_ptr->claim);
-    std::vector<std::string> title_tokens = tokenize_field(atom_ptr->title);
-    std::vector<std::string> atom_tokens =
-        combine_token_sets(claim_tokens, title_tokens, atom_ptr->tags);
-    candidate_token_sets[atom_ptr->atom_id.value] = std::move(atom_tokens);
+  RequirementTokens req_tokens;
+  req_tokens.reserve(req_token_sets.size());
+  for (const auto& tokens : req_token_sets) {
+    req_tokens.push_back(&tokens);
   }
 
-  // Process each requirement in order (preserving input order)
-  double total_score = 0.0;
-  std::set<std::string> matched_atom_ids;  // Track unique matched atoms
+  // Select candidate atoms based on strategy (token sets are precomputed in the snapshot)
+  domain::RetrievalStats stats;
+  const auto candidates =
+      select_candidates(opportunity, req_tokens, corpus, embedding_provider, vector_index, stats);
 
-  for (const auto& req : opportunity.requirements) {
-    domain::RequirementMatch req_match;
-    req_match.requirement_text = req.text;
+  // Score requirement × candidate. The parallel path produces the same BestMatch per
+  // requirement as the serial path (see score_parallel), so output is bit-identical.
+  const std::vector<BestMatch> best_matches =
+      pool_ != nullptr ? score_parallel(req_tokens, corpus, candidates, *pool_)
+                       : score_serial(req_tokens, corpus, candidates);
 
-    // Tokenize requirement text
-    std::vector<std::string> req_tokens = tokenize_field(req.text);
+  return build_report(opportunity, req_tokens, best_matches, corpus, strategy_, stats,
+                      weights_.lexical);
+}
 
-    // If requirement has no tokens, mark as unmatched
-    if (req_tokens.empty()) {
-      req_match.matched = false;
-      req_match.best_score = 0.0;
-      report.requirement_matches.push_back(req_match);
-      report.missing_requirements.push_back(req.text);
-      continue;
-    }
+std::vector<domain::MatchReport> Matcher::evaluate_batch(
+    std::span<const domain::Opportunity> opportunities,
+    const std::vector<domain::ExperienceAtom>& atoms,
+    const embedding::IEmbeddingProvider* embedding_provider,
+    const vector::IEmbeddingIndex* vector_index) const {
+  // Tokenize the corpus once for the whole batch.
+  const CorpusSnapshot corpus(atoms);
+  return evaluate_batch(opportunities, corpus, embedding_provider, vector_index);
+}
 
-    // Find best matching atom from candidates using pre-computed token sets
-    double best_score = 0.0;
-    std::optional<core::AtomId> best_atom_id;
-    std::vector<std::string> best_evidence;
-
-    for (const auto* atom_ptr : candidates) {
-      const auto& atom = *atom_ptr;
-      const auto& atom_tokens = candidate_token_sets[atom.atom_id.value];
-
-      // Compute overlap: |R ∩ A| / |R| (ES.1: use std::set_intersection)
-      std::vector<std::string> intersection = extract_intersection(req_tokens, atom_tokens);
-      double score =
-          static_cast<double>(intersection.size()) / static_cast<double>(req_tokens.size());
-
-      // Update best match (tie-break by lexicographically smaller atom_id)
-      if (score > best_score ||
-          (score == best_score &&
-           (!best_atom_id.has_value() || atom.atom_id.value < best_atom_id->value))) {
-        best_score = score;
-        best_atom_id = atom.atom_id;
-        best_evidence = std::move(intersection);  // Reuse already-computed intersection
+std::vector<domain::MatchReport> Matcher::evaluate_batch(
+    std::span<const domain::Opportunity> opportunities, const CorpusSnapshot& corpus,
+    const embedding::IEmbeddingProvider* embedding_provider,
+    const vector::IEmbeddingIndex* vector_index) const {
+  std::vector<domain::MatchReport> reports(opportunities.size());
+  if (opportunities.empty()) {
+    return reports;
+  }
+
+  // Dedupe requirement texts across the batch: each distinct text is tokenized once and
+  // every requirement refers to its text's slot.
+  const auto& dictionary = TokenDictionary::global();
+  std::unordered_map<std::string_view, size_t> slot_by_text;
+  std::vector<QueryTokenIds> unique_tokens;
+  std::vector<std::vector<size_t>> req_slots(opportunities.size());
+  for (size_t o = 0; o < opportunities.size(); ++o) {
+    for (const auto& req : opportunities[o].requirements) {
+      const auto [it, inserted] = slot_by_text.try_emplace(req.text, unique_tokens.size());
+      if (inserted) {
+        unique_tokens.push_back(lookup_token_ids(req.text, dictionary));
       }
+      req_slots[o].push_back(it->second);
     }
-
-    // Record match result
-    req_match.best_score = best_score;
-    if (best_score > 0.0 && best_atom_id.has_value()) {
-      req_match.matched = true;
-      req_match.contributing_atom_id = best_atom_id;
-      req_match.evidence_tokens = best_evidence;
-      matched_atom_ids.insert(best_atom_id->value);
-    } else {
-      req_match.matched = false;
-      report.missing_requirements.push_back(req.text);
+  }
+  const auto req_tokens_for = [&](size_t o) {
+    RequirementTokens tokens;
+    tokens.reserve(req_slots[o].size());
+    for (const size_t slot : req_slots[o]) {
+      tokens.push_back(&unique_tokens[slot]);
     }
+    return tokens;
+  };
 
-    report.requirement_matches.push_back(req_match);
-    total_score += best_score;
+  if (strategy_ == MatchingStrategy::kDeterministicLexicalV01) {
+    // v0.1: the candidate set (all verified atoms) is the same for every opportunity, so
+    // each distinct requirement text is scored against the corpus exactly once.
+    domain::RetrievalStats stats;
+    const auto candidates = select_candidates(opportunities.front(), req_tokens_for(0), corpus,
+                                              embedding_provider, vector_index, stats);
+    RequirementTokens unique_sets;
+    unique_sets.reserve(unique_tokens.size());
+    for (const auto& tokens : unique_tokens) {
+      unique_sets.push_back(&tokens);
+    }
+    const std::vector<BestMatch> unique_best =
+        pool_ != nullptr ? score_parallel(unique_sets, corpus, candidates, *pool_)
+                         : score_serial(unique_sets, corpus, candidates);
+
+    for (size_t o = 0; o < opportunities.size(); ++o) {
+      std::vector<BestMatch> best;
+      best.reserve(req_slots[o].size());
+      for (const size_t slot : req_slots[o]) {
+        best.push_back(unique_best[slot]);
+      }
+      reports[o] = build_report(opportunities[o], req_tokens_for(o), best, corpus, strategy_,
+                                stats, weights_.lexical);
+    }
+    return reports;
   }
 
-  // Calculate overall score (average of per-requirement scores)
-  if (!opportunity.requirements.empty()) {
-    report.overall_score = total_score / static_cast<double>(opportunity.requirements.size());
-  } else {
-    report.overall_score = 0.0;
+  // Hybrid: candidates depend on each opportunity's query. Retrieval (including the
+  // embedding provider and vector index) stays on the calling thread; only scoring fans
+  // out, one opportunity per task.
+  std::vector<std::vector<size_t>> candidates(opportunities.size());
+  std::vector<domain::RetrievalStats> stats(opportunities.size());
+  for (size_t o = 0; o < opportunities.size(); ++o) {
+    candidates[o] = select_candidates(opportunities[o], req_tokens_for(o), corpus,
+                                      embedding_provider, vector_index, stats[o]);
   }
 
-  // Populate legacy matched_atoms field (sorted for determinism)
-  for (const auto& atom_id_str : matched_atom_ids) {
-    core::AtomId atom_id;
-    atom_id.value = atom_id_str;
-    report.matched_atoms.push_back(atom_id);
+  const auto score_one = [&](size_t o) {
+    const auto req_tokens = req_tokens_for(o);
+    reports[o] = build_report(opportunities[o], req_tokens,
+                              score_serial(req_tokens, corpus, candidates[o]), corpus, strategy_,
+                              stats[o], weights_.lexical);
+  };
+  if (pool_ != nullptr) {
+    pool_->parallel_for(opportunities.size(), 1, [&](size_t begin, size_t end) {
+      for (size_t o = begin; o < end; ++o) {
+        score_one(o);
+      }
+    });
+  } else {
+    for (size_t o = 0; o < opportunities.size(); ++o) {
+      score_one(o);
+    }
   }
-
-  // Populate breakdown (v0.1: only lexical scoring)
-  report.breakdown.lexical = report.overall_score;
-  report.breakdown.semantic = 0.0;
-  report.breakdown.bonus = 0.0;
-  report.breakdown.final_score = weights_.lexical * report.breakdown.lexical;
-
-  return report;
+  return reports;
 }
 
 }  // namespace ccmcp::matching
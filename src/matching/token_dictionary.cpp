@@ -0,0 +1,151 @@
+#include "ccmcp/matching/token_dictionary.h"
+
+#include "ccmcp/core/normalization.h"
+
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+
+namespace ccmcp::matching {
+
+namespace {
+
+// Sort and deduplicate ids in place.
+void sort_unique(TokenIdSet& ids) {
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+}
+
+}  // namespace
+
+TokenDictionary& TokenDictionary::global() {
+  static TokenDictionary dictionary;
+  return dictionary;
+}
+
+TokenId TokenDictionary::intern(std::string_view token) {
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(token);
+    if (it != ids_.end()) {
+      return it->second;
+    }
+  }
+
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  // Re-check: another thread may have interned the token between the two locks.
+  auto it = ids_.find(token);
+  if (it != ids_.end()) {
+    return it->second;
+  }
+
+  const auto id = static_cast<TokenId>(tokens_.size());
+  const std::string& stored = tokens_.emplace_back(token);
+  ids_.emplace(std::string_view(stored), id);
+  return id;
+}
+
+std::optional<TokenId> TokenDictionary::find(std::string_view token) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto it = ids_.find(token);
+  if (it != ids_.end()) {
+    return it->second;
+  }
+  return std::nullopt;
+}
+
+const std::string& TokenDictionary::token(TokenId id) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  if (id >= tokens_.size()) {
+    throw std::out_of_range("TokenDictionary: unknown token id " + std::to_string(id));
+  }
+  return tokens_[id];
+}
+
+std::size_t TokenDictionary::size() const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return tokens_.size();
+}
+
+TokenIdSet tokenize_to_ids(std::string_view text, TokenDictionary& dictionary) {
+  const auto tokens = core::tokenize_ascii(text);
+  TokenIdSet ids;
+  ids.reserve(tokens.size());
+  for (const auto& token : tokens) {
+    ids.push_back(dictionary.intern(token));
+  }
+  sort_unique(ids);
+  return ids;
+}
+
+QueryTokenIds lookup_token_ids(std::string_view text, const TokenDictionary& dictionary) {
+  auto tokens = core::tokenize_ascii(text);
+  std::sort(tokens.begin(), tokens.end());
+  tokens.erase(std::unique(tokens.begin(), tokens.end()), tokens.end());
+  QueryTokenIds ids;
+  ids.known.reserve(tokens.size());
+  for (const auto& token : tokens) {
+    if (const auto id = dictionary.find(token)) {
+      ids.known.push_back(*id);
+    } else {
+      ++ids.unknown;
+    }
+  }
+  std::sort(ids.known.begin(), ids.known.end());
+  return ids;
+}
+
+TokenIdSet intern_tokens(const std::vector<std::string>& tokens, TokenDictionary& dictionary) {
+  TokenIdSet ids;
+  ids.reserve(tokens.size());
+  for (const auto& token : tokens) {
+    ids.push_back(dictionary.intern(token));
+  }
+  sort_unique(ids);
+  return ids;
+}
+
+TokenIdSet merge_token_sets(TokenIdSpan a, TokenIdSpan b) {
+  TokenIdSet result;
+  result.reserve(a.size() + b.size());
+  std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+  return result;
+}
+
+std::size_t intersection_size(TokenIdSpan a, TokenIdSpan b) {
+  std::size_t count = 0;
+  auto ia = a.begin();
+  auto ib = b.begin();
+  while (ia != a.end() && ib != b.end()) {
+    if (*ia < *ib) {
+      ++ia;
+    } else if (*ib < *ia) {
+      ++ib;
+    } else {
+      ++count;
+      ++ia;
+      ++ib;
+    }
+  }
+  return count;
+}
+
+TokenIdSet intersect(TokenIdSpan a, TokenIdSpan b) {
+  TokenIdSet result;
+  std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+  return result;
+}
+
+std::vector<std::string> to_sorted_strings(TokenIdSpan ids,
+                                           const TokenDictionary& dictionary) {
+  std::vector<std::string> result;
+  result.reserve(ids.size());
+  for (const TokenId id : ids) {
+    result.push_back(dictionary.token(id));
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+}  // namespace ccmcp::matching
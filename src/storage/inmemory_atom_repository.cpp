@@ -4,6 +4,17 @@ namespace ccmcp::storage {
 
 void InMemoryAtomRepository::upsert(const domain::ExperienceAtom& atom) {
   atoms_[atom.atom_id] = atom;
+  ++version_;
+}
+
+std::size_t InMemoryAtomRepository::upsert_many(const std::vector<domain::ExperienceAtom>& atoms) {
+  // std::map has no reserve(); bulk loads usually arrive in id order, so hint each insert at
+  // the end to make it amortized constant time instead of a full tree descent.
+  for (const auto& atom : atoms) {
+    atoms_.insert_or_assign(atoms_.end(), atom.atom_id, atom);
+  }
+  ++version_;
+  return atoms.size();
 }
 
 std::optional<domain::ExperienceAtom> InMemoryAtomRepository::get(const core::AtomId& id) const {
@@ -6,6 +6,15 @@ void InMemoryOpportunityRepository::upsert(const domain::Opportunity& opportunit
   opportunities_[opportunity.opportunity_id] = opportunity;
 }
 
+std::size_t InMemoryOpportunityRepository::upsert_many(
+    const std::vector<domain::Opportunity>& opportunities) {
+  // Hinted inserts: see InMemoryAtomRepository::upsert_many.
+  for (const auto& opportunity : opportunities) {
+    opportunities_.insert_or_assign(opportunities_.end(), opportunity.opportunity_id, opportunity);
+  }
+  return opportunities.size();
+}
+
 std::optional<domain::Opportunity> InMemoryOpportunityRepository::get(
     const core::OpportunityId& id) const {
   auto it = opportunities_.find(id);
@@ -15,6 +24,16 @@ std::optional<domain::Opportunity> InMemoryOpportunityRepository::get(
   return std::nullopt;
 }
 
+std::vector<std::optional<domain::Opportunity>> InMemoryOpportunityRepository::get_many(
+    const std::vector<core::OpportunityId>& ids) const {
+  std::vector<std::optional<domain::Opportunity>> result;
+  result.reserve(ids.size());
+  for (const auto& id : ids) {
+    result.push_back(get(id));
+  }
+  return result;
+}
+
 std::vector<domain::Opportunity> InMemoryOpportunityRepository::list_all() const {
   std::vector<domain::Opportunity> result;
   result.reserve(opportunities_.size());
@@ -1,19 +1,16 @@
 #include "ccmcp/storage/sqlite/sqlite_atom_repository.h"
 
+#include "ccmcp/storage/sqlite/sqlite_json.h"
+
 #include <nlohmann/json.hpp>
 
 #include <sqlite3.h>
 
 namespace ccmcp::storage::sqlite {
 
-SqliteAtomRepository::SqliteAtomRepository(std::shared_ptr<SqliteDb> db) : db_(std::move(db)) {}
-
-void SqliteAtomRepository::upsert(const domain::ExperienceAtom& atom) {
-  // Serialize tags and evidence_refs to JSON (deterministic sort)
-  nlohmann::json tags_json = atom.tags;
-  nlohmann::json evidence_json = atom.evidence_refs;
+namespace {
 
-  const char* sql = R"(
+constexpr const char* kUpsertAtomSql = R"(
     INSERT INTO atoms (atom_id, domain, title, claim, tags_json, verified, evidence_refs_json)
     VALUES (?, ?, ?, ?, ?, ?, ?)
     ON CONFLICT(atom_id) DO UPDATE SET
@@ -25,26 +22,83 @@ void SqliteAtomRepository::upsert(const domain::ExperienceAtom& atom) {
       evidence_refs_json = excluded.evidence_refs_json
   )";
 
-  PreparedStatement stmt(db_->connection(), sql);
+// Bind atom to kUpsertAtomSql and step it; true on success.
+bool step_upsert(sqlite3_stmt* stmt, const domain::ExperienceAtom& atom) {
+  // Serialize tags and evidence_refs to JSON (deterministic sort)
+  const std::string tags_json = nlohmann::json(atom.tags).dump();
+  const std::string evidence_json = nlohmann::json(atom.evidence_refs).dump();
+
+  sqlite3_bind_text(stmt, 1, atom.atom_id.value.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt, 2, atom.domain.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt, 3, atom.title.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt, 4, atom.claim.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt, 5, tags_json.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_int(stmt, 6, atom.verified ? 1 : 0);
+  sqlite3_bind_text(stmt, 7, evidence_json.c_str(), -1, SQLITE_TRANSIENT);
+
+  return sqlite3_step(stmt) == SQLITE_DONE;
+}
+
+}  // namespace
+
+SqliteAtomRepository::SqliteAtomRepository(std::shared_ptr<SqliteDb> db)
+    : SqliteAtomRepository(std::make_shared<SqliteConnectionPool>(std::move(db))) {}
+
+SqliteAtomRepository::SqliteAtomRepository(std::shared_ptr<SqliteConnectionPool> pool)
+    : pool_(std::move(pool)) {}
+
+void SqliteAtomRepository::upsert(const domain::ExperienceAtom& atom) {
+  const auto conn = pool_->write();
+  auto stmt = conn->prepare(kUpsertAtomSql);
   if (!stmt.is_valid()) {
     return;  // Silent failure for upsert (matches in-memory semantics)
   }
 
-  sqlite3_bind_text(stmt.get(), 1, atom.atom_id.value.c_str(), -1, SQLITE_TRANSIENT);
-  sqlite3_bind_text(stmt.get(), 2, atom.domain.c_str(), -1, SQLITE_TRANSIENT);
-  sqlite3_bind_text(stmt.get(), 3, atom.title.c_str(), -1, SQLITE_TRANSIENT);
-  sqlite3_bind_text(stmt.get(), 4, atom.claim.c_str(), -1, SQLITE_TRANSIENT);
-  sqlite3_bind_text(stmt.get(), 5, tags_json.dump().c_str(), -1, SQLITE_TRANSIENT);
-  sqlite3_bind_int(stmt.get(), 6, atom.verified ? 1 : 0);
-  sqlite3_bind_text(stmt.get(), 7, evidence_json.dump().c_str(), -1, SQLITE_TRANSIENT);
+  if (step_upsert(stmt.get(), atom)) {
+    local_writes_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+std::size_t SqliteAtomRepository::upsert_many(const std::vector<domain::ExperienceAtom>& atoms) {
+  if (atoms.empty()) {
+    return 0;
+  }
+
+  // One transaction and one statement for the whole batch: a single journal sync instead of
+  // one per atom, and no per-atom statement lookup.
+  const auto conn = pool_->write();
+  if (!conn->exec("BEGIN IMMEDIATE").has_value()) {
+    return 0;
+  }
+  {
+    auto stmt = conn->prepare(kUpsertAtomSql);
+    if (!stmt.is_valid()) {
+      (void)conn->exec("ROLLBACK");
+      return 0;
+    }
+    for (const auto& atom : atoms) {
+      if (!step_upsert(stmt.get(), atom)) {
+        stmt.reset();
+        (void)conn->exec("ROLLBACK");
+        return 0;
+      }
+      stmt.reset();
+    }
+  }
+  if (!conn->exec("COMMIT").has_value()) {
+    (void)conn->exec("ROLLBACK");
+    return 0;
+  }
 
-  sqlite3_step(stmt.get());
+  local_writes_.fetch_add(1, std::memory_order_relaxed);
+  return atoms.size();
 }
 
 std::optional<domain::ExperienceAtom> SqliteAtomRepository::get(const core::AtomId& id) const {
   const char* sql = "SELECT * FROM atoms WHERE atom_id = ?";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return std::nullopt;
   }
@@ -61,7 +115,8 @@ std::optional<domain::ExperienceAtom> SqliteAtomRepository::get(const core::Atom
 std::vector<domain::ExperienceAtom> SqliteAtomRepository::list_verified() const {
   const char* sql = "SELECT * FROM atoms WHERE verified = 1 ORDER BY atom_id";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return {};
   }
@@ -77,7 +132,8 @@ std::vector<domain::ExperienceAtom> SqliteAtomRepository::list_verified() const
 std::vector<domain::ExperienceAtom> SqliteAtomRepository::list_all() const {
   const char* sql = "SELECT * FROM atoms ORDER BY atom_id";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return {};
   }
@@ -90,6 +146,15 @@ std::vector<domain::ExperienceAtom> SqliteAtomRepository::list_all() const {
   return result;
 }
 
+std::uint64_t SqliteAtomRepository::corpus_version() const {
+  // data_version is per connection; always read the writer's so calls compare one counter.
+  // It ignores the writer's own commits (audit events, other stores), which local_writes_
+  // covers for atoms, and is read without waiting for the write lease.
+  const std::uint64_t data_version = pool_->writer_data_version();
+  // High half: external commits; low half: local upserts. Either changing changes the value.
+  return (data_version << 32U) ^ local_writes_.load(std::memory_order_relaxed);
+}
+
 domain::ExperienceAtom SqliteAtomRepository::row_to_atom(sqlite3_stmt* stmt) const {
   domain::ExperienceAtom atom;
 
@@ -99,16 +164,13 @@ domain::ExperienceAtom SqliteAtomRepository::row_to_atom(sqlite3_stmt* stmt) con
   atom.claim = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3));
 
   // Deserialize tags JSON
-  std::string tags_json_str = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 4));
-  nlohmann::json tags_json = nlohmann::json::parse(tags_json_str);
-  atom.tags = tags_json.get<std::vector<std::string>>();
+  atom.tags = parse_string_array(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 4)));
 
   atom.verified = sqlite3_column_int(stmt, 5) != 0;
 
   // Deserialize evidence_refs JSON
-  std::string evidence_json_str = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 6));
-  nlohmann::json evidence_json = nlohmann::json::parse(evidence_json_str);
-  atom.evidence_refs = evidence_json.get<std::vector<std::string>>();
+  atom.evidence_refs =
+      parse_string_array(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 6)));
 
   return atom;
 }
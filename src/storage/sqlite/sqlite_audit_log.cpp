@@ -10,10 +10,16 @@
 
 namespace ccmcp::storage::sqlite {
 
-SqliteAuditLog::SqliteAuditLog(std::shared_ptr<SqliteDb> db) : db_(std::move(db)) {}
+SqliteAuditLog::SqliteAuditLog(std::shared_ptr<SqliteDb> db)
+    : SqliteAuditLog(std::make_shared<SqliteConnectionPool>(std::move(db))) {}
+
+SqliteAuditLog::SqliteAuditLog(std::shared_ptr<SqliteConnectionPool> pool)
+    : pool_(std::move(pool)) {}
 
 void SqliteAuditLog::append(const AuditEvent& event) {
-  const AppendState state = get_append_state(event.trace_id);
+  // The chain state is read on the writer so it includes every committed append.
+  const auto conn = pool_->write();
+  const AppendState state = get_append_state(*conn, event.trace_id);
 
   const std::string event_hash = compute_event_hash(event, state.previous_hash);
 
@@ -27,7 +33,7 @@ void SqliteAuditLog::append(const AuditEvent& event) {
     VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)
   )";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     throw std::runtime_error("SqliteAuditLog::append failed to prepare: " + stmt.error());
   }
@@ -45,7 +51,7 @@ void SqliteAuditLog::append(const AuditEvent& event) {
   const int rc = sqlite3_step(stmt.get());
   if (rc != SQLITE_DONE) {
     throw std::runtime_error("SqliteAuditLog::append failed: " +
-                             std::string(sqlite3_errmsg(db_->connection())));
+                             std::string(sqlite3_errmsg(conn->connection())));
   }
 }
 
@@ -55,7 +61,8 @@ std::vector<AuditEvent> SqliteAuditLog::query(const std::string& trace_id) const
       "       previous_hash, event_hash"
       "  FROM audit_events WHERE trace_id = ? ORDER BY idx";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return {};
   }
@@ -89,7 +96,8 @@ std::vector<AuditEvent> SqliteAuditLog::query(const std::string& trace_id) const
 std::vector<std::string> SqliteAuditLog::list_trace_ids() const {
   const char* sql = "SELECT DISTINCT trace_id FROM audit_events";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return {};
   }
@@ -104,7 +112,8 @@ std::vector<std::string> SqliteAuditLog::list_trace_ids() const {
   return ids;
 }
 
-SqliteAuditLog::AppendState SqliteAuditLog::get_append_state(const std::string& trace_id) {
+SqliteAuditLog::AppendState SqliteAuditLog::get_append_state(const SqliteDb& db,
+                                                             const std::string& trace_id) {
   std::lock_guard<std::mutex> lock(mutex_);
 
   // ── idx ──────────────────────────────────────────────────────────────────
@@ -116,7 +125,7 @@ SqliteAuditLog::AppendState SqliteAuditLog::get_append_state(const std::string&
   } else {
     // New trace: query DB for existing max index
     const char* idx_sql = "SELECT MAX(idx) FROM audit_events WHERE trace_id = ?";
-    PreparedStatement idx_stmt(db_->connection(), idx_sql);
+    auto idx_stmt = db.prepare(idx_sql);
     int max_idx = -1;
     if (idx_stmt.is_valid()) {
       sqlite3_bind_text(idx_stmt.get(), 1, trace_id.c_str(), -1, SQLITE_TRANSIENT);
@@ -135,7 +144,7 @@ SqliteAuditLog::AppendState SqliteAuditLog::get_append_state(const std::string&
   if (idx > 0) {
     const char* hash_sql =
         "SELECT event_hash FROM audit_events WHERE trace_id = ? ORDER BY idx DESC LIMIT 1";
-    PreparedStatement hash_stmt(db_->connection(), hash_sql);
+    auto hash_stmt = db.prepare(hash_sql);
     if (hash_stmt.is_valid()) {
       sqlite3_bind_text(hash_stmt.get(), 1, trace_id.c_str(), -1, SQLITE_TRANSIENT);
       if (sqlite3_step(hash_stmt.get()) == SQLITE_ROW) {
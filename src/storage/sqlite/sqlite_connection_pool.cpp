@@ -0,0 +1,129 @@
+#include "ccmcp/storage/sqlite/sqlite_connection_pool.h"
+
+#include <sqlite3.h>
+
+#include <utility>
+
+namespace ccmcp::storage::sqlite {
+
+using PoolResult = core::Result<std::shared_ptr<SqliteConnectionPool>, std::string>;
+
+PoolResult SqliteConnectionPool::open(const std::string& path, std::size_t reader_count,
+                                      const std::optional<SqliteTuning>& tuning) {
+  if (reader_count > 0 && (path.empty() || path == ":memory:")) {
+    return PoolResult::err("Reader connections require a database file, not '" + path + "'");
+  }
+  if (reader_count > 0 && !tuning.has_value()) {
+    return PoolResult::err("Reader connections require a tuning with journal_mode=wal");
+  }
+  if (reader_count > 0 && tuning->journal_mode != SqliteJournalMode::kWal) {
+    return PoolResult::err("Reader connections require journal_mode=wal, not " +
+                           std::string(to_string(tuning->journal_mode)));
+  }
+
+  auto writer = SqliteDb::open(path, tuning);
+  if (!writer.has_value()) {
+    return PoolResult::err(writer.error());
+  }
+
+  std::vector<std::shared_ptr<SqliteDb>> readers;
+  readers.reserve(reader_count);
+  for (std::size_t i = 0; i < reader_count; ++i) {
+    auto reader = SqliteDb::open(path, tuning);
+    if (!reader.has_value()) {
+      return PoolResult::err(reader.error());
+    }
+    auto query_only = reader.value()->exec("PRAGMA query_only = ON");
+    if (!query_only.has_value()) {
+      return PoolResult::err("Failed to make reader connection read-only: " +
+                             query_only.error());
+    }
+    readers.push_back(reader.value());
+  }
+
+  return PoolResult::ok(std::shared_ptr<SqliteConnectionPool>(
+      new SqliteConnectionPool(writer.value(), std::move(readers))));
+}
+
+SqliteConnectionPool::SqliteConnectionPool(std::shared_ptr<SqliteDb> writer)
+    : SqliteConnectionPool(std::move(writer), {}) {}
+
+SqliteConnectionPool::SqliteConnectionPool(std::shared_ptr<SqliteDb> writer,
+                                           std::vector<std::shared_ptr<SqliteDb>> readers)
+    : writer_(std::move(writer)), readers_(std::move(readers)) {
+  // sqlite3_db_mutex() is null unless the connection serializes its own API calls; only
+  // then may writer_data_version() use it without the writer lock.
+  if (sqlite3_db_mutex(writer_->connection()) != nullptr) {
+    data_version_stmt_ =
+        std::make_unique<PreparedStatement>(writer_->connection(), "PRAGMA data_version");
+    if (!data_version_stmt_->is_valid()) {
+      data_version_stmt_.reset();
+    }
+  }
+  idle_readers_.reserve(readers_.size());
+  for (std::size_t i = readers_.size(); i > 0; --i) {
+    idle_readers_.push_back(i - 1);  // back() is reader 0: leased first
+  }
+}
+
+ConnectionLease SqliteConnectionPool::read() const {
+  if (readers_.empty()) {
+    return write();
+  }
+  std::unique_lock<std::mutex> lock(readers_mutex_);
+  reader_released_.wait(lock, [this] { return !idle_readers_.empty(); });
+  const std::size_t index = idle_readers_.back();
+  idle_readers_.pop_back();
+  return {*this, readers_[index].get(), index};
+}
+
+ConnectionLease SqliteConnectionPool::write() const {
+  writer_mutex_.lock();  // released by the lease
+  return {*this, writer_.get(), ConnectionLease::kWriter};
+}
+
+std::uint64_t SqliteConnectionPool::writer_data_version() const {
+  const auto read_version = [](sqlite3_stmt* stmt) {
+    std::uint64_t version = 0;
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+      version = static_cast<std::uint64_t>(sqlite3_column_int64(stmt, 0));
+    }
+    sqlite3_reset(stmt);
+    return version;
+  };
+
+  if (data_version_stmt_ == nullptr) {
+    const auto conn = write();
+    auto stmt = conn->prepare("PRAGMA data_version");
+    return stmt.is_valid() ? read_version(stmt.get()) : 0;
+  }
+  std::lock_guard<std::mutex> lock(data_version_mutex_);
+  return read_version(data_version_stmt_->get());
+}
+
+std::size_t SqliteConnectionPool::idle_reader_count() const {
+  std::lock_guard<std::mutex> lock(readers_mutex_);
+  return idle_readers_.size();
+}
+
+void SqliteConnectionPool::release(const ConnectionLease& lease) const {
+  if (lease.is_writer()) {
+    writer_mutex_.unlock();
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(readers_mutex_);
+    idle_readers_.push_back(lease.reader_index_);
+  }
+  reader_released_.notify_one();
+}
+
+ConnectionLease::ConnectionLease(const SqliteConnectionPool& pool, SqliteDb* db,
+                                 std::size_t reader_index)
+    : pool_(pool), db_(db), reader_index_(reader_index) {}
+
+ConnectionLease::~ConnectionLease() {
+  pool_.release(*this);
+}
+
+}  // namespace ccmcp::storage::sqlite
@@ -1,9 +1,55 @@
 #include "ccmcp/storage/sqlite/sqlite_db.h"
 
+#include <functional>
+#include <mutex>
 #include <sqlite3.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace ccmcp::storage::sqlite {
 
+namespace {
+
+// Idle statements kept per SQL text; more simultaneous leases than this are finalized.
+constexpr std::size_t kMaxIdleStatementsPerSql = 4;
+
+// Transparent hash so prepare() looks SQL up without copying it into a std::string.
+struct SqlTextHash {
+  using is_transparent = void;
+  std::size_t operator()(std::string_view sql) const noexcept {
+    return std::hash<std::string_view>{}(sql);
+  }
+};
+
+}  // namespace
+
+// Idle prepared statements for one SQL text.
+struct CachedStatementSlot {
+  std::vector<sqlite3_stmt*> idle;
+};
+
+// Slots are never erased while the SqliteDb lives, so a lease's slot pointer stays valid.
+struct SqliteDb::StatementCache {
+  StatementCache() = default;
+  StatementCache(const StatementCache&) = delete;
+  StatementCache& operator=(const StatementCache&) = delete;
+  StatementCache(StatementCache&&) = delete;
+  StatementCache& operator=(StatementCache&&) = delete;
+
+  ~StatementCache() {
+    for (auto& [sql, slot] : slots) {
+      for (sqlite3_stmt* stmt : slot.idle) {
+        sqlite3_finalize(stmt);
+      }
+    }
+  }
+
+  std::mutex mutex;
+  std::size_t capacity{kDefaultStatementCacheCapacity};
+  std::unordered_map<std::string, CachedStatementSlot, SqlTextHash, std::equal_to<>> slots;
+};
+
 // Deleter implementations
 void SqliteDb::SqliteDeleter::operator()(sqlite3* db) const {
   if (db != nullptr) {
@@ -196,9 +242,56 @@ INSERT OR IGNORE INTO schema_version (version, applied_at)
 VALUES (4, datetime('now'));
 )";
 
-SqliteDb::SqliteDb(sqlite3* db) : db_(db) {}
+// Embedded schema v9 SQL (adds embedding_cache for CachingEmbeddingProvider)
+constexpr const char* kSchemaV9 = R"(
+CREATE TABLE IF NOT EXISTS embedding_cache (
+  provider_id TEXT NOT NULL,
+  model_id    TEXT NOT NULL,
+  text_hash   TEXT NOT NULL,
+  dimension   INTEGER NOT NULL,
+  vector_blob BLOB NOT NULL,
+  PRIMARY KEY (provider_id, model_id, text_hash)
+);
 
-core::Result<std::shared_ptr<SqliteDb>, std::string> SqliteDb::open(const std::string& path) {
+INSERT OR IGNORE INTO schema_version (version, applied_at)
+VALUES (9, datetime('now'));
+)";
+
+// Embedded schema v10 SQL (adds artifact_index_state, the latest completed index entry per
+// artifact and provider/model/prompt, backfilled from existing completed runs)
+constexpr const char* kSchemaV10 = R"(
+CREATE TABLE IF NOT EXISTS artifact_index_state (
+  provider_id TEXT NOT NULL,
+  model_id TEXT NOT NULL,
+  prompt_version TEXT NOT NULL,
+  artifact_type TEXT NOT NULL,
+  artifact_id TEXT NOT NULL,
+  source_hash TEXT NOT NULL,
+  vector_hash TEXT NOT NULL,
+  run_id TEXT NOT NULL,
+  PRIMARY KEY (provider_id, model_id, prompt_version, artifact_type, artifact_id)
+);
+
+INSERT OR REPLACE INTO artifact_index_state
+  (provider_id, model_id, prompt_version, artifact_type, artifact_id,
+   source_hash, vector_hash, run_id)
+SELECT ir.provider_id, ir.model_id, ir.prompt_version, ie.artifact_type, ie.artifact_id,
+       ie.source_hash, ie.vector_hash, ie.run_id
+FROM index_entries ie
+JOIN index_runs ir ON ie.run_id = ir.run_id
+WHERE ir.status = 'completed'
+ORDER BY ir.completed_at ASC, ir.rowid ASC;
+
+INSERT OR IGNORE INTO schema_version (version, applied_at)
+VALUES (10, datetime('now'));
+)";
+
+SqliteDb::SqliteDb(sqlite3* db) : db_(db), statements_(std::make_unique<StatementCache>()) {}
+
+SqliteDb::~SqliteDb() = default;
+
+core::Result<std::shared_ptr<SqliteDb>, std::string> SqliteDb::open(
+    const std::string& path, const std::optional<SqliteTuning>& tuning) {
   sqlite3* db = nullptr;
   int rc = sqlite3_open(path.c_str(), &db);
   if (rc != SQLITE_OK) {
@@ -219,6 +312,22 @@ core::Result<std::shared_ptr<SqliteDb>, std::string> SqliteDb::open(const std::s
         "Failed to enable foreign keys: " + error);
   }
 
+  if (!tuning.has_value()) {
+    return core::Result<std::shared_ptr<SqliteDb>, std::string>::ok(
+        std::shared_ptr<SqliteDb>(new SqliteDb(db)));
+  }
+
+  // Apply the performance profile (journal mode, synchronous, mmap, cache, busy timeout)
+  const std::string tuning_sql = sqlite_tuning_pragmas(*tuning);
+  rc = sqlite3_exec(db, tuning_sql.c_str(), nullptr, nullptr, &err_msg);
+  if (rc != SQLITE_OK) {
+    std::string error = err_msg != nullptr ? err_msg : "Unknown error";
+    sqlite3_free(err_msg);
+    sqlite3_close(db);
+    return core::Result<std::shared_ptr<SqliteDb>, std::string>::err(
+        "Failed to apply SQLite tuning: " + error);
+  }
+
   return core::Result<std::shared_ptr<SqliteDb>, std::string>::ok(
       std::shared_ptr<SqliteDb>(new SqliteDb(db)));
 }
@@ -434,6 +543,50 @@ core::Result<bool, std::string> SqliteDb::ensure_schema_v8() {
   return core::Result<bool, std::string>::ok(true);
 }
 
+core::Result<bool, std::string> SqliteDb::ensure_schema_v9() {
+  // Ensure v8 is applied first
+  auto v8_result = ensure_schema_v8();
+  if (!v8_result.has_value()) {
+    return v8_result;
+  }
+
+  if (get_schema_version() >= 9) {
+    return core::Result<bool, std::string>::ok(true);
+  }
+
+  char* err_msg = nullptr;
+  int rc = sqlite3_exec(db_.get(), kSchemaV9, nullptr, nullptr, &err_msg);
+  if (rc != SQLITE_OK) {
+    std::string error = err_msg != nullptr ? err_msg : "Unknown error";
+    sqlite3_free(err_msg);
+    return core::Result<bool, std::string>::err("Failed to apply schema v9: " + error);
+  }
+
+  return core::Result<bool, std::string>::ok(true);
+}
+
+core::Result<bool, std::string> SqliteDb::ensure_schema_v10() {
+  // Ensure v9 is applied first
+  auto v9_result = ensure_schema_v9();
+  if (!v9_result.has_value()) {
+    return v9_result;
+  }
+
+  if (get_schema_version() >= 10) {
+    return core::Result<bool, std::string>::ok(true);
+  }
+
+  char* err_msg = nullptr;
+  int rc = sqlite3_exec(db_.get(), kSchemaV10, nullptr, nullptr, &err_msg);
+  if (rc != SQLITE_OK) {
+    std::string error = err_msg != nullptr ? err_msg : "Unknown error";
+    sqlite3_free(err_msg);
+    return core::Result<bool, std::string>::err("Failed to apply schema v10: " + error);
+  }
+
+  return core::Result<bool, std::string>::ok(true);
+}
+
 core::Result<bool, std::string> SqliteDb::exec(const std::string& sql) {
   char* err_msg = nullptr;
   int rc = sqlite3_exec(db_.get(), sql.c_str(), nullptr, nullptr, &err_msg);
@@ -446,6 +599,81 @@ core::Result<bool, std::string> SqliteDb::exec(const std::string& sql) {
   return core::Result<bool, std::string>::ok(true);
 }
 
+StatementLease SqliteDb::prepare(std::string_view sql) const {
+  CachedStatementSlot* slot = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(statements_->mutex);
+    if (statements_->capacity == 0) {
+      // Caching disabled: fall through to a statement finalized on release.
+    } else if (auto it = statements_->slots.find(sql); it != statements_->slots.end()) {
+      slot = &it->second;
+      if (!slot->idle.empty()) {
+        sqlite3_stmt* stmt = slot->idle.back();
+        slot->idle.pop_back();
+        return StatementLease(*this, slot, stmt, {});
+      }
+    }
+  }
+
+  sqlite3_stmt* raw_stmt = nullptr;
+  const int rc = sqlite3_prepare_v2(db_.get(), sql.data(), static_cast<int>(sql.size()),
+                                    &raw_stmt, nullptr);
+  if (rc != SQLITE_OK) {
+    sqlite3_finalize(raw_stmt);
+    return StatementLease(*this, nullptr, nullptr, sqlite3_errmsg(db_.get()));
+  }
+
+  // Only SQL that prepared successfully gets a slot, so bad SQL never takes up capacity.
+  if (slot == nullptr) {
+    std::lock_guard<std::mutex> lock(statements_->mutex);
+    if (statements_->capacity > 0 && statements_->slots.size() < statements_->capacity) {
+      slot = &statements_->slots.try_emplace(std::string(sql)).first->second;
+    }
+  }
+  return StatementLease(*this, slot, raw_stmt, {});
+}
+
+std::size_t SqliteDb::cached_statement_count() const {
+  std::lock_guard<std::mutex> lock(statements_->mutex);
+  std::size_t count = 0;
+  for (const auto& [sql, slot] : statements_->slots) {
+    count += slot.idle.size();
+  }
+  return count;
+}
+
+void SqliteDb::set_statement_cache_capacity(std::size_t capacity) {
+  std::lock_guard<std::mutex> lock(statements_->mutex);
+  statements_->capacity = capacity;
+}
+
+StatementLease::StatementLease(const SqliteDb& db, CachedStatementSlot* slot, sqlite3_stmt* stmt,
+                               std::string error)
+    : db_(db), slot_(slot), stmt_(stmt), error_(std::move(error)) {}
+
+StatementLease::~StatementLease() {
+  if (stmt_ == nullptr) {
+    return;
+  }
+  sqlite3_reset(stmt_);
+  sqlite3_clear_bindings(stmt_);
+  if (slot_ != nullptr) {
+    std::lock_guard<std::mutex> lock(db_.statements_->mutex);
+    if (slot_->idle.size() < kMaxIdleStatementsPerSql) {
+      slot_->idle.push_back(stmt_);
+      return;
+    }
+  }
+  sqlite3_finalize(stmt_);
+}
+
+void StatementLease::reset() {
+  if (stmt_ != nullptr) {
+    sqlite3_reset(stmt_);
+    sqlite3_clear_bindings(stmt_);
+  }
+}
+
 PreparedStatement::PreparedStatement(sqlite3* db, const std::string& sql) {
   sqlite3_stmt* raw_stmt = nullptr;
   int rc = sqlite3_prepare_v2(db, sql.c_str(), -1, &raw_stmt, nullptr);
@@ -6,7 +6,11 @@
 
 namespace ccmcp::storage::sqlite {
 
-SqliteDecisionStore::SqliteDecisionStore(std::shared_ptr<SqliteDb> db) : db_(std::move(db)) {}
+SqliteDecisionStore::SqliteDecisionStore(std::shared_ptr<SqliteDb> db)
+    : SqliteDecisionStore(std::make_shared<SqliteConnectionPool>(std::move(db))) {}
+
+SqliteDecisionStore::SqliteDecisionStore(std::shared_ptr<SqliteConnectionPool> pool)
+    : pool_(std::move(pool)) {}
 
 void SqliteDecisionStore::upsert(const domain::DecisionRecord& record) {
   const char* sql = R"(
@@ -21,7 +25,8 @@ void SqliteDecisionStore::upsert(const domain::DecisionRecord& record) {
       created_at     = excluded.created_at
   )";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->write();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return;
   }
@@ -49,7 +54,8 @@ std::optional<domain::DecisionRecord> SqliteDecisionStore::get(
       "SELECT decision_id, trace_id, opportunity_id, artifact_id, decision_json, created_at "
       "FROM decision_records WHERE decision_id = ?";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return std::nullopt;
   }
@@ -69,7 +75,8 @@ std::vector<domain::DecisionRecord> SqliteDecisionStore::list_by_trace(
       "SELECT decision_id, trace_id, opportunity_id, artifact_id, decision_json, created_at "
       "FROM decision_records WHERE trace_id = ? ORDER BY decision_id";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return {};
   }
@@ -0,0 +1,131 @@
+#include "ccmcp/storage/sqlite/sqlite_embedding_cache_store.h"
+
+#include <cstring>
+#include <sqlite3.h>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace ccmcp::storage::sqlite {
+
+namespace {
+
+constexpr const char* kPutSql = R"(
+    INSERT INTO embedding_cache (provider_id, model_id, text_hash, dimension, vector_blob)
+    VALUES (?, ?, ?, ?, ?)
+    ON CONFLICT(provider_id, model_id, text_hash) DO UPDATE SET
+      dimension   = excluded.dimension,
+      vector_blob = excluded.vector_blob
+  )";
+
+// Binds one entry to a kPutSql statement and steps it; false on failure.
+bool step_put(sqlite3_stmt* stmt, const embedding::EmbeddingCacheKey& key,
+              const vector::Vector& embedding) {
+  sqlite3_bind_text(stmt, 1, key.provider_id.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt, 2, key.model_id.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt, 3, key.text_hash.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_int64(stmt, 4, static_cast<sqlite3_int64>(embedding.size()));
+  if (embedding.empty()) {
+    sqlite3_bind_zeroblob(stmt, 5, 0);  // a null data pointer would bind NULL
+  } else {
+    sqlite3_bind_blob(stmt, 5, embedding.data(),
+                      static_cast<int>(embedding.size() * sizeof(float)), SQLITE_TRANSIENT);
+  }
+  return sqlite3_step(stmt) == SQLITE_DONE;
+}
+
+}  // namespace
+
+SqliteEmbeddingCacheStore::SqliteEmbeddingCacheStore(std::shared_ptr<SqliteDb> db)
+    : SqliteEmbeddingCacheStore(std::make_shared<SqliteConnectionPool>(std::move(db))) {}
+
+SqliteEmbeddingCacheStore::SqliteEmbeddingCacheStore(std::shared_ptr<SqliteConnectionPool> pool)
+    : pool_(std::move(pool)) {}
+
+std::optional<vector::Vector> SqliteEmbeddingCacheStore::get(
+    const embedding::EmbeddingCacheKey& key) const {
+  const char* sql = R"(
+    SELECT dimension, vector_blob FROM embedding_cache
+    WHERE provider_id = ? AND model_id = ? AND text_hash = ?
+  )";
+
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
+  if (!stmt.is_valid()) {
+    return std::nullopt;
+  }
+
+  sqlite3_bind_text(stmt.get(), 1, key.provider_id.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt.get(), 2, key.model_id.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt.get(), 3, key.text_hash.c_str(), -1, SQLITE_TRANSIENT);
+
+  if (sqlite3_step(stmt.get()) != SQLITE_ROW) {
+    return std::nullopt;
+  }
+  const auto dimension = static_cast<std::size_t>(sqlite3_column_int64(stmt.get(), 0));
+  const void* blob = sqlite3_column_blob(stmt.get(), 1);
+  const auto bytes = static_cast<std::size_t>(sqlite3_column_bytes(stmt.get(), 1));
+  if (bytes != dimension * sizeof(float) || (dimension > 0 && blob == nullptr)) {
+    return std::nullopt;
+  }
+  vector::Vector embedding(dimension);
+  if (dimension > 0) {
+    std::memcpy(embedding.data(), blob, bytes);
+  }
+  return embedding;
+}
+
+void SqliteEmbeddingCacheStore::put(const embedding::EmbeddingCacheKey& key,
+                                    const vector::Vector& embedding) {
+  const auto conn = pool_->write();
+  auto stmt = conn->prepare(kPutSql);
+  if (!stmt.is_valid()) {
+    throw std::runtime_error("SqliteEmbeddingCacheStore::put failed to prepare: " + stmt.error());
+  }
+  if (!step_put(stmt.get(), key, embedding)) {
+    throw std::runtime_error("SqliteEmbeddingCacheStore::put failed: " +
+                             std::string(sqlite3_errmsg(conn->connection())));
+  }
+}
+
+void SqliteEmbeddingCacheStore::put_many(std::span<const embedding::EmbeddingCacheKey> keys,
+                                         std::span<const vector::Vector> embeddings) {
+  if (keys.size() != embeddings.size()) {
+    throw std::invalid_argument("SqliteEmbeddingCacheStore::put_many: keys and embeddings differ");
+  }
+  if (keys.empty()) {
+    return;
+  }
+
+  // One transaction for the batch: a single journal sync instead of one per vector.
+  const auto conn = pool_->write();
+  const auto begun = conn->exec("BEGIN IMMEDIATE");
+  if (!begun.has_value()) {
+    throw std::runtime_error("SqliteEmbeddingCacheStore::put_many failed to begin: " +
+                             begun.error());
+  }
+  std::string error;
+  {
+    auto stmt = conn->prepare(kPutSql);
+    if (!stmt.is_valid()) {
+      error = "failed to prepare: " + stmt.error();
+    }
+    for (std::size_t i = 0; error.empty() && i < keys.size(); ++i) {
+      if (!step_put(stmt.get(), keys[i], embeddings[i])) {
+        error = "failed: " + std::string(sqlite3_errmsg(conn->connection()));
+      }
+      stmt.reset();
+    }
+  }
+  if (error.empty()) {
+    const auto committed = conn->exec("COMMIT");
+    if (committed.has_value()) {
+      return;
+    }
+    error = "failed to commit: " + committed.error();
+  }
+  (void)conn->exec("ROLLBACK");
+  throw std::runtime_error("SqliteEmbeddingCacheStore::put_many " + error);
+}
+
+}  // namespace ccmcp::storage::sqlite
@@ -2,13 +2,20 @@
 
 #include "ccmcp/indexing/index_run.h"
 
+#include <cstddef>
 #include <sqlite3.h>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace ccmcp::storage::sqlite {
 
-SqliteIndexRunStore::SqliteIndexRunStore(std::shared_ptr<SqliteDb> db) : db_(std::move(db)) {}
+SqliteIndexRunStore::SqliteIndexRunStore(std::shared_ptr<SqliteDb> db)
+    : SqliteIndexRunStore(std::make_shared<SqliteConnectionPool>(std::move(db))) {}
+
+SqliteIndexRunStore::SqliteIndexRunStore(std::shared_ptr<SqliteConnectionPool> pool)
+    : pool_(std::move(pool)) {}
 
 void SqliteIndexRunStore::upsert_run(const indexing::IndexRun& run) {
   const char* sql = R"(
@@ -25,7 +32,8 @@ void SqliteIndexRunStore::upsert_run(const indexing::IndexRun& run) {
       summary_json   = excluded.summary_json
   )";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->write();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return;
   }
@@ -52,7 +60,33 @@ void SqliteIndexRunStore::upsert_run(const indexing::IndexRun& run) {
   sqlite3_bind_text(stmt.get(), 7, status_str.c_str(), -1, SQLITE_TRANSIENT);
   sqlite3_bind_text(stmt.get(), 8, run.summary_json.c_str(), -1, SQLITE_TRANSIENT);
 
-  sqlite3_step(stmt.get());
+  if (sqlite3_step(stmt.get()) != SQLITE_DONE ||
+      run.status != indexing::IndexRunStatus::kCompleted) {
+    return;
+  }
+
+  // A completed run's entries become the latest state of their artifacts.
+  const char* promote_sql = R"(
+    INSERT INTO artifact_index_state
+      (provider_id, model_id, prompt_version, artifact_type, artifact_id,
+       source_hash, vector_hash, run_id)
+    SELECT ir.provider_id, ir.model_id, ir.prompt_version, ie.artifact_type, ie.artifact_id,
+           ie.source_hash, ie.vector_hash, ie.run_id
+    FROM index_entries ie
+    JOIN index_runs ir ON ie.run_id = ir.run_id
+    WHERE ie.run_id = ?
+    ON CONFLICT(provider_id, model_id, prompt_version, artifact_type, artifact_id) DO UPDATE SET
+      source_hash = excluded.source_hash,
+      vector_hash = excluded.vector_hash,
+      run_id      = excluded.run_id
+  )";
+
+  auto promote = conn->prepare(promote_sql);
+  if (!promote.is_valid()) {
+    return;
+  }
+  sqlite3_bind_text(promote.get(), 1, run.run_id.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_step(promote.get());
 }
 
 void SqliteIndexRunStore::upsert_entry(const indexing::IndexEntry& entry) {
@@ -66,7 +100,8 @@ void SqliteIndexRunStore::upsert_entry(const indexing::IndexEntry& entry) {
       indexed_at   = excluded.indexed_at
   )";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->write();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return;
   }
@@ -83,13 +118,42 @@ void SqliteIndexRunStore::upsert_entry(const indexing::IndexEntry& entry) {
     sqlite3_bind_null(stmt.get(), 6);
   }
 
-  sqlite3_step(stmt.get());
+  if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
+    return;
+  }
+
+  // An entry added to an already-completed run updates the state at once; entries of a
+  // running run wait for upsert_run() to promote them.
+  const char* state_sql = R"(
+    INSERT INTO artifact_index_state
+      (provider_id, model_id, prompt_version, artifact_type, artifact_id,
+       source_hash, vector_hash, run_id)
+    SELECT provider_id, model_id, prompt_version, ?, ?, ?, ?, run_id
+    FROM index_runs
+    WHERE run_id = ? AND status = 'completed'
+    ON CONFLICT(provider_id, model_id, prompt_version, artifact_type, artifact_id) DO UPDATE SET
+      source_hash = excluded.source_hash,
+      vector_hash = excluded.vector_hash,
+      run_id      = excluded.run_id
+  )";
+
+  auto state = conn->prepare(state_sql);
+  if (!state.is_valid()) {
+    return;
+  }
+  sqlite3_bind_text(state.get(), 1, entry.artifact_type.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(state.get(), 2, entry.artifact_id.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(state.get(), 3, entry.source_hash.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(state.get(), 4, entry.vector_hash.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(state.get(), 5, entry.run_id.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_step(state.get());
 }
 
 std::optional<indexing::IndexRun> SqliteIndexRunStore::get_run(const std::string& run_id) const {
   const char* sql = "SELECT * FROM index_runs WHERE run_id = ?";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return std::nullopt;
   }
@@ -106,7 +170,8 @@ std::optional<indexing::IndexRun> SqliteIndexRunStore::get_run(const std::string
 std::vector<indexing::IndexRun> SqliteIndexRunStore::list_runs() const {
   const char* sql = "SELECT * FROM index_runs ORDER BY run_id";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return {};
   }
@@ -125,7 +190,8 @@ std::vector<indexing::IndexEntry> SqliteIndexRunStore::get_entries_for_run(
       "SELECT * FROM index_entries WHERE run_id = ? "
       "ORDER BY artifact_type, artifact_id";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return {};
   }
@@ -145,20 +211,17 @@ std::optional<std::string> SqliteIndexRunStore::get_last_source_hash(
     const std::string& provider_id, const std::string& model_id,
     const std::string& prompt_version) const {
   const char* sql = R"(
-    SELECT ie.source_hash
-    FROM index_entries ie
-    JOIN index_runs ir ON ie.run_id = ir.run_id
-    WHERE ie.artifact_id    = ?
-      AND ie.artifact_type  = ?
-      AND ir.provider_id    = ?
-      AND ir.model_id       = ?
-      AND ir.prompt_version = ?
-      AND ir.status         = 'completed'
-    ORDER BY ir.completed_at DESC
-    LIMIT 1
+    SELECT source_hash
+    FROM artifact_index_state
+    WHERE artifact_id    = ?
+      AND artifact_type  = ?
+      AND provider_id    = ?
+      AND model_id       = ?
+      AND prompt_version = ?
   )";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return std::nullopt;
   }
@@ -179,6 +242,72 @@ std::optional<std::string> SqliteIndexRunStore::get_last_source_hash(
   return std::nullopt;
 }
 
+indexing::ArtifactStateMap SqliteIndexRunStore::load_artifact_states(
+    const std::vector<std::string>& artifact_types, const std::string& provider_id,
+    const std::string& model_id, const std::string& prompt_version) const {
+  std::string sql = R"(
+    SELECT artifact_type, artifact_id, source_hash, vector_hash, run_id
+    FROM artifact_index_state
+    WHERE provider_id = ? AND model_id = ? AND prompt_version = ?
+  )";
+  if (!artifact_types.empty()) {
+    sql += "    AND artifact_type IN (?";
+    for (std::size_t i = 1; i < artifact_types.size(); ++i) {
+      sql += ", ?";
+    }
+    sql += ")\n";
+  }
+
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
+  if (!stmt.is_valid()) {
+    return {};
+  }
+
+  sqlite3_bind_text(stmt.get(), 1, provider_id.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt.get(), 2, model_id.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt.get(), 3, prompt_version.c_str(), -1, SQLITE_TRANSIENT);
+  for (std::size_t i = 0; i < artifact_types.size(); ++i) {
+    sqlite3_bind_text(stmt.get(), static_cast<int>(i + 4), artifact_types[i].c_str(), -1,
+                      SQLITE_TRANSIENT);
+  }
+
+  const auto column = [&stmt](int index) {
+    return std::string(reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), index)));
+  };
+  indexing::ArtifactStateMap states;
+  while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+    indexing::ArtifactIndexState state{column(0), column(1), column(2), column(3), column(4)};
+    std::string key = indexing::artifact_state_key(state.artifact_type, state.artifact_id);
+    states.emplace(std::move(key), std::move(state));
+  }
+  return states;
+}
+
+std::size_t SqliteIndexRunStore::prune_entries(std::size_t keep_runs) {
+  // LIMIT -1 OFFSET n selects every completed run after the n most recent ones.
+  const char* sql = R"(
+    DELETE FROM index_entries
+    WHERE run_id IN (
+      SELECT run_id FROM index_runs
+      WHERE status = 'completed'
+      ORDER BY completed_at DESC, rowid DESC
+      LIMIT -1 OFFSET ?
+    )
+  )";
+
+  const auto conn = pool_->write();
+  auto stmt = conn->prepare(sql);
+  if (!stmt.is_valid()) {
+    throw std::runtime_error("prune_entries: failed to prepare: " + stmt.error());
+  }
+  sqlite3_bind_int64(stmt.get(), 1, static_cast<sqlite3_int64>(keep_runs));
+  if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
+    throw std::runtime_error("prune_entries: " + std::string(sqlite3_errmsg(conn->connection())));
+  }
+  return static_cast<std::size_t>(sqlite3_changes(conn->connection()));
+}
+
 // Column order for SELECT * FROM index_runs:
 //   0: run_id, 1: started_at, 2: completed_at, 3: provider_id,
 //   4: model_id, 5: prompt_version, 6: status, 7: summary_json
@@ -215,7 +344,9 @@ std::string SqliteIndexRunStore::next_index_run_id() {
   // file-based database.
   char* err_msg = nullptr;
 
-  if (sqlite3_exec(db_->connection(), "BEGIN IMMEDIATE", nullptr, nullptr, &err_msg) != SQLITE_OK) {
+  const auto conn = pool_->write();
+  if (sqlite3_exec(conn->connection(), "BEGIN IMMEDIATE", nullptr, nullptr, &err_msg) !=
+      SQLITE_OK) {
     const std::string msg = err_msg != nullptr ? err_msg : "unknown error";
     sqlite3_free(err_msg);
     throw std::runtime_error("next_index_run_id: failed to begin transaction: " + msg);
@@ -226,29 +357,29 @@ std::string SqliteIndexRunStore::next_index_run_id() {
     INSERT INTO id_counters (name, value) VALUES ('index_run', 1)
     ON CONFLICT(name) DO UPDATE SET value = value + 1
   )";
-  if (sqlite3_exec(db_->connection(), upsert_sql, nullptr, nullptr, &err_msg) != SQLITE_OK) {
+  if (sqlite3_exec(conn->connection(), upsert_sql, nullptr, nullptr, &err_msg) != SQLITE_OK) {
     const std::string msg = err_msg != nullptr ? err_msg : "unknown error";
     sqlite3_free(err_msg);
-    sqlite3_exec(db_->connection(), "ROLLBACK", nullptr, nullptr, nullptr);
+    sqlite3_exec(conn->connection(), "ROLLBACK", nullptr, nullptr, nullptr);
     throw std::runtime_error("next_index_run_id: failed to increment counter: " + msg);
   }
 
   // Read the updated value.
   const char* select_sql = "SELECT value FROM id_counters WHERE name = 'index_run'";
-  PreparedStatement stmt(db_->connection(), select_sql);
+  auto stmt = conn->prepare(select_sql);
   if (!stmt.is_valid()) {
-    sqlite3_exec(db_->connection(), "ROLLBACK", nullptr, nullptr, nullptr);
+    sqlite3_exec(conn->connection(), "ROLLBACK", nullptr, nullptr, nullptr);
     throw std::runtime_error("next_index_run_id: failed to prepare select: " + stmt.error());
   }
 
   if (sqlite3_step(stmt.get()) != SQLITE_ROW) {
-    sqlite3_exec(db_->connection(), "ROLLBACK", nullptr, nullptr, nullptr);
+    sqlite3_exec(conn->connection(), "ROLLBACK", nullptr, nullptr, nullptr);
     throw std::runtime_error("next_index_run_id: counter row missing after upsert");
   }
 
   const long long value = sqlite3_column_int64(stmt.get(), 0);
 
-  if (sqlite3_exec(db_->connection(), "COMMIT", nullptr, nullptr, &err_msg) != SQLITE_OK) {
+  if (sqlite3_exec(conn->connection(), "COMMIT", nullptr, nullptr, &err_msg) != SQLITE_OK) {
     const std::string msg = err_msg != nullptr ? err_msg : "unknown error";
     sqlite3_free(err_msg);
     throw std::runtime_error("next_index_run_id: failed to commit: " + msg);
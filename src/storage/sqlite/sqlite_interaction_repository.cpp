@@ -5,7 +5,10 @@
 namespace ccmcp::storage::sqlite {
 
 SqliteInteractionRepository::SqliteInteractionRepository(std::shared_ptr<SqliteDb> db)
-    : db_(std::move(db)) {}
+    : SqliteInteractionRepository(std::make_shared<SqliteConnectionPool>(std::move(db))) {}
+
+SqliteInteractionRepository::SqliteInteractionRepository(std::shared_ptr<SqliteConnectionPool> pool)
+    : pool_(std::move(pool)) {}
 
 void SqliteInteractionRepository::upsert(const domain::Interaction& interaction) {
   const char* sql = R"(
@@ -17,7 +20,8 @@ void SqliteInteractionRepository::upsert(const domain::Interaction& interaction)
       state = excluded.state
   )";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->write();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return;
   }
@@ -34,7 +38,8 @@ std::optional<domain::Interaction> SqliteInteractionRepository::get(
     const core::InteractionId& id) const {
   const char* sql = "SELECT * FROM interactions WHERE interaction_id = ?";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return std::nullopt;
   }
@@ -52,7 +57,8 @@ std::vector<domain::Interaction> SqliteInteractionRepository::list_by_opportunit
     const core::OpportunityId& id) const {
   const char* sql = "SELECT * FROM interactions WHERE opportunity_id = ? ORDER BY interaction_id";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return {};
   }
@@ -70,7 +76,8 @@ std::vector<domain::Interaction> SqliteInteractionRepository::list_by_opportunit
 std::vector<domain::Interaction> SqliteInteractionRepository::list_all() const {
   const char* sql = "SELECT * FROM interactions ORDER BY interaction_id";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return {};
   }
@@ -0,0 +1,82 @@
+#include "ccmcp/storage/sqlite/sqlite_json.h"
+
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <optional>
+
+namespace ccmcp::storage::sqlite {
+
+namespace {
+
+bool is_space(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Single-pass parse of ["a","b",...] without escapes; nullopt if json is not of that form.
+std::optional<std::vector<std::string>> parse_plain_string_array(std::string_view json) {
+  std::size_t i = 0;
+  const auto skip_space = [&] {
+    while (i < json.size() && is_space(json[i])) {
+      ++i;
+    }
+  };
+
+  skip_space();
+  if (i == json.size() || json[i] != '[') {
+    return std::nullopt;
+  }
+  ++i;
+  skip_space();
+
+  std::vector<std::string> values;
+  if (i < json.size() && json[i] == ']') {
+    ++i;
+  } else {
+    while (true) {
+      if (i == json.size() || json[i] != '"') {
+        return std::nullopt;
+      }
+      const std::size_t begin = ++i;
+      while (i < json.size() && json[i] != '"') {
+        if (json[i] == '\\' || static_cast<unsigned char>(json[i]) < 0x20) {
+          return std::nullopt;  // escape sequence or raw control character
+        }
+        ++i;
+      }
+      if (i == json.size()) {
+        return std::nullopt;
+      }
+      values.emplace_back(json.substr(begin, i - begin));
+      ++i;
+      skip_space();
+      if (i < json.size() && json[i] == ',') {
+        ++i;
+        skip_space();
+        continue;
+      }
+      if (i < json.size() && json[i] == ']') {
+        ++i;
+        break;
+      }
+      return std::nullopt;
+    }
+  }
+
+  skip_space();
+  if (i != json.size()) {
+    return std::nullopt;
+  }
+  return values;
+}
+
+}  // namespace
+
+std::vector<std::string> parse_string_array(std::string_view json) {
+  if (auto values = parse_plain_string_array(json)) {
+    return std::move(*values);
+  }
+  return nlohmann::json::parse(json).get<std::vector<std::string>>();
+}
+
+}  // namespace ccmcp::storage::sqlite
@@ -1,20 +1,24 @@
 #include "ccmcp/storage/sqlite/sqlite_opportunity_repository.h"
 
+#include "ccmcp/storage/sqlite/sqlite_json.h"
+
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <optional>
 #include <sqlite3.h>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 namespace ccmcp::storage::sqlite {
 
-SqliteOpportunityRepository::SqliteOpportunityRepository(std::shared_ptr<SqliteDb> db)
-    : db_(std::move(db)) {}
-
-void SqliteOpportunityRepository::upsert(const domain::Opportunity& opportunity) {
-  // Begin transaction for atomic upsert
-  db_->exec("BEGIN TRANSACTION");
+namespace {
 
-  // Upsert opportunity
-  const char* opp_sql = R"(
+constexpr const char* kUpsertOpportunitySql = R"(
     INSERT INTO opportunities (opportunity_id, company, role_title, source)
     VALUES (?, ?, ?, ?)
     ON CONFLICT(opportunity_id) DO UPDATE SET
@@ -23,25 +27,210 @@ void SqliteOpportunityRepository::upsert(const domain::Opportunity& opportunity)
       source = excluded.source
   )";
 
-  PreparedStatement opp_stmt(db_->connection(), opp_sql);
-  if (!opp_stmt.is_valid()) {
-    db_->exec("ROLLBACK");
-    return;
+constexpr const char* kDeleteRequirementsSql =
+    "DELETE FROM requirements WHERE opportunity_id = ?";
+
+constexpr const char* kInsertRequirementSql = R"(
+    INSERT INTO requirements (opportunity_id, idx, text, tags_json, required)
+    VALUES (?, ?, ?, ?, ?)
+  )";
+
+// Rows per multi-row requirements INSERT in upsert_many: 5 parameters each, well below
+// SQLite's bound-parameter limit.
+constexpr std::size_t kRequirementBatchRows = 64;
+
+std::string insert_requirements_sql(std::size_t rows) {
+  std::string sql =
+      "INSERT INTO requirements (opportunity_id, idx, text, tags_json, required) VALUES ";
+  for (std::size_t i = 0; i < rows; ++i) {
+    sql += i == 0 ? "(?, ?, ?, ?, ?)" : ", (?, ?, ?, ?, ?)";
   }
+  return sql;
+}
+
+void bind_opportunity(sqlite3_stmt* stmt, const domain::Opportunity& opportunity) {
+  sqlite3_bind_text(stmt, 1, opportunity.opportunity_id.value.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt, 2, opportunity.company.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt, 3, opportunity.role_title.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt, 4, opportunity.source.c_str(), -1, SQLITE_TRANSIENT);
+}
+
+// One requirements row: requirement idx of opportunity.
+struct RequirementRow {
+  const domain::Opportunity* opportunity;  // NOLINT(readability-identifier-naming)
+  std::size_t idx;                         // NOLINT(readability-identifier-naming)
+};
+
+// Bind one requirements row starting at parameter first; returns the next free parameter.
+int bind_requirement(sqlite3_stmt* stmt, int first, const RequirementRow& row) {
+  const auto& req = row.opportunity->requirements[row.idx];
+  const std::string tags_json = nlohmann::json(req.tags).dump();
 
-  sqlite3_bind_text(opp_stmt.get(), 1, opportunity.opportunity_id.value.c_str(), -1,
+  sqlite3_bind_text(stmt, first, row.opportunity->opportunity_id.value.c_str(), -1,
                     SQLITE_TRANSIENT);
-  sqlite3_bind_text(opp_stmt.get(), 2, opportunity.company.c_str(), -1, SQLITE_TRANSIENT);
-  sqlite3_bind_text(opp_stmt.get(), 3, opportunity.role_title.c_str(), -1, SQLITE_TRANSIENT);
-  sqlite3_bind_text(opp_stmt.get(), 4, opportunity.source.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_int(stmt, first + 1, static_cast<int>(row.idx));
+  sqlite3_bind_text(stmt, first + 2, req.text.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt, first + 3, tags_json.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_int(stmt, first + 4, req.required ? 1 : 0);
+  return first + 5;
+}
+
+// Write opportunities inside the caller's transaction; false on the first failed statement.
+bool upsert_batch(const SqliteDb& db, const std::vector<domain::Opportunity>& opportunities) {
+  auto opp_stmt = db.prepare(kUpsertOpportunitySql);
+  auto del_stmt = db.prepare(kDeleteRequirementsSql);
+  auto req_stmt = db.prepare(kInsertRequirementSql);
+  static const std::string batch_sql = insert_requirements_sql(kRequirementBatchRows);
+  auto batch_stmt = db.prepare(batch_sql);
+  if (!opp_stmt.is_valid() || !del_stmt.is_valid() || !req_stmt.is_valid() ||
+      !batch_stmt.is_valid()) {
+    return false;
+  }
+
+  // Requirement rows are queued across opportunities and inserted kRequirementBatchRows at a
+  // time; the tail of the queue goes through the single-row statement.
+  std::vector<RequirementRow> pending;
+  pending.reserve(kRequirementBatchRows);
+  std::unordered_set<std::string_view> pending_ids;
+
+  const auto insert_full_batch = [&] {
+    int param = 1;
+    for (const auto& row : pending) {
+      param = bind_requirement(batch_stmt.get(), param, row);
+    }
+    const bool ok = sqlite3_step(batch_stmt.get()) == SQLITE_DONE;
+    batch_stmt.reset();
+    pending.clear();
+    pending_ids.clear();
+    return ok;
+  };
+  const auto insert_pending_rows = [&] {
+    for (const auto& row : pending) {
+      bind_requirement(req_stmt.get(), 1, row);
+      const bool ok = sqlite3_step(req_stmt.get()) == SQLITE_DONE;
+      req_stmt.reset();
+      if (!ok) {
+        return false;
+      }
+    }
+    pending.clear();
+    pending_ids.clear();
+    return true;
+  };
+
+  for (const auto& opportunity : opportunities) {
+    const std::string& id = opportunity.opportunity_id.value;
+    // A repeated id must see its earlier rows in the table, or DELETE would miss them.
+    if (pending_ids.count(id) > 0 && !insert_pending_rows()) {
+      return false;
+    }
+
+    bind_opportunity(opp_stmt.get(), opportunity);
+    const bool opp_ok = sqlite3_step(opp_stmt.get()) == SQLITE_DONE;
+    opp_stmt.reset();
+    sqlite3_bind_text(del_stmt.get(), 1, id.c_str(), -1, SQLITE_TRANSIENT);
+    const bool del_ok = opp_ok && sqlite3_step(del_stmt.get()) == SQLITE_DONE;
+    del_stmt.reset();
+    if (!del_ok) {
+      return false;
+    }
+
+    for (std::size_t i = 0; i < opportunity.requirements.size(); ++i) {
+      pending.push_back({&opportunity, i});
+      pending_ids.insert(id);
+      if (pending.size() == kRequirementBatchRows && !insert_full_batch()) {
+        return false;
+      }
+    }
+  }
+  return insert_pending_rows();
+}
+
+// Opportunities are read with their requirements in one statement: opportunities LEFT JOIN
+// requirements, ordered so that each opportunity's rows are adjacent and in idx order.
+// Columns 0-3 are the opportunity, 4-6 a requirement (NULL for an opportunity without any).
+std::string hydrate_sql(const std::string& where) {
+  return "SELECT o.opportunity_id, o.company, o.role_title, o.source, "
+         "r.text, r.tags_json, r.required "
+         "FROM opportunities o "
+         "LEFT JOIN requirements r ON r.opportunity_id = o.opportunity_id " +
+         where + " ORDER BY o.opportunity_id, r.idx";
+}
+
+// Ids bound per get_many statement. Each chunk reuses one cached statement.
+constexpr std::size_t kIdsPerLookup = 64;
+
+// "WHERE o.opportunity_id IN (?, ..., ?)" with n parameters.
+std::string in_list(std::size_t n) {
+  std::string where = "WHERE o.opportunity_id IN (";
+  for (std::size_t i = 0; i < n; ++i) {
+    where += i == 0 ? "?" : ", ?";
+  }
+  return where + ")";
+}
+
+std::string_view column_view(sqlite3_stmt* stmt, int column) {
+  const auto* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, column));
+  return {text, static_cast<std::size_t>(sqlite3_column_bytes(stmt, column))};
+}
+
+// Step a hydrate_sql statement to the end, calling emit(Opportunity&&) for each opportunity
+// once its last row has been read. Only one opportunity is held at a time.
+template <typename Emit>
+void hydrate(sqlite3_stmt* stmt, Emit emit) {
+  std::optional<domain::Opportunity> current;
+  while (sqlite3_step(stmt) == SQLITE_ROW) {
+    const std::string_view id = column_view(stmt, 0);
+    if (!current.has_value() || current->opportunity_id.value != id) {
+      if (current.has_value()) {
+        emit(std::move(*current));
+      }
+      current.emplace();
+      current->opportunity_id = core::OpportunityId{std::string(id)};
+      current->company = column_view(stmt, 1);
+      current->role_title = column_view(stmt, 2);
+      current->source = column_view(stmt, 3);
+    }
+    if (sqlite3_column_type(stmt, 4) == SQLITE_NULL) {
+      continue;  // no requirements
+    }
+    domain::Requirement req;
+    req.text = column_view(stmt, 4);
+    req.tags = parse_string_array(column_view(stmt, 5));
+    req.required = sqlite3_column_int(stmt, 6) != 0;
+    current->requirements.push_back(std::move(req));
+  }
+  if (current.has_value()) {
+    emit(std::move(*current));
+  }
+}
+
+}  // namespace
+
+SqliteOpportunityRepository::SqliteOpportunityRepository(std::shared_ptr<SqliteDb> db)
+    : SqliteOpportunityRepository(std::make_shared<SqliteConnectionPool>(std::move(db))) {}
+
+SqliteOpportunityRepository::SqliteOpportunityRepository(std::shared_ptr<SqliteConnectionPool> pool)
+    : pool_(std::move(pool)) {}
 
+void SqliteOpportunityRepository::upsert(const domain::Opportunity& opportunity) {
+  const auto conn = pool_->write();
+  // Begin transaction for atomic upsert
+  conn->exec("BEGIN TRANSACTION");
+
+  // Upsert opportunity
+  auto opp_stmt = conn->prepare(kUpsertOpportunitySql);
+  if (!opp_stmt.is_valid()) {
+    conn->exec("ROLLBACK");
+    return;
+  }
+  bind_opportunity(opp_stmt.get(), opportunity);
   sqlite3_step(opp_stmt.get());
 
   // Delete old requirements
-  const char* del_sql = "DELETE FROM requirements WHERE opportunity_id = ?";
-  PreparedStatement del_stmt(db_->connection(), del_sql);
+  auto del_stmt = conn->prepare(kDeleteRequirementsSql);
   if (!del_stmt.is_valid()) {
-    db_->exec("ROLLBACK");
+    conn->exec("ROLLBACK");
     return;
   }
 
@@ -50,114 +239,118 @@ void SqliteOpportunityRepository::upsert(const domain::Opportunity& opportunity)
   sqlite3_step(del_stmt.get());
 
   // Insert new requirements
-  const char* req_sql = R"(
-    INSERT INTO requirements (opportunity_id, idx, text, tags_json, required)
-    VALUES (?, ?, ?, ?, ?)
-  )";
-
-  PreparedStatement req_stmt(db_->connection(), req_sql);
+  auto req_stmt = conn->prepare(kInsertRequirementSql);
   if (!req_stmt.is_valid()) {
-    db_->exec("ROLLBACK");
+    conn->exec("ROLLBACK");
     return;
   }
 
   for (size_t i = 0; i < opportunity.requirements.size(); ++i) {
-    const auto& req = opportunity.requirements[i];
-    nlohmann::json tags_json = req.tags;
-
-    sqlite3_bind_text(req_stmt.get(), 1, opportunity.opportunity_id.value.c_str(), -1,
-                      SQLITE_TRANSIENT);
-    sqlite3_bind_int(req_stmt.get(), 2, static_cast<int>(i));
-    sqlite3_bind_text(req_stmt.get(), 3, req.text.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(req_stmt.get(), 4, tags_json.dump().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_int(req_stmt.get(), 5, req.required ? 1 : 0);
-
+    bind_requirement(req_stmt.get(), 1, {&opportunity, i});
     sqlite3_step(req_stmt.get());
     req_stmt.reset();
   }
 
-  db_->exec("COMMIT");
+  conn->exec("COMMIT");
+}
+
+std::size_t SqliteOpportunityRepository::upsert_many(
+    const std::vector<domain::Opportunity>& opportunities) {
+  if (opportunities.empty()) {
+    return 0;
+  }
+
+  const auto conn = pool_->write();
+  if (!conn->exec("BEGIN IMMEDIATE").has_value()) {
+    return 0;
+  }
+  if (!upsert_batch(*conn, opportunities)) {
+    (void)conn->exec("ROLLBACK");
+    return 0;
+  }
+  if (!conn->exec("COMMIT").has_value()) {
+    (void)conn->exec("ROLLBACK");
+    return 0;
+  }
+  return opportunities.size();
 }
 
 std::optional<domain::Opportunity> SqliteOpportunityRepository::get(
     const core::OpportunityId& id) const {
-  const char* sql = "SELECT * FROM opportunities WHERE opportunity_id = ?";
+  static const std::string sql = hydrate_sql("WHERE o.opportunity_id = ?");
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return std::nullopt;
   }
 
   sqlite3_bind_text(stmt.get(), 1, id.value.c_str(), -1, SQLITE_TRANSIENT);
 
-  if (sqlite3_step(stmt.get()) == SQLITE_ROW) {
-    domain::Opportunity opp;
-    opp.opportunity_id =
-        core::OpportunityId{reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 0))};
-    opp.company = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 1));
-    opp.role_title = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 2));
-    opp.source = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 3));
-
-    opp.requirements = load_requirements(id);
+  std::optional<domain::Opportunity> result;
+  hydrate(stmt.get(), [&](domain::Opportunity&& opp) { result = std::move(opp); });
+  return result;
+}
 
-    return opp;
+std::vector<std::optional<domain::Opportunity>> SqliteOpportunityRepository::get_many(
+    const std::vector<core::OpportunityId>& ids) const {
+  std::vector<std::optional<domain::Opportunity>> result(ids.size());
+  if (ids.empty()) {
+    return result;
   }
 
-  return std::nullopt;
-}
+  // Positions in ids of each distinct id, so repeated ids are looked up once.
+  std::unordered_map<std::string_view, std::vector<std::size_t>> positions;
+  std::vector<std::string_view> distinct;
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    auto& at = positions[ids[i].value];
+    if (at.empty()) {
+      distinct.push_back(ids[i].value);
+    }
+    at.push_back(i);
+  }
 
-std::vector<domain::Opportunity> SqliteOpportunityRepository::list_all() const {
-  const char* sql = "SELECT * FROM opportunities ORDER BY opportunity_id";
+  static const std::string sql = hydrate_sql(in_list(kIdsPerLookup));
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
-    return {};
+    return result;
   }
 
-  std::vector<domain::Opportunity> result;
-  while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
-    domain::Opportunity opp;
-    opp.opportunity_id =
-        core::OpportunityId{reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 0))};
-    opp.company = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 1));
-    opp.role_title = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 2));
-    opp.source = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 3));
-
-    opp.requirements = load_requirements(opp.opportunity_id);
-
-    result.push_back(opp);
+  for (std::size_t first = 0; first < distinct.size(); first += kIdsPerLookup) {
+    // Unused parameters stay NULL, which matches no row.
+    const std::size_t count = std::min(kIdsPerLookup, distinct.size() - first);
+    for (std::size_t i = 0; i < count; ++i) {
+      const std::string_view id = distinct[first + i];
+      sqlite3_bind_text(stmt.get(), static_cast<int>(i + 1), id.data(),
+                        static_cast<int>(id.size()), SQLITE_TRANSIENT);
+    }
+    hydrate(stmt.get(), [&](domain::Opportunity&& opp) {
+      const auto& at = positions.at(opp.opportunity_id.value);
+      for (std::size_t k = 1; k < at.size(); ++k) {
+        result[at[k]] = opp;
+      }
+      result[at.front()] = std::move(opp);
+    });
+    stmt.reset();
   }
 
   return result;
 }
 
-std::vector<domain::Requirement> SqliteOpportunityRepository::load_requirements(
-    const core::OpportunityId& id) const {
-  const char* sql =
-      "SELECT text, tags_json, required FROM requirements WHERE opportunity_id = ? ORDER BY idx";
+std::vector<domain::Opportunity> SqliteOpportunityRepository::list_all() const {
+  static const std::string sql = hydrate_sql("");
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return {};
   }
 
-  sqlite3_bind_text(stmt.get(), 1, id.value.c_str(), -1, SQLITE_TRANSIENT);
-
-  std::vector<domain::Requirement> requirements;
-  while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
-    domain::Requirement req;
-    req.text = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 0));
-
-    std::string tags_json_str = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 1));
-    nlohmann::json tags_json = nlohmann::json::parse(tags_json_str);
-    req.tags = tags_json.get<std::vector<std::string>>();
-
-    req.required = sqlite3_column_int(stmt.get(), 2) != 0;
-
-    requirements.push_back(req);
-  }
-
-  return requirements;
+  std::vector<domain::Opportunity> result;
+  hydrate(stmt.get(), [&](domain::Opportunity&& opp) { result.push_back(std::move(opp)); });
+  return result;
 }
 
 }  // namespace ccmcp::storage::sqlite
@@ -4,11 +4,16 @@
 
 namespace ccmcp::storage::sqlite {
 
-SqliteResumeStore::SqliteResumeStore(std::shared_ptr<SqliteDb> db) : db_(std::move(db)) {}
+SqliteResumeStore::SqliteResumeStore(std::shared_ptr<SqliteDb> db)
+    : SqliteResumeStore(std::make_shared<SqliteConnectionPool>(std::move(db))) {}
+
+SqliteResumeStore::SqliteResumeStore(std::shared_ptr<SqliteConnectionPool> pool)
+    : pool_(std::move(pool)) {}
 
 void SqliteResumeStore::upsert(const ingest::IngestedResume& resume) {
+  const auto conn = pool_->write();
   // Begin transaction
-  db_->exec("BEGIN TRANSACTION");
+  conn->exec("BEGIN TRANSACTION");
 
   // Upsert resume
   const char* resume_sql = R"(
@@ -20,9 +25,9 @@ void SqliteResumeStore::upsert(const ingest::IngestedResume& resume) {
       created_at = excluded.created_at
   )";
 
-  PreparedStatement resume_stmt(db_->connection(), resume_sql);
+  auto resume_stmt = conn->prepare(resume_sql);
   if (!resume_stmt.is_valid()) {
-    db_->exec("ROLLBACK");
+    conn->exec("ROLLBACK");
     return;  // Silent failure for upsert
   }
 
@@ -33,7 +38,7 @@ void SqliteResumeStore::upsert(const ingest::IngestedResume& resume) {
   sqlite3_bind_text(resume_stmt.get(), 4, created_at.c_str(), -1, SQLITE_TRANSIENT);
 
   if (sqlite3_step(resume_stmt.get()) != SQLITE_DONE) {
-    db_->exec("ROLLBACK");
+    conn->exec("ROLLBACK");
     return;
   }
 
@@ -49,9 +54,9 @@ void SqliteResumeStore::upsert(const ingest::IngestedResume& resume) {
       ingestion_version = excluded.ingestion_version
   )";
 
-  PreparedStatement meta_stmt(db_->connection(), meta_sql);
+  auto meta_stmt = conn->prepare(meta_sql);
   if (!meta_stmt.is_valid()) {
-    db_->exec("ROLLBACK");
+    conn->exec("ROLLBACK");
     return;
   }
 
@@ -73,18 +78,19 @@ void SqliteResumeStore::upsert(const ingest::IngestedResume& resume) {
                     SQLITE_TRANSIENT);
 
   if (sqlite3_step(meta_stmt.get()) != SQLITE_DONE) {
-    db_->exec("ROLLBACK");
+    conn->exec("ROLLBACK");
     return;
   }
 
   // Commit transaction
-  db_->exec("COMMIT");
+  conn->exec("COMMIT");
 }
 
 std::optional<ingest::IngestedResume> SqliteResumeStore::get(const core::ResumeId& id) const {
   const char* sql = "SELECT * FROM resumes WHERE resume_id = ?";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return std::nullopt;
   }
@@ -92,7 +98,7 @@ std::optional<ingest::IngestedResume> SqliteResumeStore::get(const core::ResumeI
   sqlite3_bind_text(stmt.get(), 1, id.value.c_str(), -1, SQLITE_TRANSIENT);
 
   if (sqlite3_step(stmt.get()) == SQLITE_ROW) {
-    return row_to_resume(stmt.get());
+    return row_to_resume(*conn, stmt.get());
   }
 
   return std::nullopt;
@@ -102,7 +108,8 @@ std::optional<ingest::IngestedResume> SqliteResumeStore::get_by_hash(
     const std::string& resume_hash) const {
   const char* sql = "SELECT * FROM resumes WHERE resume_hash = ?";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return std::nullopt;
   }
@@ -110,7 +117,7 @@ std::optional<ingest::IngestedResume> SqliteResumeStore::get_by_hash(
   sqlite3_bind_text(stmt.get(), 1, resume_hash.c_str(), -1, SQLITE_TRANSIENT);
 
   if (sqlite3_step(stmt.get()) == SQLITE_ROW) {
-    return row_to_resume(stmt.get());
+    return row_to_resume(*conn, stmt.get());
   }
 
   return std::nullopt;
@@ -119,20 +126,22 @@ std::optional<ingest::IngestedResume> SqliteResumeStore::get_by_hash(
 std::vector<ingest::IngestedResume> SqliteResumeStore::list_all() const {
   const char* sql = "SELECT * FROM resumes ORDER BY resume_id";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return {};
   }
 
   std::vector<ingest::IngestedResume> result;
   while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
-    result.push_back(row_to_resume(stmt.get()));
+    result.push_back(row_to_resume(*conn, stmt.get()));
   }
 
   return result;
 }
 
-ingest::IngestedResume SqliteResumeStore::row_to_resume(sqlite3_stmt* stmt) const {
+ingest::IngestedResume SqliteResumeStore::row_to_resume(const SqliteDb& db,
+                                                        sqlite3_stmt* stmt) const {
   ingest::IngestedResume resume;
 
   // Extract resume_id from column 0
@@ -152,15 +161,16 @@ ingest::IngestedResume SqliteResumeStore::row_to_resume(sqlite3_stmt* stmt) cons
   resume.created_at = std::string(reinterpret_cast<const char*>(created_at_text));
 
   // Fetch meta separately
-  resume.meta = get_meta(resume.resume_id.value);
+  resume.meta = get_meta(db, resume.resume_id.value);
 
   return resume;
 }
 
-ingest::ResumeMeta SqliteResumeStore::get_meta(const std::string& resume_id) const {
+ingest::ResumeMeta SqliteResumeStore::get_meta(const SqliteDb& db,
+                                               const std::string& resume_id) const {
   const char* sql = "SELECT * FROM resume_meta WHERE resume_id = ?";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  auto stmt = db.prepare(sql);
   ingest::ResumeMeta meta;
 
   if (!stmt.is_valid()) {
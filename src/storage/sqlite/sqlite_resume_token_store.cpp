@@ -8,7 +8,11 @@
 
 namespace ccmcp::storage::sqlite {
 
-SqliteResumeTokenStore::SqliteResumeTokenStore(std::shared_ptr<SqliteDb> db) : db_(std::move(db)) {}
+SqliteResumeTokenStore::SqliteResumeTokenStore(std::shared_ptr<SqliteDb> db)
+    : SqliteResumeTokenStore(std::make_shared<SqliteConnectionPool>(std::move(db))) {}
+
+SqliteResumeTokenStore::SqliteResumeTokenStore(std::shared_ptr<SqliteConnectionPool> pool)
+    : pool_(std::move(pool)) {}
 
 void SqliteResumeTokenStore::upsert(const std::string& token_ir_id, const core::ResumeId& resume_id,
                                     const domain::ResumeTokenIR& token_ir) {
@@ -20,7 +24,8 @@ void SqliteResumeTokenStore::upsert(const std::string& token_ir_id, const core::
       created_at = excluded.created_at
   )";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->write();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return;  // Silent failure for upsert
   }
@@ -38,7 +43,8 @@ std::optional<domain::ResumeTokenIR> SqliteResumeTokenStore::get(
     const std::string& token_ir_id) const {
   const char* sql = "SELECT token_ir_json FROM resume_token_ir WHERE token_ir_id = ?";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return std::nullopt;
   }
@@ -56,7 +62,8 @@ std::optional<domain::ResumeTokenIR> SqliteResumeTokenStore::get_by_resume(
     const core::ResumeId& resume_id) const {
   const char* sql = "SELECT token_ir_json FROM resume_token_ir WHERE resume_id = ?";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return std::nullopt;
   }
@@ -73,7 +80,8 @@ std::optional<domain::ResumeTokenIR> SqliteResumeTokenStore::get_by_resume(
 std::vector<domain::ResumeTokenIR> SqliteResumeTokenStore::list_all() const {
   const char* sql = "SELECT token_ir_json FROM resume_token_ir ORDER BY token_ir_id";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return {};
   }
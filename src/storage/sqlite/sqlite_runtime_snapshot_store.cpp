@@ -7,7 +7,10 @@
 namespace ccmcp::storage::sqlite {
 
 SqliteRuntimeSnapshotStore::SqliteRuntimeSnapshotStore(std::shared_ptr<SqliteDb> db)
-    : db_(std::move(db)) {}
+    : SqliteRuntimeSnapshotStore(std::make_shared<SqliteConnectionPool>(std::move(db))) {}
+
+SqliteRuntimeSnapshotStore::SqliteRuntimeSnapshotStore(std::shared_ptr<SqliteConnectionPool> pool)
+    : pool_(std::move(pool)) {}
 
 void SqliteRuntimeSnapshotStore::save(const std::string& run_id, const std::string& snapshot_json,
                                       const std::string& snapshot_hash,
@@ -17,7 +20,8 @@ void SqliteRuntimeSnapshotStore::save(const std::string& run_id, const std::stri
     VALUES (?, ?, ?, ?)
   )";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->write();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     throw std::runtime_error("SqliteRuntimeSnapshotStore::save failed to prepare: " + stmt.error());
   }
@@ -30,7 +34,7 @@ void SqliteRuntimeSnapshotStore::save(const std::string& run_id, const std::stri
   const int rc = sqlite3_step(stmt.get());
   if (rc != SQLITE_DONE) {
     throw std::runtime_error("SqliteRuntimeSnapshotStore::save failed: " +
-                             std::string(sqlite3_errmsg(db_->connection())));
+                             std::string(sqlite3_errmsg(conn->connection())));
   }
 }
 
@@ -38,7 +42,8 @@ std::optional<std::string> SqliteRuntimeSnapshotStore::get_snapshot_json(
     const std::string& run_id) const {
   const char* sql = "SELECT snapshot_json FROM runtime_snapshots WHERE run_id = ?";
 
-  PreparedStatement stmt(db_->connection(), sql);
+  const auto conn = pool_->read();
+  auto stmt = conn->prepare(sql);
   if (!stmt.is_valid()) {
     return std::nullopt;
   }
@@ -0,0 +1,179 @@
+#include "ccmcp/storage/sqlite_tuning.h"
+
+namespace ccmcp::storage {
+
+SqliteTuning sqlite_tuning_for(SqliteTuningProfile profile) {
+  // Every profile uses WAL, so reader connections run alongside the writer.
+  SqliteTuning tuning;  // SQLite's defaults
+  tuning.journal_mode = SqliteJournalMode::kWal;
+  tuning.busy_timeout_ms = 5000;
+  switch (profile) {
+    case SqliteTuningProfile::kDurable:
+      break;  // synchronous=full, no mmap, SQLite's cache and temp store
+    case SqliteTuningProfile::kBalanced:
+      tuning.synchronous = SqliteSynchronous::kNormal;
+      tuning.mmap_size = std::size_t{256} << 20;
+      tuning.cache_size_kib = 65536;
+      tuning.temp_store = SqliteTempStore::kMemory;
+      break;
+    case SqliteTuningProfile::kBulkLoad:
+      tuning.synchronous = SqliteSynchronous::kOff;
+      tuning.mmap_size = std::size_t{1} << 30;
+      tuning.cache_size_kib = 262144;
+      tuning.temp_store = SqliteTempStore::kMemory;
+      tuning.busy_timeout_ms = 30000;
+      tuning.wal_autocheckpoint = 10000;
+      break;
+  }
+  return tuning;
+}
+
+SqliteTuning resolve(const SqliteTuningConfig& config) {
+  SqliteTuning tuning = sqlite_tuning_for(config.profile);
+  tuning.journal_mode = config.journal_mode.value_or(tuning.journal_mode);
+  tuning.synchronous = config.synchronous.value_or(tuning.synchronous);
+  tuning.mmap_size = config.mmap_size.value_or(tuning.mmap_size);
+  tuning.cache_size_kib = config.cache_size_kib.value_or(tuning.cache_size_kib);
+  tuning.temp_store = config.temp_store.value_or(tuning.temp_store);
+  tuning.busy_timeout_ms = config.busy_timeout_ms.value_or(tuning.busy_timeout_ms);
+  tuning.wal_autocheckpoint = config.wal_autocheckpoint.value_or(tuning.wal_autocheckpoint);
+  return tuning;
+}
+
+std::vector<std::pair<std::string, std::string>> sqlite_tuning_settings(
+    const SqliteTuning& tuning) {
+  return {
+      {"busy_timeout", std::to_string(tuning.busy_timeout_ms)},
+      {"journal_mode", std::string(to_string(tuning.journal_mode))},
+      {"synchronous", std::string(to_string(tuning.synchronous))},
+      {"mmap_size", std::to_string(tuning.mmap_size)},
+      {"cache_size", "-" + std::to_string(tuning.cache_size_kib)},
+      {"temp_store", std::string(to_string(tuning.temp_store))},
+      {"wal_autocheckpoint", std::to_string(tuning.wal_autocheckpoint)},
+  };
+}
+
+std::string sqlite_tuning_pragmas(const SqliteTuning& tuning) {
+  std::string sql;
+  for (const auto& [pragma, value] : sqlite_tuning_settings(tuning)) {
+    sql += "PRAGMA " + pragma + " = " + value + ";\n";
+  }
+  return sql;
+}
+
+std::optional<SqliteTuningProfile> parse_sqlite_tuning_profile(const std::string& s) {
+  if (s == "durable") {
+    return SqliteTuningProfile::kDurable;
+  }
+  if (s == "balanced") {
+    return SqliteTuningProfile::kBalanced;
+  }
+  if (s == "bulk-load") {
+    return SqliteTuningProfile::kBulkLoad;
+  }
+  return std::nullopt;
+}
+
+std::optional<SqliteJournalMode> parse_sqlite_journal_mode(const std::string& s) {
+  if (s == "delete") {
+    return SqliteJournalMode::kDelete;
+  }
+  if (s == "truncate") {
+    return SqliteJournalMode::kTruncate;
+  }
+  if (s == "persist") {
+    return SqliteJournalMode::kPersist;
+  }
+  if (s == "memory") {
+    return SqliteJournalMode::kMemory;
+  }
+  if (s == "wal") {
+    return SqliteJournalMode::kWal;
+  }
+  return std::nullopt;
+}
+
+std::optional<SqliteSynchronous> parse_sqlite_synchronous(const std::string& s) {
+  if (s == "off") {
+    return SqliteSynchronous::kOff;
+  }
+  if (s == "normal") {
+    return SqliteSynchronous::kNormal;
+  }
+  if (s == "full") {
+    return SqliteSynchronous::kFull;
+  }
+  if (s == "extra") {
+    return SqliteSynchronous::kExtra;
+  }
+  return std::nullopt;
+}
+
+std::optional<SqliteTempStore> parse_sqlite_temp_store(const std::string& s) {
+  if (s == "default") {
+    return SqliteTempStore::kDefault;
+  }
+  if (s == "file") {
+    return SqliteTempStore::kFile;
+  }
+  if (s == "memory") {
+    return SqliteTempStore::kMemory;
+  }
+  return std::nullopt;
+}
+
+std::string_view to_string(SqliteTuningProfile profile) {
+  switch (profile) {
+    case SqliteTuningProfile::kDurable:
+      return "durable";
+    case SqliteTuningProfile::kBalanced:
+      return "balanced";
+    case SqliteTuningProfile::kBulkLoad:
+      return "bulk-load";
+  }
+  return "unknown";  // unreachable — all enumerators covered above
+}
+
+std::string_view to_string(SqliteJournalMode mode) {
+  switch (mode) {
+    case SqliteJournalMode::kDelete:
+      return "delete";
+    case SqliteJournalMode::kTruncate:
+      return "truncate";
+    case SqliteJournalMode::kPersist:
+      return "persist";
+    case SqliteJournalMode::kMemory:
+      return "memory";
+    case SqliteJournalMode::kWal:
+      return "wal";
+  }
+  return "unknown";  // unreachable — all enumerators covered above
+}
+
+std::string_view to_string(SqliteSynchronous mode) {
+  switch (mode) {
+    case SqliteSynchronous::kOff:
+      return "off";
+    case SqliteSynchronous::kNormal:
+      return "normal";
+    case SqliteSynchronous::kFull:
+      return "full";
+    case SqliteSynchronous::kExtra:
+      return "extra";
+  }
+  return "unknown";  // unreachable — all enumerators covered above
+}
+
+std::string_view to_string(SqliteTempStore mode) {
+  switch (mode) {
+    case SqliteTempStore::kDefault:
+      return "default";
+    case SqliteTempStore::kFile:
+      return "file";
+    case SqliteTempStore::kMemory:
+      return "memory";
+  }
+  return "unknown";  // unreachable — all enumerators covered above
+}
+
+}  // namespace ccmcp::storage
@@ -0,0 +1,204 @@
+#include "ccmcp/vector/flat_vector_store.h"
+
+#include "ccmcp/vector/top_k.h"
+#include "ccmcp/vector/vector_math.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace ccmcp::vector {
+
+namespace {
+
+// Rows scored per math::dot_block() call; bounds the score buffer.
+constexpr std::size_t kScoreChunkRows = 256;
+
+// Queries scored together against each chunk of rows by query_batch().
+constexpr std::size_t kQueryBlock = 16;
+
+std::size_t padded_stride(const std::size_t dim) {
+  constexpr std::size_t kUnit = FlatVectorStore::kRowAlignmentFloats;
+  return (dim + kUnit - 1) / kUnit * kUnit;
+}
+
+}  // namespace
+
+void FlatVectorStore::upsert(const VectorKey& key, const Vector& embedding,
+                             const std::string& metadata) {
+  const std::size_t dim = embedding.size();
+  const auto [it, inserted] = ids_.try_emplace(key, static_cast<std::uint32_t>(keys_.size()));
+  const std::uint32_t id = it->second;
+
+  if (!inserted) {
+    metadata_[id] = metadata;
+    const Location loc = locations_[id];
+    if (loc.dim == dim) {
+      write_row(blocks_.at(dim), loc.row, embedding);
+      return;
+    }
+    remove_row(loc.dim, loc.row);
+  } else {
+    keys_.push_back(key);
+    metadata_.push_back(metadata);
+    locations_.push_back(Location{dim, 0});
+  }
+
+  auto [block_it, created] = blocks_.try_emplace(dim);
+  Block& block = block_it->second;
+  if (created) {
+    block.stride = padded_stride(dim);
+  }
+  const std::size_t row = block.norms.size();
+  block.rows.resize((row + 1) * block.stride, 0.0F);
+  block.norms.push_back(0.0);
+  block.entries.push_back(id);
+  write_row(block, row, embedding);
+  locations_[id] = Location{dim, row};
+}
+
+void FlatVectorStore::reserve(const std::size_t count, const std::size_t dim) {
+  const std::size_t entries = keys_.size() + count;
+  keys_.reserve(entries);
+  metadata_.reserve(entries);
+  locations_.reserve(entries);
+  ids_.reserve(entries);
+
+  auto [block_it, created] = blocks_.try_emplace(dim);
+  Block& block = block_it->second;
+  if (created) {
+    block.stride = padded_stride(dim);
+  }
+  const std::size_t rows = block.norms.size() + count;
+  block.rows.reserve(rows * block.stride);
+  block.norms.reserve(rows);
+  block.entries.reserve(rows);
+}
+
+std::optional<Vector> FlatVectorStore::get(const VectorKey& key) const {
+  const auto it = ids_.find(key);
+  if (it == ids_.end()) {
+    return std::nullopt;
+  }
+  const Location loc = locations_[it->second];
+  const Block& block = blocks_.at(loc.dim);
+  const float* row = block.rows.data() + loc.row * block.stride;
+  return Vector(row, row + loc.dim);
+}
+
+const std::string* FlatVectorStore::metadata(const VectorKey& key) const {
+  const auto it = ids_.find(key);
+  return it != ids_.end() ? &metadata_[it->second] : nullptr;
+}
+
+std::vector<VectorSearchResult> FlatVectorStore::query(const Vector& query_vector,
+                                                       const std::size_t top_k) const {
+  return std::move(query_batch(std::span(&query_vector, 1), top_k).front());
+}
+
+std::vector<std::vector<VectorSearchResult>> FlatVectorStore::query_batch(
+    std::span<const Vector> queries, const std::size_t top_k) const {
+  std::vector<std::vector<VectorSearchResult>> results(queries.size());
+  if (top_k == 0 || queries.empty()) {
+    return results;
+  }
+
+  std::vector<double> query_norms;
+  std::vector<TopKSelector> selectors;
+  query_norms.reserve(queries.size());
+  selectors.reserve(queries.size());
+  for (const auto& query : queries) {
+    query_norms.push_back(math::l2_norm(query.data(), query.size()));
+    selectors.emplace_back(top_k);
+  }
+
+  const auto consider = [&](const std::size_t q, const double score, const std::uint32_t id) {
+    if (selectors[q].accepts(score, keys_[id])) {
+      selectors[q].push(
+          VectorSearchResult{.key = keys_[id], .score = score, .metadata = metadata_[id]});
+    }
+  };
+
+  // Every query visits blocks, and rows within a block, in the same order as a lone query.
+  std::vector<std::size_t> scored;  // indices of the queries scored against this block
+  std::vector<const float*> block_queries;
+  std::vector<double> dots(std::min(kQueryBlock, queries.size()) * kScoreChunkRows);
+  for (const auto& [block_dim, block] : blocks_) {
+    const std::size_t rows = block.norms.size();
+
+    // Only queries of the block's dimension can score above 0.0.
+    scored.clear();
+    for (std::size_t q = 0; q < queries.size(); ++q) {
+      if (block_dim > 0 && queries[q].size() == block_dim && query_norms[q] != 0.0) {
+        scored.push_back(q);
+        continue;
+      }
+      for (std::size_t r = 0; r < rows; ++r) {
+        consider(q, 0.0, block.entries[r]);
+      }
+    }
+
+    for (std::size_t first_query = 0; first_query < scored.size(); first_query += kQueryBlock) {
+      const std::size_t num_queries = std::min(kQueryBlock, scored.size() - first_query);
+      block_queries.clear();
+      for (std::size_t i = 0; i < num_queries; ++i) {
+        block_queries.push_back(queries[scored[first_query + i]].data());
+      }
+      for (std::size_t first = 0; first < rows; first += kScoreChunkRows) {
+        const std::size_t count = std::min(kScoreChunkRows, rows - first);
+        math::dot_block(block_queries.data(), num_queries,
+                        block.rows.data() + first * block.stride, block.stride, count, block_dim,
+                        dots.data());
+        for (std::size_t i = 0; i < num_queries; ++i) {
+          const std::size_t q = scored[first_query + i];
+          for (std::size_t r = 0; r < count; ++r) {
+            consider(q,
+                     math::cosine_from_dot(dots[i * count + r], query_norms[q],
+                                           block.norms[first + r]),
+                     block.entries[first + r]);
+          }
+        }
+      }
+    }
+  }
+
+  for (std::size_t q = 0; q < queries.size(); ++q) {
+    results[q] = selectors[q].take_sorted();
+  }
+  return results;
+}
+
+std::size_t FlatVectorStore::vector_bytes() const noexcept {
+  std::size_t bytes = 0;
+  for (const auto& [dim, block] : blocks_) {
+    bytes += block.rows.size() * sizeof(float) + block.norms.size() * sizeof(double);
+  }
+  return bytes;
+}
+
+void FlatVectorStore::write_row(Block& block, const std::size_t row, const Vector& embedding) {
+  float* dst = block.rows.data() + row * block.stride;
+  std::copy(embedding.begin(), embedding.end(), dst);
+  block.norms[row] = math::l2_norm(embedding.data(), embedding.size());
+}
+
+void FlatVectorStore::remove_row(const std::size_t dim, const std::size_t row) {
+  auto it = blocks_.find(dim);
+  Block& block = it->second;
+  const std::size_t last = block.norms.size() - 1;
+  if (row != last) {
+    // Move the last row into the hole so the matrix stays dense.
+    float* rows = block.rows.data();
+    std::copy_n(rows + last * block.stride, block.stride, rows + row * block.stride);
+    block.norms[row] = block.norms[last];
+    block.entries[row] = block.entries[last];
+    locations_[block.entries[row]].row = row;
+  }
+  block.rows.resize(last * block.stride);
+  block.norms.pop_back();
+  block.entries.pop_back();
+  if (block.norms.empty()) {
+    blocks_.erase(it);
+  }
+}
+
+}  // namespace ccmcp::vector
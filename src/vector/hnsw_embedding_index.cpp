@@ -0,0 +1,687 @@
+#include "ccmcp/vector/hnsw_embedding_index.h"
+
+#include "ccmcp/vector/top_k.h"
+#include "ccmcp/vector/vector_math.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+namespace ccmcp::vector {
+
+namespace {
+
+constexpr std::array<char, 8> kFileMagic = {'C', 'C', 'M', 'C', 'H', 'N', 'S', 'W'};
+// Version 2 stores one graph per namespace; version 1 files (a single graph over legacy
+// prefixed keys) are still read and migrated.
+constexpr std::uint32_t kFileFormatVersion = 2;
+constexpr std::uint32_t kLegacyFileFormatVersion = 1;
+
+// Level cap; with m >= 2 a level above this has probability < 2^-32 per node.
+constexpr int kMaxLevel = 32;
+
+// L2 norm from the same kernels as FlatVectorStore (InMemoryEmbeddingIndex), so that the
+// scores this index returns are bit-identical to the exact backend's.
+double vector_norm(const Vector& v) {
+  return math::l2_norm(v.data(), v.size());
+}
+
+// Draws a node level from the exponential distribution floor(-ln(U) * ml), U in (0, 1].
+// U is derived from the raw 64-bit engine output (not std::uniform_real_distribution, whose
+// algorithm is implementation-defined) so the levels are identical on every platform.
+int draw_level(std::mt19937_64& rng, const double ml) {
+  const double u = static_cast<double>((rng() >> 11) + 1) * 0x1.0p-53;
+  const double level = std::floor(-std::log(u) * ml);
+  return level >= kMaxLevel ? kMaxLevel : static_cast<int>(level);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Binary file helpers (native byte order, like SqliteEmbeddingIndex blobs)
+// ─────────────────────────────────────────────────────────────────────────────
+
+template <typename T>
+void write_pod(std::ofstream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void write_string(std::ofstream& out, const std::string& s) {
+  write_pod(out, static_cast<std::uint32_t>(s.size()));
+  out.write(s.data(), static_cast<std::streamsize>(s.size()));
+}
+
+}  // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// VisitedSet
+// ─────────────────────────────────────────────────────────────────────────────
+
+class HnswEmbeddingIndex::VisitedSet {
+ public:
+  // Starts a new search over n nodes; all nodes become unvisited in O(1) (amortised).
+  void reset(const std::size_t n) {
+    if (marks_.size() < n) {
+      marks_.resize(n, 0);
+    }
+    if (++epoch_ == 0) {  // wrapped: clear stale marks once
+      std::fill(marks_.begin(), marks_.end(), 0);
+      epoch_ = 1;
+    }
+  }
+
+  // Marks node visited; returns false if it already was.
+  bool insert(const std::uint32_t node) {
+    if (marks_[node] == epoch_) {
+      return false;
+    }
+    marks_[node] = epoch_;
+    return true;
+  }
+
+ private:
+  std::vector<std::uint32_t> marks_;
+  std::uint32_t epoch_{0};
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// FileReader
+// ─────────────────────────────────────────────────────────────────────────────
+
+class HnswEmbeddingIndex::FileReader {
+ public:
+  FileReader(std::ifstream& in, std::string path) : in_(in), path_(std::move(path)) {}
+
+  template <typename T>
+  T pod() {
+    T value{};
+    in_.read(reinterpret_cast<char*>(&value), sizeof(T));
+    check();
+    return value;
+  }
+
+  std::string string() {
+    std::string s(pod<std::uint32_t>(), '\0');
+    in_.read(s.data(), static_cast<std::streamsize>(s.size()));
+    check();
+    return s;
+  }
+
+  Vector floats() {
+    Vector v(pod<std::uint32_t>());
+    in_.read(reinterpret_cast<char*>(v.data()), static_cast<std::streamsize>(v.size() * 4));
+    check();
+    return v;
+  }
+
+  [[noreturn]] void fail(const std::string& what) const {
+    throw std::runtime_error("HnswEmbeddingIndex: malformed index file '" + path_ + "': " + what);
+  }
+
+ private:
+  void check() const {
+    if (!in_) {
+      fail("unexpected end of file");
+    }
+  }
+
+  std::ifstream& in_;
+  std::string path_;
+};
+
+namespace {
+
+// Search order: higher similarity first, then lower node index (= key order).
+struct Better {
+  template <typename C>
+  bool operator()(const C& a, const C& b) const noexcept {
+    if (a.similarity != b.similarity) {
+      return a.similarity > b.similarity;
+    }
+    return a.node < b.node;
+  }
+};
+
+struct Worse {
+  template <typename C>
+  bool operator()(const C& a, const C& b) const noexcept {
+    return Better{}(b, a);
+  }
+};
+
+}  // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Construction / destruction
+// ─────────────────────────────────────────────────────────────────────────────
+
+HnswEmbeddingIndex::HnswEmbeddingIndex(HnswConfig config) : config_(config) {
+  if (config_.m < 2) {
+    throw std::invalid_argument("HnswEmbeddingIndex: m must be at least 2");
+  }
+  config_.ef_construction = std::max(config_.ef_construction, config_.m);
+}
+
+HnswEmbeddingIndex::HnswEmbeddingIndex(HnswConfig config, std::string file_path)
+    : HnswEmbeddingIndex(config) {
+  file_path_ = std::move(file_path);
+  load();
+}
+
+HnswEmbeddingIndex::~HnswEmbeddingIndex() {
+  if (!file_dirty_) {
+    return;  // a stale file is rewritten only by an explicit save()
+  }
+  try {
+    save();
+  } catch (...) {
+    // Best effort: the index is a derived store and can be rebuilt with index-build.
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// IEmbeddingIndex interface
+// ─────────────────────────────────────────────────────────────────────────────
+
+void HnswEmbeddingIndex::upsert(VectorNamespace ns, const VectorKey& key,
+                                const Vector& embedding, const std::string& metadata) {
+  std::unique_lock<std::shared_mutex> lock(graph_mutex_);
+  upsert_entry(partitions_.try_emplace(std::string(ns)).first->second, key, embedding,
+               metadata);
+}
+
+void HnswEmbeddingIndex::upsert_many(VectorNamespace ns, std::span<const VectorRecord> records) {
+  if (records.empty()) {
+    return;
+  }
+  std::unique_lock<std::shared_mutex> lock(graph_mutex_);
+  Partition& partition = partitions_.try_emplace(std::string(ns)).first->second;
+  for (const auto& record : records) {
+    upsert_entry(partition, record.key, record.embedding, record.metadata);
+  }
+}
+
+void HnswEmbeddingIndex::upsert_entry(Partition& partition, const VectorKey& key,
+                                      const Vector& embedding, const std::string& metadata) {
+  auto& entries = partition.entries;
+  auto it = entries.find(key);
+  if (it != entries.end() && it->second.embedding == embedding) {
+    // Same vector: the graph is unaffected; only metadata may change.
+    if (it->second.metadata != metadata) {
+      it->second.metadata = metadata;
+      file_dirty_ = true;
+    }
+    return;
+  }
+
+  entries.insert_or_assign(key, Entry{embedding, metadata});
+  partition.graph_dirty = true;
+  file_dirty_ = true;
+}
+
+std::vector<VectorSearchResult> HnswEmbeddingIndex::query(VectorNamespace ns,
+                                                          const Vector& query_vector,
+                                                          size_t top_k) const {
+  if (top_k == 0) {
+    return {};
+  }
+  {
+    std::shared_lock<std::shared_mutex> lock(graph_mutex_);
+    const Partition* partition = find_partition(ns);
+    if (partition == nullptr) {
+      return {};
+    }
+    if (!partition->graph_dirty) {
+      return search(partition->graph, query_vector, top_k);
+    }
+  }
+  std::unique_lock<std::shared_mutex> lock(graph_mutex_);
+  const Partition* partition = find_partition(ns);
+  if (partition == nullptr) {
+    return {};
+  }
+  ensure_graph(*partition);
+  return search(partition->graph, query_vector, top_k);
+}
+
+std::vector<std::vector<VectorSearchResult>> HnswEmbeddingIndex::query_batch(
+    VectorNamespace ns, std::span<const Vector> queries, size_t top_k) const {
+  std::vector<std::vector<VectorSearchResult>> results;
+  results.reserve(queries.size());
+  for (const auto& query_vector : queries) {
+    results.push_back(query(ns, query_vector, top_k));
+  }
+  return results;
+}
+
+std::optional<Vector> HnswEmbeddingIndex::get(VectorNamespace ns, const VectorKey& key) const {
+  std::shared_lock<std::shared_mutex> lock(graph_mutex_);
+  const Partition* partition = find_partition(ns);
+  if (partition == nullptr) {
+    return std::nullopt;
+  }
+  auto it = partition->entries.find(key);
+  if (it == partition->entries.end()) {
+    return std::nullopt;
+  }
+  return it->second.embedding;
+}
+
+std::size_t HnswEmbeddingIndex::size() const {
+  std::shared_lock<std::shared_mutex> lock(graph_mutex_);
+  std::size_t total = 0;
+  for (const auto& [ns, partition] : partitions_) {
+    total += partition.entries.size();
+  }
+  return total;
+}
+
+void HnswEmbeddingIndex::save() {
+  if (!file_path_.has_value() || (!file_dirty_ && !file_stale_)) {
+    return;
+  }
+  std::unique_lock<std::shared_mutex> lock(graph_mutex_);
+  for (const auto& [ns, partition] : partitions_) {
+    ensure_graph(partition);
+  }
+  write_file();
+  file_dirty_ = false;
+  file_stale_ = false;
+}
+
+const HnswEmbeddingIndex::Partition* HnswEmbeddingIndex::find_partition(
+    VectorNamespace ns) const {
+  const auto it = partitions_.find(ns);
+  return it != partitions_.end() ? &it->second : nullptr;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Graph construction
+// ─────────────────────────────────────────────────────────────────────────────
+
+void HnswEmbeddingIndex::ensure_graph(const Partition& partition) const {
+  if (partition.graph_dirty) {
+    build_graph(partition);
+    partition.graph_dirty = false;
+  }
+}
+
+void HnswEmbeddingIndex::build_graph(const Partition& partition) const {
+  Graph& graph = partition.graph;
+  graph = Graph{};
+  graph.nodes.reserve(partition.entries.size());
+  graph.norms.reserve(partition.entries.size());
+  for (const auto& entry : partition.entries) {  // ascending key order
+    graph.nodes.push_back(&entry);
+    graph.norms.push_back(vector_norm(entry.second.embedding));
+  }
+  graph.links.resize(graph.nodes.size());
+
+  // Every partition draws levels from a freshly seeded generator, so its graph depends on
+  // its own entries only.
+  std::mt19937_64 rng(config_.seed);
+  const double ml = 1.0 / std::log(static_cast<double>(config_.m));
+  VisitedSet visited;
+  for (std::uint32_t node = 0; node < graph.nodes.size(); ++node) {
+    insert_node(graph, node, draw_level(rng, ml), visited);
+  }
+}
+
+void HnswEmbeddingIndex::insert_node(Graph& graph, const std::uint32_t node, const int level,
+                                     VisitedSet& visited) const {
+  graph.links[node].resize(static_cast<std::size_t>(level) + 1);
+  if (graph.max_level < 0) {
+    graph.entry_point = node;
+    graph.max_level = level;
+    return;
+  }
+
+  const Vector& vec = graph.nodes[node]->second.embedding;
+  const double norm = graph.norms[node];
+
+  // Greedy descent through the layers above the new node's level.
+  std::vector<Candidate> entry_points{
+      Candidate{similarity(graph, vec, norm, graph.entry_point), graph.entry_point}};
+  for (int lc = graph.max_level; lc > level; --lc) {
+    entry_points = search_layer(graph, vec, norm, entry_points, 1, lc, visited);
+  }
+
+  for (int lc = std::min(level, graph.max_level); lc >= 0; --lc) {
+    auto found = search_layer(graph, vec, norm, entry_points, config_.ef_construction, lc, visited);
+    auto& own_links = graph.links[node][static_cast<std::size_t>(lc)];
+    own_links = select_neighbours(graph, found, config_.m);
+    for (const std::uint32_t neighbour : own_links) {
+      graph.links[neighbour][static_cast<std::size_t>(lc)].push_back(node);
+      shrink_links(graph, neighbour, lc);
+    }
+    entry_points = std::move(found);
+  }
+
+  if (level > graph.max_level) {
+    graph.entry_point = node;
+    graph.max_level = level;
+  }
+}
+
+std::vector<std::uint32_t> HnswEmbeddingIndex::select_neighbours(
+    const Graph& graph, const std::vector<Candidate>& candidates,
+    const std::size_t max_count) const {
+  // Diversity heuristic (HNSW paper, algorithm 4): walk candidates best-first and keep one
+  // only if it is more similar to the base than to every neighbour already kept.
+  std::vector<std::uint32_t> selected;
+  selected.reserve(max_count);
+  for (const auto& candidate : candidates) {
+    if (selected.size() >= max_count) {
+      break;
+    }
+    const Vector& vec = graph.nodes[candidate.node]->second.embedding;
+    const double norm = graph.norms[candidate.node];
+    const bool diverse = std::none_of(selected.begin(), selected.end(), [&](std::uint32_t kept) {
+      return similarity(graph, vec, norm, kept) > candidate.similarity;
+    });
+    if (diverse) {
+      selected.push_back(candidate.node);
+    }
+  }
+  return selected;
+}
+
+void HnswEmbeddingIndex::shrink_links(Graph& graph, const std::uint32_t node,
+                                      const int level) const {
+  auto& links = graph.links[node][static_cast<std::size_t>(level)];
+  if (links.size() <= max_links(level)) {
+    return;
+  }
+  const Vector& vec = graph.nodes[node]->second.embedding;
+  const double norm = graph.norms[node];
+  std::vector<Candidate> candidates;
+  candidates.reserve(links.size());
+  for (const std::uint32_t neighbour : links) {
+    candidates.push_back(Candidate{similarity(graph, vec, norm, neighbour), neighbour});
+  }
+  std::sort(candidates.begin(), candidates.end(), Better{});
+  links = select_neighbours(graph, candidates, max_links(level));
+}
+
+std::size_t HnswEmbeddingIndex::max_links(const int level) const noexcept {
+  return level == 0 ? 2 * config_.m : config_.m;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Search
+// ─────────────────────────────────────────────────────────────────────────────
+
+double HnswEmbeddingIndex::similarity(const Graph& graph, const Vector& query,
+                                      const double query_norm, const std::uint32_t node) const {
+  const Vector& vec = graph.nodes[node]->second.embedding;
+  if (query.size() != vec.size() || query.empty()) {
+    return 0.0;
+  }
+  const double node_norm = graph.norms[node];
+  if (query_norm == 0.0 || node_norm == 0.0) {
+    return 0.0;
+  }
+  return math::cosine_from_dot(math::dot(query.data(), vec.data(), query.size()), query_norm,
+                               node_norm);
+}
+
+std::vector<HnswEmbeddingIndex::Candidate> HnswEmbeddingIndex::search_layer(
+    const Graph& graph, const Vector& query, const double query_norm,
+    const std::vector<Candidate>& entry_points, const std::size_t ef, const int level,
+    VisitedSet& visited) const {
+  visited.reset(graph.nodes.size());
+
+  // frontier: best candidate on top. found: worst kept result on top, at most ef entries.
+  std::priority_queue<Candidate, std::vector<Candidate>, Worse> frontier;
+  std::priority_queue<Candidate, std::vector<Candidate>, Better> found;
+  for (const auto& ep : entry_points) {
+    if (visited.insert(ep.node)) {
+      frontier.push(ep);
+      found.push(ep);
+      if (found.size() > ef) {
+        found.pop();
+      }
+    }
+  }
+
+  while (!frontier.empty()) {
+    const Candidate current = frontier.top();
+    if (found.size() >= ef && Better{}(found.top(), current)) {
+      break;  // every remaining frontier node is worse than the worst kept result
+    }
+    frontier.pop();
+
+    for (const std::uint32_t neighbour :
+         graph.links[current.node][static_cast<std::size_t>(level)]) {
+      if (!visited.insert(neighbour)) {
+        continue;
+      }
+      const Candidate next{similarity(graph, query, query_norm, neighbour), neighbour};
+      if (found.size() < ef || Better{}(next, found.top())) {
+        frontier.push(next);
+        found.push(next);
+        if (found.size() > ef) {
+          found.pop();
+        }
+      }
+    }
+  }
+
+  std::vector<Candidate> result(found.size());
+  for (auto it = result.rbegin(); it != result.rend(); ++it) {
+    *it = found.top();
+    found.pop();
+  }
+  return result;  // best first
+}
+
+std::vector<VectorSearchResult> HnswEmbeddingIndex::search(const Graph& graph,
+                                                           const Vector& query_vector,
+                                                           const std::size_t top_k) const {
+  if (graph.max_level < 0) {
+    return {};
+  }
+
+  // One visited set per thread, reused across queries (and across index instances).
+  thread_local VisitedSet visited;
+
+  const double query_norm = vector_norm(query_vector);
+  std::vector<Candidate> entry_points{Candidate{
+      similarity(graph, query_vector, query_norm, graph.entry_point), graph.entry_point}};
+  for (int lc = graph.max_level; lc > 0; --lc) {
+    entry_points = search_layer(graph, query_vector, query_norm, entry_points, 1, lc, visited);
+  }
+  const auto found = search_layer(graph, query_vector, query_norm, entry_points,
+                                  std::max(config_.ef_search, top_k), 0, visited);
+
+  TopKSelector selector(top_k);
+  for (const auto& candidate : found) {
+    const auto& [key, entry] = *graph.nodes[candidate.node];
+    if (selector.accepts(candidate.similarity, key)) {
+      selector.push(VectorSearchResult{
+          .key = key, .score = candidate.similarity, .metadata = entry.metadata});
+    }
+  }
+  return selector.take_sorted();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Persistence
+// ─────────────────────────────────────────────────────────────────────────────
+
+void HnswEmbeddingIndex::write_file() const {
+  const std::string& path = file_path_.value();
+  const std::string tmp_path = path + ".tmp";
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      throw std::runtime_error("HnswEmbeddingIndex: cannot write '" + tmp_path + "'");
+    }
+    out.write(kFileMagic.data(), kFileMagic.size());
+    write_pod(out, kFileFormatVersion);
+    write_pod(out, static_cast<std::uint64_t>(config_.m));
+    write_pod(out, static_cast<std::uint64_t>(config_.ef_construction));
+    write_pod(out, config_.seed);
+    write_pod(out, static_cast<std::uint32_t>(partitions_.size()));
+
+    for (const auto& [ns, partition] : partitions_) {  // ascending namespace order
+      const Graph& graph = partition.graph;
+      write_string(out, ns);
+      write_pod(out, static_cast<std::uint64_t>(graph.nodes.size()));
+      write_pod(out, static_cast<std::int32_t>(graph.max_level));
+      write_pod(out, graph.entry_point);
+
+      for (std::size_t node = 0; node < graph.nodes.size(); ++node) {
+        const auto& [key, entry] = *graph.nodes[node];
+        write_string(out, key);
+        write_string(out, entry.metadata);
+        write_pod(out, static_cast<std::uint32_t>(entry.embedding.size()));
+        out.write(reinterpret_cast<const char*>(entry.embedding.data()),
+                  static_cast<std::streamsize>(entry.embedding.size() * sizeof(float)));
+        write_pod(out, static_cast<std::uint32_t>(graph.links[node].size()));
+        for (const auto& layer : graph.links[node]) {
+          write_pod(out, static_cast<std::uint32_t>(layer.size()));
+          out.write(reinterpret_cast<const char*>(layer.data()),
+                    static_cast<std::streamsize>(layer.size() * sizeof(std::uint32_t)));
+        }
+      }
+    }
+    out.flush();
+    if (!out) {
+      throw std::runtime_error("HnswEmbeddingIndex: write failed for '" + tmp_path + "'");
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmp_path, path, ec);
+  if (ec) {
+    throw std::runtime_error("HnswEmbeddingIndex: cannot replace '" + path + "': " + ec.message());
+  }
+}
+
+void HnswEmbeddingIndex::load() {
+  const std::string& path = file_path_.value();
+  if (!std::filesystem::exists(path)) {
+    return;  // new index; the file is created by the first save()
+  }
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error("HnswEmbeddingIndex: cannot open '" + path + "'");
+  }
+  FileReader reader(in, path);
+
+  std::array<char, 8> magic{};
+  in.read(magic.data(), magic.size());
+  if (!in || magic != kFileMagic) {
+    reader.fail("not an HNSW index file");
+  }
+  const auto version = reader.pod<std::uint32_t>();
+  if (version != kFileFormatVersion && version != kLegacyFileFormatVersion) {
+    reader.fail("unsupported format version");
+  }
+  const auto file_m = reader.pod<std::uint64_t>();
+  const auto file_ef_construction = reader.pod<std::uint64_t>();
+  const auto file_seed = reader.pod<std::uint64_t>();
+  const bool same_build = file_m == config_.m &&
+                          file_ef_construction == config_.ef_construction &&
+                          file_seed == config_.seed;
+
+  if (version == kLegacyFileFormatVersion) {
+    // One graph over every artifact: split its entries into partitions by key prefix and
+    // rebuild each graph on first use; save() rewrites the file in the current format.
+    Partition legacy;
+    read_partition(reader, in, legacy);
+    for (auto& [key, entry] : legacy.entries) {
+      const auto [ns, ns_key] = split_legacy_key(key);
+      Partition& partition = partitions_.try_emplace(std::string(ns)).first->second;
+      partition.entries.insert_or_assign(std::string(ns_key), std::move(entry));
+      partition.graph_dirty = true;
+    }
+    file_stale_ = true;
+    return;
+  }
+
+  const auto partition_count = reader.pod<std::uint32_t>();
+  for (std::uint32_t p = 0; p < partition_count; ++p) {
+    std::string ns = reader.string();
+    if (!partitions_.empty() && !(partitions_.rbegin()->first < ns)) {
+      reader.fail("namespaces out of order");
+    }
+    Partition& partition = partitions_.emplace_hint(partitions_.end(), std::move(ns),
+                                                    Partition{})
+                               ->second;
+    read_partition(reader, in, partition);
+    if (!same_build) {
+      partition.graph_dirty = true;
+    }
+  }
+  if (!same_build) {
+    // Built with other parameters: rebuild on first use and rewrite the file on save().
+    file_stale_ = true;
+  }
+}
+
+void HnswEmbeddingIndex::read_partition(FileReader& reader, std::ifstream& in,
+                                        Partition& partition) {
+  const auto count = reader.pod<std::uint64_t>();
+  const auto max_level = reader.pod<std::int32_t>();
+  const auto entry_point = reader.pod<std::uint32_t>();
+
+  EntryMap& entries = partition.entries;
+  Graph graph;
+  graph.max_level = max_level;
+  graph.entry_point = entry_point;
+  for (std::uint64_t node = 0; node < count; ++node) {
+    std::string key = reader.string();
+    Entry entry;
+    entry.metadata = reader.string();
+    entry.embedding = reader.floats();
+
+    // Nodes are stored in key order; anything else means the graph ids are meaningless.
+    if (!entries.empty() && !(entries.rbegin()->first < key)) {
+      reader.fail("keys out of order");
+    }
+    const auto it = entries.emplace_hint(entries.end(), std::move(key), std::move(entry));
+    graph.nodes.push_back(&*it);
+    graph.norms.push_back(vector_norm(it->second.embedding));
+
+    auto& layers = graph.links.emplace_back(reader.pod<std::uint32_t>());
+    if (layers.empty() || layers.size() > static_cast<std::size_t>(kMaxLevel) + 1) {
+      reader.fail("invalid node level");
+    }
+    for (auto& layer : layers) {
+      layer.resize(reader.pod<std::uint32_t>());
+      in.read(reinterpret_cast<char*>(layer.data()),
+              static_cast<std::streamsize>(layer.size() * sizeof(std::uint32_t)));
+      if (!in) {
+        reader.fail("unexpected end of file");
+      }
+    }
+  }
+
+  // Structural validation: every link must point at a node present on that layer.
+  const bool empty = count == 0;
+  if (empty != (max_level < 0) || (!empty && entry_point >= count) ||
+      (!empty && graph.links[entry_point].size() != static_cast<std::size_t>(max_level) + 1)) {
+    reader.fail("invalid entry point");
+  }
+  for (const auto& layers : graph.links) {
+    for (std::size_t lc = 0; lc < layers.size(); ++lc) {
+      for (const std::uint32_t neighbour : layers[lc]) {
+        if (neighbour >= count || graph.links[neighbour].size() <= lc) {
+          reader.fail("dangling neighbour link");
+        }
+      }
+    }
+  }
+
+  partition.graph = std::move(graph);
+  partition.graph_dirty = false;
+}
+
+}  // namespace ccmcp::vector
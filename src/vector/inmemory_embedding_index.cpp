@@ -1,76 +1,179 @@
 #include "ccmcp/vector/inmemory_embedding_index.h"
 
+#include "ccmcp/vector/top_k.h"
+
 #include <algorithm>
-#include <cmath>
+#include <utility>
 
 namespace ccmcp::vector {
 
-void InMemoryEmbeddingIndex::upsert(const VectorKey& key, const Vector& embedding,
-                                    const std::string& metadata) {
-  vectors_[key] = std::make_pair(embedding, metadata);
+namespace {
+
+template <typename SegmentT>
+std::size_t shadowed_count(const SegmentT& segment) {
+  return segment.shadowed != nullptr ? segment.shadowed->size() : 0;
+}
+
+template <typename SegmentT>
+std::size_t live_count(const SegmentT& segment) {
+  return segment.store->size() - shadowed_count(segment);
+}
+
+template <typename SegmentT>
+bool is_shadowed(const SegmentT& segment, const VectorKey& key) {
+  return segment.shadowed != nullptr && segment.shadowed->contains(key);
+}
+
+// Upserts every live row of segment into out.
+template <typename SegmentT>
+void copy_live_rows(const SegmentT& segment, FlatVectorStore& out) {
+  for (const auto& key : segment.store->keys()) {
+    if (!is_shadowed(segment, key)) {
+      out.upsert(key, *segment.store->get(key), *segment.store->metadata(key));
+    }
+  }
 }
 
-std::vector<VectorSearchResult> InMemoryEmbeddingIndex::query(const Vector& query_vector,
+}  // namespace
+
+void InMemoryEmbeddingIndex::upsert(VectorNamespace ns, const VectorKey& key,
+                                    const Vector& embedding, const std::string& metadata) {
+  auto segment = std::make_shared<FlatVectorStore>();
+  segment->upsert(key, embedding, metadata);
+  publish(ns, std::move(segment));
+}
+
+void InMemoryEmbeddingIndex::upsert_many(VectorNamespace ns,
+                                         std::span<const VectorRecord> records) {
+  if (records.empty()) {
+    return;
+  }
+  // The segment is built before the write lock is taken; only publishing is serialized.
+  auto segment = std::make_shared<FlatVectorStore>();
+  segment->reserve(records.size(), records.front().embedding.size());
+  for (const auto& record : records) {
+    segment->upsert(record.key, record.embedding, record.metadata);
+  }
+  publish(ns, std::move(segment));
+}
+
+std::vector<VectorSearchResult> InMemoryEmbeddingIndex::query(VectorNamespace ns,
+                                                              const Vector& query_vector,
                                                               size_t top_k) const {
-  std::vector<VectorSearchResult> results;
-  results.reserve(vectors_.size());
-
-  // Compute similarity for all vectors
-  for (const auto& [key, pair] : vectors_) {
-    const auto& [embedding, metadata] = pair;
-    double score = cosine_similarity(query_vector, embedding);
-    results.push_back(VectorSearchResult{.key = key, .score = score, .metadata = metadata});
+  return std::move(query_batch(ns, std::span(&query_vector, 1), top_k).front());
+}
+
+std::vector<std::vector<VectorSearchResult>> InMemoryEmbeddingIndex::query_batch(
+    VectorNamespace ns, std::span<const Vector> queries, size_t top_k) const {
+  const std::shared_ptr<const Snapshot> snapshot = snapshot_.load();
+  const auto it = snapshot->partitions.find(ns);
+  if (it == snapshot->partitions.end() || top_k == 0) {
+    return std::vector<std::vector<VectorSearchResult>>(queries.size());
+  }
+  const Partition& partition = it->second;
+  if (partition.size() == 1 && shadowed_count(partition.front()) == 0) {
+    return partition.front().store->query_batch(queries, top_k);
   }
 
-  // Sort by score descending, then by key ascending (deterministic tie-breaking)
-  std::sort(results.begin(), results.end(),
-            [](const VectorSearchResult& a, const VectorSearchResult& b) {
-              constexpr double kEpsilon = 1e-9;
-              if (std::abs(a.score - b.score) > kEpsilon) {
-                return a.score > b.score;  // Higher score first
-              }
-              return a.key < b.key;  // Lexicographic tie-breaking
-            });
-
-  // Return top_k results
-  if (results.size() > top_k) {
-    results.resize(top_k);
+  // Each segment's top (top_k + shadowed) contains its live top_k; merge those.
+  std::vector<TopKSelector> selectors;
+  selectors.reserve(queries.size());
+  for (std::size_t q = 0; q < queries.size(); ++q) {
+    selectors.emplace_back(top_k);
+  }
+  for (const auto& segment : partition) {
+    const std::size_t fetch = std::min(top_k, live_count(segment)) + shadowed_count(segment);
+    auto hits = segment.store->query_batch(queries, fetch);
+    for (std::size_t q = 0; q < queries.size(); ++q) {
+      for (auto& hit : hits[q]) {
+        if (!is_shadowed(segment, hit.key) && selectors[q].accepts(hit.score, hit.key)) {
+          selectors[q].push(std::move(hit));
+        }
+      }
+    }
   }
 
+  std::vector<std::vector<VectorSearchResult>> results;
+  results.reserve(queries.size());
+  for (auto& selector : selectors) {
+    results.push_back(selector.take_sorted());
+  }
   return results;
 }
 
-std::optional<Vector> InMemoryEmbeddingIndex::get(const VectorKey& key) const {
-  auto it = vectors_.find(key);
-  if (it != vectors_.end()) {
-    return it->second.first;
+std::optional<Vector> InMemoryEmbeddingIndex::get(VectorNamespace ns,
+                                                  const VectorKey& key) const {
+  const std::shared_ptr<const Snapshot> snapshot = snapshot_.load();
+  const auto it = snapshot->partitions.find(ns);
+  if (it == snapshot->partitions.end()) {
+    return std::nullopt;
+  }
+  // The newest segment holding key has its live value.
+  for (auto segment = it->second.rbegin(); segment != it->second.rend(); ++segment) {
+    if (segment->store->metadata(key) != nullptr) {
+      return segment->store->get(key);
+    }
   }
   return std::nullopt;
 }
 
-double InMemoryEmbeddingIndex::cosine_similarity(const Vector& a, const Vector& b) {
-  if (a.size() != b.size() || a.empty()) {
-    return 0.0;
-  }
-
-  double dot_product = 0.0;
-  double norm_a = 0.0;
-  double norm_b = 0.0;
+std::size_t InMemoryEmbeddingIndex::segment_count(VectorNamespace ns) const {
+  const std::shared_ptr<const Snapshot> snapshot = snapshot_.load();
+  const auto it = snapshot->partitions.find(ns);
+  return it != snapshot->partitions.end() ? it->second.size() : 0;
+}
 
-  for (size_t i = 0; i < a.size(); ++i) {
-    dot_product += a[i] * b[i];
-    norm_a += a[i] * a[i];
-    norm_b += b[i] * b[i];
+void InMemoryEmbeddingIndex::publish(VectorNamespace ns,
+                                     std::shared_ptr<const FlatVectorStore> segment) {
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  auto next = std::make_shared<Snapshot>(*snapshot_.load());
+  Partition& partition = next->partitions.try_emplace(std::string(ns)).first->second;
+
+  // Shadow the keys this segment replaces; older snapshots keep their own key sets.
+  for (auto& older : partition) {
+    std::shared_ptr<KeySet> shadowed;
+    for (const auto& key : segment->keys()) {
+      if (older.store->metadata(key) != nullptr && !is_shadowed(older, key)) {
+        if (shadowed == nullptr) {
+          shadowed = older.shadowed != nullptr ? std::make_shared<KeySet>(*older.shadowed)
+                                               : std::make_shared<KeySet>();
+        }
+        shadowed->insert(key);
+      }
+    }
+    if (shadowed != nullptr) {
+      older.shadowed = std::move(shadowed);
+    }
+  }
+  partition.push_back(Segment{std::move(segment), nullptr});
+
+  // Drop fully shadowed segments and rewrite mostly shadowed ones.
+  Partition kept;
+  kept.reserve(partition.size());
+  for (auto& current : partition) {
+    if (live_count(current) == 0) {
+      continue;
+    }
+    if (shadowed_count(current) * 2 > current.store->size()) {
+      auto rewritten = std::make_shared<FlatVectorStore>();
+      copy_live_rows(current, *rewritten);
+      current = Segment{std::move(rewritten), nullptr};
+    }
+    kept.push_back(std::move(current));
   }
 
-  norm_a = std::sqrt(norm_a);
-  norm_b = std::sqrt(norm_b);
-
-  if (norm_a == 0.0 || norm_b == 0.0) {
-    return 0.0;
+  // Size-tiered merge. Every key shadowed in the predecessor lives in a newer segment, and
+  // merging always takes the newest two, so the merged segment has no shadowed keys.
+  while (kept.size() >= 2 && live_count(kept.back()) * 2 >= live_count(kept[kept.size() - 2])) {
+    auto merged = std::make_shared<FlatVectorStore>();
+    copy_live_rows(kept[kept.size() - 2], *merged);
+    copy_live_rows(kept.back(), *merged);
+    kept.pop_back();
+    kept.back() = Segment{std::move(merged), nullptr};
   }
+  partition = std::move(kept);
 
-  return dot_product / (norm_a * norm_b);
+  snapshot_.store(std::move(next));
 }
 
 }  // namespace ccmcp::vector
@@ -4,17 +4,29 @@
 
 namespace ccmcp::vector {
 
-void LanceDBEmbeddingIndex::upsert(const VectorKey& /*key*/, const Vector& /*embedding*/,
-                                   const std::string& /*metadata*/) {
+void LanceDBEmbeddingIndex::upsert(VectorNamespace /*ns*/, const VectorKey& /*key*/,
+                                   const Vector& /*embedding*/, const std::string& /*metadata*/) {
   throw std::runtime_error("LanceDB not implemented in v0.2");
 }
 
-std::vector<VectorSearchResult> LanceDBEmbeddingIndex::query(const Vector& /*query_vector*/,
+void LanceDBEmbeddingIndex::upsert_many(VectorNamespace /*ns*/,
+                                        std::span<const VectorRecord> /*records*/) {
+  throw std::runtime_error("LanceDB not implemented in v0.2");
+}
+
+std::vector<VectorSearchResult> LanceDBEmbeddingIndex::query(VectorNamespace /*ns*/,
+                                                             const Vector& /*query_vector*/,
                                                              size_t /*top_k*/) const {
   throw std::runtime_error("LanceDB not implemented in v0.2");
 }
 
-std::optional<Vector> LanceDBEmbeddingIndex::get(const VectorKey& /*key*/) const {
+std::vector<std::vector<VectorSearchResult>> LanceDBEmbeddingIndex::query_batch(
+    VectorNamespace /*ns*/, std::span<const Vector> /*queries*/, size_t /*top_k*/) const {
+  throw std::runtime_error("LanceDB not implemented in v0.2");
+}
+
+std::optional<Vector> LanceDBEmbeddingIndex::get(VectorNamespace /*ns*/,
+                                                 const VectorKey& /*key*/) const {
   throw std::runtime_error("LanceDB not implemented in v0.2");
 }
 
@@ -0,0 +1,828 @@
+#include "ccmcp/vector/mmap_embedding_index.h"
+
+#include "ccmcp/core/hashing.h"
+#include "ccmcp/vector/top_k.h"
+#include "ccmcp/vector/vector_math.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <map>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace ccmcp::vector {
+
+namespace {
+
+constexpr std::array<char, 8> kBaseMagic = {'C', 'C', 'M', 'C', 'M', 'M', 'A', 'P'};
+constexpr std::array<char, 8> kTailMagic = {'C', 'C', 'M', 'C', 'M', 'W', 'A', 'L'};
+// Version 2 keys every row by namespace (see composite_key()); version 1 files, keyed by
+// the pre-namespace keys, are migrated at open.
+constexpr std::uint32_t kFileFormatVersion = 2;
+constexpr std::uint32_t kLegacyFileFormatVersion = 1;
+
+// The float matrix starts on a page boundary so rows can be paged in independently.
+constexpr std::uint64_t kPageSize = 4096;
+// Row padding unit, as in FlatVectorStore: 16 floats = one 64-byte cache line.
+constexpr std::uint64_t kRowAlignmentFloats = FlatVectorStore::kRowAlignmentFloats;
+
+// Rows scored per math::dot_block() call.
+constexpr std::size_t kScoreChunkRows = 256;
+
+// Queries scored together against each chunk of base rows by query_batch().
+constexpr std::size_t kQueryBlock = 16;
+
+struct FileHeader {
+  std::array<char, 8> magic;     // NOLINT(readability-identifier-naming)
+  std::uint32_t version;         // NOLINT(readability-identifier-naming)
+  std::uint32_t dimension;       // NOLINT(readability-identifier-naming)
+  std::uint64_t count;           // NOLINT(readability-identifier-naming)
+  std::uint64_t stride;          // NOLINT(readability-identifier-naming)
+  std::uint64_t strings_offset;  // NOLINT(readability-identifier-naming)
+  std::uint64_t strings_size;    // NOLINT(readability-identifier-naming)
+  std::uint64_t norms_offset;    // NOLINT(readability-identifier-naming)
+  std::uint64_t matrix_offset;   // NOLINT(readability-identifier-naming)
+};
+static_assert(sizeof(FileHeader) == 64);
+
+struct TailHeader {
+  std::array<char, 8> magic;  // NOLINT(readability-identifier-naming)
+  std::uint32_t version;      // NOLINT(readability-identifier-naming)
+  std::uint32_t reserved;     // NOLINT(readability-identifier-naming)
+};
+static_assert(sizeof(TailHeader) == 16);
+
+// Tail record: this header, then key bytes, metadata bytes and dimension floats.
+struct RecordHeader {
+  std::uint32_t key_size;       // NOLINT(readability-identifier-naming)
+  std::uint32_t metadata_size;  // NOLINT(readability-identifier-naming)
+  std::uint32_t dimension;      // NOLINT(readability-identifier-naming)
+  std::uint32_t reserved;       // NOLINT(readability-identifier-naming)
+  std::uint64_t checksum;       // stable_hash64 of the payload
+};
+static_assert(sizeof(RecordHeader) == 24);
+
+std::uint64_t align_up(const std::uint64_t value, const std::uint64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+std::uint64_t payload_checksum(const std::string& payload) {
+  return core::stable_hash64(payload);
+}
+
+template <typename T>
+void write_pod(std::ofstream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void write_zeros(std::ofstream& out, std::uint64_t count) {
+  static constexpr std::array<char, 4096> kZeros{};
+  while (count > 0) {
+    const std::uint64_t n = std::min<std::uint64_t>(count, kZeros.size());
+    out.write(kZeros.data(), static_cast<std::streamsize>(n));
+    count -= n;
+  }
+}
+
+void write_tail_header(std::ofstream& out) {
+  write_pod(out, TailHeader{.magic = kTailMagic, .version = kFileFormatVersion, .reserved = 0});
+}
+
+// Serialises one tail record (header + payload) into a single buffer so it is appended
+// with one write.
+std::string encode_record(const VectorKey& key, const Vector& embedding,
+                          const std::string& metadata) {
+  std::string payload;
+  payload.reserve(key.size() + metadata.size() + embedding.size() * sizeof(float));
+  payload.append(key);
+  payload.append(metadata);
+  payload.append(reinterpret_cast<const char*>(embedding.data()),
+                 embedding.size() * sizeof(float));
+
+  const RecordHeader header{.key_size = static_cast<std::uint32_t>(key.size()),
+                            .metadata_size = static_cast<std::uint32_t>(metadata.size()),
+                            .dimension = static_cast<std::uint32_t>(embedding.size()),
+                            .reserved = 0,
+                            .checksum = payload_checksum(payload)};
+  std::string record(sizeof(header), '\0');
+  std::memcpy(record.data(), &header, sizeof(header));
+  record.append(payload);
+  return record;
+}
+
+[[noreturn]] void fail(const std::string& path, const std::string& what) {
+  throw std::runtime_error("MmapEmbeddingIndex: '" + path + "': " + what);
+}
+
+// Files store "<namespace>\0<key>". '\0' sorts before every other byte, so the rows of one
+// namespace form a contiguous range of the sorted key table, in key order.
+std::string composite_key(VectorNamespace ns, std::string_view key) {
+  std::string out;
+  out.reserve(ns.size() + 1 + key.size());
+  out.append(ns);
+  out.push_back('\0');
+  out.append(key);
+  return out;
+}
+
+// Inverse of composite_key(); nullopt if the separator is missing.
+std::optional<NamespacedKey> split_composite_key(std::string_view composite) {
+  const std::size_t separator = composite.find('\0');
+  if (separator == std::string_view::npos) {
+    return std::nullopt;
+  }
+  return NamespacedKey{composite.substr(0, separator), composite.substr(separator + 1)};
+}
+
+}  // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Mapping
+// ─────────────────────────────────────────────────────────────────────────────
+
+// The key is strings[offset, offset + key_size); its metadata follows immediately.
+struct MmapEmbeddingIndex::KeyEntry {
+  std::uint64_t offset;         // NOLINT(readability-identifier-naming)
+  std::uint32_t key_size;       // NOLINT(readability-identifier-naming)
+  std::uint32_t metadata_size;  // NOLINT(readability-identifier-naming)
+};
+
+class MmapEmbeddingIndex::Mapping {
+ public:
+  explicit Mapping(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      fail(path, std::string("cannot open: ") + std::strerror(errno));
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+      const int err = errno;
+      ::close(fd);
+      fail(path, std::string("cannot stat: ") + std::strerror(err));
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ > 0) {
+      void* data = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+      if (data == MAP_FAILED) {
+        const int err = errno;
+        ::close(fd);
+        fail(path, std::string("cannot map: ") + std::strerror(err));
+      }
+      data_ = static_cast<const unsigned char*>(data);
+    }
+    ::close(fd);  // the mapping keeps the file alive
+  }
+
+  ~Mapping() {
+    if (data_ != nullptr) {
+      ::munmap(const_cast<unsigned char*>(data_), size_);
+    }
+  }
+
+  Mapping(const Mapping&) = delete;
+  Mapping& operator=(const Mapping&) = delete;
+  Mapping(Mapping&&) = delete;
+  Mapping& operator=(Mapping&&) = delete;
+
+  [[nodiscard]] const unsigned char* data() const noexcept { return data_; }
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+ private:
+  const unsigned char* data_{nullptr};
+  std::size_t size_{0};
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Construction / destruction
+// ─────────────────────────────────────────────────────────────────────────────
+
+MmapEmbeddingIndex::MmapEmbeddingIndex(std::string file_path, const OpenMode mode)
+    : file_path_(std::move(file_path)), tail_path_(file_path_ + ".wal"), mode_(mode) {
+  map_base();
+  replay_tail();
+  if (needs_migration_ && mode_ == OpenMode::kReadWrite) {
+    compact();  // rewrite base and tail in the current format
+  }
+}
+
+MmapEmbeddingIndex::~MmapEmbeddingIndex() {
+  if (appended_ == 0) {
+    return;
+  }
+  try {
+    compact();
+  } catch (...) {
+    // Best effort: the tail still holds every record and is replayed on the next open.
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// IEmbeddingIndex interface
+// ─────────────────────────────────────────────────────────────────────────────
+
+void MmapEmbeddingIndex::upsert(VectorNamespace ns, const VectorKey& key,
+                                const Vector& embedding, const std::string& metadata) {
+  if (mode_ == OpenMode::kReadOnly ||
+      !append_records(encode_record(composite_key(ns, key), embedding, metadata))) {
+    return;  // Silent failure for upsert (matches in-memory semantics)
+  }
+  apply(ns, key, embedding, metadata);
+  ++tail_records_;
+  ++appended_;
+}
+
+void MmapEmbeddingIndex::upsert_many(VectorNamespace ns, std::span<const VectorRecord> records) {
+  if (mode_ == OpenMode::kReadOnly) {
+    return;
+  }
+  std::string buffer;
+  for (const auto& record : records) {
+    buffer.append(encode_record(composite_key(ns, record.key), record.embedding,
+                                record.metadata));
+  }
+  if (buffer.empty() || !append_records(buffer)) {
+    return;  // Silent failure for upsert (matches in-memory semantics)
+  }
+  for (const auto& record : records) {
+    apply(ns, record.key, record.embedding, record.metadata);
+  }
+  tail_records_ += records.size();
+  appended_ += records.size();
+}
+
+std::vector<VectorSearchResult> MmapEmbeddingIndex::query(VectorNamespace ns,
+                                                          const Vector& query_vector,
+                                                          const size_t top_k) const {
+  return std::move(query_batch(ns, std::span(&query_vector, 1), top_k).front());
+}
+
+std::vector<std::vector<VectorSearchResult>> MmapEmbeddingIndex::query_batch(
+    VectorNamespace ns, std::span<const Vector> queries, const size_t top_k) const {
+  std::vector<std::vector<VectorSearchResult>> results(queries.size());
+  if (top_k == 0 || queries.empty()) {
+    return results;
+  }
+
+  // Only the namespace's range of base rows is read.
+  const auto [begin, end] = namespace_rows(ns);
+  const std::size_t key_offset = ns.size() + 1;
+
+  std::vector<TopKSelector> selectors;
+  selectors.reserve(queries.size());
+  for (std::size_t q = 0; q < queries.size(); ++q) {
+    selectors.emplace_back(top_k);
+  }
+  const auto consider = [&](const std::size_t q, const double score, const std::size_t row) {
+    if (!shadowed_.empty() && shadowed_[row]) {
+      return;
+    }
+    const std::string_view key = base_key(row).substr(key_offset);
+    if (selectors[q].accepts(score, key)) {
+      selectors[q].push(VectorSearchResult{
+          .key = std::string(key), .score = score, .metadata = std::string(base_metadata(row))});
+    }
+  };
+
+  // Base rows: only the base dimension can score above 0.0 (as in FlatVectorStore).
+  std::vector<double> query_norms(queries.size(), 0.0);
+  std::vector<std::size_t> scored;
+  for (std::size_t q = 0; q < queries.size(); ++q) {
+    const Vector& query = queries[q];
+    query_norms[q] = math::l2_norm(query.data(), query.size());
+    if (!query.empty() && query.size() == base_.dimension && query_norms[q] != 0.0) {
+      scored.push_back(q);
+      continue;
+    }
+    for (std::size_t row = begin; row < end; ++row) {
+      consider(q, 0.0, row);
+    }
+  }
+
+  std::vector<const float*> block_queries;
+  std::vector<double> dots(std::min(kQueryBlock, scored.size()) * kScoreChunkRows);
+  for (std::size_t first_query = 0; first_query < scored.size(); first_query += kQueryBlock) {
+    const std::size_t num_queries = std::min(kQueryBlock, scored.size() - first_query);
+    block_queries.clear();
+    for (std::size_t i = 0; i < num_queries; ++i) {
+      block_queries.push_back(queries[scored[first_query + i]].data());
+    }
+    for (std::size_t first = begin; first < end; first += kScoreChunkRows) {
+      const std::size_t count = std::min(kScoreChunkRows, end - first);
+      math::dot_block(block_queries.data(), num_queries, base_.rows + first * base_.stride,
+                      base_.stride, count, base_.dimension, dots.data());
+      for (std::size_t i = 0; i < num_queries; ++i) {
+        const std::size_t q = scored[first_query + i];
+        for (std::size_t r = 0; r < count; ++r) {
+          consider(q, math::cosine_from_dot(dots[i * count + r], query_norms[q],
+                                            base_.norms[first + r]),
+                   first + r);
+        }
+      }
+    }
+  }
+
+  // Tail rows: its own top_k contains every tail row that can reach the merged top_k.
+  const auto tail = tail_.find(ns);
+  auto tail_results = tail != tail_.end()
+                          ? tail->second.query_batch(queries, top_k)
+                          : std::vector<std::vector<VectorSearchResult>>(queries.size());
+  for (std::size_t q = 0; q < queries.size(); ++q) {
+    for (auto& result : tail_results[q]) {
+      if (selectors[q].accepts(result.score, result.key)) {
+        selectors[q].push(std::move(result));
+      }
+    }
+    results[q] = selectors[q].take_sorted();
+  }
+  return results;
+}
+
+std::optional<Vector> MmapEmbeddingIndex::get(VectorNamespace ns, const VectorKey& key) const {
+  const auto tail = tail_.find(ns);
+  if (tail != tail_.end()) {
+    if (auto vec = tail->second.get(key)) {
+      return vec;
+    }
+  }
+  const auto row = find_base_row(composite_key(ns, key));
+  if (!row.has_value()) {
+    return std::nullopt;
+  }
+  const float* data = base_.rows + *row * base_.stride;
+  return Vector(data, data + base_.dimension);
+}
+
+std::size_t MmapEmbeddingIndex::size() const noexcept {
+  std::size_t tail_size = 0;
+  for (const auto& [ns, store] : tail_) {
+    tail_size += store.size();
+  }
+  return base_.count - shadowed_count_ + tail_size;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Compaction
+// ─────────────────────────────────────────────────────────────────────────────
+
+void MmapEmbeddingIndex::compact() {
+  if (mode_ == OpenMode::kReadOnly || (tail_records_ == 0 && !needs_migration_)) {
+    return;
+  }
+
+  // Tail items carry composite keys, so they merge with the base in file order.
+  struct TailItem {
+    VectorKey key;
+    Vector embedding;
+    std::string metadata;
+  };
+  std::vector<TailItem> items;
+  for (const auto& [ns, store] : tail_) {
+    for (const auto& key : store.keys()) {
+      items.push_back(TailItem{.key = composite_key(ns, key),
+                               .embedding = *store.get(key),
+                               .metadata = *store.metadata(key)});
+    }
+  }
+  std::sort(items.begin(), items.end(),
+            [](const TailItem& a, const TailItem& b) { return a.key < b.key; });
+
+  // The base keeps the most common non-zero dimension (ties: the smaller one).
+  std::map<std::size_t, std::size_t> dimension_counts;
+  if (base_.count > shadowed_count_) {
+    dimension_counts[base_.dimension] += base_.count - shadowed_count_;
+  }
+  for (const auto& item : items) {
+    if (!item.embedding.empty()) {
+      ++dimension_counts[item.embedding.size()];
+    }
+  }
+  std::size_t dimension = 0;
+  std::size_t best = 0;
+  for (const auto& [dim, count] : dimension_counts) {
+    if (count > best) {
+      dimension = dim;
+      best = count;
+    }
+  }
+
+  // If the majority moved to another dimension, the old base rows join the tail items and
+  // end up in the tail with every other off-dimension vector. They are appended to the
+  // current tail first, so a crash after the new base replaces the old one loses nothing.
+  const std::size_t base_rows = base_.dimension == dimension ? base_.count : 0;
+  if (base_rows == 0 && base_.count > shadowed_count_) {
+    std::string demoted;
+    for (std::size_t b = 0; b < base_.count; ++b) {
+      if (!shadowed_.empty() && shadowed_[b]) {
+        continue;
+      }
+      const float* data = base_.rows + b * base_.stride;
+      TailItem item{.key = std::string(base_key(b)),
+                    .embedding = Vector(data, data + base_.dimension),
+                    .metadata = std::string(base_metadata(b))};
+      demoted.append(encode_record(item.key, item.embedding, item.metadata));
+      items.push_back(std::move(item));
+    }
+    // A format-1 tail cannot hold composite keys; it is rewritten below either way.
+    if (!needs_migration_ && !append_records(demoted)) {
+      fail(tail_path_, "write failed");
+    }
+    std::sort(items.begin(), items.end(),
+              [](const TailItem& a, const TailItem& b) { return a.key < b.key; });
+  }
+
+  // Merge unshadowed base rows and same-dimension tail items in key order. Empty vectors
+  // (dimension 0) never enter the base.
+  struct Row {
+    std::string_view key;
+    std::string_view metadata;
+    const float* data;
+    double norm;
+  };
+  std::vector<Row> rows;
+  std::vector<const TailItem*> leftovers;
+  {
+    std::size_t b = 0;
+    auto next_base = [&]() {
+      while (b < base_rows && !shadowed_.empty() && shadowed_[b]) {
+        ++b;
+      }
+      return b < base_rows;
+    };
+    auto it = items.begin();
+    while (next_base() || it != items.end()) {
+      if (it != items.end() && (dimension == 0 || it->embedding.size() != dimension)) {
+        leftovers.push_back(&*it++);
+        continue;
+      }
+      const bool take_base =
+          b < base_rows && (it == items.end() || base_key(b) < std::string_view(it->key));
+      if (take_base) {
+        rows.push_back(Row{base_key(b), base_metadata(b), base_.rows + b * base_.stride,
+                           base_.norms[b]});
+        ++b;
+      } else {
+        rows.push_back(Row{it->key, it->metadata, it->embedding.data(),
+                           math::l2_norm(it->embedding.data(), dimension)});
+        ++it;
+      }
+    }
+  }
+
+  // A base is written only for a non-zero dimension. Otherwise every vector is in the tail,
+  // which also shadows every row of an old base file, so that file is dropped.
+  std::error_code ec;
+  if (dimension > 0) {
+    // Layout: header, key table, strings, norms, page-aligned matrix.
+    const std::uint64_t count = rows.size();
+    const std::uint64_t stride = align_up(dimension, kRowAlignmentFloats);
+    std::uint64_t strings_size = 0;
+    for (const auto& row : rows) {
+      strings_size += row.key.size() + row.metadata.size();
+    }
+    FileHeader header{};
+    header.magic = kBaseMagic;
+    header.version = kFileFormatVersion;
+    header.dimension = static_cast<std::uint32_t>(dimension);
+    header.count = count;
+    header.stride = stride;
+    header.strings_offset = sizeof(FileHeader) + count * sizeof(KeyEntry);
+    header.strings_size = strings_size;
+    header.norms_offset = align_up(header.strings_offset + strings_size, sizeof(double));
+    header.matrix_offset = align_up(header.norms_offset + count * sizeof(double), kPageSize);
+
+    const std::string tmp_path = file_path_ + ".tmp";
+    {
+      std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+      if (!out) {
+        fail(tmp_path, "cannot write");
+      }
+      write_pod(out, header);
+      std::uint64_t offset = 0;
+      for (const auto& row : rows) {
+        write_pod(out, KeyEntry{.offset = offset,
+                                .key_size = static_cast<std::uint32_t>(row.key.size()),
+                                .metadata_size = static_cast<std::uint32_t>(row.metadata.size())});
+        offset += row.key.size() + row.metadata.size();
+      }
+      for (const auto& row : rows) {
+        out.write(row.key.data(), static_cast<std::streamsize>(row.key.size()));
+        out.write(row.metadata.data(), static_cast<std::streamsize>(row.metadata.size()));
+      }
+      write_zeros(out, header.norms_offset - (header.strings_offset + strings_size));
+      for (const auto& row : rows) {
+        write_pod(out, row.norm);
+      }
+      write_zeros(out, header.matrix_offset - (header.norms_offset + count * sizeof(double)));
+      for (const auto& row : rows) {
+        out.write(reinterpret_cast<const char*>(row.data),
+                  static_cast<std::streamsize>(dimension * sizeof(float)));
+        write_zeros(out, (stride - dimension) * sizeof(float));
+      }
+      out.flush();
+      if (!out) {
+        fail(tmp_path, "write failed");
+      }
+    }
+    std::filesystem::rename(tmp_path, file_path_, ec);
+    if (ec) {
+      fail(file_path_, "cannot replace: " + ec.message());
+    }
+  } else {
+    std::filesystem::remove(file_path_, ec);
+    if (ec) {
+      fail(file_path_, "cannot remove: " + ec.message());
+    }
+  }
+
+  // The new base now holds every tail record of the base dimension. Replaying the old
+  // tail on top of it is harmless, so a crash before the tail is rewritten loses nothing.
+  const std::string tail_tmp_path = tail_path_ + ".tmp";
+  {
+    std::ofstream out(tail_tmp_path, std::ios::binary | std::ios::trunc);
+    write_tail_header(out);
+    for (const TailItem* item : leftovers) {
+      const std::string record = encode_record(item->key, item->embedding, item->metadata);
+      out.write(record.data(), static_cast<std::streamsize>(record.size()));
+    }
+    out.flush();
+    if (!out) {
+      fail(tail_tmp_path, "write failed");
+    }
+  }
+  tail_out_.close();
+  std::filesystem::rename(tail_tmp_path, tail_path_, ec);
+  if (ec) {
+    open_tail_for_append();
+    fail(tail_path_, "cannot replace: " + ec.message());
+  }
+
+  std::vector<TailItem> kept;
+  kept.reserve(leftovers.size());
+  for (const TailItem* item : leftovers) {
+    kept.push_back(*item);
+  }
+  rows.clear();
+  mapping_.reset();
+  base_ = Base{};
+  shadowed_.clear();
+  shadowed_count_ = 0;
+  tail_.clear();
+  needs_migration_ = false;
+  map_base();
+  for (const auto& item : kept) {
+    const auto split = split_composite_key(item.key).value();
+    apply(split.ns, std::string(split.key), item.embedding, item.metadata);
+  }
+  tail_records_ = kept.size();
+  appended_ = 0;
+  tail_bytes_ = std::filesystem::file_size(tail_path_);
+  open_tail_for_append();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Private helpers
+// ─────────────────────────────────────────────────────────────────────────────
+
+std::string_view MmapEmbeddingIndex::base_key(const std::size_t row) const {
+  const KeyEntry& entry = base_.keys[row];
+  return {base_.strings + entry.offset, entry.key_size};
+}
+
+std::string_view MmapEmbeddingIndex::base_metadata(const std::size_t row) const {
+  const KeyEntry& entry = base_.keys[row];
+  return {base_.strings + entry.offset + entry.key_size, entry.metadata_size};
+}
+
+std::size_t MmapEmbeddingIndex::lower_bound_row(const std::string_view key) const {
+  std::size_t lo = 0;
+  std::size_t hi = base_.count;
+  while (lo < hi) {
+    const std::size_t mid = lo + (hi - lo) / 2;
+    if (base_key(mid) < key) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+std::optional<std::size_t> MmapEmbeddingIndex::find_base_row(const std::string_view key) const {
+  const std::size_t row = lower_bound_row(key);
+  if (row < base_.count && base_key(row) == key) {
+    return row;
+  }
+  return std::nullopt;
+}
+
+std::pair<std::size_t, std::size_t> MmapEmbeddingIndex::namespace_rows(VectorNamespace ns) const {
+  // Composite keys of ns lie in ["<ns>\0", "<ns>\1").
+  std::string bound(ns);
+  bound.push_back('\0');
+  const std::size_t begin = lower_bound_row(bound);
+  bound.back() = '\1';
+  return {begin, lower_bound_row(bound)};
+}
+
+void MmapEmbeddingIndex::map_base() {
+  if (!std::filesystem::exists(file_path_)) {
+    return;  // new index; the file is created by the first compact()
+  }
+  static_assert(sizeof(KeyEntry) == 16);
+  auto mapping = std::make_unique<Mapping>(file_path_);
+  const std::uint64_t size = mapping->size();
+  const unsigned char* data = mapping->data();
+
+  FileHeader header{};
+  if (size < sizeof(header)) {
+    fail(file_path_, "not a vector file");
+  }
+  std::memcpy(&header, data, sizeof(header));
+  if (header.magic != kBaseMagic) {
+    fail(file_path_, "not a vector file");
+  }
+  if (header.version != kFileFormatVersion && header.version != kLegacyFileFormatVersion) {
+    fail(file_path_, "unsupported format version");
+  }
+
+  // Section bounds, checked in an order that cannot overflow.
+  const std::uint64_t count = header.count;
+  const bool sections_ok =
+      count <= (size - sizeof(header)) / sizeof(KeyEntry) &&
+      header.strings_offset >= sizeof(header) + count * sizeof(KeyEntry) &&
+      header.strings_offset <= size && header.strings_size <= size - header.strings_offset &&
+      header.norms_offset % sizeof(double) == 0 &&
+      header.norms_offset >= header.strings_offset + header.strings_size &&
+      header.norms_offset <= size && count <= (size - header.norms_offset) / sizeof(double) &&
+      header.matrix_offset % kPageSize == 0 &&
+      header.matrix_offset >= header.norms_offset + count * sizeof(double) &&
+      header.matrix_offset <= size && header.stride % kRowAlignmentFloats == 0 &&
+      header.stride >= header.dimension && (count == 0 || header.dimension > 0) &&
+      (count == 0 || count <= (size - header.matrix_offset) / sizeof(float) / header.stride);
+  if (!sections_ok) {
+    fail(file_path_, "corrupt section table");
+  }
+
+  Base base;
+  base.dimension = header.dimension;
+  base.count = count;
+  base.stride = header.stride;
+  base.keys = reinterpret_cast<const KeyEntry*>(data + sizeof(header));
+  base.strings = reinterpret_cast<const char*>(data + header.strings_offset);
+  base.norms = reinterpret_cast<const double*>(data + header.norms_offset);
+  base.rows = reinterpret_cast<const float*>(data + header.matrix_offset);
+
+  std::string_view previous;
+  for (std::uint64_t row = 0; row < count; ++row) {
+    const KeyEntry& entry = base.keys[row];
+    if (entry.offset > header.strings_size ||
+        std::uint64_t{entry.key_size} + entry.metadata_size > header.strings_size - entry.offset) {
+      fail(file_path_, "corrupt key table");
+    }
+    const std::string_view key(base.strings + entry.offset, entry.key_size);
+    if (row > 0 && !(previous < key)) {
+      fail(file_path_, "keys out of order");
+    }
+    previous = key;
+  }
+
+  if (header.version == kLegacyFileFormatVersion) {
+    // Pre-namespace keys: move every row into the in-memory tail under its namespace; the
+    // constructor then compacts them into a current-format base.
+    for (std::size_t row = 0; row < count; ++row) {
+      const KeyEntry& entry = base.keys[row];
+      const auto [ns, key] =
+          split_legacy_key(std::string_view(base.strings + entry.offset, entry.key_size));
+      const float* data = base.rows + row * base.stride;
+      apply(ns, std::string(key), Vector(data, data + base.dimension),
+            std::string(base.strings + entry.offset + entry.key_size, entry.metadata_size));
+    }
+    needs_migration_ = true;
+    return;
+  }
+
+  mapping_ = std::move(mapping);
+  base_ = base;
+}
+
+void MmapEmbeddingIndex::replay_tail() {
+  if (!std::filesystem::exists(tail_path_)) {
+    if (mode_ == OpenMode::kReadOnly) {
+      return;  // nothing appended yet; the writer creates the tail
+    }
+    std::ofstream out(tail_path_, std::ios::binary | std::ios::trunc);
+    write_tail_header(out);
+    out.flush();
+    if (!out) {
+      fail(tail_path_, "cannot create");
+    }
+    tail_bytes_ = sizeof(TailHeader);
+    open_tail_for_append();
+    return;
+  }
+
+  const std::uint64_t file_size = std::filesystem::file_size(tail_path_);
+  std::ifstream in(tail_path_, std::ios::binary);
+  TailHeader header{};
+  in.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!in || header.magic != kTailMagic) {
+    fail(tail_path_, "not a vector tail file");
+  }
+  if (header.version != kFileFormatVersion && header.version != kLegacyFileFormatVersion) {
+    fail(tail_path_, "unsupported format version");
+  }
+  const bool legacy = header.version == kLegacyFileFormatVersion;
+
+  // Records are applied in order; the first short or corrupt record ends the tail.
+  std::uint64_t good = sizeof(header);
+  std::string payload;
+  Vector embedding;
+  for (;;) {
+    RecordHeader record{};
+    if (!in.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+      break;
+    }
+    const std::uint64_t payload_size = std::uint64_t{record.key_size} + record.metadata_size +
+                                       std::uint64_t{record.dimension} * sizeof(float);
+    if (payload_size > file_size - good - sizeof(record)) {
+      break;
+    }
+    payload.resize(payload_size);
+    if (!in.read(payload.data(), static_cast<std::streamsize>(payload_size)) ||
+        payload_checksum(payload) != record.checksum) {
+      break;
+    }
+    const std::string_view stored_key = std::string_view(payload).substr(0, record.key_size);
+    const auto split = legacy ? std::optional(split_legacy_key(stored_key))
+                              : split_composite_key(stored_key);
+    if (!split.has_value()) {
+      break;
+    }
+    const std::string metadata = payload.substr(record.key_size, record.metadata_size);
+    embedding.resize(record.dimension);
+    std::memcpy(embedding.data(), payload.data() + record.key_size + record.metadata_size,
+                embedding.size() * sizeof(float));
+    apply(split->ns, std::string(split->key), embedding, metadata);
+    ++tail_records_;
+    good += sizeof(record) + payload_size;
+  }
+  in.close();
+  if (legacy) {
+    needs_migration_ = true;
+  }
+  tail_bytes_ = good;
+  if (mode_ == OpenMode::kReadOnly) {
+    return;  // a short final record may still be in flight from the writer
+  }
+
+  if (good < file_size) {
+    std::filesystem::resize_file(tail_path_, good);  // drop the torn record
+  }
+  open_tail_for_append();
+}
+
+void MmapEmbeddingIndex::open_tail_for_append() {
+  tail_out_.close();
+  tail_out_.clear();
+  tail_out_.open(tail_path_, std::ios::binary | std::ios::app);
+}
+
+bool MmapEmbeddingIndex::append_records(const std::string& records) {
+  tail_out_.write(records.data(), static_cast<std::streamsize>(records.size()));
+  tail_out_.flush();
+  if (tail_out_) {
+    tail_bytes_ += records.size();
+    return true;
+  }
+  // Cut any partial record so later appends stay readable, then reopen.
+  std::error_code ec;
+  tail_out_.close();
+  std::filesystem::resize_file(tail_path_, tail_bytes_, ec);
+  open_tail_for_append();
+  return false;
+}
+
+void MmapEmbeddingIndex::apply(VectorNamespace ns, const VectorKey& key, const Vector& embedding,
+                               const std::string& metadata) {
+  tail_.try_emplace(std::string(ns)).first->second.upsert(key, embedding, metadata);
+  const auto row = find_base_row(composite_key(ns, key));
+  if (!row.has_value()) {
+    return;
+  }
+  if (shadowed_.empty()) {
+    shadowed_.resize(base_.count, false);
+  }
+  if (!shadowed_[*row]) {
+    shadowed_[*row] = true;
+    ++shadowed_count_;
+  }
+}
+
+}  // namespace ccmcp::vector
@@ -2,17 +2,29 @@
 
 namespace ccmcp::vector {
 
-void NullEmbeddingIndex::upsert(const VectorKey& /*key*/, const Vector& /*embedding*/,
-                                const std::string& /*metadata*/) {
+void NullEmbeddingIndex::upsert(VectorNamespace /*ns*/, const VectorKey& /*key*/,
+                                const Vector& /*embedding*/, const std::string& /*metadata*/) {
   // No-op
 }
 
-std::vector<VectorSearchResult> NullEmbeddingIndex::query(const Vector& /*query_vector*/,
+void NullEmbeddingIndex::upsert_many(VectorNamespace /*ns*/,
+                                     std::span<const VectorRecord> /*records*/) {
+  // No-op
+}
+
+std::vector<VectorSearchResult> NullEmbeddingIndex::query(VectorNamespace /*ns*/,
+                                                          const Vector& /*query_vector*/,
                                                           size_t /*top_k*/) const {
   return {};
 }
 
-std::optional<Vector> NullEmbeddingIndex::get(const VectorKey& /*key*/) const {
+std::vector<std::vector<VectorSearchResult>> NullEmbeddingIndex::query_batch(
+    VectorNamespace /*ns*/, std::span<const Vector> queries, size_t /*top_k*/) const {
+  return std::vector<std::vector<VectorSearchResult>>(queries.size());
+}
+
+std::optional<Vector> NullEmbeddingIndex::get(VectorNamespace /*ns*/,
+                                              const VectorKey& /*key*/) const {
   return std::nullopt;
 }
 
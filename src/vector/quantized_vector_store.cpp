@@ -0,0 +1,175 @@
+#include "ccmcp/vector/quantized_vector_store.h"
+
+#include "ccmcp/vector/top_k.h"
+#include "ccmcp/vector/vector_math.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ccmcp::vector {
+
+namespace {
+
+// Rows scored per math::dot_i8_many() call; bounds the score buffer.
+constexpr std::size_t kScoreChunkRows = 256;
+
+constexpr float kMaxCode = 127.0F;
+
+std::size_t padded_stride(const std::size_t dim) {
+  constexpr std::size_t kUnit = QuantizedVectorStore::kRowAlignmentBytes;
+  return (dim + kUnit - 1) / kUnit * kUnit;
+}
+
+}  // namespace
+
+float quantize_int8(const Vector& v, std::int8_t* codes) {
+  float max_abs = 0.0F;
+  for (const float x : v) {
+    max_abs = std::max(max_abs, std::fabs(x));
+  }
+  if (max_abs == 0.0F || !std::isfinite(max_abs)) {
+    std::fill_n(codes, v.size(), std::int8_t{0});
+    return 0.0F;
+  }
+  const float scale = max_abs / kMaxCode;
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    const float code = std::clamp(std::round(v[i] / scale), -kMaxCode, kMaxCode);
+    codes[i] = static_cast<std::int8_t>(code);
+  }
+  return scale;
+}
+
+void QuantizedVectorStore::upsert(const VectorKey& key, const Vector& embedding,
+                                  const std::string& metadata) {
+  const std::size_t dim = embedding.size();
+  const auto [it, inserted] = ids_.try_emplace(key, static_cast<std::uint32_t>(keys_.size()));
+  const std::uint32_t id = it->second;
+
+  if (!inserted) {
+    metadata_[id] = metadata;
+    const Location loc = locations_[id];
+    if (loc.dim == dim) {
+      write_row(blocks_.at(dim), loc.row, embedding);
+      return;
+    }
+    remove_row(loc.dim, loc.row);
+  } else {
+    keys_.push_back(key);
+    metadata_.push_back(metadata);
+    locations_.push_back(Location{dim, 0});
+  }
+
+  auto [block_it, created] = blocks_.try_emplace(dim);
+  Block& block = block_it->second;
+  if (created) {
+    block.stride = padded_stride(dim);
+  }
+  const std::size_t row = block.norms.size();
+  block.rows.resize((row + 1) * block.stride, std::int8_t{0});
+  block.scales.push_back(0.0F);
+  block.norms.push_back(0.0);
+  block.entries.push_back(id);
+  write_row(block, row, embedding);
+  locations_[id] = Location{dim, row};
+}
+
+void QuantizedVectorStore::reserve(const std::size_t count, const std::size_t dim) {
+  const std::size_t entries = keys_.size() + count;
+  keys_.reserve(entries);
+  metadata_.reserve(entries);
+  locations_.reserve(entries);
+  ids_.reserve(entries);
+
+  auto [block_it, created] = blocks_.try_emplace(dim);
+  Block& block = block_it->second;
+  if (created) {
+    block.stride = padded_stride(dim);
+  }
+  const std::size_t rows = block.norms.size() + count;
+  block.rows.reserve(rows * block.stride);
+  block.scales.reserve(rows);
+  block.norms.reserve(rows);
+  block.entries.reserve(rows);
+}
+
+std::vector<VectorSearchResult> QuantizedVectorStore::candidates(const Vector& query_vector,
+                                                                 const std::size_t count) const {
+  if (count == 0) {
+    return {};
+  }
+
+  const std::size_t dim = query_vector.size();
+  const double query_norm = math::l2_norm(query_vector.data(), dim);
+  std::vector<std::int8_t> query_codes(dim);
+  const double query_scale = quantize_int8(query_vector, query_codes.data());
+
+  TopKSelector selector(count);
+  const auto consider = [&](const double score, const std::uint32_t id) {
+    if (selector.accepts(score, keys_[id])) {
+      selector.push(
+          VectorSearchResult{.key = keys_[id], .score = score, .metadata = metadata_[id]});
+    }
+  };
+
+  std::vector<std::int32_t> dots(kScoreChunkRows);
+  for (const auto& [block_dim, block] : blocks_) {
+    const std::size_t rows = block.norms.size();
+    if (block_dim == 0 || block_dim != dim || query_norm == 0.0) {
+      for (std::size_t r = 0; r < rows; ++r) {
+        consider(0.0, block.entries[r]);
+      }
+      continue;
+    }
+    for (std::size_t first = 0; first < rows; first += kScoreChunkRows) {
+      const std::size_t chunk = std::min(kScoreChunkRows, rows - first);
+      math::dot_i8_many(query_codes.data(), block.rows.data() + first * block.stride,
+                        block.stride, chunk, dim, dots.data());
+      for (std::size_t r = 0; r < chunk; ++r) {
+        const double dot = query_scale * static_cast<double>(block.scales[first + r]) *
+                           static_cast<double>(dots[r]);
+        consider(math::cosine_from_dot(dot, query_norm, block.norms[first + r]),
+                 block.entries[first + r]);
+      }
+    }
+  }
+  return selector.take_sorted();
+}
+
+std::size_t QuantizedVectorStore::vector_bytes() const noexcept {
+  std::size_t bytes = 0;
+  for (const auto& [dim, block] : blocks_) {
+    bytes += block.rows.size() * sizeof(std::int8_t) + block.scales.size() * sizeof(float) +
+             block.norms.size() * sizeof(double);
+  }
+  return bytes;
+}
+
+void QuantizedVectorStore::write_row(Block& block, const std::size_t row,
+                                     const Vector& embedding) {
+  block.scales[row] = quantize_int8(embedding, block.rows.data() + row * block.stride);
+  block.norms[row] = math::l2_norm(embedding.data(), embedding.size());
+}
+
+void QuantizedVectorStore::remove_row(const std::size_t dim, const std::size_t row) {
+  auto it = blocks_.find(dim);
+  Block& block = it->second;
+  const std::size_t last = block.norms.size() - 1;
+  if (row != last) {
+    // Move the last row into the hole so the matrix stays dense.
+    std::int8_t* rows = block.rows.data();
+    std::copy_n(rows + last * block.stride, block.stride, rows + row * block.stride);
+    block.scales[row] = block.scales[last];
+    block.norms[row] = block.norms[last];
+    block.entries[row] = block.entries[last];
+    locations_[block.entries[row]].row = row;
+  }
+  block.rows.resize(last * block.stride);
+  block.scales.pop_back();
+  block.norms.pop_back();
+  block.entries.pop_back();
+  if (block.norms.empty()) {
+    blocks_.erase(it);
+  }
+}
+
+}  // namespace ccmcp::vector
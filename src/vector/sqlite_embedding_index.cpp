@@ -1,26 +1,76 @@
 #include "ccmcp/vector/sqlite_embedding_index.h"
 
+#include "ccmcp/vector/top_k.h"
+#include "ccmcp/vector/vector_math.h"
+
 #include <algorithm>
-#include <cmath>
 #include <cstring>
+#include <limits>
 #include <memory>
 #include <sqlite3.h>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
 
 namespace ccmcp::vector {
 
 namespace {
 
+// PRAGMA user_version of the current layout. Version 0 is either a new file or the
+// pre-namespace layout (key TEXT PRIMARY KEY), which ensure_schema() migrates.
+constexpr int kSchemaVersion = 1;
+
 constexpr const char* kSchema = R"(
 CREATE TABLE IF NOT EXISTS embedding_vectors (
-  key          TEXT PRIMARY KEY,
-  vector_blob  BLOB NOT NULL,
-  dimension    INTEGER NOT NULL,
+  namespace     TEXT NOT NULL,
+  key           TEXT NOT NULL,
+  vector_blob   BLOB NOT NULL,
+  dimension     INTEGER NOT NULL,
+  metadata_json TEXT NOT NULL,
+  created_at    TEXT NOT NULL DEFAULT (datetime('now')),
+  PRIMARY KEY (namespace, key)
+);
+)";
+
+// Moves the rows of the pre-namespace table into their partitions. Keys were written by the
+// index build as "<atom_id>", "resume:<id>" and "opp:<id>"; the prefix becomes the
+// namespace and is dropped from the key.
+constexpr const char* kMigrateLegacySql = R"(
+ALTER TABLE embedding_vectors RENAME TO embedding_vectors_legacy;
+CREATE TABLE embedding_vectors (
+  namespace     TEXT NOT NULL,
+  key           TEXT NOT NULL,
+  vector_blob   BLOB NOT NULL,
+  dimension     INTEGER NOT NULL,
   metadata_json TEXT NOT NULL,
-  created_at   TEXT NOT NULL DEFAULT (datetime('now'))
+  created_at    TEXT NOT NULL DEFAULT (datetime('now')),
+  PRIMARY KEY (namespace, key)
 );
+INSERT INTO embedding_vectors (namespace, key, vector_blob, dimension, metadata_json, created_at)
+  SELECT CASE WHEN substr(key, 1, 7) = 'resume:' THEN 'resume'
+              WHEN substr(key, 1, 4) = 'opp:' THEN 'opportunity'
+              ELSE 'atom' END,
+         CASE WHEN substr(key, 1, 7) = 'resume:' THEN substr(key, 8)
+              WHEN substr(key, 1, 4) = 'opp:' THEN substr(key, 5)
+              ELSE key END,
+         vector_blob, dimension, metadata_json, created_at
+  FROM embedding_vectors_legacy;
+DROP TABLE embedding_vectors_legacy;
 )";
 
+constexpr const char* kUpsertSql = R"(
+    INSERT INTO embedding_vectors (namespace, key, vector_blob, dimension, metadata_json)
+    VALUES (?, ?, ?, ?, ?)
+    ON CONFLICT(namespace, key) DO UPDATE SET
+      vector_blob   = excluded.vector_blob,
+      dimension     = excluded.dimension,
+      metadata_json = excluded.metadata_json
+  )";
+
+constexpr const char* kSelectVectorSql =
+    "SELECT vector_blob FROM embedding_vectors WHERE namespace = ? AND key = ?";
+
 // RAII guard for prepared statements, local to this translation unit.
 struct StmtGuard {
   sqlite3_stmt* stmt = nullptr;
@@ -34,6 +84,29 @@ struct StmtGuard {
   StmtGuard& operator=(const StmtGuard&) = delete;
 };
 
+// Binds one row to a prepared kUpsertSql statement and executes it. The vector is bound as
+// its raw float32 bytes (native byte order).
+bool bind_and_step(sqlite3_stmt* stmt, VectorNamespace ns, const VectorKey& key,
+                   const Vector& embedding, const std::string& metadata) {
+  const auto byte_count = static_cast<int>(embedding.size() * sizeof(float));
+  sqlite3_bind_text(stmt, 1, ns.data(), static_cast<int>(ns.size()), SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt, 2, key.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_blob(stmt, 3, embedding.data(), byte_count, SQLITE_TRANSIENT);
+  sqlite3_bind_int(stmt, 4, static_cast<int>(embedding.size()));
+  sqlite3_bind_text(stmt, 5, metadata.c_str(), -1, SQLITE_TRANSIENT);
+  return sqlite3_step(stmt) == SQLITE_DONE;
+}
+
+// Single-integer result of sql (a PRAGMA or COUNT), or -1 if it cannot be read.
+std::int64_t query_int(sqlite3* db, const char* sql) {
+  StmtGuard guard;
+  if (sqlite3_prepare_v2(db, sql, -1, &guard.stmt, nullptr) != SQLITE_OK ||
+      sqlite3_step(guard.stmt) != SQLITE_ROW) {
+    return -1;
+  }
+  return sqlite3_column_int64(guard.stmt, 0);
+}
+
 }  // namespace
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -50,7 +123,10 @@ void SqliteEmbeddingIndex::DbDeleter::operator()(sqlite3* db) const {
 // Construction / destruction
 // ─────────────────────────────────────────────────────────────────────────────
 
-SqliteEmbeddingIndex::SqliteEmbeddingIndex(const std::string& db_path) {
+SqliteEmbeddingIndex::SqliteEmbeddingIndex(const std::string& db_path,
+                                           QuantizationConfig quantization,
+                                           const std::optional<storage::SqliteTuning>& tuning)
+    : quantization_(quantization) {
   sqlite3* raw_db = nullptr;
   int rc = sqlite3_open(db_path.c_str(), &raw_db);
   if (rc != SQLITE_OK) {
@@ -59,7 +135,21 @@ SqliteEmbeddingIndex::SqliteEmbeddingIndex(const std::string& db_path) {
     throw std::runtime_error("SqliteEmbeddingIndex: cannot open '" + db_path + "': " + err);
   }
   db_.reset(raw_db);
+  if (tuning.has_value()) {
+    const std::string tuning_sql = storage::sqlite_tuning_pragmas(*tuning);
+    char* err_msg = nullptr;
+    if (sqlite3_exec(db_.get(), tuning_sql.c_str(), nullptr, nullptr, &err_msg) != SQLITE_OK) {
+      std::string err = (err_msg != nullptr) ? err_msg : "unknown error";
+      sqlite3_free(err_msg);
+      throw std::runtime_error("SqliteEmbeddingIndex: cannot apply SQLite tuning to '" +
+                               db_path + "': " + err);
+    }
+  }
   ensure_schema();
+  if (!load_mirror()) {
+    throw std::runtime_error("SqliteEmbeddingIndex: cannot load vectors from '" + db_path +
+                             "': " + sqlite3_errmsg(db_.get()));
+  }
 }
 
 // Destructor must be defined here so the sqlite3 deleter runs where sqlite3 is a complete type.
@@ -70,158 +160,271 @@ SqliteEmbeddingIndex::~SqliteEmbeddingIndex() = default;
 // ─────────────────────────────────────────────────────────────────────────────
 
 void SqliteEmbeddingIndex::ensure_schema() {
-  char* err_msg = nullptr;
-  int rc = sqlite3_exec(db_.get(), kSchema, nullptr, nullptr, &err_msg);
-  if (rc != SQLITE_OK) {
-    std::string err = (err_msg != nullptr) ? err_msg : "unknown error";
-    sqlite3_free(err_msg);
-    throw std::runtime_error("SqliteEmbeddingIndex: schema setup failed: " + err);
+  const auto run = [this](const char* sql) {
+    char* err_msg = nullptr;
+    if (sqlite3_exec(db_.get(), sql, nullptr, nullptr, &err_msg) != SQLITE_OK) {
+      std::string err = (err_msg != nullptr) ? err_msg : "unknown error";
+      sqlite3_free(err_msg);
+      (void)exec("ROLLBACK");
+      throw std::runtime_error("SqliteEmbeddingIndex: schema setup failed: " + err);
+    }
+  };
+
+  run("BEGIN IMMEDIATE");
+  const std::int64_t version = query_int(db_.get(), "PRAGMA user_version");
+  if (version > kSchemaVersion) {
+    (void)exec("ROLLBACK");
+    throw std::runtime_error("SqliteEmbeddingIndex: unsupported schema version " +
+                             std::to_string(version));
+  }
+  if (version < kSchemaVersion) {
+    const bool legacy_table =
+        query_int(db_.get(),
+                  "SELECT COUNT(*) FROM sqlite_master "
+                  "WHERE type = 'table' AND name = 'embedding_vectors'") > 0;
+    run(legacy_table ? kMigrateLegacySql : kSchema);
+    run(("PRAGMA user_version = " + std::to_string(kSchemaVersion)).c_str());
   }
+  run("COMMIT");
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
 // IEmbeddingIndex interface
 // ─────────────────────────────────────────────────────────────────────────────
 
-void SqliteEmbeddingIndex::upsert(const VectorKey& key, const Vector& embedding,
-                                  const std::string& metadata) {
-  constexpr const char* sql = R"(
-    INSERT INTO embedding_vectors (key, vector_blob, dimension, metadata_json)
-    VALUES (?, ?, ?, ?)
-    ON CONFLICT(key) DO UPDATE SET
-      vector_blob   = excluded.vector_blob,
-      dimension     = excluded.dimension,
-      metadata_json = excluded.metadata_json
-  )";
-
+void SqliteEmbeddingIndex::upsert(VectorNamespace ns, const VectorKey& key,
+                                  const Vector& embedding, const std::string& metadata) {
   StmtGuard guard;
-  int rc = sqlite3_prepare_v2(db_.get(), sql, -1, &guard.stmt, nullptr);
+  int rc = sqlite3_prepare_v2(db_.get(), kUpsertSql, -1, &guard.stmt, nullptr);
   if (rc != SQLITE_OK) {
     return;  // Silent failure for upsert (matches in-memory semantics)
   }
 
-  auto blob = to_blob(embedding);
-  const int dim = static_cast<int>(embedding.size());
-
-  sqlite3_bind_text(guard.stmt, 1, key.c_str(), -1, SQLITE_TRANSIENT);
-  sqlite3_bind_blob(guard.stmt, 2, blob.data(), static_cast<int>(blob.size()), SQLITE_TRANSIENT);
-  sqlite3_bind_int(guard.stmt, 3, dim);
-  sqlite3_bind_text(guard.stmt, 4, metadata.c_str(), -1, SQLITE_TRANSIENT);
-
-  sqlite3_step(guard.stmt);
+  if (bind_and_step(guard.stmt, ns, key, embedding, metadata)) {
+    apply(segments_.try_emplace(std::string(ns)).first->second, key, embedding, metadata);
+  }
 }
 
-std::vector<VectorSearchResult> SqliteEmbeddingIndex::query(const Vector& query_vector,
-                                                            size_t top_k) const {
-  // Load all rows ordered by key to ensure a deterministic baseline before sorting.
-  // The final ordering is by score (desc) then key (asc), applied in-process below.
-  constexpr const char* sql =
-      "SELECT key, vector_blob, metadata_json FROM embedding_vectors ORDER BY key";
+void SqliteEmbeddingIndex::upsert_many(VectorNamespace ns,
+                                       std::span<const VectorRecord> records) {
+  if (records.empty()) {
+    return;
+  }
 
   StmtGuard guard;
-  int rc = sqlite3_prepare_v2(db_.get(), sql, -1, &guard.stmt, nullptr);
-  if (rc != SQLITE_OK) {
-    return {};
+  if (sqlite3_prepare_v2(db_.get(), kUpsertSql, -1, &guard.stmt, nullptr) != SQLITE_OK) {
+    return;  // Silent failure for upsert (matches in-memory semantics)
+  }
+  if (!exec("BEGIN IMMEDIATE")) {
+    return;
   }
 
-  std::vector<VectorSearchResult> results;
-  while (sqlite3_step(guard.stmt) == SQLITE_ROW) {
-    const char* raw_key = reinterpret_cast<const char*>(sqlite3_column_text(guard.stmt, 0));
-    const void* blob_data = sqlite3_column_blob(guard.stmt, 1);
-    const int blob_size = sqlite3_column_bytes(guard.stmt, 1);
-    const char* raw_meta = reinterpret_cast<const char*>(sqlite3_column_text(guard.stmt, 2));
+  for (const auto& record : records) {
+    if (!bind_and_step(guard.stmt, ns, record.key, record.embedding, record.metadata)) {
+      (void)exec("ROLLBACK");
+      return;
+    }
+    sqlite3_reset(guard.stmt);
+    sqlite3_clear_bindings(guard.stmt);
+  }
 
-    Vector stored = from_blob(blob_data, blob_size);
-    double score = cosine_similarity(query_vector, stored);
+  if (!exec("COMMIT")) {
+    (void)exec("ROLLBACK");
+    return;
+  }
 
-    results.push_back(VectorSearchResult{
-        .key = raw_key != nullptr ? std::string(raw_key) : std::string{},
-        .score = score,
-        .metadata = raw_meta != nullptr ? std::string(raw_meta) : std::string{},
-    });
+  // Our own commit does not change PRAGMA data_version, so the mirror stays current.
+  Segment& segment = segments_.try_emplace(std::string(ns)).first->second;
+  if (quantization_.mode == VectorQuantization::kInt8) {
+    segment.quantized.reserve(records.size(), records.front().embedding.size());
+  } else {
+    segment.flat.reserve(records.size(), records.front().embedding.size());
   }
+  for (const auto& record : records) {
+    apply(segment, record.key, record.embedding, record.metadata);
+  }
+}
 
-  // Sort: score descending, tie-break by key ascending (lexicographic).
-  // Epsilon 1e-9 matches InMemoryEmbeddingIndex exactly.
-  std::sort(results.begin(), results.end(),
-            [](const VectorSearchResult& a, const VectorSearchResult& b) {
-              constexpr double kEpsilon = 1e-9;
-              if (std::abs(a.score - b.score) > kEpsilon) {
-                return a.score > b.score;
-              }
-              return a.key < b.key;
-            });
+std::vector<VectorSearchResult> SqliteEmbeddingIndex::query(VectorNamespace ns,
+                                                            const Vector& query_vector,
+                                                            size_t top_k) const {
+  refresh_mirror();
+  const Segment* segment = find_segment(ns);
+  if (segment == nullptr) {
+    return {};
+  }
+  if (quantization_.mode == VectorQuantization::kInt8) {
+    return query_quantized(ns, *segment, query_vector, top_k);
+  }
+  return segment->flat.query(query_vector, top_k);
+}
 
-  if (results.size() > top_k) {
-    results.resize(top_k);
+std::vector<std::vector<VectorSearchResult>> SqliteEmbeddingIndex::query_batch(
+    VectorNamespace ns, std::span<const Vector> queries, size_t top_k) const {
+  refresh_mirror();
+  const Segment* segment = find_segment(ns);
+  if (segment == nullptr) {
+    return std::vector<std::vector<VectorSearchResult>>(queries.size());
   }
+  if (quantization_.mode == VectorQuantization::kInt8) {
+    std::vector<std::vector<VectorSearchResult>> results;
+    results.reserve(queries.size());
+    for (const auto& query_vector : queries) {
+      results.push_back(query_quantized(ns, *segment, query_vector, top_k));
+    }
+    return results;
+  }
+  return segment->flat.query_batch(queries, top_k);
+}
 
-  return results;
+std::optional<Vector> SqliteEmbeddingIndex::get(VectorNamespace ns, const VectorKey& key) const {
+  if (quantization_.mode == VectorQuantization::kInt8) {
+    return read_vector(ns, key);
+  }
+  refresh_mirror();
+  const Segment* segment = find_segment(ns);
+  return segment != nullptr ? segment->flat.get(key) : std::nullopt;
 }
 
-std::optional<Vector> SqliteEmbeddingIndex::get(const VectorKey& key) const {
-  constexpr const char* sql = "SELECT vector_blob FROM embedding_vectors WHERE key = ?";
+// ─────────────────────────────────────────────────────────────────────────────
+// Private helpers
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool SqliteEmbeddingIndex::exec(const char* sql) const {
+  return sqlite3_exec(db_.get(), sql, nullptr, nullptr, nullptr) == SQLITE_OK;
+}
 
-  StmtGuard guard;
-  int rc = sqlite3_prepare_v2(db_.get(), sql, -1, &guard.stmt, nullptr);
-  if (rc != SQLITE_OK) {
-    return std::nullopt;
+void SqliteEmbeddingIndex::apply(Segment& segment, const VectorKey& key,
+                                 const Vector& embedding, const std::string& metadata) const {
+  if (quantization_.mode == VectorQuantization::kInt8) {
+    segment.quantized.upsert(key, embedding, metadata);
+  } else {
+    segment.flat.upsert(key, embedding, metadata);
   }
+}
 
-  sqlite3_bind_text(guard.stmt, 1, key.c_str(), -1, SQLITE_TRANSIENT);
+const SqliteEmbeddingIndex::Segment* SqliteEmbeddingIndex::find_segment(VectorNamespace ns) const {
+  const auto it = segments_.find(ns);
+  return it != segments_.end() ? &it->second : nullptr;
+}
 
-  if (sqlite3_step(guard.stmt) == SQLITE_ROW) {
-    const void* blob_data = sqlite3_column_blob(guard.stmt, 0);
-    const int blob_size = sqlite3_column_bytes(guard.stmt, 0);
-    return from_blob(blob_data, blob_size);
+std::vector<VectorSearchResult> SqliteEmbeddingIndex::query_quantized(VectorNamespace ns,
+                                                                      const Segment& segment,
+                                                                      const Vector& query_vector,
+                                                                      size_t top_k) const {
+  if (top_k == 0) {
+    return {};
   }
+  const size_t factor = std::max<size_t>(quantization_.rerank_factor, 1);
+  const size_t candidate_count = top_k > std::numeric_limits<size_t>::max() / factor
+                                     ? std::numeric_limits<size_t>::max()
+                                     : top_k * factor;
+  auto candidates = segment.quantized.candidates(query_vector, candidate_count);
 
-  return std::nullopt;
+  StmtGuard guard;
+  if (sqlite3_prepare_v2(db_.get(), kSelectVectorSql, -1, &guard.stmt, nullptr) != SQLITE_OK) {
+    return {};
+  }
+  sqlite3_bind_text(guard.stmt, 1, ns.data(), static_cast<int>(ns.size()), SQLITE_STATIC);
+
+  TopKSelector selector(top_k);
+  Vector exact;
+  for (auto& candidate : candidates) {
+    sqlite3_bind_text(guard.stmt, 2, candidate.key.c_str(), -1, SQLITE_STATIC);
+    const bool found = sqlite3_step(guard.stmt) == SQLITE_ROW;
+    if (found) {
+      decode_blob_into(sqlite3_column_blob(guard.stmt, 0), sqlite3_column_bytes(guard.stmt, 0),
+                       exact);
+    }
+    sqlite3_reset(guard.stmt);
+    if (!found) {
+      continue;  // deleted behind the mirror's back; the next refresh drops it
+    }
+    candidate.score = math::cosine_similarity(query_vector, exact);
+    if (selector.accepts(candidate.score, candidate.key)) {
+      selector.push(std::move(candidate));
+    }
+  }
+  return selector.take_sorted();
 }
 
-// ─────────────────────────────────────────────────────────────────────────────
-// Private helpers
-// ─────────────────────────────────────────────────────────────────────────────
+std::optional<Vector> SqliteEmbeddingIndex::read_vector(VectorNamespace ns,
+                                                       const VectorKey& key) const {
+  StmtGuard guard;
+  if (sqlite3_prepare_v2(db_.get(), kSelectVectorSql, -1, &guard.stmt, nullptr) != SQLITE_OK) {
+    return std::nullopt;
+  }
+  sqlite3_bind_text(guard.stmt, 1, ns.data(), static_cast<int>(ns.size()), SQLITE_STATIC);
+  sqlite3_bind_text(guard.stmt, 2, key.c_str(), -1, SQLITE_STATIC);
+  if (sqlite3_step(guard.stmt) != SQLITE_ROW) {
+    return std::nullopt;
+  }
+  Vector out;
+  decode_blob_into(sqlite3_column_blob(guard.stmt, 0), sqlite3_column_bytes(guard.stmt, 0), out);
+  return out;
+}
 
-double SqliteEmbeddingIndex::cosine_similarity(const Vector& a, const Vector& b) {
-  if (a.size() != b.size() || a.empty()) {
-    return 0.0;
+void SqliteEmbeddingIndex::refresh_mirror() const {
+  const std::int64_t version = read_data_version();
+  if (version != -1 && version != data_version_) {
+    (void)load_mirror();  // on failure keep serving the previous snapshot
   }
+}
 
-  double dot_product = 0.0;
-  double norm_a = 0.0;
-  double norm_b = 0.0;
+bool SqliteEmbeddingIndex::load_mirror() const {
+  // Read the version first: a commit landing during the scan then triggers one more reload
+  // instead of being missed.
+  const std::int64_t version = read_data_version();
 
-  for (size_t i = 0; i < a.size(); ++i) {
-    dot_product += static_cast<double>(a[i]) * static_cast<double>(b[i]);
-    norm_a += static_cast<double>(a[i]) * static_cast<double>(a[i]);
-    norm_b += static_cast<double>(b[i]) * static_cast<double>(b[i]);
+  constexpr const char* sql =
+      "SELECT namespace, key, vector_blob, metadata_json FROM embedding_vectors "
+      "ORDER BY namespace, key";
+  StmtGuard guard;
+  if (sqlite3_prepare_v2(db_.get(), sql, -1, &guard.stmt, nullptr) != SQLITE_OK) {
+    return false;
   }
 
-  norm_a = std::sqrt(norm_a);
-  norm_b = std::sqrt(norm_b);
-
-  if (norm_a == 0.0 || norm_b == 0.0) {
-    return 0.0;
+  SegmentMap loaded;
+  Segment* segment = nullptr;
+  std::string segment_ns;
+  Vector scratch;
+  int rc = SQLITE_ROW;
+  while ((rc = sqlite3_step(guard.stmt)) == SQLITE_ROW) {
+    const auto* raw_ns = reinterpret_cast<const char*>(sqlite3_column_text(guard.stmt, 0));
+    const auto* raw_key = reinterpret_cast<const char*>(sqlite3_column_text(guard.stmt, 1));
+    const auto* raw_meta = reinterpret_cast<const char*>(sqlite3_column_text(guard.stmt, 3));
+    decode_blob_into(sqlite3_column_blob(guard.stmt, 2), sqlite3_column_bytes(guard.stmt, 2),
+                     scratch);
+    const std::string_view ns = raw_ns != nullptr ? std::string_view(raw_ns) : std::string_view{};
+    if (segment == nullptr || ns != segment_ns) {
+      segment_ns = std::string(ns);  // rows arrive grouped by namespace
+      segment = &loaded.try_emplace(segment_ns).first->second;
+    }
+    const std::string key = raw_key != nullptr ? std::string(raw_key) : std::string{};
+    const std::string metadata = raw_meta != nullptr ? std::string(raw_meta) : std::string{};
+    apply(*segment, key, scratch, metadata);
+  }
+  if (rc != SQLITE_DONE) {
+    return false;
   }
 
-  return dot_product / (norm_a * norm_b);
+  segments_ = std::move(loaded);
+  data_version_ = version;
+  return true;
 }
 
-std::vector<std::byte> SqliteEmbeddingIndex::to_blob(const Vector& v) {
-  std::vector<std::byte> blob(v.size() * sizeof(float));
-  std::memcpy(blob.data(), v.data(), blob.size());
-  return blob;
+std::int64_t SqliteEmbeddingIndex::read_data_version() const {
+  return query_int(db_.get(), "PRAGMA data_version");
 }
 
-Vector SqliteEmbeddingIndex::from_blob(const void* data, int size_bytes) {
+void SqliteEmbeddingIndex::decode_blob_into(const void* data, int size_bytes, Vector& out) {
   if (data == nullptr || size_bytes <= 0) {
-    return {};
+    out.clear();
+    return;
   }
   const size_t n = static_cast<size_t>(size_bytes) / sizeof(float);
-  Vector result(n);
-  std::memcpy(result.data(), data, static_cast<size_t>(size_bytes));
-  return result;
+  out.resize(n);  // keeps capacity, so a load allocates once
+  std::memcpy(out.data(), data, n * sizeof(float));
 }
 
 }  // namespace ccmcp::vector
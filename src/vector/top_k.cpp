@@ -0,0 +1,49 @@
+#include "ccmcp/vector/top_k.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace ccmcp::vector {
+
+namespace {
+
+bool result_ranks_before(const VectorSearchResult& a, const VectorSearchResult& b) {
+  return ranks_before(a.score, a.key, b.score, b.key);
+}
+
+}  // namespace
+
+TopKSelector::TopKSelector(const std::size_t top_k) : top_k_(top_k) {
+  heap_.reserve(top_k_);
+}
+
+bool TopKSelector::accepts(const double score, const std::string_view key) const noexcept {
+  if (heap_.size() < top_k_) {
+    return true;
+  }
+  if (heap_.empty()) {
+    return false;  // top_k == 0
+  }
+  const auto& worst = heap_.front();
+  return ranks_before(score, key, worst.score, worst.key);
+}
+
+void TopKSelector::push(VectorSearchResult result) {
+  if (!accepts(result.score, result.key)) {
+    return;
+  }
+  if (heap_.size() == top_k_) {
+    std::pop_heap(heap_.begin(), heap_.end(), result_ranks_before);
+    heap_.back() = std::move(result);
+  } else {
+    heap_.push_back(std::move(result));
+  }
+  std::push_heap(heap_.begin(), heap_.end(), result_ranks_before);
+}
+
+std::vector<VectorSearchResult> TopKSelector::take_sorted() {
+  std::sort_heap(heap_.begin(), heap_.end(), result_ranks_before);
+  return std::exchange(heap_, {});
+}
+
+}  // namespace ccmcp::vector
@@ -0,0 +1,378 @@
+#include "ccmcp/vector/vector_math.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CCMCP_VECTOR_MATH_X86 1
+#include <immintrin.h>
+#else
+#define CCMCP_VECTOR_MATH_X86 0
+#endif
+
+namespace ccmcp::vector::math {
+
+namespace {
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Fixed reduction order, shared by every kernel
+// ─────────────────────────────────────────────────────────────────────────────
+
+// Sums the lanes pairwise: lane l += lane l + 8, then + 4, + 2, + 1.
+double reduce_lanes(double* lanes) {
+  for (std::size_t width = kLanes / 2; width > 0; width /= 2) {
+    for (std::size_t l = 0; l < width; ++l) {
+      lanes[l] += lanes[l + width];
+    }
+  }
+  return lanes[0];
+}
+
+// Adds the elements [begin, n) after the last full block (begin is a multiple of kLanes,
+// so element i still lands in lane i % kLanes), then reduces.
+double finish(double* lanes, const float* a, const float* b, const std::size_t begin,
+              const std::size_t n) {
+  for (std::size_t i = begin; i < n; ++i) {
+    lanes[i - begin] += static_cast<double>(a[i] * b[i]);
+  }
+  return reduce_lanes(lanes);
+}
+
+std::size_t full_blocks(const std::size_t n) {
+  return n - n % kLanes;
+}
+
+// Adds the int8 products of [begin, n) to sum; the integer sum is exact in any order.
+std::int32_t finish_i8(std::int32_t sum, const std::int8_t* a, const std::int8_t* b,
+                       const std::size_t begin, const std::size_t n) {
+  for (std::size_t i = begin; i < n; ++i) {
+    sum += std::int32_t{a[i]} * std::int32_t{b[i]};
+  }
+  return sum;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Scalar
+// ─────────────────────────────────────────────────────────────────────────────
+
+double dot_scalar(const float* a, const float* b, const std::size_t n) {
+  double lanes[kLanes] = {};
+  const std::size_t body = full_blocks(n);
+  for (std::size_t i = 0; i < body; i += kLanes) {
+    for (std::size_t l = 0; l < kLanes; ++l) {
+      lanes[l] += static_cast<double>(a[i + l] * b[i + l]);
+    }
+  }
+  return finish(lanes, a, b, body, n);
+}
+
+void dot_many_scalar(const float* query, const float* rows, const std::size_t stride,
+                     const std::size_t count, const std::size_t dim, double* out) {
+  for (std::size_t r = 0; r < count; ++r) {
+    out[r] = dot_scalar(query, rows + r * stride, dim);
+  }
+}
+
+std::int32_t dot_i8_scalar(const std::int8_t* a, const std::int8_t* b, const std::size_t n) {
+  return finish_i8(0, a, b, 0, n);
+}
+
+void dot_i8_many_scalar(const std::int8_t* query, const std::int8_t* rows,
+                        const std::size_t stride, const std::size_t count, const std::size_t dim,
+                        std::int32_t* out) {
+  for (std::size_t r = 0; r < count; ++r) {
+    out[r] = dot_i8_scalar(query, rows + r * stride, dim);
+  }
+}
+
+const Kernels kScalarKernels{.isa = Isa::kScalar,
+                             .dot = &dot_scalar,
+                             .dot_many = &dot_many_scalar,
+                             .dot_i8 = &dot_i8_scalar,
+                             .dot_i8_many = &dot_i8_many_scalar};
+
+#if CCMCP_VECTOR_MATH_X86
+
+// ─────────────────────────────────────────────────────────────────────────────
+// SSE4.2: 8 × 2 double lanes
+// ─────────────────────────────────────────────────────────────────────────────
+
+__attribute__((target("sse4.2"))) double dot_sse42(const float* a, const float* b,
+                                                   const std::size_t n) {
+  __m128d acc[8];
+  for (auto& v : acc) {
+    v = _mm_setzero_pd();
+  }
+  const std::size_t body = full_blocks(n);
+  for (std::size_t i = 0; i < body; i += kLanes) {
+    for (std::size_t j = 0; j < 4; ++j) {
+      const __m128 p = _mm_mul_ps(_mm_loadu_ps(a + i + 4 * j), _mm_loadu_ps(b + i + 4 * j));
+      acc[2 * j] = _mm_add_pd(acc[2 * j], _mm_cvtps_pd(p));
+      acc[2 * j + 1] = _mm_add_pd(acc[2 * j + 1], _mm_cvtps_pd(_mm_movehl_ps(p, p)));
+    }
+  }
+  alignas(16) double lanes[kLanes];
+  for (std::size_t j = 0; j < 8; ++j) {
+    _mm_store_pd(lanes + 2 * j, acc[j]);
+  }
+  return finish(lanes, a, b, body, n);
+}
+
+__attribute__((target("sse4.2"))) void dot_many_sse42(const float* query, const float* rows,
+                                                      const std::size_t stride,
+                                                      const std::size_t count,
+                                                      const std::size_t dim, double* out) {
+  for (std::size_t r = 0; r < count; ++r) {
+    out[r] = dot_sse42(query, rows + r * stride, dim);
+  }
+}
+
+// Sign-extends 8 int8 pairs to int16 and multiply-adds adjacent pairs into 4 int32 lanes.
+__attribute__((target("sse4.2"))) std::int32_t dot_i8_sse42(const std::int8_t* a,
+                                                            const std::int8_t* b,
+                                                            const std::size_t n) {
+  __m128i acc = _mm_setzero_si128();
+  const std::size_t body = n - n % 8;
+  for (std::size_t i = 0; i < body; i += 8) {
+    const __m128i va =
+        _mm_cvtepi8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(a + i)));
+    const __m128i vb =
+        _mm_cvtepi8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(b + i)));
+    acc = _mm_add_epi32(acc, _mm_madd_epi16(va, vb));
+  }
+  alignas(16) std::int32_t lanes[4];
+  _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+  return finish_i8(lanes[0] + lanes[1] + lanes[2] + lanes[3], a, b, body, n);
+}
+
+__attribute__((target("sse4.2"))) void dot_i8_many_sse42(const std::int8_t* query,
+                                                         const std::int8_t* rows,
+                                                         const std::size_t stride,
+                                                         const std::size_t count,
+                                                         const std::size_t dim,
+                                                         std::int32_t* out) {
+  for (std::size_t r = 0; r < count; ++r) {
+    out[r] = dot_i8_sse42(query, rows + r * stride, dim);
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// AVX2: 4 × 4 double lanes
+// ─────────────────────────────────────────────────────────────────────────────
+
+__attribute__((target("avx2"))) double dot_avx2(const float* a, const float* b,
+                                               const std::size_t n) {
+  __m256d acc0 = _mm256_setzero_pd();
+  __m256d acc1 = _mm256_setzero_pd();
+  __m256d acc2 = _mm256_setzero_pd();
+  __m256d acc3 = _mm256_setzero_pd();
+  const std::size_t body = full_blocks(n);
+  for (std::size_t i = 0; i < body; i += kLanes) {
+    const __m256 p0 = _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+    const __m256 p1 = _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8));
+    acc0 = _mm256_add_pd(acc0, _mm256_cvtps_pd(_mm256_castps256_ps128(p0)));
+    acc1 = _mm256_add_pd(acc1, _mm256_cvtps_pd(_mm256_extractf128_ps(p0, 1)));
+    acc2 = _mm256_add_pd(acc2, _mm256_cvtps_pd(_mm256_castps256_ps128(p1)));
+    acc3 = _mm256_add_pd(acc3, _mm256_cvtps_pd(_mm256_extractf128_ps(p1, 1)));
+  }
+  alignas(32) double lanes[kLanes];
+  _mm256_store_pd(lanes, acc0);
+  _mm256_store_pd(lanes + 4, acc1);
+  _mm256_store_pd(lanes + 8, acc2);
+  _mm256_store_pd(lanes + 12, acc3);
+  return finish(lanes, a, b, body, n);
+}
+
+__attribute__((target("avx2"))) void dot_many_avx2(const float* query, const float* rows,
+                                                   const std::size_t stride,
+                                                   const std::size_t count, const std::size_t dim,
+                                                   double* out) {
+  for (std::size_t r = 0; r < count; ++r) {
+    out[r] = dot_avx2(query, rows + r * stride, dim);
+  }
+}
+
+// 16 int8 pairs per step, widened to int16 and multiply-added into 8 int32 lanes.
+__attribute__((target("avx2"))) std::int32_t dot_i8_avx2(const std::int8_t* a,
+                                                        const std::int8_t* b,
+                                                        const std::size_t n) {
+  __m256i acc = _mm256_setzero_si256();
+  const std::size_t body = n - n % 16;
+  for (std::size_t i = 0; i < body; i += 16) {
+    const __m256i va =
+        _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+    const __m256i vb =
+        _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+    acc = _mm256_add_epi32(acc, _mm256_madd_epi16(va, vb));
+  }
+  alignas(32) std::int32_t lanes[8];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+  std::int32_t sum = 0;
+  for (const std::int32_t lane : lanes) {
+    sum += lane;
+  }
+  return finish_i8(sum, a, b, body, n);
+}
+
+__attribute__((target("avx2"))) void dot_i8_many_avx2(const std::int8_t* query,
+                                                      const std::int8_t* rows,
+                                                      const std::size_t stride,
+                                                      const std::size_t count,
+                                                      const std::size_t dim, std::int32_t* out) {
+  for (std::size_t r = 0; r < count; ++r) {
+    out[r] = dot_i8_avx2(query, rows + r * stride, dim);
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// AVX-512: 2 × 8 double lanes
+// ─────────────────────────────────────────────────────────────────────────────
+
+// GCC's AVX-512 intrinsics pass _mm512_undefined_pd() as the unused merge source, which
+// -Wmaybe-uninitialized reports as a false positive when inlined.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+__attribute__((target("avx512f"))) double dot_avx512(const float* a, const float* b,
+                                                    const std::size_t n) {
+  __m512d acc0 = _mm512_setzero_pd();
+  __m512d acc1 = _mm512_setzero_pd();
+  const std::size_t body = full_blocks(n);
+  for (std::size_t i = 0; i < body; i += kLanes) {
+    const __m512 p = _mm512_mul_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i));
+    // Upper eight products via the 64-bit extract (the 32-bit one needs AVX512DQ).
+    const __m256 high = _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(p), 1));
+    acc0 = _mm512_add_pd(acc0, _mm512_cvtps_pd(_mm512_castps512_ps256(p)));
+    acc1 = _mm512_add_pd(acc1, _mm512_cvtps_pd(high));
+  }
+  alignas(64) double lanes[kLanes];
+  _mm512_store_pd(lanes, acc0);
+  _mm512_store_pd(lanes + 8, acc1);
+  return finish(lanes, a, b, body, n);
+}
+
+__attribute__((target("avx512f"))) void dot_many_avx512(const float* query, const float* rows,
+                                                        const std::size_t stride,
+                                                        const std::size_t count,
+                                                        const std::size_t dim, double* out) {
+  for (std::size_t r = 0; r < count; ++r) {
+    out[r] = dot_avx512(query, rows + r * stride, dim);
+  }
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+const Kernels kSse42Kernels{.isa = Isa::kSse42,
+                            .dot = &dot_sse42,
+                            .dot_many = &dot_many_sse42,
+                            .dot_i8 = &dot_i8_sse42,
+                            .dot_i8_many = &dot_i8_many_sse42};
+const Kernels kAvx2Kernels{.isa = Isa::kAvx2,
+                           .dot = &dot_avx2,
+                           .dot_many = &dot_many_avx2,
+                           .dot_i8 = &dot_i8_avx2,
+                           .dot_i8_many = &dot_i8_many_avx2};
+// The int8 kernels stay on AVX2: a 512-bit version needs AVX512BW, which avx512f CPUs may
+// lack, and the quantized scan is already memory-bound at AVX2 width.
+const Kernels kAvx512Kernels{.isa = Isa::kAvx512,
+                             .dot = &dot_avx512,
+                             .dot_many = &dot_many_avx512,
+                             .dot_i8 = &dot_i8_avx2,
+                             .dot_i8_many = &dot_i8_many_avx2};
+
+// __builtin_cpu_supports also checks that the OS saves the wider register state.
+bool cpu_supports(const Isa isa) {
+  __builtin_cpu_init();
+  switch (isa) {
+    case Isa::kScalar:
+      return true;
+    case Isa::kSse42:
+      return __builtin_cpu_supports("sse4.2") != 0;
+    case Isa::kAvx2:
+      return __builtin_cpu_supports("avx2") != 0;
+    case Isa::kAvx512:
+      return __builtin_cpu_supports("avx512f") != 0;
+  }
+  return false;
+}
+
+#endif  // CCMCP_VECTOR_MATH_X86
+
+}  // namespace
+
+std::string_view to_string(const Isa isa) noexcept {
+  switch (isa) {
+    case Isa::kScalar:
+      return "scalar";
+    case Isa::kSse42:
+      return "sse4.2";
+    case Isa::kAvx2:
+      return "avx2";
+    case Isa::kAvx512:
+      return "avx512";
+  }
+  return "unknown";
+}
+
+const Kernels* kernels_for(const Isa isa) noexcept {
+  switch (isa) {
+    case Isa::kScalar:
+      return &kScalarKernels;
+#if CCMCP_VECTOR_MATH_X86
+    case Isa::kSse42:
+      return cpu_supports(isa) ? &kSse42Kernels : nullptr;
+    case Isa::kAvx2:
+      return cpu_supports(isa) ? &kAvx2Kernels : nullptr;
+    case Isa::kAvx512:
+      return cpu_supports(isa) ? &kAvx512Kernels : nullptr;
+#endif
+    default:
+      return nullptr;
+  }
+}
+
+const Kernels& kernels() noexcept {
+  static const Kernels* const selected = []() {
+    for (const Isa isa : {Isa::kAvx512, Isa::kAvx2, Isa::kSse42}) {
+      if (const Kernels* k = kernels_for(isa)) {
+        return k;
+      }
+    }
+    return &kScalarKernels;
+  }();
+  return *selected;
+}
+
+double l2_norm(const float* v, const std::size_t n) {
+  return std::sqrt(dot(v, v, n));
+}
+
+void dot_block(const float* const* queries, const std::size_t num_queries, const float* rows,
+               const std::size_t stride, const std::size_t count, const std::size_t dim,
+               double* out) {
+  const DotManyFn dot_many_fn = kernels().dot_many;
+  const std::size_t row_bytes = std::max<std::size_t>(stride, 1) * sizeof(float);
+  const std::size_t tile_rows = std::max<std::size_t>(kBlockTileBytes / row_bytes, 1);
+  for (std::size_t first = 0; first < count; first += tile_rows) {
+    const std::size_t tile = std::min(tile_rows, count - first);
+    for (std::size_t q = 0; q < num_queries; ++q) {
+      dot_many_fn(queries[q], rows + first * stride, stride, tile, dim, out + q * count + first);
+    }
+  }
+}
+
+double cosine_similarity(const Vector& a, const Vector& b) {
+  if (a.size() != b.size() || a.empty()) {
+    return 0.0;
+  }
+  const Kernels& k = kernels();
+  const std::size_t n = a.size();
+  return cosine_from_dot(k.dot(a.data(), b.data(), n), std::sqrt(k.dot(a.data(), a.data(), n)),
+                         std::sqrt(k.dot(b.data(), b.data(), n)));
+}
+
+}  // namespace ccmcp::vector::math
@@ -13,6 +13,10 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <string>
+#include <utility>
+#include <vector>
+
 using namespace ccmcp;
 
 TEST_CASE("app_service: run_match_pipeline with deterministic components",
@@ -185,3 +189,90 @@ TEST_CASE(
 
   CHECK_THROWS_AS(app::run_match_pipeline(request, services, id_gen, clock), std::invalid_argument);
 }
+
+TEST_CASE("app_service: run_match_batch_pipeline emits one trace for the batch",
+          "[app_service][match][batch]") {
+  core::DeterministicIdGenerator id_gen;
+  core::FixedClock clock("2026-01-01T00:00:00Z");
+
+  storage::InMemoryAtomRepository atom_repo;
+  storage::InMemoryOpportunityRepository opportunity_repo;
+  storage::InMemoryInteractionRepository interaction_repo;
+  storage::InMemoryAuditLog audit_log;
+  vector::NullEmbeddingIndex vector_index;
+  embedding::DeterministicStubEmbeddingProvider embedding_provider;
+
+  core::Services services{atom_repo, opportunity_repo, interaction_repo,
+                          audit_log, vector_index,     embedding_provider};
+
+  for (const auto& [id, text] : std::vector<std::pair<std::string, std::string>>{
+           {"opp-1", "C++20 systems"}, {"opp-2", "Architecture"}, {"opp-3", "C++20 systems"}}) {
+    services.opportunities.upsert(domain::Opportunity{
+        core::OpportunityId{id}, "ExampleCo", "Engineer", {{text, {}, true}}, "test"});
+  }
+  services.atoms.upsert({core::AtomId{"atom-cpp"},
+                         "cpp",
+                         "Modern C++",
+                         "Built C++20 systems",
+                         {"cpp20", "systems"},
+                         true,
+                         {}});
+
+  matching::CorpusSnapshotCache cache;
+  core::ThreadPool pool(2);
+  app::MatchBatchPipelineRequest request{
+      .opportunity_ids = {core::OpportunityId{"opp-3"}, core::OpportunityId{"opp-1"}},
+  };
+  const auto response = app::run_match_batch_pipeline(request, services, id_gen, clock, &cache,
+                                                      &pool);
+
+  REQUIRE(response.results.size() == 2);
+  CHECK(response.results[0].match_report.opportunity_id.value == "opp-3");
+  CHECK(response.results[1].match_report.opportunity_id.value == "opp-1");
+
+  // Each batch report equals the single-opportunity pipeline's report.
+  for (const auto& result : response.results) {
+    CHECK(result.trace_id == response.trace_id);
+    const auto single = app::run_match_pipeline(
+        app::MatchPipelineRequest{.opportunity_id = result.match_report.opportunity_id}, services,
+        id_gen, clock);
+    CHECK(result.match_report.overall_score == single.match_report.overall_score);
+    CHECK(result.match_report.matched_atoms == single.match_report.matched_atoms);
+    CHECK(result.validation_report.status == single.validation_report.status);
+  }
+
+  const auto events = services.audit_log.query(response.trace_id);
+  REQUIRE(events.size() == 6);
+  CHECK(events[0].event_type == "RunStarted");
+  CHECK(events[1].event_type == "MatchCompleted");
+  CHECK(events[2].event_type == "ValidationCompleted");
+  CHECK(events[3].event_type == "MatchCompleted");
+  CHECK(events[4].event_type == "ValidationCompleted");
+  CHECK(events[5].event_type == "RunCompleted");
+
+  // Defaulted opportunity_ids: every opportunity in the repository.
+  const auto all = app::run_match_batch_pipeline(app::MatchBatchPipelineRequest{}, services,
+                                                 id_gen, clock);
+  CHECK(all.results.size() == 3);
+}
+
+TEST_CASE("app_service: run_match_batch_pipeline throws on missing opportunity",
+          "[app_service][match][batch][error]") {
+  core::DeterministicIdGenerator id_gen;
+  core::FixedClock clock("2026-01-01T00:00:00Z");
+
+  storage::InMemoryAtomRepository atom_repo;
+  storage::InMemoryOpportunityRepository opportunity_repo;
+  storage::InMemoryInteractionRepository interaction_repo;
+  storage::InMemoryAuditLog audit_log;
+  vector::NullEmbeddingIndex vector_index;
+  embedding::DeterministicStubEmbeddingProvider embedding_provider;
+
+  core::Services services{atom_repo, opportunity_repo, interaction_repo,
+                          audit_log, vector_index,     embedding_provider};
+
+  app::MatchBatchPipelineRequest request{.opportunity_ids = {core::OpportunityId{"missing"}}};
+  CHECK_THROWS_AS(app::run_match_batch_pipeline(request, services, id_gen, clock),
+                  std::invalid_argument);
+  CHECK(services.audit_log.list_trace_ids().empty());  // nothing emitted
+}
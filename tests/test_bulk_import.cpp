@@ -0,0 +1,273 @@
+#include "ccmcp/app/app_service.h"
+#include "ccmcp/core/clock.h"
+#include "ccmcp/core/id_generator.h"
+#include "ccmcp/embedding/embedding_provider.h"
+#include "ccmcp/ingest/bulk_import.h"
+#include "ccmcp/storage/audit_log.h"
+#include "ccmcp/storage/inmemory_atom_repository.h"
+#include "ccmcp/storage/inmemory_interaction_repository.h"
+#include "ccmcp/storage/inmemory_opportunity_repository.h"
+#include "ccmcp/storage/sqlite/sqlite_atom_repository.h"
+#include "ccmcp/storage/sqlite/sqlite_db.h"
+#include "ccmcp/storage/sqlite/sqlite_opportunity_repository.h"
+#include "ccmcp/vector/null_embedding_index.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ccmcp;
+
+namespace {
+
+std::shared_ptr<storage::sqlite::SqliteDb> make_db() {
+  auto result = storage::sqlite::SqliteDb::open(":memory:");
+  REQUIRE(result.has_value());
+  REQUIRE(result.value()->ensure_schema_v1().has_value());
+  return result.value();
+}
+
+domain::ExperienceAtom make_atom(const std::string& id, const std::string& title) {
+  return {core::AtomId{id}, "cpp", title, "Claim " + id, {"ab", "cd"}, true, {"ref"}};
+}
+
+domain::Opportunity make_opportunity(const std::string& id, std::size_t requirement_count) {
+  domain::Opportunity opp{core::OpportunityId{id}, "Acme", "Engineer " + id, {}, "src"};
+  for (std::size_t i = 0; i < requirement_count; ++i) {
+    opp.requirements.push_back({id + " req " + std::to_string(i), {"t" + std::to_string(i % 7)},
+                                i % 2 == 0});
+  }
+  return opp;
+}
+
+void check_same(const domain::Opportunity& a, const domain::Opportunity& b) {
+  CHECK(a.opportunity_id == b.opportunity_id);
+  CHECK(a.company == b.company);
+  CHECK(a.role_title == b.role_title);
+  CHECK(a.source == b.source);
+  REQUIRE(a.requirements.size() == b.requirements.size());
+  for (std::size_t i = 0; i < a.requirements.size(); ++i) {
+    CHECK(a.requirements[i].text == b.requirements[i].text);
+    CHECK(a.requirements[i].tags == b.requirements[i].tags);
+    CHECK(a.requirements[i].required == b.requirements[i].required);
+  }
+}
+
+}  // namespace
+
+TEST_CASE("SqliteAtomRepository::upsert_many writes every atom in one transaction",
+          "[bulk_import][sqlite]") {
+  auto db = make_db();
+  storage::sqlite::SqliteAtomRepository repo(db);
+  repo.upsert(make_atom("atom-0", "Old"));
+  const auto version_before = repo.corpus_version();
+
+  std::vector<domain::ExperienceAtom> atoms;
+  for (int i = 0; i < 50; ++i) {
+    atoms.push_back(make_atom("atom-" + std::to_string(i), "New"));
+  }
+  atoms.push_back(make_atom("atom-7", "Last wins"));
+
+  CHECK(repo.upsert_many(atoms) == atoms.size());
+  CHECK(repo.list_all().size() == 50);
+  CHECK(repo.get(core::AtomId{"atom-0"})->title == "New");
+  CHECK(repo.get(core::AtomId{"atom-7"})->title == "Last wins");
+  CHECK(repo.get(core::AtomId{"atom-3"})->evidence_refs == std::vector<std::string>{"ref"});
+  CHECK(repo.corpus_version() != version_before);
+  CHECK(repo.upsert_many({}) == 0);
+}
+
+TEST_CASE("SqliteAtomRepository::upsert_many rolls back the whole batch on failure",
+          "[bulk_import][sqlite]") {
+  auto db = make_db();
+  REQUIRE(db->exec("CREATE TRIGGER reject_bad BEFORE INSERT ON atoms WHEN NEW.atom_id = 'bad' "
+                   "BEGIN SELECT RAISE(ABORT, 'rejected'); END")
+              .has_value());
+  storage::sqlite::SqliteAtomRepository repo(db);
+
+  CHECK(repo.upsert_many({make_atom("good-1", "A"), make_atom("bad", "B"),
+                          make_atom("good-2", "C")}) == 0);
+  CHECK(repo.list_all().empty());
+
+  // The connection is usable afterwards: no transaction was left open.
+  CHECK(repo.upsert_many({make_atom("good-1", "A")}) == 1);
+  CHECK(repo.list_all().size() == 1);
+}
+
+TEST_CASE("SqliteOpportunityRepository::upsert_many matches per-item upsert",
+          "[bulk_import][sqlite]") {
+  // Requirement counts straddle the 64-row multi-row INSERT: full batches, a tail,
+  // and an opportunity split across two batches.
+  std::vector<domain::Opportunity> opportunities = {
+      make_opportunity("opp-a", 3),  make_opportunity("opp-b", 64), make_opportunity("opp-c", 0),
+      make_opportunity("opp-d", 70), make_opportunity("opp-e", 1),
+  };
+  // A repeated id with rows still queued replaces the earlier version.
+  opportunities.push_back(make_opportunity("opp-e", 5));
+  opportunities.back().company = "Replaced";
+
+  auto bulk_db = make_db();
+  storage::sqlite::SqliteOpportunityRepository bulk(bulk_db);
+  bulk.upsert(make_opportunity("opp-a", 90));  // existing rows are replaced
+  CHECK(bulk.upsert_many(opportunities) == opportunities.size());
+
+  auto single_db = make_db();
+  storage::sqlite::SqliteOpportunityRepository single(single_db);
+  for (const auto& opportunity : opportunities) {
+    single.upsert(opportunity);
+  }
+
+  const auto bulk_all = bulk.list_all();
+  const auto single_all = single.list_all();
+  REQUIRE(bulk_all.size() == 5);
+  REQUIRE(bulk_all.size() == single_all.size());
+  for (std::size_t i = 0; i < bulk_all.size(); ++i) {
+    check_same(bulk_all[i], single_all[i]);
+  }
+  CHECK(bulk.get(core::OpportunityId{"opp-a"})->requirements.size() == 3);
+  CHECK(bulk.get(core::OpportunityId{"opp-e"})->company == "Replaced");
+  CHECK(bulk.get(core::OpportunityId{"opp-e"})->requirements.size() == 5);
+}
+
+TEST_CASE("InMemory repositories: upsert_many stores every item", "[bulk_import][inmemory]") {
+  storage::InMemoryAtomRepository atoms;
+  const auto version_before = atoms.corpus_version();
+  CHECK(atoms.upsert_many({make_atom("b", "B"), make_atom("a", "A"), make_atom("b", "B2")}) == 3);
+  const auto all = atoms.list_all();
+  REQUIRE(all.size() == 2);
+  CHECK(all[0].atom_id.value == "a");
+  CHECK(all[1].title == "B2");
+  CHECK(atoms.corpus_version() != version_before);
+
+  storage::InMemoryOpportunityRepository opportunities;
+  CHECK(opportunities.upsert_many({make_opportunity("o2", 2), make_opportunity("o1", 1)}) == 2);
+  CHECK(opportunities.list_all().size() == 2);
+  CHECK(opportunities.get(core::OpportunityId{"o2"})->requirements.size() == 2);
+}
+
+TEST_CASE("import_jsonl: imports valid lines and reports the rest", "[bulk_import]") {
+  std::istringstream input(
+      R"({"kind":"atom","atom_id":"atom-1","domain":" CPP ","title":"T","claim":" Built it ",)"
+      R"("tags":["Systems","Systems"],"verified":true})"
+      "\n"
+      "\n"
+      R"({"kind":"opportunity","opportunity_id":"opp-1","company":"Acme","role_title":"Eng",)"
+      R"("requirements":[{"text":"C++","tags":["cpp"]},{"text":"Go","required":false}]})"
+      "\n"
+      "not json\n"
+      R"({"kind":"resume","id":"x"})"
+      "\n"
+      R"({"kind":"atom","domain":"cpp","claim":"no id"})"
+      "\n"
+      R"({"kind":"atom","atom_id":"atom-2","claim":""})"
+      "\n"
+      R"({"kind":"atom","atom_id":"atom-3","claim":"ok","tags":"not-an-array"})"
+      "\n"
+      R"({"kind":"atom","atom_id":"atom-4","domain":"go","claim":"Shipped"})");
+
+  storage::InMemoryAtomRepository atoms;
+  storage::InMemoryOpportunityRepository opportunities;
+  ingest::BulkImportOptions options;
+  options.batch_size = 1;
+  const auto result = ingest::import_jsonl(input, atoms, opportunities, options);
+
+  CHECK(result.lines_read == 9);
+  CHECK(result.atoms_imported == 2);
+  CHECK(result.opportunities_imported == 1);
+  CHECK(result.error_count == 5);
+  REQUIRE(result.errors.size() == 5);
+  CHECK(result.errors[0] == "line 4: not a JSON object");
+  CHECK(result.errors[1].rfind("line 5: kind must be", 0) == 0);
+  CHECK(result.errors[2].rfind("line 6: ", 0) == 0);
+  CHECK(result.errors[3] == "line 7: claim must not be empty");
+  CHECK(result.errors[4].rfind("line 8: ", 0) == 0);
+
+  // Records are normalized on the way in.
+  const auto atom = atoms.get(core::AtomId{"atom-1"});
+  REQUIRE(atom.has_value());
+  CHECK(atom->domain == "cpp");
+  CHECK(atom->claim == "Built it");
+  CHECK(atom->tags == std::vector<std::string>{"systems"});
+  CHECK(atom->verified);
+  CHECK_FALSE(atoms.get(core::AtomId{"atom-4"})->verified);
+
+  const auto opp = opportunities.get(core::OpportunityId{"opp-1"});
+  REQUIRE(opp.has_value());
+  REQUIRE(opp->requirements.size() == 2);
+  CHECK(opp->requirements[0].required);
+  CHECK_FALSE(opp->requirements[1].required);
+}
+
+TEST_CASE("import_jsonl: batches writes and caps the kept error messages", "[bulk_import]") {
+  std::ostringstream lines;
+  for (int i = 0; i < 25; ++i) {
+    lines << R"({"kind":"atom","atom_id":"atom-)" << i << R"(","domain":"cpp","claim":"c"})"
+          << "\n";
+    lines << "{}\n";  // no kind
+  }
+  std::istringstream input(lines.str());
+
+  auto db = make_db();
+  REQUIRE(db->exec("CREATE TRIGGER reject_bad BEFORE INSERT ON atoms WHEN NEW.atom_id = 'atom-12' "
+                   "BEGIN SELECT RAISE(ABORT, 'rejected'); END")
+              .has_value());
+  storage::sqlite::SqliteAtomRepository atoms(db);
+  storage::sqlite::SqliteOpportunityRepository opportunities(db);
+  ingest::BulkImportOptions options;
+  options.batch_size = 10;
+  options.max_errors = 3;
+  const auto result = ingest::import_jsonl(input, atoms, opportunities, options);
+
+  // Batches: atoms 0-9, 10-19 (rejected as a whole), 20-24.
+  CHECK(result.atoms_imported == 15);
+  CHECK(atoms.list_all().size() == 15);
+  CHECK_FALSE(atoms.get(core::AtomId{"atom-15"}).has_value());
+  CHECK(result.error_count == 25 + 10);
+  CHECK(result.errors.size() == 3);
+}
+
+TEST_CASE("run_bulk_import_pipeline: imports a file and emits audit events",
+          "[bulk_import][app_service]") {
+  core::DeterministicIdGenerator id_gen;
+  core::FixedClock clock{"2026-01-01T00:00:00Z"};
+  storage::InMemoryAtomRepository atom_repo;
+  storage::InMemoryOpportunityRepository opportunity_repo;
+  storage::InMemoryInteractionRepository interaction_repo;
+  storage::InMemoryAuditLog audit_log;
+  vector::NullEmbeddingIndex vector_index;
+  embedding::DeterministicStubEmbeddingProvider embedding_provider;
+  core::Services services{atom_repo, opportunity_repo, interaction_repo,
+                          audit_log, vector_index,     embedding_provider};
+
+  const std::string path = "tmp_bulk_import.jsonl";
+  {
+    std::ofstream ofs(path);
+    ofs << R"({"kind":"atom","atom_id":"atom-1","domain":"cpp","claim":"c"})" << "\n";
+    ofs << R"({"kind":"opportunity","opportunity_id":"opp-1","company":"A","role_title":"R"})";
+  }
+
+  app::BulkImportPipelineRequest req;
+  req.input_path = path;
+  req.trace_id = "trace-bulk";
+  const auto response = app::run_bulk_import_pipeline(req, services, id_gen, clock);
+  std::remove(path.c_str());
+
+  CHECK(response.trace_id == "trace-bulk");
+  CHECK(response.result.atoms_imported == 1);
+  CHECK(response.result.opportunities_imported == 1);
+  CHECK(response.result.error_count == 0);
+
+  const auto events = audit_log.query("trace-bulk");
+  REQUIRE(events.size() == 2);
+  CHECK(events[0].event_type == "BulkImportStarted");
+  CHECK(events[1].event_type == "BulkImportCompleted");
+  CHECK(events[1].payload.find(R"("atoms_imported":1)") != std::string::npos);
+
+  req.input_path = "does/not/exist.jsonl";
+  CHECK_THROWS_AS(app::run_bulk_import_pipeline(req, services, id_gen, clock), std::runtime_error);
+}
@@ -0,0 +1,224 @@
+#include "ccmcp/core/sha256.h"
+#include "ccmcp/embedding/caching_embedding_provider.h"
+#include "ccmcp/embedding/embedding_provider.h"
+#include "ccmcp/storage/sqlite/sqlite_db.h"
+#include "ccmcp/storage/sqlite/sqlite_embedding_cache_store.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace ccmcp;
+
+namespace {
+
+// CountingProvider wraps the deterministic stub and counts inference calls.
+class CountingProvider final : public embedding::IEmbeddingProvider {
+ public:
+  explicit CountingProvider(size_t dim) : stub_(dim) {}
+
+  [[nodiscard]] vector::Vector embed_text(std::string_view text) const override {
+    ++calls;
+    return stub_.embed_text(text);
+  }
+  [[nodiscard]] size_t dimension() const override { return stub_.dimension(); }
+
+  mutable std::atomic<int> calls{0};  // NOLINT(readability-identifier-naming)
+
+ private:
+  embedding::DeterministicStubEmbeddingProvider stub_;
+};
+
+// CountingStore forwards to another store and counts the write calls.
+class CountingStore final : public embedding::IEmbeddingCacheStore {
+ public:
+  explicit CountingStore(embedding::IEmbeddingCacheStore& inner) : inner_(inner) {}
+
+  [[nodiscard]] std::optional<vector::Vector> get(
+      const embedding::EmbeddingCacheKey& key) const override {
+    return inner_.get(key);
+  }
+  void put(const embedding::EmbeddingCacheKey& key, const vector::Vector& embedding) override {
+    ++puts;
+    inner_.put(key, embedding);
+  }
+  void put_many(std::span<const embedding::EmbeddingCacheKey> keys,
+                std::span<const vector::Vector> embeddings) override {
+    ++put_manys;
+    inner_.put_many(keys, embeddings);
+  }
+
+  int puts{0};       // NOLINT(readability-identifier-naming)
+  int put_manys{0};  // NOLINT(readability-identifier-naming)
+
+ private:
+  embedding::IEmbeddingCacheStore& inner_;
+};
+
+std::shared_ptr<storage::sqlite::SqliteDb> make_db() {
+  auto result = storage::sqlite::SqliteDb::open(":memory:");
+  REQUIRE(result.has_value());
+  auto db = result.value();
+  REQUIRE(db->ensure_schema_v9().has_value());
+  return db;
+}
+
+}  // namespace
+
+TEST_CASE("CachingEmbeddingProvider returns the inner vector and embeds each text once",
+          "[embedding][cache]") {
+  CountingProvider inner(32);
+  embedding::CachingEmbeddingProvider cache(inner, "counting", "m1");
+
+  const auto first = cache.embed_text("distributed systems in C++");
+  const auto second = cache.embed_text("distributed systems in C++");
+  CHECK(first == inner.embed_text("distributed systems in C++"));
+  CHECK(second == first);
+  CHECK(cache.dimension() == 32);
+
+  const auto stats = cache.stats();
+  CHECK(stats.misses == 1);
+  CHECK(stats.memory_hits == 1);
+  CHECK(stats.store_hits == 0);
+  CHECK(inner.calls == 2);  // one miss plus the direct comparison call above
+}
+
+TEST_CASE("CachingEmbeddingProvider evicts the least recently used vector",
+          "[embedding][cache]") {
+  CountingProvider inner(16);
+  embedding::CachingEmbeddingProvider cache(inner, "counting", "m1", nullptr, 2);
+
+  (void)cache.embed_text("a");
+  (void)cache.embed_text("b");
+  (void)cache.embed_text("a");  // refresh a; b is now least recent
+  (void)cache.embed_text("c");  // evicts b
+  CHECK(inner.calls == 3);
+
+  (void)cache.embed_text("a");
+  CHECK(inner.calls == 3);
+  (void)cache.embed_text("b");
+  CHECK(inner.calls == 4);
+}
+
+TEST_CASE("CachingEmbeddingProvider persists vectors across instances through SQLite",
+          "[embedding][cache][sqlite]") {
+  auto db = make_db();
+  storage::sqlite::SqliteEmbeddingCacheStore store(db);
+  CountingProvider inner(24);
+
+  vector::Vector original;
+  {
+    embedding::CachingEmbeddingProvider cache(inner, "counting", "m1", &store);
+    original = cache.embed_text("platform engineering lead");
+  }
+  CHECK(inner.calls == 1);
+
+  // A fresh provider (empty LRU) over the same store — as after a restart — skips inference.
+  embedding::CachingEmbeddingProvider restarted(inner, "counting", "m1", &store);
+  CHECK(restarted.embed_text("platform engineering lead") == original);
+  CHECK(inner.calls == 1);
+  CHECK(restarted.stats().store_hits == 1);
+
+  // A different model id is a different key.
+  embedding::CachingEmbeddingProvider other_model(inner, "counting", "m2", &store);
+  (void)other_model.embed_text("platform engineering lead");
+  CHECK(inner.calls == 2);
+}
+
+TEST_CASE("CachingEmbeddingProvider ignores stored vectors of another dimension",
+          "[embedding][cache][sqlite]") {
+  auto db = make_db();
+  storage::sqlite::SqliteEmbeddingCacheStore store(db);
+  CountingProvider narrow(8);
+  CountingProvider wide(12);
+
+  embedding::CachingEmbeddingProvider narrow_cache(narrow, "counting", "", &store);
+  CHECK(narrow_cache.embed_text("text").size() == 8);
+
+  // Same provider and model ids, reconfigured dimension: re-embedded and replaced.
+  embedding::CachingEmbeddingProvider wide_cache(wide, "counting", "", &store);
+  CHECK(wide_cache.embed_text("text").size() == 12);
+  CHECK(wide.calls == 1);
+  const auto stored = store.get({"counting", "", core::sha256_hex("text")});
+  REQUIRE(stored.has_value());
+  CHECK(stored->size() == 12);
+}
+
+TEST_CASE("CachingEmbeddingProvider::embed_batch embeds only the misses, in one batch",
+          "[embedding][cache]") {
+  CountingProvider inner(16);
+  embedding::CachingEmbeddingProvider cache(inner, "counting", "m1");
+  (void)cache.embed_text("cached text");
+  CHECK(inner.calls == 1);
+
+  const std::vector<std::string_view> texts{"cached text", "new one", "new two"};
+  std::vector<float> out(texts.size() * 16);
+  cache.embed_batch(texts, out);
+  CHECK(inner.calls == 3);  // the default embed_batch calls embed_text per miss
+  for (size_t i = 0; i < texts.size(); ++i) {
+    const auto expected = cache.embed_text(texts[i]);
+    CHECK(std::vector<float>(out.begin() + static_cast<std::ptrdiff_t>(i * 16),
+                             out.begin() + static_cast<std::ptrdiff_t>((i + 1) * 16)) == expected);
+  }
+  CHECK(inner.calls == 3);  // every text is cached now
+  CHECK(cache.stats().misses == 3);
+}
+
+TEST_CASE("SqliteEmbeddingCacheStore::put_many writes the batch in one transaction",
+          "[embedding][cache][sqlite]") {
+  auto db = make_db();
+  storage::sqlite::SqliteEmbeddingCacheStore store(db);
+  store.put({"p", "m", "h0"}, vector::Vector{9.0f});
+
+  const std::vector<embedding::EmbeddingCacheKey> keys{{"p", "m", "h0"}, {"p", "m", "h1"}};
+  const std::vector<vector::Vector> embeddings{vector::Vector{1.0f, 2.0f}, vector::Vector{}};
+  store.put_many(keys, embeddings);
+  CHECK(store.get(keys[0]) == std::optional(embeddings[0]));  // replaced
+  CHECK(store.get(keys[1]) == std::optional(embeddings[1]));
+  store.put_many({}, {});
+
+  // A failing row rolls the whole batch back and leaves the writer usable.
+  REQUIRE(db->exec("CREATE TRIGGER reject_bad BEFORE INSERT ON embedding_cache "
+                   "WHEN NEW.text_hash = 'bad' BEGIN SELECT RAISE(ABORT, 'rejected'); END")
+              .has_value());
+  const std::vector<embedding::EmbeddingCacheKey> bad_keys{{"p", "m", "h2"}, {"p", "m", "bad"}};
+  const std::vector<vector::Vector> bad_embeddings{vector::Vector{3.0f}, vector::Vector{4.0f}};
+  CHECK_THROWS_AS(store.put_many(bad_keys, bad_embeddings), std::runtime_error);
+  CHECK_FALSE(store.get(bad_keys[0]).has_value());
+  store.put_many(std::span(bad_keys).first(1), std::span(bad_embeddings).first(1));
+  CHECK(store.get(bad_keys[0]) == std::optional(bad_embeddings[0]));
+}
+
+TEST_CASE("CachingEmbeddingProvider::embed_batch writes its misses with one put_many",
+          "[embedding][cache][sqlite]") {
+  auto db = make_db();
+  storage::sqlite::SqliteEmbeddingCacheStore sqlite_store(db);
+  CountingStore store(sqlite_store);
+  CountingProvider inner(8);
+
+  const std::vector<std::string_view> texts{"alpha", "beta", "gamma", "delta"};
+  std::vector<float> out(texts.size() * 8);
+  {
+    embedding::CachingEmbeddingProvider cache(inner, "counting", "m1", &store);
+    cache.embed_batch(texts, out);
+    CHECK(store.put_manys == 1);
+    CHECK(store.puts == 0);
+    CHECK(cache.stats().misses == 4);
+  }
+
+  // After a restart every text is a store hit and nothing is written.
+  embedding::CachingEmbeddingProvider restarted(inner, "counting", "m1", &store);
+  std::vector<float> again(out.size());
+  restarted.embed_batch(texts, again);
+  CHECK(again == out);
+  CHECK(restarted.stats().store_hits == 4);
+  CHECK(store.put_manys == 1);
+  CHECK(inner.calls == 4);
+}
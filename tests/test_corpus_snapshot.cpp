@@ -0,0 +1,159 @@
+#include "ccmcp/matching/corpus_snapshot.h"
+#include "ccmcp/matching/matcher.h"
+#include "ccmcp/storage/inmemory_atom_repository.h"
+#include "ccmcp/storage/sqlite/sqlite_atom_repository.h"
+#include "ccmcp/storage/sqlite/sqlite_db.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace ccmcp;
+
+namespace {
+
+domain::ExperienceAtom make_atom(const std::string& id, const std::string& title,
+                                 const std::string& claim, std::vector<std::string> tags,
+                                 bool verified = true) {
+  return domain::ExperienceAtom{
+      core::AtomId{id}, "general", title, claim, std::move(tags), verified, {}};
+}
+
+void check_same_report(const domain::MatchReport& a, const domain::MatchReport& b) {
+  CHECK(a.strategy == b.strategy);
+  CHECK(a.overall_score == b.overall_score);
+  CHECK(a.missing_requirements == b.missing_requirements);
+  CHECK(a.matched_atoms == b.matched_atoms);
+  CHECK(a.retrieval_stats.merged_candidates == b.retrieval_stats.merged_candidates);
+  REQUIRE(a.requirement_matches.size() == b.requirement_matches.size());
+  for (size_t i = 0; i < a.requirement_matches.size(); ++i) {
+    const auto& ra = a.requirement_matches[i];
+    const auto& rb = b.requirement_matches[i];
+    CHECK(ra.matched == rb.matched);
+    CHECK(ra.best_score == rb.best_score);
+    CHECK(ra.contributing_atom_id == rb.contributing_atom_id);
+    CHECK(ra.evidence_tokens == rb.evidence_tokens);
+  }
+}
+
+}  // namespace
+
+TEST_CASE("CorpusSnapshot precomputes claim, title and tag tokens", "[matching][corpus]") {
+  const std::vector<domain::ExperienceAtom> atoms = {
+      make_atom("atom-1", "Rust Services", "Built async services", {"tokio"}),
+      make_atom("atom-2", "Empty", "", {}),
+  };
+
+  const matching::CorpusSnapshot snapshot(atoms);
+  REQUIRE(snapshot.size() == 2);
+  CHECK(snapshot.version() == 0);
+  CHECK(&snapshot.atoms() == &atoms);  // borrowing: no copy
+
+  const auto& dict = matching::TokenDictionary::global();
+  CHECK(matching::to_sorted_strings(snapshot.tokens(0), dict) ==
+        std::vector<std::string>{"async", "built", "rust", "services", "tokio"});
+  CHECK(matching::to_sorted_strings(snapshot.tokens(1), dict) ==
+        std::vector<std::string>{"empty"});
+}
+
+TEST_CASE("Matcher produces identical reports from atoms and from a snapshot",
+          "[matching][corpus]") {
+  std::vector<domain::ExperienceAtom> atoms = {
+      make_atom("atom-b", "Kafka Pipelines", "Streamed events with kafka", {"streaming"}),
+      make_atom("atom-a", "Kafka Ops", "Operated kafka clusters", {"ops"}),
+      make_atom("atom-c", "Unverified", "kafka kafka", {}, false),
+  };
+  const domain::Opportunity opportunity{core::OpportunityId{"opp-1"},
+                                        "Acme",
+                                        "Engineer",
+                                        {{"kafka streaming", {}, true}, {"golang", {}, true}},
+                                        "test"};
+
+  for (const auto strategy : {matching::MatchingStrategy::kDeterministicLexicalV01,
+                              matching::MatchingStrategy::kHybridLexicalEmbeddingV02}) {
+    const matching::Matcher matcher(matching::ScoreWeights{}, strategy);
+    const auto from_atoms = matcher.evaluate(opportunity, atoms);
+
+    const matching::CorpusSnapshot snapshot(std::vector<domain::ExperienceAtom>(atoms), 7);
+    const auto from_snapshot = matcher.evaluate(opportunity, snapshot);
+
+    check_same_report(from_atoms, from_snapshot);
+    REQUIRE(from_snapshot.requirement_matches.size() == 2);
+    CHECK(from_snapshot.requirement_matches[0].contributing_atom_id->value == "atom-b");
+    CHECK(from_snapshot.requirement_matches[0].evidence_tokens ==
+          std::vector<std::string>{"kafka", "streaming"});
+  }
+}
+
+TEST_CASE("CorpusSnapshotCache reuses snapshot until corpus version changes",
+          "[matching][corpus]") {
+  storage::InMemoryAtomRepository repo;
+  repo.upsert(make_atom("atom-1", "Go", "Wrote go services", {"go"}));
+  repo.upsert(make_atom("atom-2", "Draft", "unverified", {}, false));
+
+  matching::CorpusSnapshotCache cache;
+  const auto first = cache.get(repo);
+  const auto second = cache.get(repo);
+  CHECK(first == second);
+  CHECK(first->size() == 1);  // verified atoms only
+
+  repo.upsert(make_atom("atom-3", "Rust", "Wrote rust services", {"rust"}));
+  const auto third = cache.get(repo);
+  CHECK(third != first);
+  CHECK(third->size() == 2);
+  CHECK(third->version() == repo.corpus_version());
+
+  // Readers holding the old snapshot are unaffected by the swap.
+  CHECK(first->size() == 1);
+}
+
+TEST_CASE("SqliteAtomRepository corpus_version changes on upsert", "[matching][corpus][sqlite]") {
+  auto db_result = storage::sqlite::SqliteDb::open(":memory:");
+  REQUIRE(db_result.has_value());
+  auto db = db_result.value();
+  REQUIRE(db->ensure_schema_v1().has_value());
+
+  storage::sqlite::SqliteAtomRepository repo(db);
+  const auto v0 = repo.corpus_version();
+  CHECK(repo.corpus_version() == v0);  // stable without writes
+
+  repo.upsert(make_atom("atom-1", "Go", "Wrote go services", {"go"}));
+  const auto v1 = repo.corpus_version();
+  CHECK(v1 != v0);
+
+  matching::CorpusSnapshotCache cache;
+  const auto snapshot = cache.get(repo);
+  CHECK(snapshot->size() == 1);
+  CHECK(cache.get(repo) == snapshot);
+
+  repo.upsert(make_atom("atom-2", "Rust", "Wrote rust services", {"rust"}));
+  CHECK(cache.get(repo)->size() == 2);
+}
+
+TEST_CASE("CorpusSnapshot postings index verified atoms only", "[matching][corpus]") {
+  const std::vector<domain::ExperienceAtom> atoms = {
+      make_atom("atom-z", "Kafka", "kafka streams", {}),
+      make_atom("atom-y", "Draft", "kafka", {}, false),
+      make_atom("atom-a", "Kafka", "kafka ops", {}),
+  };
+  const matching::CorpusSnapshot snapshot(atoms);
+
+  auto& dict = matching::TokenDictionary::global();
+  const auto kafka = dict.find("kafka");
+  REQUIRE(kafka.has_value());
+
+  const auto postings = snapshot.postings(*kafka);
+  CHECK(std::vector<std::uint32_t>(postings.begin(), postings.end()) ==
+        std::vector<std::uint32_t>{0, 2});
+
+  const auto by_id = snapshot.verified_by_id();
+  CHECK(std::vector<std::uint32_t>(by_id.begin(), by_id.end()) ==
+        std::vector<std::uint32_t>{2, 0});
+  CHECK(snapshot.id_rank(2) < snapshot.id_rank(1));
+  CHECK(snapshot.id_rank(1) < snapshot.id_rank(0));
+
+  // A token interned after the snapshot was built has no postings.
+  CHECK(snapshot.postings(dict.intern("token-added-after-snapshot")).empty());
+}
@@ -0,0 +1,129 @@
+#include "ccmcp/core/hashing.h"
+#include "ccmcp/core/normalization.h"
+#include "ccmcp/embedding/embedding_provider.h"
+#include "ccmcp/vector/vector_math.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace ccmcp;
+
+namespace {
+
+// reference_embedding is the histogram formulation of the stub: tokenize, count, spread.
+vector::Vector reference_embedding(std::string_view text, size_t dim) {
+  std::vector<double> acc(dim, 0.0);
+  std::map<std::string, int> counts;
+  for (const auto& token : core::tokenize_ascii(text)) {
+    ++counts[token];
+  }
+  for (const auto& [token, count] : counts) {
+    const size_t idx = core::stable_hash64(token) % dim;
+    acc[idx] += count;
+    acc[(idx + dim - 1) % dim] += count * 0.3;
+    acc[(idx + 1) % dim] += count * 0.3;
+  }
+  double norm = 0.0;
+  for (const double x : acc) {
+    norm += x * x;
+  }
+  norm = std::sqrt(norm);
+  vector::Vector out(dim, 0.0f);
+  for (size_t i = 0; i < dim; ++i) {
+    out[i] = norm > 0.0 ? static_cast<float>(acc[i] / norm) : 0.0f;
+  }
+  return out;
+}
+
+// PerTextProvider relies on the default IEmbeddingProvider::embed_batch().
+class PerTextProvider final : public embedding::IEmbeddingProvider {
+ public:
+  [[nodiscard]] vector::Vector embed_text(std::string_view text) const override {
+    return {static_cast<float>(text.size()), 1.0f};
+  }
+  [[nodiscard]] size_t dimension() const override { return 2; }
+};
+
+// ShortRowProvider returns an empty vector for "" and a one-float vector for "short".
+class ShortRowProvider final : public embedding::IEmbeddingProvider {
+ public:
+  [[nodiscard]] vector::Vector embed_text(std::string_view text) const override {
+    if (text.empty())
+      return {};
+    if (text == "short")
+      return {1.0f};
+    return {1.0f, 2.0f};
+  }
+  [[nodiscard]] size_t dimension() const override { return 2; }
+};
+
+}  // namespace
+
+TEST_CASE("DeterministicStubEmbeddingProvider matches the token histogram formulation",
+          "[embedding]") {
+  const embedding::DeterministicStubEmbeddingProvider provider(64);
+  const std::vector<std::string> texts{
+      "Led migration of payments platform to Kubernetes",
+      "C++ C++ c++ systems; SYSTEMS, latency-sensitive trading systems!",
+      "a b c",  // only single-character tokens: zero vector
+      "",
+      "x9 y8 z7 x9",
+  };
+  for (const auto& text : texts) {
+    const auto actual = provider.embed_text(text);
+    const auto expected = reference_embedding(text, 64);
+    REQUIRE(actual.size() == 64);
+    for (size_t i = 0; i < 64; ++i) {
+      CHECK(std::fabs(actual[i] - expected[i]) < 1e-6f);
+    }
+  }
+  CHECK(provider.embed_text("a b c") == vector::Vector(64, 0.0f));
+}
+
+TEST_CASE("embed_batch writes the embed_text rows into the caller's buffer", "[embedding]") {
+  const embedding::DeterministicStubEmbeddingProvider stub(16);
+  const PerTextProvider per_text;
+  const std::vector<std::string_view> texts{"distributed systems", "", "Rust and Go services"};
+
+  for (const embedding::IEmbeddingProvider* provider :
+       {static_cast<const embedding::IEmbeddingProvider*>(&stub),
+        static_cast<const embedding::IEmbeddingProvider*>(&per_text)}) {
+    const size_t dim = provider->dimension();
+    std::vector<float> out(texts.size() * dim, -1.0f);
+    provider->embed_batch(texts, out);
+    for (size_t i = 0; i < texts.size(); ++i) {
+      const auto row = provider->embed_text(texts[i]);
+      CHECK(std::vector<float>(out.begin() + static_cast<std::ptrdiff_t>(i * dim),
+                               out.begin() + static_cast<std::ptrdiff_t>((i + 1) * dim)) == row);
+    }
+
+    std::vector<float> wrong(texts.size() * dim + 1);
+    CHECK_THROWS_AS(provider->embed_batch(texts, wrong), std::invalid_argument);
+  }
+
+  // dimension 0: an empty buffer for any number of texts.
+  const embedding::NullEmbeddingProvider null_provider;
+  std::vector<float> none;
+  null_provider.embed_batch(texts, none);
+  CHECK(none.empty());
+}
+
+TEST_CASE("default embed_batch rejects rows that are not dimension() floats", "[embedding]") {
+  const ShortRowProvider provider;
+  std::vector<float> out(4, -1.0f);
+
+  const std::vector<std::string_view> full{"full", "also full"};
+  provider.embed_batch(full, out);
+  CHECK(out == std::vector<float>{1.0f, 2.0f, 1.0f, 2.0f});
+
+  for (const std::string_view bad : {std::string_view{}, std::string_view{"short"}}) {
+    const std::vector<std::string_view> texts{"full", bad};
+    CHECK_THROWS_AS(provider.embed_batch(texts, out), std::runtime_error);
+  }
+}
@@ -0,0 +1,164 @@
+#include "ccmcp/vector/flat_vector_store.h"
+#include "ccmcp/vector/top_k.h"
+#include "ccmcp/vector/vector_math.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ccmcp::vector;
+
+namespace {
+
+// Reference score from the scalar kernels, while the store runs the best kernel this CPU
+// supports: the fixed reduction order makes them bit-identical.
+double reference_cosine(const Vector& a, const Vector& b) {
+  if (a.size() != b.size() || a.empty()) {
+    return 0.0;
+  }
+  const auto& scalar = *math::kernels_for(math::Isa::kScalar);
+  const size_t n = a.size();
+  return math::cosine_from_dot(scalar.dot(a.data(), b.data(), n),
+                               std::sqrt(scalar.dot(a.data(), a.data(), n)),
+                               std::sqrt(scalar.dot(b.data(), b.data(), n)));
+}
+
+std::vector<VectorSearchResult> reference_query(
+    const std::map<std::string, std::pair<Vector, std::string>>& vectors, const Vector& query,
+    size_t top_k) {
+  std::vector<VectorSearchResult> results;
+  for (const auto& [key, pair] : vectors) {
+    results.push_back(VectorSearchResult{
+        .key = key, .score = reference_cosine(query, pair.first), .metadata = pair.second});
+  }
+  std::sort(results.begin(), results.end(),
+            [](const VectorSearchResult& a, const VectorSearchResult& b) {
+              return ranks_before(a.score, a.key, b.score, b.key);
+            });
+  if (results.size() > top_k) {
+    results.resize(top_k);
+  }
+  return results;
+}
+
+Vector random_vector(std::mt19937& rng, size_t dim) {
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  Vector v(dim);
+  for (auto& x : v) {
+    x = dist(rng);
+  }
+  return v;
+}
+
+}  // namespace
+
+TEST_CASE("FlatVectorStore: scores and ranking match the reference scan bit for bit",
+          "[vector][flat]") {
+  FlatVectorStore store;
+  std::map<std::string, std::pair<Vector, std::string>> reference;
+  std::mt19937 rng(5);
+
+  // Mixed dimensions (including non-multiples of 16), zero vectors, and replacements that
+  // move a key between dimension blocks.
+  const std::vector<size_t> dims = {3, 16, 17, 40};
+  for (int i = 0; i < 400; ++i) {
+    const size_t dim = dims[static_cast<size_t>(i) % dims.size()];
+    Vector v = (i % 37 == 0) ? Vector(dim, 0.0f) : random_vector(rng, dim);
+    const std::string key = "key-" + std::to_string((i * 31) % 250);
+    const std::string meta = "meta-" + std::to_string(i);
+    store.upsert(key, v, meta);
+    reference[key] = {v, meta};
+  }
+  REQUIRE(store.size() == reference.size());
+
+  for (const size_t dim : {size_t{3}, size_t{17}, size_t{40}, size_t{7}}) {
+    for (int q = 0; q < 5; ++q) {
+      const Vector query = random_vector(rng, dim);
+      for (const size_t k : {size_t{0}, size_t{1}, size_t{25}, size_t{400}}) {
+        const auto got = store.query(query, k);
+        const auto expected = reference_query(reference, query, k);
+        REQUIRE(got.size() == expected.size());
+        for (size_t i = 0; i < got.size(); ++i) {
+          CHECK(got[i].key == expected[i].key);
+          CHECK(got[i].score == expected[i].score);
+          CHECK(got[i].metadata == expected[i].metadata);
+        }
+      }
+    }
+  }
+
+  for (const auto& [key, pair] : reference) {
+    const auto stored = store.get(key);
+    REQUIRE(stored.has_value());
+    CHECK(*stored == pair.first);
+  }
+}
+
+TEST_CASE("FlatVectorStore: query_batch matches the reference scan for every query",
+          "[vector][flat]") {
+  FlatVectorStore store;
+  std::map<std::string, std::pair<Vector, std::string>> reference;
+  std::mt19937 rng(17);
+
+  // 300 rows of dimension 200 span two score chunks and several dot_block tiles.
+  for (int i = 0; i < 600; ++i) {
+    const size_t dim = (i % 2 == 0) ? 200 : 24;
+    const std::string key = "key-" + std::to_string((i * 7) % 600);
+    store.upsert(key, random_vector(rng, dim), "meta-" + std::to_string(i));
+    reference[key] = {*store.get(key), "meta-" + std::to_string(i)};
+  }
+
+  // 40 queries cross the 16-query block boundary; the odd dimension and the zero vector
+  // score 0.0 against every row.
+  std::vector<Vector> queries;
+  for (int q = 0; q < 40; ++q) {
+    const size_t dim = (q % 5 == 4) ? 24 : 200;
+    queries.push_back(random_vector(rng, dim));
+  }
+  queries.push_back(Vector(200, 0.0f));
+  queries.push_back(random_vector(rng, 9));
+
+  for (const size_t k : {size_t{0}, size_t{10}, size_t{700}}) {
+    const auto batch = store.query_batch(queries, k);
+    REQUIRE(batch.size() == queries.size());
+    for (size_t q = 0; q < queries.size(); ++q) {
+      const auto expected = reference_query(reference, queries[q], k);
+      REQUIRE(batch[q].size() == expected.size());
+      for (size_t i = 0; i < expected.size(); ++i) {
+        CHECK(batch[q][i].key == expected[i].key);
+        CHECK(batch[q][i].score == expected[i].score);
+        CHECK(batch[q][i].metadata == expected[i].metadata);
+      }
+    }
+  }
+  CHECK(store.query_batch({}, 10).empty());
+}
+
+TEST_CASE("FlatVectorStore: replacing with another dimension keeps other rows intact",
+          "[vector][flat]") {
+  FlatVectorStore store;
+  store.upsert("a", Vector{1.0f, 0.0f}, "ma");
+  store.upsert("b", Vector{0.0f, 1.0f}, "mb");
+  store.upsert("c", Vector{1.0f, 1.0f}, "mc");
+
+  // "a" leaves the 2-d block; "c" is swapped into its row.
+  store.upsert("a", Vector{1.0f, 0.0f, 0.0f}, "ma2");
+
+  CHECK(store.size() == 3);
+  CHECK(store.get("a") == std::optional<Vector>(Vector{1.0f, 0.0f, 0.0f}));
+  CHECK(store.get("b") == std::optional<Vector>(Vector{0.0f, 1.0f}));
+  CHECK(store.get("c") == std::optional<Vector>(Vector{1.0f, 1.0f}));
+
+  const auto results = store.query(Vector{1.0f, 0.0f, 0.0f}, 3);
+  REQUIRE(results.size() == 3);
+  CHECK(results[0].key == "a");
+  CHECK(results[0].metadata == "ma2");
+  CHECK(results[1].key == "b");  // 0.0 scores tie-break by key
+  CHECK(results[2].key == "c");
+}
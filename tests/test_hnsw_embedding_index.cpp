@@ -0,0 +1,347 @@
+#include "ccmcp/vector/hnsw_embedding_index.h"
+#include "ccmcp/vector/inmemory_embedding_index.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ccmcp::vector;
+
+namespace {
+
+Vector random_vector(std::mt19937& rng, std::size_t dim) {
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  Vector v(dim);
+  for (auto& x : v) {
+    x = dist(rng);
+  }
+  return v;
+}
+
+std::string key_for(int i) {
+  std::string digits = std::to_string(i);
+  return "atom-" + std::string(5 - digits.size(), '0') + digits;
+}
+
+void check_same_results(const std::vector<VectorSearchResult>& a,
+                        const std::vector<VectorSearchResult>& b) {
+  REQUIRE(a.size() == b.size());
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    CHECK(a[i].key == b[i].key);
+    CHECK(a[i].score == b[i].score);
+    CHECK(a[i].metadata == b[i].metadata);
+  }
+}
+
+std::filesystem::path temp_index_path(const std::string& name) {
+  const auto dir = std::filesystem::temp_directory_path() / "ccmcp_test_hnsw";
+  std::filesystem::create_directories(dir);
+  const auto path = dir / name;
+  std::filesystem::remove(path);
+  return path;
+}
+
+}  // namespace
+
+TEST_CASE("HnswEmbeddingIndex: upsert, replace and get", "[vector][hnsw]") {
+  HnswEmbeddingIndex index;
+  index.upsert("key1", Vector{1.0f, 2.0f, 3.0f}, "meta1");
+  index.upsert("key1", Vector{4.0f, 5.0f, 6.0f}, "meta2");
+
+  const auto stored = index.get("key1");
+  REQUIRE(stored.has_value());
+  CHECK((*stored)[0] == 4.0f);
+  CHECK_FALSE(index.get("missing").has_value());
+  CHECK(index.size() == 1);
+
+  const auto results = index.query(Vector{4.0f, 5.0f, 6.0f}, 5);
+  REQUIRE(results.size() == 1);
+  CHECK(results[0].metadata == "meta2");
+}
+
+TEST_CASE("HnswEmbeddingIndex: empty index and top_k 0 return no results", "[vector][hnsw]") {
+  HnswEmbeddingIndex index;
+  CHECK(index.query(Vector{1.0f, 0.0f}, 5).empty());
+
+  index.upsert("key1", Vector{1.0f, 0.0f}, "meta");
+  CHECK(index.query(Vector{1.0f, 0.0f}, 0).empty());
+}
+
+TEST_CASE("HnswEmbeddingIndex: m below 2 is rejected", "[vector][hnsw]") {
+  CHECK_THROWS_AS(HnswEmbeddingIndex(HnswConfig{.m = 1}), std::invalid_argument);
+}
+
+TEST_CASE("HnswEmbeddingIndex: identical vectors tie-break by key", "[vector][hnsw]") {
+  HnswEmbeddingIndex index;
+  index.upsert("key-c", Vector{1.0f, 0.0f, 0.0f}, "meta");
+  index.upsert("key-a", Vector{1.0f, 0.0f, 0.0f}, "meta");
+  index.upsert("key-b", Vector{1.0f, 0.0f, 0.0f}, "meta");
+  index.upsert("key-d", Vector{0.0f, 1.0f, 0.0f}, "meta");
+
+  const auto results = index.query(Vector{1.0f, 0.0f, 0.0f}, 3);
+  REQUIRE(results.size() == 3);
+  CHECK(results[0].key == "key-a");
+  CHECK(results[1].key == "key-b");
+  CHECK(results[2].key == "key-c");
+}
+
+TEST_CASE("HnswEmbeddingIndex: wide search matches the exact index bit for bit",
+          "[vector][hnsw]") {
+  // With ef_search >= corpus size the layer-0 search never prunes, so the result must be the
+  // exact top-k, with scores identical to InMemoryEmbeddingIndex.
+  HnswEmbeddingIndex hnsw(HnswConfig{.m = 8, .ef_construction = 64, .ef_search = 512});
+  InMemoryEmbeddingIndex exact;
+
+  std::mt19937 rng(7);
+  for (int i = 0; i < 300; ++i) {
+    const auto v = random_vector(rng, 16);
+    hnsw.upsert(key_for(i), v, "meta-" + std::to_string(i));
+    exact.upsert(key_for(i), v, "meta-" + std::to_string(i));
+  }
+
+  for (int q = 0; q < 10; ++q) {
+    const auto query = random_vector(rng, 16);
+    check_same_results(hnsw.query(query, 10), exact.query(query, 10));
+  }
+}
+
+TEST_CASE("HnswEmbeddingIndex: query_batch returns query() results in order", "[vector][hnsw]") {
+  HnswEmbeddingIndex index;
+  std::mt19937 rng(41);
+  for (int i = 0; i < 200; ++i) {
+    index.upsert(key_for(i), random_vector(rng, 16), "m" + std::to_string(i));
+  }
+  std::vector<Vector> queries;
+  for (int q = 0; q < 6; ++q) {
+    queries.push_back(random_vector(rng, 16));
+  }
+
+  const auto batch = index.query_batch(queries, 5);
+  REQUIRE(batch.size() == queries.size());
+  for (std::size_t q = 0; q < queries.size(); ++q) {
+    check_same_results(batch[q], index.query(queries[q], 5));
+  }
+}
+
+TEST_CASE("HnswEmbeddingIndex: recall@10 against the exact index", "[vector][hnsw]") {
+  HnswEmbeddingIndex hnsw(HnswConfig{.m = 12, .ef_construction = 100, .ef_search = 64});
+  InMemoryEmbeddingIndex exact;
+
+  std::mt19937 rng(42);
+  for (int i = 0; i < 2000; ++i) {
+    const auto v = random_vector(rng, 32);
+    hnsw.upsert(key_for(i), v, "");
+    exact.upsert(key_for(i), v, "");
+  }
+
+  std::size_t hits = 0;
+  std::size_t total = 0;
+  for (int q = 0; q < 25; ++q) {
+    const auto query = random_vector(rng, 32);
+    std::set<std::string> truth;
+    for (const auto& r : exact.query(query, 10)) {
+      truth.insert(r.key);
+    }
+    for (const auto& r : hnsw.query(query, 10)) {
+      hits += truth.count(r.key);
+    }
+    total += truth.size();
+  }
+  CHECK(static_cast<double>(hits) / static_cast<double>(total) >= 0.9);
+}
+
+TEST_CASE("HnswEmbeddingIndex: graph is independent of upsert order", "[vector][hnsw]") {
+  std::mt19937 rng(3);
+  std::vector<std::pair<std::string, Vector>> items;
+  for (int i = 0; i < 500; ++i) {
+    items.emplace_back(key_for(i), random_vector(rng, 8));
+  }
+  const HnswConfig config{.m = 6, .ef_construction = 32, .ef_search = 16};
+
+  HnswEmbeddingIndex forward(config);
+  for (const auto& [key, v] : items) {
+    forward.upsert(key, v, key);
+  }
+  HnswEmbeddingIndex shuffled(config);
+  auto reordered = items;
+  std::shuffle(reordered.begin(), reordered.end(), std::mt19937(99));
+  for (const auto& [key, v] : reordered) {
+    shuffled.upsert(key, v, key);
+  }
+
+  for (int q = 0; q < 20; ++q) {
+    const auto query = random_vector(rng, 8);
+    check_same_results(forward.query(query, 10), shuffled.query(query, 10));
+  }
+}
+
+TEST_CASE("HnswEmbeddingIndex: save and reload reproduce query results", "[vector][hnsw]") {
+  const auto path = temp_index_path("roundtrip.hnsw");
+  const HnswConfig config{.m = 8, .ef_construction = 48, .ef_search = 24};
+
+  std::mt19937 rng(11);
+  std::vector<Vector> queries;
+  for (int q = 0; q < 10; ++q) {
+    queries.push_back(random_vector(rng, 12));
+  }
+
+  std::vector<std::vector<VectorSearchResult>> expected;
+  {
+    HnswEmbeddingIndex index(config, path.string());
+    for (int i = 0; i < 400; ++i) {
+      index.upsert(key_for(i), random_vector(rng, 12), "meta-" + std::to_string(i));
+    }
+    index.save();
+    for (const auto& query : queries) {
+      expected.push_back(index.query(query, 10));
+    }
+  }
+  REQUIRE(std::filesystem::exists(path));
+
+  {
+    HnswEmbeddingIndex reloaded(config, path.string());
+    CHECK(reloaded.size() == 400);
+    for (std::size_t q = 0; q < queries.size(); ++q) {
+      check_same_results(reloaded.query(queries[q], 10), expected[q]);
+    }
+  }
+
+  const auto read_file = [&path]() {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  };
+  const std::string saved = read_file();
+
+  // Different build parameters: the stored graph is discarded and rebuilt, giving the same
+  // results as a fresh index built with those parameters.
+  {
+    const HnswConfig other{.m = 4, .ef_construction = 16, .ef_search = 24};
+    HnswEmbeddingIndex rebuilt(other, path.string());
+    HnswEmbeddingIndex fresh(other);
+    for (int i = 0; i < 400; ++i) {
+      const auto v = rebuilt.get(key_for(i));
+      REQUIRE(v.has_value());
+      fresh.upsert(key_for(i), *v, "meta-" + std::to_string(i));
+    }
+    for (const auto& query : queries) {
+      check_same_results(rebuilt.query(query, 10), fresh.query(query, 10));
+    }
+  }  // nothing was upserted: the file is left as it was
+
+  CHECK(read_file() == saved);
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("HnswEmbeddingIndex: namespaces have separate graphs that survive reload",
+          "[vector][hnsw]") {
+  const auto path = temp_index_path("namespaces.hnsw");
+  const HnswConfig config{.m = 8, .ef_construction = 48, .ef_search = 400};
+
+  std::mt19937 rng(17);
+  InMemoryEmbeddingIndex exact;
+  std::vector<Vector> queries;
+  for (int q = 0; q < 5; ++q) {
+    queries.push_back(random_vector(rng, 8));
+  }
+  {
+    HnswEmbeddingIndex index(config, path.string());
+    for (int i = 0; i < 150; ++i) {
+      const auto ns = i % 3 == 0 ? kResumeNamespace : kAtomNamespace;
+      const auto v = random_vector(rng, 8);
+      index.upsert(ns, key_for(i), v, "meta");
+      exact.upsert(ns, key_for(i), v, "meta");
+    }
+    index.upsert(kOpportunityNamespace, key_for(0), Vector(8, 1.0f), "opp");  // key reused
+    exact.upsert(kOpportunityNamespace, key_for(0), Vector(8, 1.0f), "opp");
+    index.save();
+  }
+
+  HnswEmbeddingIndex reloaded(config, path.string());
+  CHECK(reloaded.size() == 151);
+  for (const auto ns : {kAtomNamespace, kResumeNamespace, kOpportunityNamespace}) {
+    for (const auto& query : queries) {
+      // ef_search covers every node, so each graph search is exact within its namespace.
+      check_same_results(reloaded.query(ns, query, 10), exact.query(ns, query, 10));
+    }
+  }
+  CHECK(reloaded.query(kAtomNamespace, queries[0], 200).size() == 100);
+  CHECK(reloaded.query("unknown", queries[0], 10).empty());
+  CHECK(reloaded.get(kOpportunityNamespace, key_for(0)) == std::optional(Vector(8, 1.0f)));
+  CHECK_FALSE(reloaded.get(kAtomNamespace, key_for(0)).has_value());
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("HnswEmbeddingIndex: format-1 file is split into namespaces", "[vector][hnsw]") {
+  const auto path = temp_index_path("legacy.hnsw");
+  const HnswConfig config{};
+
+  // Two nodes on layer 0, linked to each other, keyed as before namespaces existed.
+  {
+    std::ofstream out(path, std::ios::binary);
+    const auto pod = [&out](const auto& value) {
+      out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    const auto node = [&](const std::string& key, const Vector& v, std::uint32_t link) {
+      pod(static_cast<std::uint32_t>(key.size()));
+      out.write(key.data(), static_cast<std::streamsize>(key.size()));
+      pod(std::uint32_t{0});  // metadata
+      pod(static_cast<std::uint32_t>(v.size()));
+      out.write(reinterpret_cast<const char*>(v.data()),
+                static_cast<std::streamsize>(v.size() * sizeof(float)));
+      pod(std::uint32_t{1});  // one layer
+      pod(std::uint32_t{1});  // one neighbour
+      pod(link);
+    };
+    out.write("CCMCHNSW", 8);
+    pod(std::uint32_t{1});
+    pod(static_cast<std::uint64_t>(config.m));
+    pod(static_cast<std::uint64_t>(config.ef_construction));
+    pod(config.seed);
+    pod(std::uint64_t{2});
+    pod(std::int32_t{0});
+    pod(std::uint32_t{0});
+    node("atom-1", Vector{1.0f, 0.0f}, 1);
+    node("resume:r-1", Vector{0.0f, 1.0f}, 0);
+  }
+
+  {
+    HnswEmbeddingIndex index(config, path.string());
+    CHECK(index.get(kAtomNamespace, "atom-1") == std::optional(Vector{1.0f, 0.0f}));
+    CHECK(index.get(kResumeNamespace, "r-1") == std::optional(Vector{0.0f, 1.0f}));
+    const auto atoms = index.query(kAtomNamespace, Vector{0.0f, 1.0f}, 10);
+    REQUIRE(atoms.size() == 1);
+    CHECK(atoms[0].key == "atom-1");
+  }  // nothing was upserted: the format-1 file is left as it was
+
+  {
+    HnswEmbeddingIndex index(config, path.string());
+    index.save();  // rewrites it in the current format
+  }
+
+  HnswEmbeddingIndex reopened(config, path.string());
+  CHECK(reopened.size() == 2);
+  CHECK(reopened.query(kResumeNamespace, Vector{0.0f, 1.0f}, 10).front().key == "r-1");
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("HnswEmbeddingIndex: malformed index file is rejected", "[vector][hnsw]") {
+  const auto path = temp_index_path("corrupt.hnsw");
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << "not an index";
+  }
+  CHECK_THROWS_AS(HnswEmbeddingIndex(HnswConfig{}, path.string()), std::runtime_error);
+  std::filesystem::remove(path);
+}
@@ -16,6 +16,10 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <span>
+#include <string>
+#include <vector>
+
 using namespace ccmcp;
 
 // ---------------------------------------------------------------------------
@@ -57,12 +61,78 @@ class InMemoryResumeStore final : public ingest::IResumeStore {
   std::map<std::string, ingest::IngestedResume> resumes_;
 };
 
-// Open an in-memory SQLite DB with schema v6 (chained: v1→v6).
+// RecordingEmbeddingIndex: InMemoryEmbeddingIndex that records the namespace and size of
+// every upsert_many() batch.
+class RecordingEmbeddingIndex final : public vector::IEmbeddingIndex {
+ public:
+  using vector::IEmbeddingIndex::get;
+  using vector::IEmbeddingIndex::query;
+  using vector::IEmbeddingIndex::query_batch;
+  using vector::IEmbeddingIndex::upsert;
+  using vector::IEmbeddingIndex::upsert_many;
+
+  void upsert(vector::VectorNamespace ns, const vector::VectorKey& key,
+              const vector::Vector& embedding, const std::string& metadata) override {
+    inner_.upsert(ns, key, embedding, metadata);
+  }
+
+  void upsert_many(vector::VectorNamespace ns,
+                   std::span<const vector::VectorRecord> records) override {
+    batch_namespaces.emplace_back(ns);
+    batch_sizes.push_back(records.size());
+    inner_.upsert_many(ns, records);
+  }
+
+  std::vector<vector::VectorSearchResult> query(vector::VectorNamespace ns,
+                                                const vector::Vector& query_vector,
+                                                size_t top_k) const override {
+    return inner_.query(ns, query_vector, top_k);
+  }
+
+  std::vector<std::vector<vector::VectorSearchResult>> query_batch(
+      vector::VectorNamespace ns, std::span<const vector::Vector> queries,
+      size_t top_k) const override {
+    return inner_.query_batch(ns, queries, top_k);
+  }
+
+  std::optional<vector::Vector> get(vector::VectorNamespace ns,
+                                    const vector::VectorKey& key) const override {
+    return inner_.get(ns, key);
+  }
+
+  std::vector<std::string> batch_namespaces;
+  std::vector<size_t> batch_sizes;
+
+ private:
+  vector::InMemoryEmbeddingIndex inner_;
+};
+
+// GapEmbeddingProvider embeds like the deterministic stub but returns an empty vector for
+// any text containing one of the given substrings, relying on the default embed_batch().
+class GapEmbeddingProvider final : public embedding::IEmbeddingProvider {
+ public:
+  explicit GapEmbeddingProvider(std::vector<std::string> gaps) : gaps_(std::move(gaps)) {}
+
+  [[nodiscard]] vector::Vector embed_text(std::string_view text) const override {
+    for (const auto& gap : gaps_) {
+      if (text.find(gap) != std::string_view::npos)
+        return {};
+    }
+    return stub_.embed_text(text);
+  }
+  [[nodiscard]] size_t dimension() const override { return stub_.dimension(); }
+
+ private:
+  embedding::DeterministicStubEmbeddingProvider stub_;
+  std::vector<std::string> gaps_;
+};
+
+// Open an in-memory SQLite DB with schema v10 (chained: v1→v10).
 static std::shared_ptr<storage::sqlite::SqliteDb> make_db() {
   auto result = storage::sqlite::SqliteDb::open(":memory:");
   REQUIRE(result.has_value());
   auto db = result.value();
-  REQUIRE(db->ensure_schema_v6().has_value());
+  REQUIRE(db->ensure_schema_v10().has_value());
   return db;
 }
 
@@ -116,11 +186,11 @@ TEST_CASE("index-build indexes expected atoms", "[indexing][pipeline]") {
   CHECK(entries.size() == 2);
 
   // Verify vectors were stored.
-  auto vec1 = vector_index.get("atom-001");
+  auto vec1 = vector_index.get(vector::kAtomNamespace, "atom-001");
   CHECK(vec1.has_value());
   CHECK(vec1->size() == 128);
 
-  auto vec2 = vector_index.get("atom-002");
+  auto vec2 = vector_index.get(vector::kAtomNamespace, "atom-002");
   CHECK(vec2.has_value());
 }
 
@@ -147,7 +217,7 @@ TEST_CASE("index-build skips resumes when scope=atoms", "[indexing][pipeline]")
 
   CHECK(result.indexed_count == 1);
   // Resume vector key should not be present.
-  CHECK(!vector_index.get("resume:resume-001").has_value());
+  CHECK(!vector_index.get(vector::kResumeNamespace, "resume-001").has_value());
 }
 
 TEST_CASE("index-build is idempotent on rerun with same source", "[indexing][pipeline]") {
@@ -317,9 +387,9 @@ TEST_CASE("index-build scope=all indexes atoms+resumes+opps", "[indexing][pipeli
   CHECK(result.skipped_count == 0);
 
   // Check each vector type was stored.
-  CHECK(vector_index.get("atom-001").has_value());
-  CHECK(vector_index.get("resume:resume-001").has_value());
-  CHECK(vector_index.get("opp:opp-001").has_value());
+  CHECK(vector_index.get(vector::kAtomNamespace, "atom-001").has_value());
+  CHECK(vector_index.get(vector::kResumeNamespace, "resume-001").has_value());
+  CHECK(vector_index.get(vector::kOpportunityNamespace, "opp-001").has_value());
 }
 
 // ---------------------------------------------------------------------------
@@ -415,3 +485,251 @@ TEST_CASE("index-build artifact hashes are deterministic across independent data
   // Different canonical text → different source_hash (collision resistance sanity check).
   CHECK(entries_a1[0].source_hash != entries_b[0].source_hash);
 }
+
+TEST_CASE("index-build batch size changes only how vectors are written", "[indexing][pipeline]") {
+  struct BuildOutput {
+    std::vector<std::string> batch_namespaces;
+    std::vector<size_t> batch_sizes;
+    std::vector<storage::AuditEvent> events;
+    std::vector<indexing::IndexEntry> entries;
+    std::vector<vector::VectorSearchResult> ranking;
+  };
+
+  auto build = [](size_t batch_size) {
+    auto db = make_db();
+    storage::sqlite::SqliteIndexRunStore run_store(db);
+    storage::InMemoryAtomRepository atom_repo;
+    InMemoryResumeStore resume_store;
+    storage::InMemoryOpportunityRepository opp_repo;
+    RecordingEmbeddingIndex vector_index;
+    embedding::DeterministicStubEmbeddingProvider embedding_provider(128);
+    storage::InMemoryAuditLog audit_log;
+    core::DeterministicIdGenerator id_gen;
+    core::FixedClock clock("2026-01-01T00:00:00Z");
+
+    for (int i = 0; i < 5; ++i) {
+      const std::string n = std::to_string(i);
+      atom_repo.upsert(
+          {core::AtomId{"atom-00" + n}, "cpp", "Title " + n, "Claim " + n, {}, true, {}});
+    }
+    domain::Requirement req{"5+ years C++", {}, true};
+    opp_repo.upsert({core::OpportunityId{"opp-001"}, "ExampleCo", "Architect", {req}, "manual"});
+    resume_store.upsert(
+        {core::ResumeId{"resume-001"}, "# CV\nContent.", "hash-r1", {}, std::nullopt});
+
+    auto config = default_config("all");
+    config.batch_size = batch_size;
+    const auto result =
+        indexing::run_index_build(atom_repo, resume_store, opp_repo, run_store, vector_index,
+                                  embedding_provider, audit_log, id_gen, clock, config);
+    CHECK(result.indexed_count == 7);
+
+    const auto query = embedding_provider.embed_text("Title 3 Claim 3");
+    return BuildOutput{vector_index.batch_namespaces, vector_index.batch_sizes,
+                       audit_log.query(result.run_id),
+                       run_store.get_entries_for_run(result.run_id),
+                       vector_index.query(vector::kAtomNamespace, query, 10)};
+  };
+
+  const auto unbatched = build(1);
+  const auto chunked = build(3);
+  const auto single = build(1000);
+
+  // A batch never spans namespaces: 5 atoms, then 1 resume, then 1 opportunity.
+  CHECK(unbatched.batch_sizes == std::vector<size_t>(7, 1));
+  CHECK(chunked.batch_sizes == std::vector<size_t>{3, 2, 1, 1});
+  CHECK(single.batch_sizes == std::vector<size_t>{5, 1, 1});
+  CHECK(single.batch_namespaces == std::vector<std::string>{"atom", "resume", "opportunity"});
+  CHECK(build(0).batch_sizes == unbatched.batch_sizes);  // 0 is treated as 1
+
+  for (const auto* other : {&chunked, &single}) {
+    REQUIRE(other->events.size() == unbatched.events.size());
+    for (size_t i = 0; i < unbatched.events.size(); ++i) {
+      CHECK(other->events[i].event_id == unbatched.events[i].event_id);
+      CHECK(other->events[i].event_type == unbatched.events[i].event_type);
+      CHECK(other->events[i].payload == unbatched.events[i].payload);
+    }
+    REQUIRE(other->entries.size() == unbatched.entries.size());
+    for (size_t i = 0; i < unbatched.entries.size(); ++i) {
+      CHECK(other->entries[i].artifact_id == unbatched.entries[i].artifact_id);
+      CHECK(other->entries[i].vector_hash == unbatched.entries[i].vector_hash);
+    }
+    REQUIRE(other->ranking.size() == unbatched.ranking.size());
+    for (size_t i = 0; i < unbatched.ranking.size(); ++i) {
+      CHECK(other->ranking[i].key == unbatched.ranking[i].key);
+      CHECK(other->ranking[i].score == unbatched.ranking[i].score);
+    }
+  }
+}
+
+TEST_CASE("index-build jobs parallelise embedding without changing the run",
+          "[indexing][pipeline]") {
+  struct BuildOutput {
+    indexing::IndexBuildResult first;
+    indexing::IndexBuildResult second;
+    std::vector<storage::AuditEvent> events;
+    std::vector<indexing::IndexEntry> entries;
+    std::vector<vector::VectorSearchResult> ranking;
+  };
+
+  auto build = [](size_t jobs) {
+    auto db = make_db();
+    storage::sqlite::SqliteIndexRunStore run_store(db);
+    storage::InMemoryAtomRepository atom_repo;
+    InMemoryResumeStore resume_store;
+    storage::InMemoryOpportunityRepository opp_repo;
+    RecordingEmbeddingIndex vector_index;
+    embedding::DeterministicStubEmbeddingProvider embedding_provider(64);
+    storage::InMemoryAuditLog audit_log;
+    core::DeterministicIdGenerator id_gen;
+    core::FixedClock clock("2026-01-01T00:00:00Z");
+
+    for (int i = 0; i < 50; ++i) {
+      const std::string n = std::to_string(i);
+      atom_repo.upsert({core::AtomId{"atom-" + std::string(3 - n.size(), '0') + n}, "cpp",
+                        "Title " + n, "Claim about topic " + std::to_string(i % 7), {}, true, {}});
+    }
+
+    auto config = default_config("all");
+    config.batch_size = 16;
+    config.jobs = jobs;
+    BuildOutput out;
+    out.first = indexing::run_index_build(atom_repo, resume_store, opp_repo, run_store,
+                                          vector_index, embedding_provider, audit_log, id_gen,
+                                          clock, config);
+    out.events = audit_log.query(out.first.run_id);
+    out.entries = run_store.get_entries_for_run(out.first.run_id);
+    out.ranking = vector_index.query(vector::kAtomNamespace,
+                                     embedding_provider.embed_text("Claim about topic 3"), 20);
+
+    // A second run over unchanged sources skips every artifact at any job count.
+    atom_repo.upsert({core::AtomId{"atom-007"}, "cpp", "Title 7", "Changed claim", {}, true, {}});
+    out.second = indexing::run_index_build(atom_repo, resume_store, opp_repo, run_store,
+                                           vector_index, embedding_provider, audit_log, id_gen,
+                                           clock, config);
+    return out;
+  };
+
+  const auto serial = build(1);
+  CHECK(serial.first.indexed_count == 50);
+  CHECK(serial.second.indexed_count == 1);
+  CHECK(serial.second.stale_count == 1);
+  CHECK(serial.second.skipped_count == 49);
+
+  // Values above kMaxIndexBuildJobs are clamped to it.
+  for (const size_t jobs : {size_t{0}, size_t{3}, size_t{8}, indexing::kMaxIndexBuildJobs + 100}) {
+    const auto parallel = build(jobs);
+    CHECK(parallel.first.run_id == serial.first.run_id);
+    CHECK(parallel.first.indexed_count == serial.first.indexed_count);
+    CHECK(parallel.second.indexed_count == serial.second.indexed_count);
+    CHECK(parallel.second.stale_count == serial.second.stale_count);
+    CHECK(parallel.second.skipped_count == serial.second.skipped_count);
+
+    REQUIRE(parallel.events.size() == serial.events.size());
+    for (size_t i = 0; i < serial.events.size(); ++i) {
+      CHECK(parallel.events[i].event_id == serial.events[i].event_id);
+      CHECK(parallel.events[i].payload == serial.events[i].payload);
+    }
+    REQUIRE(parallel.entries.size() == serial.entries.size());
+    for (size_t i = 0; i < serial.entries.size(); ++i) {
+      CHECK(parallel.entries[i].artifact_id == serial.entries[i].artifact_id);
+      CHECK(parallel.entries[i].vector_hash == serial.entries[i].vector_hash);
+    }
+    REQUIRE(parallel.ranking.size() == serial.ranking.size());
+    for (size_t i = 0; i < serial.ranking.size(); ++i) {
+      CHECK(parallel.ranking[i].key == serial.ranking[i].key);
+      CHECK(parallel.ranking[i].score == serial.ranking[i].score);
+    }
+  }
+}
+
+TEST_CASE("index-build retain_runs prunes old entries without forcing re-indexing",
+          "[indexing][pipeline]") {
+  auto db = make_db();
+  storage::sqlite::SqliteIndexRunStore run_store(db);
+  storage::InMemoryAtomRepository atom_repo;
+  InMemoryResumeStore resume_store;
+  storage::InMemoryOpportunityRepository opp_repo;
+  vector::InMemoryEmbeddingIndex vector_index;
+  embedding::DeterministicStubEmbeddingProvider embedding_provider(32);
+  storage::InMemoryAuditLog audit_log;
+  core::DeterministicIdGenerator id_gen;
+  core::FixedClock clock("2026-01-01T00:00:00Z");
+
+  atom_repo.upsert({core::AtomId{"atom-001"}, "cpp", "C++", "Original claim", {}, true, {}});
+  atom_repo.upsert({core::AtomId{"atom-002"}, "arch", "Arch", "Stable claim", {}, true, {}});
+
+  auto config = default_config("atoms");
+  config.retain_runs = 1;
+
+  auto first = indexing::run_index_build(atom_repo, resume_store, opp_repo, run_store, vector_index,
+                                         embedding_provider, audit_log, id_gen, clock, config);
+  CHECK(first.indexed_count == 2);
+  CHECK(first.pruned_count == 0);  // the only run is the one retained
+
+  atom_repo.upsert({core::AtomId{"atom-001"}, "cpp", "C++", "Updated claim", {}, true, {}});
+  auto second =
+      indexing::run_index_build(atom_repo, resume_store, opp_repo, run_store, vector_index,
+                                embedding_provider, audit_log, id_gen, clock, config);
+  CHECK(second.indexed_count == 1);
+  CHECK(second.pruned_count == 2);  // both entries of the first run
+  CHECK(run_store.get_entries_for_run(first.run_id).empty());
+
+  // atom-002 was last indexed by the pruned run and is still recognised as unchanged.
+  auto third = indexing::run_index_build(atom_repo, resume_store, opp_repo, run_store,
+                                         vector_index, embedding_provider, audit_log, id_gen,
+                                         clock, config);
+  CHECK(third.indexed_count == 0);
+  CHECK(third.skipped_count == 2);
+  CHECK(third.pruned_count == 1);
+  CHECK(run_store.list_runs().size() == 3);
+}
+
+TEST_CASE("index-build skips only the artifacts whose text does not embed",
+          "[indexing][pipeline]") {
+  auto db = make_db();
+  storage::sqlite::SqliteIndexRunStore run_store(db);
+  storage::InMemoryAtomRepository atom_repo;
+  InMemoryResumeStore resume_store;
+  storage::InMemoryOpportunityRepository opp_repo;
+  RecordingEmbeddingIndex vector_index;
+  storage::InMemoryAuditLog audit_log;
+  core::DeterministicIdGenerator id_gen;
+  core::FixedClock clock("2026-01-01T00:00:00Z");
+
+  for (int i = 0; i < 4; ++i) {
+    const std::string n = std::to_string(i);
+    atom_repo.upsert(
+        {core::AtomId{"atom-00" + n}, "cpp", "Title " + n, "Claim " + n, {}, true, {}});
+  }
+  const embedding::DeterministicStubEmbeddingProvider stub;
+  GapEmbeddingProvider provider({"Claim 1", "Claim 3"});
+
+  // Two batches of two: each batch reuses the embedding buffer of the one before.
+  auto config = default_config("atoms");
+  config.batch_size = 2;
+  const auto result = indexing::run_index_build(atom_repo, resume_store, opp_repo, run_store,
+                                                vector_index, provider, audit_log, id_gen,
+                                                clock, config);
+
+  CHECK(result.indexed_count == 2);
+  CHECK(vector_index.batch_sizes == std::vector<size_t>{1, 1});
+  CHECK(vector_index.get(vector::kAtomNamespace, "atom-000") ==
+        stub.embed_text("Title 0 Claim 0"));
+  CHECK(vector_index.get(vector::kAtomNamespace, "atom-002") ==
+        stub.embed_text("Title 2 Claim 2"));
+  CHECK_FALSE(vector_index.get(vector::kAtomNamespace, "atom-001").has_value());
+  CHECK_FALSE(vector_index.get(vector::kAtomNamespace, "atom-003").has_value());
+
+  const auto entries = run_store.get_entries_for_run(result.run_id);
+  REQUIRE(entries.size() == 2);
+  CHECK(entries[0].artifact_id == "atom-000");
+  CHECK(entries[1].artifact_id == "atom-002");
+
+  size_t indexed_events = 0;
+  for (const auto& event : audit_log.query(result.run_id)) {
+    if (event.event_type == "IndexedArtifact")
+      ++indexed_events;
+  }
+  CHECK(indexed_events == 2);
+}
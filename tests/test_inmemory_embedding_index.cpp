@@ -1,8 +1,17 @@
+#include "ccmcp/vector/flat_vector_store.h"
 #include "ccmcp/vector/inmemory_embedding_index.h"
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
+#include <atomic>
+#include <cmath>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
 using namespace ccmcp::vector;
 
 TEST_CASE("InMemoryEmbeddingIndex::upsert and get work correctly", "[vector][index]") {
@@ -113,3 +122,206 @@ TEST_CASE("InMemoryEmbeddingIndex::query handles empty index", "[vector][index]"
 
   CHECK(results.empty());
 }
+
+TEST_CASE("InMemoryEmbeddingIndex::query top_k is a prefix of the full ranking",
+          "[vector][index]") {
+  InMemoryEmbeddingIndex index;
+
+  // Few distinct directions → many exact score ties across a larger index.
+  for (int i = 0; i < 100; ++i) {
+    const float x = static_cast<float>(i % 5);
+    index.upsert("key-" + std::to_string(99 - i), Vector{x, 1.0f}, "meta-" + std::to_string(i));
+  }
+
+  const Vector query = {1.0f, 0.5f};
+  const auto full = index.query(query, 100);
+  REQUIRE(full.size() == 100);
+  for (size_t i = 1; i < full.size(); ++i) {
+    const bool ordered = full[i - 1].score > full[i].score + 1e-9 ||
+                         (std::abs(full[i - 1].score - full[i].score) <= 1e-9 &&
+                          full[i - 1].key < full[i].key);
+    CHECK(ordered);
+  }
+
+  for (const size_t k : {size_t{0}, size_t{1}, size_t{10}, size_t{33}}) {
+    const auto top = index.query(query, k);
+    REQUIRE(top.size() == k);
+    for (size_t i = 0; i < k; ++i) {
+      CHECK(top[i].key == full[i].key);
+      CHECK(top[i].metadata == full[i].metadata);
+    }
+  }
+}
+
+TEST_CASE("InMemoryEmbeddingIndex::upsert_many matches per-record upsert", "[vector][index]") {
+  InMemoryEmbeddingIndex batched;
+  InMemoryEmbeddingIndex single;
+  single.upsert("key-3", Vector{9.0f, 9.0f}, "existing");
+  batched.upsert("key-3", Vector{9.0f, 9.0f}, "existing");
+
+  std::vector<VectorRecord> records;
+  for (int i = 0; i < 50; ++i) {
+    records.push_back({"key-" + std::to_string(i % 20),
+                       Vector{static_cast<float>(i), static_cast<float>(50 - i)},
+                       "meta-" + std::to_string(i)});
+  }
+  records.push_back({"other-dim", Vector{1.0f, 2.0f, 3.0f}, "odd"});
+  batched.upsert_many(records);
+  for (const auto& r : records) {
+    single.upsert(r.key, r.embedding, r.metadata);
+  }
+
+  const auto got = batched.query(Vector{1.0f, 2.0f}, 100);
+  const auto want = single.query(Vector{1.0f, 2.0f}, 100);
+  REQUIRE(got.size() == 21);
+  REQUIRE(got.size() == want.size());
+  for (size_t i = 0; i < got.size(); ++i) {
+    CHECK(got[i].key == want[i].key);
+    CHECK(got[i].score == want[i].score);
+    CHECK(got[i].metadata == want[i].metadata);
+  }
+  CHECK(batched.get("other-dim") == single.get("other-dim"));
+}
+
+TEST_CASE("InMemoryEmbeddingIndex::namespaces are isolated", "[vector][index]") {
+  InMemoryEmbeddingIndex index;
+  index.upsert(kAtomNamespace, "id-1", Vector{1.0f, 0.0f}, "atom");
+  index.upsert(kResumeNamespace, "id-1", Vector{0.0f, 1.0f}, "resume");
+  index.upsert_many(kOpportunityNamespace, std::vector<VectorRecord>{
+                                               {"id-2", Vector{1.0f, 1.0f}, "opp"},
+                                           });
+
+  // The same key lives independently in each namespace.
+  CHECK(index.get(kAtomNamespace, "id-1") == std::optional<Vector>(Vector{1.0f, 0.0f}));
+  CHECK(index.get(kResumeNamespace, "id-1") == std::optional<Vector>(Vector{0.0f, 1.0f}));
+  CHECK_FALSE(index.get(kAtomNamespace, "id-2").has_value());
+  CHECK_FALSE(index.get("id-1").has_value());  // default namespace is empty
+
+  const auto atoms = index.query(kAtomNamespace, Vector{0.0f, 1.0f}, 10);
+  REQUIRE(atoms.size() == 1);
+  CHECK(atoms[0].metadata == "atom");
+  CHECK(index.query(kOpportunityNamespace, Vector{1.0f, 1.0f}, 10).size() == 1);
+  CHECK(index.query("unknown", Vector{1.0f, 0.0f}, 10).empty());
+
+  const std::vector<Vector> queries{Vector{1.0f, 0.0f}, Vector{0.0f, 1.0f}};
+  const auto batch = index.query_batch("unknown", queries, 10);
+  REQUIRE(batch.size() == 2);
+  CHECK(batch[0].empty());
+  CHECK(batch[1].empty());
+}
+
+TEST_CASE("InMemoryEmbeddingIndex::segments rank exactly like one flat store",
+          "[vector][index]") {
+  std::mt19937 rng(17);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::uniform_int_distribution<int> pick(0, 149);
+  const auto random_vector = [&] {
+    Vector v(8);
+    for (auto& x : v) {
+      x = dist(rng);
+    }
+    return v;
+  };
+
+  InMemoryEmbeddingIndex index;
+  FlatVectorStore reference;
+  for (int round = 0; round < 400; ++round) {
+    if (round % 25 == 0) {
+      std::vector<VectorRecord> batch;
+      for (int i = 0; i < 20; ++i) {
+        batch.push_back(VectorRecord{"k" + std::to_string(pick(rng)), random_vector(),
+                                     "batch-" + std::to_string(round)});
+      }
+      index.upsert_many(batch);
+      for (const auto& record : batch) {
+        reference.upsert(record.key, record.embedding, record.metadata);
+      }
+    } else {
+      const std::string key = "k" + std::to_string(pick(rng));  // replaces keys often
+      const auto v = random_vector();
+      index.upsert(key, v, "single-" + std::to_string(round));
+      reference.upsert(key, v, "single-" + std::to_string(round));
+    }
+  }
+
+  // Size-tiered merging keeps the segment list logarithmic in the row count.
+  CHECK(index.segment_count(kDefaultNamespace) <= 8);
+
+  for (const auto& key : reference.keys()) {
+    CHECK(index.get(key) == reference.get(key));
+  }
+  std::vector<Vector> queries;
+  for (int q = 0; q < 8; ++q) {
+    queries.push_back(random_vector());
+  }
+  for (const size_t top_k : {size_t{1}, size_t{7}, size_t{500}}) {
+    const auto expected = reference.query_batch(queries, top_k);
+    const auto actual = index.query_batch(queries, top_k);
+    REQUIRE(actual.size() == expected.size());
+    for (size_t q = 0; q < queries.size(); ++q) {
+      REQUIRE(actual[q].size() == expected[q].size());
+      for (size_t i = 0; i < expected[q].size(); ++i) {
+        CHECK(actual[q][i].key == expected[q][i].key);
+        CHECK(actual[q][i].score == expected[q][i].score);
+        CHECK(actual[q][i].metadata == expected[q][i].metadata);
+      }
+    }
+  }
+}
+
+TEST_CASE("InMemoryEmbeddingIndex::readers see whole snapshots during concurrent writes",
+          "[vector][index]") {
+  InMemoryEmbeddingIndex index;
+  constexpr int kRows = 300;
+  std::atomic<bool> done{false};
+  std::atomic<int> torn{0};
+
+  // Each batch writes every key with the same generation, so a reader that observes two
+  // generations in one result has seen a partially published write.
+  std::thread writer([&] {
+    for (int generation = 0; generation < 40; ++generation) {
+      std::vector<VectorRecord> batch;
+      for (int i = 0; i < kRows; ++i) {
+        batch.push_back(VectorRecord{"k" + std::to_string(i),
+                                     Vector{1.0f, static_cast<float>(i)},
+                                     std::to_string(generation)});
+      }
+      index.upsert_many(batch);
+      index.upsert("extra-" + std::to_string(generation), Vector{0.0f, 1.0f}, "extra");
+    }
+    done = true;
+  });
+
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 3; ++r) {
+    readers.emplace_back([&] {
+      while (!done) {
+        const auto results = index.query(Vector{1.0f, 0.0f}, kRows * 2);
+        std::string generation;
+        int rows = 0;
+        for (const auto& result : results) {
+          if (result.metadata == "extra") {
+            continue;
+          }
+          ++rows;
+          if (generation.empty()) {
+            generation = result.metadata;
+          } else if (result.metadata != generation) {
+            ++torn;
+          }
+        }
+        if (rows != 0 && rows != kRows) {
+          ++torn;
+        }
+      }
+    });
+  }
+
+  writer.join();
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  CHECK(torn == 0);
+  CHECK(index.query(Vector{1.0f, 0.0f}, kRows * 2).size() == kRows + 40);
+  CHECK(index.get("k0") == std::optional<Vector>(Vector{1.0f, 0.0f}));
+}
@@ -56,3 +56,17 @@ TEST_CASE("InMemoryOpportunityRepository::list_all returns opportunities in dete
   CHECK(all_opps[1].opportunity_id.value == "opp-002");
   CHECK(all_opps[2].opportunity_id.value == "opp-003");
 }
+
+TEST_CASE("InMemoryOpportunityRepository::get_many aligns results with the requested ids",
+          "[storage][repository]") {
+  storage::InMemoryOpportunityRepository repo;
+  repo.upsert({core::OpportunityId{"opp-001"}, "A", "Role", {}, ""});
+  repo.upsert({core::OpportunityId{"opp-002"}, "B", "Role", {}, ""});
+
+  const auto found = repo.get_many({core::OpportunityId{"opp-002"}, core::OpportunityId{"missing"},
+                                    core::OpportunityId{"opp-001"}});
+  REQUIRE(found.size() == 3);
+  CHECK(found[0]->company == "B");
+  CHECK_FALSE(found[1].has_value());
+  CHECK(found[2]->company == "A");
+}
@@ -4,6 +4,7 @@
 #include "ccmcp/domain/opportunity.h"
 #include "ccmcp/domain/requirement.h"
 #include "ccmcp/matching/matcher.h"
+#include "ccmcp/matching/token_dictionary.h"
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -103,3 +104,34 @@ TEST_CASE("Matcher produces lexical overlap scores", "[matching][basic]") {
     REQUIRE(report.missing_requirements.size() == 1);
   }
 }
+
+TEST_CASE("Matcher scores unseen requirement tokens without interning them",
+          "[matching][basic]") {
+  core::DeterministicIdGenerator gen;
+
+  domain::ExperienceAtom atom;
+  atom.atom_id = core::new_atom_id(gen);
+  atom.domain = "architecture";
+  atom.title = "Architecture Lead";
+  atom.claim = "Led architecture reviews";
+  atom.verified = true;
+  const std::vector<domain::ExperienceAtom> atoms{atom};
+
+  domain::Opportunity opp;
+  opp.opportunity_id = core::new_opportunity_id(gen);
+  opp.requirements = {{"architecture qzxunseena qzxunseenb qzxunseenc", {}, true},
+                      {"qzxunseend only", {}, true}};
+
+  const matching::CorpusSnapshot corpus(atoms);
+  const auto dictionary_size = matching::TokenDictionary::global().size();
+  const auto report = matching::Matcher().evaluate(opp, corpus);
+  CHECK(matching::TokenDictionary::global().size() == dictionary_size);
+
+  // Unseen tokens still count in |R|: 1 of 4 tokens overlaps.
+  REQUIRE(report.requirement_matches.size() == 2);
+  CHECK(report.requirement_matches[0].matched);
+  CHECK(report.requirement_matches[0].best_score == 0.25);
+  CHECK(report.requirement_matches[0].evidence_tokens == std::vector<std::string>{"architecture"});
+  CHECK_FALSE(report.requirement_matches[1].matched);
+  CHECK(report.missing_requirements == std::vector<std::string>{"qzxunseend only"});
+}
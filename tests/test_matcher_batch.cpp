@@ -0,0 +1,91 @@
+#include "ccmcp/core/thread_pool.h"
+#include "ccmcp/embedding/embedding_provider.h"
+#include "ccmcp/matching/matcher.h"
+#include "ccmcp/vector/inmemory_embedding_index.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace ccmcp;
+
+namespace {
+
+domain::ExperienceAtom make_atom(const std::string& id, const std::string& claim,
+                                 bool verified = true) {
+  return domain::ExperienceAtom{core::AtomId{id}, "general", "", claim, {}, verified, {}};
+}
+
+domain::Opportunity make_opportunity(const std::string& id, std::vector<std::string> texts) {
+  domain::Opportunity opp{core::OpportunityId{id}, "Acme", "Engineer", {}, "test"};
+  for (auto& text : texts) {
+    opp.requirements.push_back(domain::Requirement{std::move(text), {}, true});
+  }
+  return opp;
+}
+
+void check_identical(const domain::MatchReport& a, const domain::MatchReport& b) {
+  CHECK(a.opportunity_id == b.opportunity_id);
+  CHECK(a.strategy == b.strategy);
+  CHECK(a.overall_score == b.overall_score);
+  CHECK(a.breakdown.final_score == b.breakdown.final_score);
+  CHECK(a.matched_atoms == b.matched_atoms);
+  CHECK(a.missing_requirements == b.missing_requirements);
+  CHECK(a.retrieval_stats.lexical_candidates == b.retrieval_stats.lexical_candidates);
+  CHECK(a.retrieval_stats.embedding_candidates == b.retrieval_stats.embedding_candidates);
+  CHECK(a.retrieval_stats.merged_candidates == b.retrieval_stats.merged_candidates);
+  REQUIRE(a.requirement_matches.size() == b.requirement_matches.size());
+  for (size_t i = 0; i < a.requirement_matches.size(); ++i) {
+    CHECK(a.requirement_matches[i].requirement_text == b.requirement_matches[i].requirement_text);
+    CHECK(a.requirement_matches[i].matched == b.requirement_matches[i].matched);
+    CHECK(a.requirement_matches[i].best_score == b.requirement_matches[i].best_score);
+    CHECK(a.requirement_matches[i].contributing_atom_id ==
+          b.requirement_matches[i].contributing_atom_id);
+    CHECK(a.requirement_matches[i].evidence_tokens == b.requirement_matches[i].evidence_tokens);
+  }
+}
+
+}  // namespace
+
+TEST_CASE("evaluate_batch matches per-opportunity evaluate", "[matcher][batch]") {
+  const std::vector<domain::ExperienceAtom> atoms = {
+      make_atom("atom-3", "kafka streaming pipelines"),
+      make_atom("atom-1", "rust services and kafka"),
+      make_atom("atom-2", "react frontend"),
+      make_atom("atom-0", "kafka rust react", false),
+  };
+  // Shared requirement texts across opportunities exercise the dedupe path.
+  const std::vector<domain::Opportunity> opportunities = {
+      make_opportunity("opp-a", {"kafka", "rust services", "golang"}),
+      make_opportunity("opp-b", {"react frontend", "kafka", "kafka"}),
+      make_opportunity("opp-c", {}),
+      make_opportunity("opp-d", {"!!!", "rust services"}),
+  };
+
+  embedding::DeterministicStubEmbeddingProvider provider;
+  vector::InMemoryEmbeddingIndex index;
+  for (const auto& atom : atoms) {
+    index.upsert(vector::kAtomNamespace, atom.atom_id.value, provider.embed_text(atom.claim), "");
+  }
+
+  core::ThreadPool pool(3);
+  for (const auto strategy : {matching::MatchingStrategy::kDeterministicLexicalV01,
+                              matching::MatchingStrategy::kHybridLexicalEmbeddingV02}) {
+    const matching::HybridConfig hybrid{.k_lexical = 1, .k_embedding = 1};
+    for (core::ThreadPool* p : {static_cast<core::ThreadPool*>(nullptr), &pool}) {
+      const matching::Matcher matcher(matching::ScoreWeights{}, strategy, hybrid, p);
+
+      const auto batch = matcher.evaluate_batch(opportunities, atoms, &provider, &index);
+      REQUIRE(batch.size() == opportunities.size());
+      for (size_t i = 0; i < opportunities.size(); ++i) {
+        check_identical(batch[i], matcher.evaluate(opportunities[i], atoms, &provider, &index));
+      }
+    }
+  }
+}
+
+TEST_CASE("evaluate_batch with no opportunities returns no reports", "[matcher][batch]") {
+  const matching::Matcher matcher;
+  CHECK(matcher.evaluate_batch({}, std::vector<domain::ExperienceAtom>{}).empty());
+}
@@ -50,7 +50,7 @@ TEST_CASE("Hybrid retrieval produces deterministic output", "[matcher][hybrid][d
   for (const auto& atom : atoms) {
     std::string atom_text = atom.claim + " " + atom.title;
     auto embedding = embedding_provider.embed_text(atom_text);
-    vector_index.upsert(atom.atom_id.value, embedding, "");
+    vector_index.upsert(vector::kAtomNamespace, atom.atom_id.value, embedding, "");
   }
 
   matching::Matcher hybrid_matcher(matching::ScoreWeights{},
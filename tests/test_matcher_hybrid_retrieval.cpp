@@ -54,7 +54,7 @@ TEST_CASE("Hybrid retrieval expands recall beyond lexical", "[matcher][hybrid]")
   for (const auto& atom : atoms) {
     std::string atom_text = atom.claim + " " + atom.title;
     auto embedding = embedding_provider.embed_text(atom_text);
-    vector_index.upsert(atom.atom_id.value, embedding, "");
+    vector_index.upsert(vector::kAtomNamespace, atom.atom_id.value, embedding, "");
   }
 
   // Run matcher in hybrid mode
@@ -127,7 +127,7 @@ TEST_CASE("Hybrid retrieval preserves lexical scoring and tie-breaks", "[matcher
   // Index atoms
   for (const auto& atom : atoms) {
     auto embedding = embedding_provider.embed_text(atom.claim);
-    vector_index.upsert(atom.atom_id.value, embedding, "");
+    vector_index.upsert(vector::kAtomNamespace, atom.atom_id.value, embedding, "");
   }
 
   matching::Matcher hybrid_matcher(matching::ScoreWeights{},
@@ -140,3 +140,46 @@ TEST_CASE("Hybrid retrieval preserves lexical scoring and tie-breaks", "[matcher
   REQUIRE(report.requirement_matches[0].matched);
   CHECK(report.requirement_matches[0].contributing_atom_id.value().value == "atom-a");
 }
+
+TEST_CASE("Hybrid lexical top-K keeps (score desc, atom_id asc) order", "[matcher][hybrid]") {
+  auto make = [](const std::string& id, const std::string& claim, bool verified = true) {
+    return domain::ExperienceAtom{core::AtomId{id}, "general", "", claim, {}, verified, {}};
+  };
+  // Input order deliberately differs from atom_id order.
+  std::vector<domain::ExperienceAtom> atoms = {
+      make("c-beta", "beta"),      make("m-both", "alpha beta"),
+      make("a-beta", "beta"),      make("b-none", "unrelated"),
+      make("0-unverified", "alpha beta", false),
+  };
+
+  domain::Opportunity opportunity{core::OpportunityId{"opp-1"},
+                                  "Company",
+                                  "Role",
+                                  {domain::Requirement{"alpha beta", {}, true},
+                                   domain::Requirement{"beta", {}, true}},
+                                  "manual"};
+
+  SECTION("top-2 is best overlap, then smallest atom_id among ties") {
+    matching::Matcher matcher(matching::ScoreWeights{},
+                              matching::MatchingStrategy::kHybridLexicalEmbeddingV02,
+                              matching::HybridConfig{.k_lexical = 2, .k_embedding = 0});
+    auto report = matcher.evaluate(opportunity, atoms);
+
+    CHECK(report.retrieval_stats.lexical_candidates == 2);
+    REQUIRE(report.requirement_matches.size() == 2);
+    CHECK(report.requirement_matches[0].contributing_atom_id->value == "m-both");
+    // Candidates are {m-both, a-beta}; both score 1.0 on "beta", a-beta wins the tie.
+    CHECK(report.requirement_matches[1].contributing_atom_id->value == "a-beta");
+  }
+
+  SECTION("zero-overlap atoms fill remaining slots in atom_id order") {
+    matching::Matcher matcher(matching::ScoreWeights{},
+                              matching::MatchingStrategy::kHybridLexicalEmbeddingV02,
+                              matching::HybridConfig{.k_lexical = 10, .k_embedding = 0});
+    auto report = matcher.evaluate(opportunity, atoms);
+
+    // All four verified atoms are selected; the unverified one never is.
+    CHECK(report.retrieval_stats.lexical_candidates == 4);
+    CHECK(report.retrieval_stats.merged_candidates == 4);
+  }
+}
@@ -0,0 +1,106 @@
+#include "ccmcp/core/thread_pool.h"
+#include "ccmcp/matching/matcher.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace ccmcp;
+
+namespace {
+
+// Deterministic pseudo-random corpus: small vocabulary so many atoms tie on score and the
+// atom_id tie-break is exercised across parallel block boundaries.
+std::vector<domain::ExperienceAtom> make_corpus(size_t count) {
+  static const std::vector<std::string> vocab = {
+      "cpp",    "rust",  "kafka", "latency", "systems", "python", "trading", "react",
+      "cloud",  "infra", "sql",   "graphs",  "ml",      "search", "golang",  "design",
+  };
+  std::vector<domain::ExperienceAtom> atoms;
+  std::uint64_t state = 0x9E3779B97F4A7C15ULL;
+  for (size_t i = 0; i < count; ++i) {
+    std::string claim;
+    for (int w = 0; w < 4; ++w) {
+      state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+      claim += vocab[(state >> 33U) % vocab.size()] + " ";
+    }
+    // Ids are not in input order, to make the tie-break matter.
+    const std::string id = "atom-" + std::to_string((i * 7919) % count);
+    atoms.push_back(domain::ExperienceAtom{
+        core::AtomId{id}, "general", "", claim, {}, (i % 11) != 0, {}});
+  }
+  return atoms;
+}
+
+domain::Opportunity make_opportunity() {
+  domain::Opportunity opp{core::OpportunityId{"opp-parallel"}, "Acme", "Engineer", {}, "test"};
+  const std::vector<std::string> texts = {
+      "cpp latency systems", "rust", "kafka trading", "react frontend", "!!!",
+      "python ml search",    "sql", "cloud infra golang", "unmatched words here",
+  };
+  for (int round = 0; round < 5; ++round) {
+    for (const auto& text : texts) {
+      opp.requirements.push_back(domain::Requirement{text, {}, true});
+    }
+  }
+  return opp;
+}
+
+void check_identical(const domain::MatchReport& serial, const domain::MatchReport& parallel) {
+  CHECK(serial.strategy == parallel.strategy);
+  CHECK(serial.overall_score == parallel.overall_score);  // bit-identical, not approximate
+  CHECK(serial.breakdown.final_score == parallel.breakdown.final_score);
+  CHECK(serial.matched_atoms == parallel.matched_atoms);
+  CHECK(serial.missing_requirements == parallel.missing_requirements);
+  CHECK(serial.retrieval_stats.merged_candidates == parallel.retrieval_stats.merged_candidates);
+  REQUIRE(serial.requirement_matches.size() == parallel.requirement_matches.size());
+  for (size_t i = 0; i < serial.requirement_matches.size(); ++i) {
+    const auto& s = serial.requirement_matches[i];
+    const auto& p = parallel.requirement_matches[i];
+    CHECK(s.requirement_text == p.requirement_text);
+    CHECK(s.matched == p.matched);
+    CHECK(s.best_score == p.best_score);
+    CHECK(s.contributing_atom_id == p.contributing_atom_id);
+    CHECK(s.evidence_tokens == p.evidence_tokens);
+  }
+}
+
+}  // namespace
+
+TEST_CASE("Parallel Matcher output is identical to serial output", "[matcher][parallel]") {
+  const auto atoms = make_corpus(3000);
+  const auto opportunity = make_opportunity();
+  core::ThreadPool pool(4);
+
+  for (const auto strategy : {matching::MatchingStrategy::kDeterministicLexicalV01,
+                              matching::MatchingStrategy::kHybridLexicalEmbeddingV02}) {
+    const matching::HybridConfig hybrid{.k_lexical = 700, .k_embedding = 0};
+    const matching::Matcher serial(matching::ScoreWeights{}, strategy, hybrid);
+    const matching::Matcher parallel(matching::ScoreWeights{}, strategy, hybrid, &pool);
+
+    const auto serial_report = serial.evaluate(opportunity, atoms);
+    REQUIRE_FALSE(serial_report.matched_atoms.empty());
+
+    // Repeat to give different schedules a chance to surface ordering bugs.
+    for (int run = 0; run < 3; ++run) {
+      check_identical(serial_report, parallel.evaluate(opportunity, atoms));
+    }
+  }
+}
+
+TEST_CASE("Parallel Matcher handles empty corpus and empty requirements", "[matcher][parallel]") {
+  core::ThreadPool pool(2);
+  const matching::Matcher parallel(matching::ScoreWeights{},
+                                   matching::MatchingStrategy::kDeterministicLexicalV01,
+                                   matching::HybridConfig{}, &pool);
+
+  const auto opportunity = make_opportunity();
+  const auto report = parallel.evaluate(opportunity, {});
+  CHECK(report.overall_score == 0.0);
+  CHECK(report.missing_requirements.size() == opportunity.requirements.size());
+
+  const domain::Opportunity empty{core::OpportunityId{"opp-empty"}, "Acme", "Role", {}, "test"};
+  CHECK(parallel.evaluate(empty, make_corpus(10)).requirement_matches.empty());
+}
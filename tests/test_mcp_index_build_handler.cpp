@@ -0,0 +1,113 @@
+#include "ccmcp/core/clock.h"
+#include "ccmcp/core/id_generator.h"
+#include "ccmcp/core/services.h"
+#include "ccmcp/embedding/embedding_provider.h"
+#include "ccmcp/indexing/index_build_pipeline.h"
+#include "ccmcp/ingest/resume_ingestor.h"
+#include "ccmcp/interaction/inmemory_interaction_coordinator.h"
+#include "ccmcp/matching/corpus_snapshot.h"
+#include "ccmcp/storage/audit_log.h"
+#include "ccmcp/storage/inmemory_atom_repository.h"
+#include "ccmcp/storage/inmemory_interaction_repository.h"
+#include "ccmcp/storage/inmemory_opportunity_repository.h"
+#include "ccmcp/storage/sqlite/sqlite_db.h"
+#include "ccmcp/storage/sqlite/sqlite_decision_store.h"
+#include "ccmcp/storage/sqlite/sqlite_index_run_store.h"
+#include "ccmcp/storage/sqlite/sqlite_resume_store.h"
+#include "ccmcp/vector/inmemory_embedding_index.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "config.h"
+#include "handlers/index_build.h"
+#include "server_context.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace ccmcp;
+using json = nlohmann::json;
+
+namespace {
+
+// The index_build tool never ingests; this ingestor only satisfies ServerContext.
+class UnusedIngestor final : public ingest::IResumeIngestor {
+ public:
+  [[nodiscard]] ingest::IngestResult ingest_file(const std::string& /*file_path*/,
+                                                 const ingest::IngestOptions& /*options*/,
+                                                 core::IIdGenerator& /*id_gen*/,
+                                                 core::IClock& /*clock*/) override {
+    return ingest::IngestResult::err("unused");
+  }
+  [[nodiscard]] ingest::IngestResult ingest_bytes(const std::vector<uint8_t>& /*data*/,
+                                                  const std::string& /*format*/,
+                                                  const ingest::IngestOptions& /*options*/,
+                                                  core::IIdGenerator& /*id_gen*/,
+                                                  core::IClock& /*clock*/) override {
+    return ingest::IngestResult::err("unused");
+  }
+};
+
+// Fixture wiring a ServerContext over in-memory repositories and in-memory SQLite stores.
+struct HandlerFixture {
+  core::DeterministicIdGenerator id_gen;
+  core::FixedClock clock{"2026-01-01T00:00:00Z"};
+
+  storage::InMemoryAtomRepository atom_repo;
+  storage::InMemoryOpportunityRepository opportunity_repo;
+  storage::InMemoryInteractionRepository interaction_repo;
+  storage::InMemoryAuditLog audit_log;
+  vector::InMemoryEmbeddingIndex vector_index;
+  embedding::DeterministicStubEmbeddingProvider embedding_provider;
+  core::Services services{atom_repo, opportunity_repo, interaction_repo,
+                          audit_log, vector_index,     embedding_provider};
+
+  interaction::InMemoryInteractionCoordinator coordinator;
+  UnusedIngestor ingestor;
+  std::shared_ptr<storage::sqlite::SqliteDb> db;
+  storage::sqlite::SqliteResumeStore resume_store;
+  storage::sqlite::SqliteIndexRunStore index_run_store;
+  storage::sqlite::SqliteDecisionStore decision_store;
+  mcp::McpServerConfig config;
+  matching::CorpusSnapshotCache corpus_cache;
+  mcp::ServerContext ctx{services,       coordinator,    ingestor, resume_store,
+                         index_run_store, decision_store, id_gen,   clock,
+                         config,          corpus_cache};
+
+  HandlerFixture()
+      : db([] {
+          auto r = storage::sqlite::SqliteDb::open(":memory:");
+          REQUIRE(r.has_value());
+          REQUIRE(r.value()->ensure_schema_v10().has_value());
+          return r.value();
+        }()),
+        resume_store(db),
+        index_run_store(db),
+        decision_store(db) {}
+};
+
+}  // namespace
+
+TEST_CASE("index_build tool: jobs is bounded by kMaxIndexBuildJobs", "[mcp][index_build]") {
+  HandlerFixture fx;
+
+  SECTION("values in range are accepted") {
+    for (const std::size_t jobs : {std::size_t{1}, indexing::kMaxIndexBuildJobs}) {
+      const auto result = mcp::handlers::handle_index_build(json{{"jobs", jobs}}, fx.ctx);
+      CHECK_FALSE(result.contains("error"));
+      CHECK(result.contains("run_id"));
+    }
+  }
+
+  SECTION("zero, values above the bound and non-integers are rejected") {
+    for (const json& jobs : {json(0), json(indexing::kMaxIndexBuildJobs + 1), json(100000),
+                             json(-4), json(2.5), json("8")}) {
+      const auto result = mcp::handlers::handle_index_build(json{{"jobs", jobs}}, fx.ctx);
+      REQUIRE(result.contains("error"));
+      CHECK(result["error"].get<std::string>().rfind("Invalid jobs: ", 0) == 0);
+    }
+    CHECK(fx.index_run_store.list_runs().empty());  // rejected before any run starts
+  }
+}
@@ -0,0 +1,396 @@
+#include "ccmcp/core/hashing.h"
+#include "ccmcp/vector/inmemory_embedding_index.h"
+#include "ccmcp/vector/mmap_embedding_index.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ccmcp::vector;
+
+namespace {
+
+Vector random_vector(std::mt19937& rng, std::size_t dim) {
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  Vector v(dim);
+  for (auto& x : v) {
+    x = dist(rng);
+  }
+  return v;
+}
+
+std::string key_for(int i) {
+  std::string digits = std::to_string(i);
+  return "atom-" + std::string(5 - digits.size(), '0') + digits;
+}
+
+void check_same_results(const std::vector<VectorSearchResult>& a,
+                        const std::vector<VectorSearchResult>& b) {
+  REQUIRE(a.size() == b.size());
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    CHECK(a[i].key == b[i].key);
+    CHECK(a[i].score == b[i].score);
+    CHECK(a[i].metadata == b[i].metadata);
+  }
+}
+
+// Fresh directory per test; returns the base file path inside it.
+std::string temp_index_path(const std::string& name) {
+  const auto dir = std::filesystem::temp_directory_path() / "ccmcp_test_mmap" / name;
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  return (dir / "vectors.mmap").string();
+}
+
+}  // namespace
+
+TEST_CASE("MmapEmbeddingIndex: upsert, replace and get", "[vector][mmap]") {
+  const auto path = temp_index_path("basic");
+  MmapEmbeddingIndex index(path);
+  index.upsert("key1", Vector{1.0f, 2.0f, 3.0f}, "meta1");
+  index.upsert("key1", Vector{4.0f, 5.0f, 6.0f}, "meta2");
+
+  CHECK(index.size() == 1);
+  CHECK(index.get("key1") == std::optional<Vector>(Vector{4.0f, 5.0f, 6.0f}));
+  CHECK_FALSE(index.get("missing").has_value());
+
+  const auto results = index.query(Vector{4.0f, 5.0f, 6.0f}, 5);
+  REQUIRE(results.size() == 1);
+  CHECK(results[0].metadata == "meta2");
+  CHECK(index.query(Vector{4.0f, 5.0f, 6.0f}, 0).empty());
+}
+
+TEST_CASE("MmapEmbeddingIndex: matches the in-memory index across tail, compaction and reopen",
+          "[vector][mmap]") {
+  const auto path = temp_index_path("equivalence");
+  InMemoryEmbeddingIndex exact;
+  std::mt19937 rng(21);
+  std::vector<Vector> queries;
+  for (int q = 0; q < 20; ++q) {
+    queries.push_back(random_vector(rng, 24));
+  }
+  queries.push_back(random_vector(rng, 5));  // other dimension: every row scores 0.0
+
+  const auto check_batch = [&](const MmapEmbeddingIndex& index) {
+    const auto batch = index.query_batch(queries, 10);
+    REQUIRE(batch.size() == queries.size());
+    for (std::size_t q = 0; q < queries.size(); ++q) {
+      check_same_results(batch[q], exact.query(queries[q], 10));
+    }
+  };
+  const auto check_all = [&](const MmapEmbeddingIndex& index) {
+    for (const auto& query : queries) {
+      for (const std::size_t k : {std::size_t{1}, std::size_t{10}, std::size_t{500}}) {
+        check_same_results(index.query(query, k), exact.query(query, k));
+      }
+    }
+  };
+
+  {
+    MmapEmbeddingIndex index(path);
+    for (int i = 0; i < 300; ++i) {
+      const auto v = random_vector(rng, 24);
+      index.upsert(key_for(i), v, "meta-" + std::to_string(i));
+      exact.upsert(key_for(i), v, "meta-" + std::to_string(i));
+    }
+    check_all(index);  // everything in the tail
+    check_batch(index);
+
+    index.compact();
+    CHECK(index.tail_records() == 0);
+    check_all(index);  // everything in the base file
+
+    // Replacements shadow base rows; a mixed-dimension key stays in the tail.
+    for (int i = 0; i < 300; i += 7) {
+      const auto v = random_vector(rng, 24);
+      index.upsert(key_for(i), v, "meta-v2-" + std::to_string(i));
+      exact.upsert(key_for(i), v, "meta-v2-" + std::to_string(i));
+    }
+    index.upsert("odd-dimension", Vector{1.0f, 2.0f}, "odd");
+    exact.upsert("odd-dimension", Vector{1.0f, 2.0f}, "odd");
+    CHECK(index.size() == 301);
+    check_all(index);
+    check_batch(index);  // shadowed base rows, tail rows and the odd dimension together
+  }
+
+  {
+    // The destructor compacted; only the other-dimension key remains in the tail.
+    MmapEmbeddingIndex reopened(path);
+    CHECK(reopened.size() == 301);
+    CHECK(reopened.tail_records() == 1);
+    check_all(reopened);
+    CHECK(reopened.get(key_for(7)) == exact.get(key_for(7)));
+    CHECK(reopened.get("odd-dimension") == exact.get("odd-dimension"));
+  }
+}
+
+TEST_CASE("MmapEmbeddingIndex: tail is replayed on open and a torn record is dropped",
+          "[vector][mmap]") {
+  const auto path = temp_index_path("replay");
+  {
+    MmapEmbeddingIndex index(path);
+    index.upsert("key-a", Vector{1.0f, 0.0f}, "a");
+    index.upsert("key-b", Vector{0.0f, 1.0f}, "b");
+    index.compact();
+    index.upsert("key-c", Vector{1.0f, 1.0f}, "c");
+    // Simulate a crash: the tail must survive without another compaction.
+    std::filesystem::copy_file(path + ".wal", path + ".wal.crash");
+  }
+  std::filesystem::rename(path + ".wal.crash", path + ".wal");
+
+  // Append half a record, as if the process died mid-write.
+  {
+    std::ofstream out(path + ".wal", std::ios::binary | std::ios::app);
+    out.write("\x05\x00\x00\x00\x00\x00", 6);
+  }
+
+  MmapEmbeddingIndex index(path);
+  CHECK(index.size() == 3);
+  CHECK(index.tail_records() == 1);
+  CHECK(index.get("key-c") == std::optional<Vector>(Vector{1.0f, 1.0f}));
+
+  // Appends after the truncated record are readable on the next open.
+  index.upsert("key-d", Vector{2.0f, 0.0f}, "d");
+  MmapEmbeddingIndex second(path);
+  CHECK(second.get("key-d") == std::optional<Vector>(Vector{2.0f, 0.0f}));
+}
+
+TEST_CASE("MmapEmbeddingIndex: read-only open never creates, truncates or compacts",
+          "[vector][mmap]") {
+  const auto path = temp_index_path("read_only");
+  using OpenMode = MmapEmbeddingIndex::OpenMode;
+
+  {
+    MmapEmbeddingIndex missing(path, OpenMode::kReadOnly);
+    CHECK(missing.size() == 0);
+    CHECK(missing.query(Vector{1.0f, 0.0f}, 5).empty());
+  }
+  CHECK_FALSE(std::filesystem::exists(path));
+  CHECK_FALSE(std::filesystem::exists(path + ".wal"));
+
+  MmapEmbeddingIndex writer(path);
+  writer.upsert("key-a", Vector{1.0f, 0.0f}, "a");
+  writer.compact();
+  writer.upsert("key-b", Vector{0.0f, 1.0f}, "b");
+
+  // A record the writer has only partly written so far.
+  {
+    std::ofstream out(path + ".wal", std::ios::binary | std::ios::app);
+    out.write("\x05\x00\x00\x00\x00\x00", 6);
+  }
+  const auto tail_size = std::filesystem::file_size(path + ".wal");
+  const auto base_time = std::filesystem::last_write_time(path);
+
+  {
+    MmapEmbeddingIndex reader(path, OpenMode::kReadOnly);
+    CHECK(reader.size() == 2);
+    CHECK(reader.tail_records() == 1);
+    CHECK(reader.get("key-b") == std::optional<Vector>(Vector{0.0f, 1.0f}));
+
+    reader.upsert("key-c", Vector{1.0f, 1.0f}, "c");
+    reader.upsert_many(kAtomNamespace, std::vector<VectorRecord>{{"key-d", {2.0f, 0.0f}, "d"}});
+    CHECK_FALSE(reader.get("key-c").has_value());
+    CHECK_FALSE(reader.get("key-d").has_value());
+    reader.compact();
+    CHECK(reader.tail_records() == 1);
+  }
+  CHECK(std::filesystem::file_size(path + ".wal") == tail_size);
+  CHECK(std::filesystem::last_write_time(path) == base_time);
+}
+
+TEST_CASE("MmapEmbeddingIndex: upsert_many appends one batch that survives reopen",
+          "[vector][mmap]") {
+  const auto path = temp_index_path("batch");
+  InMemoryEmbeddingIndex exact;
+  std::mt19937 rng(5);
+  std::vector<VectorRecord> records;
+  for (int i = 0; i < 120; ++i) {
+    records.push_back({key_for(i % 100), random_vector(rng, 16), "meta-" + std::to_string(i)});
+  }
+  exact.upsert_many(records);
+
+  const auto query = random_vector(rng, 16);
+  {
+    MmapEmbeddingIndex index(path);
+    index.upsert_many(records);
+    CHECK(index.size() == 100);
+    CHECK(index.tail_records() == 120);
+    check_same_results(index.query(query, 20), exact.query(query, 20));
+    // Simulate a crash so the reopen below replays the tail.
+    std::filesystem::copy_file(path + ".wal", path + ".wal.crash");
+  }
+  std::filesystem::rename(path + ".wal.crash", path + ".wal");
+  std::filesystem::remove(path);
+
+  MmapEmbeddingIndex reopened(path);
+  CHECK(reopened.size() == 100);
+  check_same_results(reopened.query(query, 20), exact.query(query, 20));
+}
+
+TEST_CASE("MmapEmbeddingIndex: namespaces are isolated across tail, compaction and reopen",
+          "[vector][mmap]") {
+  const auto path = temp_index_path("namespaces");
+  InMemoryEmbeddingIndex exact;
+  std::mt19937 rng(23);
+  std::vector<Vector> queries;
+  for (int q = 0; q < 4; ++q) {
+    queries.push_back(random_vector(rng, 16));
+  }
+  const auto check_all = [&](const MmapEmbeddingIndex& index) {
+    for (const auto ns : {kAtomNamespace, kResumeNamespace, kOpportunityNamespace}) {
+      const auto got = index.query_batch(ns, queries, 10);
+      for (std::size_t q = 0; q < queries.size(); ++q) {
+        check_same_results(got[q], exact.query(ns, queries[q], 10));
+      }
+    }
+    CHECK(index.query("unknown", queries[0], 10).empty());
+  };
+
+  MmapEmbeddingIndex index(path);
+  for (int i = 0; i < 90; ++i) {
+    const auto ns = i % 3 == 0 ? kAtomNamespace : i % 3 == 1 ? kResumeNamespace
+                                                             : kOpportunityNamespace;
+    const auto v = random_vector(rng, 16);
+    index.upsert(ns, key_for(i % 40), v, "meta-" + std::to_string(i));
+    exact.upsert(ns, key_for(i % 40), v, "meta-" + std::to_string(i));
+  }
+  check_all(index);
+  index.compact();
+  CHECK(index.tail_records() == 0);
+  check_all(index);
+
+  // Shadow one base row of the atom namespace only; the same key elsewhere is untouched.
+  index.upsert(kAtomNamespace, key_for(0), Vector(16, 1.0f), "replaced");
+  exact.upsert(kAtomNamespace, key_for(0), Vector(16, 1.0f), "replaced");
+  check_all(index);
+  CHECK(index.get(kAtomNamespace, key_for(0)) == std::optional(Vector(16, 1.0f)));
+
+  MmapEmbeddingIndex reopened(path);
+  CHECK(reopened.size() == index.size());
+  check_all(reopened);
+}
+
+TEST_CASE("MmapEmbeddingIndex: base rows move to the tail when the majority dimension changes",
+          "[vector][mmap]") {
+  const auto path = temp_index_path("dimension_change");
+  {
+    MmapEmbeddingIndex index(path);
+    for (int i = 0; i < 3; ++i) {
+      index.upsert(kResumeNamespace, "r" + std::to_string(i), Vector(4, 2.0f), "resume");
+    }
+    index.compact();
+    CHECK(index.tail_records() == 0);
+
+    // Re-embedding another namespace with a wider model makes 8 the most common dimension.
+    for (int i = 0; i < 5; ++i) {
+      index.upsert(kAtomNamespace, "a" + std::to_string(i), Vector(8, 1.0f), "atom");
+    }
+    index.compact();
+    CHECK(index.size() == 8);
+    CHECK(index.tail_records() == 3);  // the dimension-4 rows
+    CHECK(index.get(kResumeNamespace, "r1") == std::optional(Vector(4, 2.0f)));
+    CHECK(index.get(kAtomNamespace, "a1") == std::optional(Vector(8, 1.0f)));
+
+    const auto resumes = index.query(kResumeNamespace, Vector(4, 1.0f), 10);
+    REQUIRE(resumes.size() == 3);
+    CHECK(resumes[0].score > 0.99);
+    CHECK(resumes[0].metadata == "resume");
+    const auto atoms = index.query(kAtomNamespace, Vector(8, 1.0f), 10);
+    REQUIRE(atoms.size() == 5);
+    CHECK(atoms[0].score > 0.99);
+  }
+
+  MmapEmbeddingIndex reopened(path);
+  CHECK(reopened.size() == 8);
+  CHECK(reopened.get(kResumeNamespace, "r2") == std::optional(Vector(4, 2.0f)));
+  CHECK(reopened.query(kResumeNamespace, Vector(4, 1.0f), 1).front().score > 0.99);
+}
+
+TEST_CASE("MmapEmbeddingIndex: empty vectors stay in the tail", "[vector][mmap]") {
+  const auto path = temp_index_path("empty_vector");
+  {
+    MmapEmbeddingIndex index(path);
+    index.upsert("empty", Vector{}, "none");
+    REQUIRE_NOTHROW(index.compact());
+    CHECK(index.tail_records() == 1);
+    CHECK(index.get("empty") == std::optional(Vector{}));
+    CHECK_FALSE(std::filesystem::exists(path));
+
+    // Once every base row is shadowed by an empty vector, the base file is dropped.
+    index.upsert("full", Vector{1.0f, 2.0f}, "full");
+    index.compact();
+    CHECK(std::filesystem::exists(path));
+    index.upsert("full", Vector{}, "emptied");
+    REQUIRE_NOTHROW(index.compact());
+    CHECK_FALSE(std::filesystem::exists(path));
+    CHECK(index.size() == 2);
+  }
+
+  MmapEmbeddingIndex reopened(path);
+  CHECK(reopened.size() == 2);
+  CHECK(reopened.get("full") == std::optional(Vector{}));
+}
+
+TEST_CASE("MmapEmbeddingIndex: format-1 tail is migrated into namespaces", "[vector][mmap]") {
+  const auto path = temp_index_path("legacy");
+  {
+    std::ofstream out(path + ".wal", std::ios::binary);
+    const auto pod = [&out](const auto& value) {
+      out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    out.write("CCMCMWAL", 8);
+    pod(std::uint32_t{1});  // format version
+    pod(std::uint32_t{0});
+    for (const auto& [key, v] : {std::pair<std::string, Vector>{"atom-1", {1.0f, 0.0f}},
+                                 std::pair<std::string, Vector>{"opp:o-1", {0.0f, 1.0f}}}) {
+      std::string payload = key;
+      payload.append(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(float));
+      pod(static_cast<std::uint32_t>(key.size()));
+      pod(std::uint32_t{0});  // metadata
+      pod(static_cast<std::uint32_t>(v.size()));
+      pod(std::uint32_t{0});
+      pod(ccmcp::core::stable_hash64(payload));
+      out.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+    }
+  }
+
+  {
+    // A read-only open migrates in memory and leaves the format-1 tail in place.
+    const auto tail_size = std::filesystem::file_size(path + ".wal");
+    MmapEmbeddingIndex reader(path, MmapEmbeddingIndex::OpenMode::kReadOnly);
+    CHECK(reader.get(kOpportunityNamespace, "o-1") == std::optional(Vector{0.0f, 1.0f}));
+    CHECK(std::filesystem::file_size(path + ".wal") == tail_size);
+    CHECK_FALSE(std::filesystem::exists(path));
+  }
+
+  {
+    MmapEmbeddingIndex index(path);
+    CHECK(index.tail_records() == 0);  // compacted into a current-format base
+    CHECK(index.get(kAtomNamespace, "atom-1") == std::optional(Vector{1.0f, 0.0f}));
+    CHECK(index.get(kOpportunityNamespace, "o-1") == std::optional(Vector{0.0f, 1.0f}));
+    CHECK_FALSE(index.get(kAtomNamespace, "opp:o-1").has_value());
+  }
+
+  MmapEmbeddingIndex reopened(path);
+  CHECK(reopened.size() == 2);
+  const auto atoms = reopened.query(kAtomNamespace, Vector{0.0f, 1.0f}, 10);
+  REQUIRE(atoms.size() == 1);
+  CHECK(atoms[0].key == "atom-1");
+}
+
+TEST_CASE("MmapEmbeddingIndex: malformed base file is rejected", "[vector][mmap]") {
+  const auto path = temp_index_path("corrupt");
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << "not an index";
+  }
+  CHECK_THROWS_AS(MmapEmbeddingIndex(path), std::runtime_error);
+}
@@ -2,6 +2,8 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <vector>
+
 using namespace ccmcp::vector;
 
 TEST_CASE("NullEmbeddingIndex::upsert is no-op", "[vector][index]") {
@@ -28,3 +30,21 @@ TEST_CASE("NullEmbeddingIndex::get returns nullopt", "[vector][index]") {
   auto result = index.get("key1");
   CHECK_FALSE(result.has_value());
 }
+
+TEST_CASE("NullEmbeddingIndex::upsert_many is no-op", "[vector][index]") {
+  NullEmbeddingIndex index;
+  const std::vector<VectorRecord> records = {{"key1", {1.0f, 2.0f}, "metadata"}};
+
+  REQUIRE_NOTHROW(index.upsert_many(records));
+  CHECK_FALSE(index.get("key1").has_value());
+}
+
+TEST_CASE("NullEmbeddingIndex::query_batch returns one empty list per query", "[vector][index]") {
+  NullEmbeddingIndex index;
+  const std::vector<Vector> queries = {{1.0f, 2.0f}, {3.0f, 4.0f}};
+
+  const auto results = index.query_batch(queries, 5);
+  REQUIRE(results.size() == 2);
+  CHECK(results[0].empty());
+  CHECK(results[1].empty());
+}
@@ -0,0 +1,128 @@
+#include "ccmcp/vector/flat_vector_store.h"
+#include "ccmcp/vector/quantized_vector_store.h"
+#include "ccmcp/vector/top_k.h"
+#include "ccmcp/vector/vector_math.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace ccmcp::vector;
+
+namespace {
+
+Vector random_vector(std::mt19937& rng, size_t dim) {
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  Vector v(dim);
+  for (auto& x : v) {
+    x = dist(rng);
+  }
+  return v;
+}
+
+std::string key_for(int i) {
+  std::string digits = std::to_string(i);
+  return "vec-" + std::string(4 - digits.size(), '0') + digits;
+}
+
+}  // namespace
+
+TEST_CASE("quantize_int8: codes span [-127, 127] and reconstruct within half a step",
+          "[vector][quantized]") {
+  std::mt19937 rng(3);
+  const auto v = random_vector(rng, 100);
+  std::vector<std::int8_t> codes(v.size());
+  const float scale = quantize_int8(v, codes.data());
+
+  REQUIRE(scale > 0.0F);
+  const auto [lo, hi] = std::minmax_element(codes.begin(), codes.end());
+  CHECK(std::max(-int{*lo}, int{*hi}) == 127);  // the largest magnitude maps to ±127
+  for (size_t i = 0; i < v.size(); ++i) {
+    CHECK(std::fabs(static_cast<float>(codes[i]) * scale - v[i]) <= scale * 0.5F + 1e-6F);
+  }
+
+  std::vector<std::int8_t> zero_codes(3, std::int8_t{9});
+  CHECK(quantize_int8(Vector{0.0f, 0.0f, 0.0f}, zero_codes.data()) == 0.0F);
+  CHECK(zero_codes == std::vector<std::int8_t>(3, std::int8_t{0}));
+}
+
+TEST_CASE("QuantizedVectorStore: candidates approximate cosine and contain the exact top-k",
+          "[vector][quantized]") {
+  std::mt19937 rng(11);
+  const size_t dim = 96;
+  QuantizedVectorStore quantized;
+  FlatVectorStore exact;
+  for (int i = 0; i < 400; ++i) {
+    const auto v = random_vector(rng, dim);
+    quantized.upsert(key_for(i), v, "meta-" + std::to_string(i));
+    exact.upsert(key_for(i), v, "meta-" + std::to_string(i));
+  }
+  quantized.upsert("short", Vector{1.0f, 2.0f}, "meta-short");  // other dimension scores 0.0
+  CHECK(quantized.size() == 401);
+
+  for (int q = 0; q < 10; ++q) {
+    const auto query = random_vector(rng, dim);
+    const auto approx = quantized.candidates(query, 40);
+    REQUIRE(approx.size() == 40);
+    for (size_t i = 1; i < approx.size(); ++i) {
+      CHECK(ranks_before(approx[i - 1].score, approx[i - 1].key, approx[i].score, approx[i].key));
+    }
+    std::set<std::string> candidate_keys;
+    for (const auto& c : approx) {
+      candidate_keys.insert(c.key);
+      const auto stored = exact.get(c.key);
+      REQUIRE(stored.has_value());
+      CHECK(std::fabs(c.score - math::cosine_similarity(query, *stored)) < 0.01);
+      CHECK(c.metadata == *exact.metadata(c.key));
+    }
+    // With 4× over-fetch the exact top 10 survives the int8 scan.
+    for (const auto& hit : exact.query(query, 10)) {
+      CHECK(candidate_keys.contains(hit.key));
+    }
+  }
+
+  // Every key is a candidate once count covers the store, the other-dimension one at 0.0.
+  const auto all = quantized.candidates(random_vector(rng, dim), 1000);
+  REQUIRE(all.size() == 401);
+  CHECK(std::count_if(all.begin(), all.end(), [](const VectorSearchResult& r) {
+          return r.key == "short" && r.score == 0.0;
+        }) == 1);
+  CHECK(quantized.candidates(random_vector(rng, dim), 0).empty());
+}
+
+TEST_CASE("QuantizedVectorStore: replacement, dimension change and memory footprint",
+          "[vector][quantized]") {
+  QuantizedVectorStore store;
+  store.upsert("a", Vector{1.0f, 0.0f}, "a1");
+  store.upsert("b", Vector{0.0f, 1.0f}, "b1");
+  store.upsert("c", Vector{1.0f, 1.0f}, "c1");
+
+  store.upsert("a", Vector{0.0f, 2.0f}, "a2");      // same dimension: rewritten in place
+  store.upsert("b", Vector{1.0f, 0.0f, 0.0f}, "b2");  // other dimension: moved to a new block
+  CHECK(store.size() == 3);
+  CHECK(store.contains("b"));
+  CHECK_FALSE(store.contains("d"));
+
+  const auto results = store.candidates(Vector{0.0f, 1.0f}, 3);
+  REQUIRE(results.size() == 3);
+  CHECK(results[0].key == "a");
+  CHECK(results[0].metadata == "a2");
+  CHECK(results[1].key == "c");
+  CHECK(results[2].key == "b");
+  CHECK(results[2].score == 0.0);
+
+  // One byte per dimension (1536 is already a multiple of 64) plus a float scale and a
+  // double norm per row; FlatVectorStore spends 4 bytes per dimension.
+  QuantizedVectorStore wide;
+  std::mt19937 rng(5);
+  for (int i = 0; i < 10; ++i) {
+    wide.upsert(key_for(i), random_vector(rng, 1536), "");
+  }
+  CHECK(wide.vector_bytes() == 10 * (1536 + sizeof(float) + sizeof(double)));
+}
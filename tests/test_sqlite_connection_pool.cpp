@@ -0,0 +1,202 @@
+#include "ccmcp/storage/sqlite/sqlite_atom_repository.h"
+#include "ccmcp/storage/sqlite/sqlite_connection_pool.h"
+#include "ccmcp/storage/sqlite/sqlite_db.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <sqlite3.h>
+#include <string>
+#include <thread>
+#include <utility>
+
+using namespace ccmcp;
+using storage::sqlite::SqliteConnectionPool;
+
+namespace {
+
+// Fresh directory per test; returns the database file path inside it.
+std::string temp_db_path(const std::string& name) {
+  const auto dir = std::filesystem::temp_directory_path() / "ccmcp_test_connection_pool" / name;
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  return (dir / "ccmcp.db").string();
+}
+
+std::shared_ptr<SqliteConnectionPool> make_pool(const std::string& name, std::size_t readers) {
+  auto result = SqliteConnectionPool::open(
+      temp_db_path(name), readers,
+      storage::sqlite_tuning_for(storage::SqliteTuningProfile::kBalanced));
+  REQUIRE(result.has_value());
+  auto pool = result.value();
+  REQUIRE(pool->writer()->ensure_schema_v10().has_value());
+  return pool;
+}
+
+domain::ExperienceAtom make_atom(const std::string& id) {
+  return {core::AtomId{id}, "cpp", "Title " + id, "Claim", {"a"}, true, {}};
+}
+
+}  // namespace
+
+TEST_CASE("SqliteConnectionPool: repositories read through readers and write through the writer",
+          "[sqlite][connection-pool]") {
+  auto pool = make_pool("routing", 2);
+  CHECK(pool->reader_count() == 2);
+  CHECK(pool->idle_reader_count() == 2);
+
+  storage::sqlite::SqliteAtomRepository repo(pool);
+  repo.upsert(make_atom("atom-1"));
+  const auto atom = repo.get(core::AtomId{"atom-1"});
+  REQUIRE(atom.has_value());
+  CHECK(atom->title == "Title atom-1");
+  CHECK(repo.list_all().size() == 1);
+  CHECK(pool->idle_reader_count() == 2);  // every lease was returned
+
+  {
+    const auto reader = pool->read();
+    CHECK_FALSE(reader.is_writer());
+    CHECK(pool->idle_reader_count() == 1);
+    // Readers are query_only: writes through them fail.
+    CHECK_FALSE(reader->exec("DELETE FROM atoms").has_value());
+  }
+  CHECK(pool->idle_reader_count() == 2);
+  CHECK(repo.get(core::AtomId{"atom-1"}).has_value());
+}
+
+TEST_CASE("SqliteConnectionPool: readers run while the writer holds a transaction",
+          "[sqlite][connection-pool]") {
+  auto pool = make_pool("parallel", 2);
+  storage::sqlite::SqliteAtomRepository repo(pool);
+  repo.upsert(make_atom("atom-1"));
+
+  const auto writer = pool->write();
+  REQUIRE(writer->exec("BEGIN IMMEDIATE").has_value());
+  REQUIRE(writer->exec("UPDATE atoms SET title = 'uncommitted' WHERE atom_id = 'atom-1'")
+              .has_value());
+
+  // Two readers on other threads, each holding its lease until both are inside: they run
+  // in parallel with each other and with the open write transaction, and see the last commit.
+  std::atomic<int> inside{0};
+  const auto read_concurrently = [&] {
+    const auto reader = pool->read();
+    inside.fetch_add(1);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (inside.load() < 2 && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    auto stmt = reader->prepare("SELECT title FROM atoms WHERE atom_id = 'atom-1'");
+    std::string title;
+    if (stmt.is_valid() && sqlite3_step(stmt.get()) == SQLITE_ROW) {
+      title = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 0));
+    }
+    return std::make_pair(inside.load(), title);
+  };
+  auto first = std::async(std::launch::async, read_concurrently);
+  auto second = std::async(std::launch::async, read_concurrently);
+  const auto [first_seen, first_title] = first.get();
+  const auto [second_seen, second_title] = second.get();
+  CHECK(first_seen == 2);
+  CHECK(second_seen == 2);
+  CHECK(first_title == "Title atom-1");
+  CHECK(second_title == "Title atom-1");
+
+  // A repository read does not wait for the writer either.
+  auto get = std::async(std::launch::async, [&] { return repo.get(core::AtomId{"atom-1"}); });
+  REQUIRE(get.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+  CHECK(get.get()->title == "Title atom-1");
+
+  REQUIRE(writer->exec("COMMIT").has_value());
+  CHECK(repo.get(core::AtomId{"atom-1"})->title == "uncommitted");
+}
+
+TEST_CASE("SqliteConnectionPool: corpus_version does not wait for the write lease",
+          "[sqlite][connection-pool]") {
+  const auto path = temp_db_path("data_version");
+  auto result = SqliteConnectionPool::open(
+      path, 1, storage::sqlite_tuning_for(storage::SqliteTuningProfile::kBalanced));
+  REQUIRE(result.has_value());
+  auto pool = result.value();
+  REQUIRE(pool->writer()->ensure_schema_v10().has_value());
+  storage::sqlite::SqliteAtomRepository repo(pool);
+  repo.upsert(make_atom("atom-1"));
+  const auto v0 = repo.corpus_version();
+
+  // The writer's own commits outside the atom repository leave the version alone.
+  REQUIRE(pool->writer()->exec("UPDATE atoms SET title = 'same' WHERE 0").has_value());
+  CHECK(repo.corpus_version() == v0);
+
+  {
+    const auto writer = pool->write();
+    REQUIRE(writer->exec("BEGIN IMMEDIATE").has_value());
+    REQUIRE(writer->exec("UPDATE atoms SET title = 'pending' WHERE atom_id = 'atom-1'")
+                .has_value());
+    auto version = std::async(std::launch::async, [&] { return repo.corpus_version(); });
+    REQUIRE(version.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+    CHECK(version.get() == v0);
+    REQUIRE(writer->exec("ROLLBACK").has_value());
+  }
+
+  // A commit by another connection changes it.
+  auto other = storage::sqlite::SqliteDb::open(path);
+  REQUIRE(other.has_value());
+  REQUIRE(other.value()->exec("UPDATE atoms SET title = 'external'").has_value());
+  CHECK(repo.corpus_version() != v0);
+}
+
+TEST_CASE("SqliteConnectionPool: read() waits for a reader to be released",
+          "[sqlite][connection-pool]") {
+  auto pool = make_pool("exhausted", 1);
+  std::future<int> waiter;
+  {
+    const auto reader = pool->read();
+    CHECK(pool->idle_reader_count() == 0);
+    waiter = std::async(std::launch::async, [&] {
+      const auto second = pool->read();
+      return second->get_schema_version();
+    });
+    CHECK(waiter.wait_for(std::chrono::milliseconds(100)) == std::future_status::timeout);
+  }
+  REQUIRE(waiter.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+  CHECK(waiter.get() == 10);
+  CHECK(pool->idle_reader_count() == 1);
+}
+
+TEST_CASE("SqliteConnectionPool: a pool without readers serves reads from the writer",
+          "[sqlite][connection-pool]") {
+  auto db = storage::sqlite::SqliteDb::open(":memory:");
+  REQUIRE(db.has_value());
+  auto pool = std::make_shared<SqliteConnectionPool>(db.value());
+  CHECK(pool->reader_count() == 0);
+  {
+    const auto reader = pool->read();
+    CHECK(reader.is_writer());
+    const auto nested = pool->write();  // the writer lock is recursive
+    CHECK(&*nested == &*reader);
+  }
+
+  // A repository built from a SqliteDb uses such a pool.
+  REQUIRE(db.value()->ensure_schema_v1().has_value());
+  storage::sqlite::SqliteAtomRepository repo(db.value());
+  repo.upsert(make_atom("atom-1"));
+  CHECK(repo.get(core::AtomId{"atom-1"}).has_value());
+}
+
+TEST_CASE("SqliteConnectionPool::open rejects readers that could not run alongside the writer",
+          "[sqlite][connection-pool]") {
+  CHECK_FALSE(SqliteConnectionPool::open(":memory:", 2).has_value());
+  // Readers need WAL, so a pool without tuning (SQLite's rollback journal) has none.
+  CHECK_FALSE(SqliteConnectionPool::open(temp_db_path("untuned"), 2).has_value());
+
+  storage::SqliteTuning rollback_journal;
+  rollback_journal.journal_mode = storage::SqliteJournalMode::kDelete;
+  CHECK_FALSE(SqliteConnectionPool::open(temp_db_path("delete"), 2, rollback_journal).has_value());
+
+  // Without readers either is fine.
+  CHECK(SqliteConnectionPool::open(":memory:", 0).has_value());
+  CHECK(SqliteConnectionPool::open(temp_db_path("delete0"), 0, rollback_journal).has_value());
+}
@@ -1,11 +1,18 @@
+#include "ccmcp/storage/sqlite/sqlite_db.h"
+#include "ccmcp/vector/inmemory_embedding_index.h"
 #include "ccmcp/vector/sqlite_embedding_index.h"
+#include "ccmcp/vector/top_k.h"
+#include "ccmcp/vector/vector_math.h"
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
 #include <cstdlib>
 #include <filesystem>
+#include <optional>
+#include <span>
 #include <string>
+#include <vector>
 
 using namespace ccmcp::vector;
 
@@ -127,6 +134,55 @@ TEST_CASE("SqliteEmbeddingIndex: metadata is stored and retrieved via query", "[
   CHECK(results[0].metadata == R"({"atom_id":"atom-001","domain":"cpp"})");
 }
 
+TEST_CASE("SqliteEmbeddingIndex: query top_k agrees with InMemoryEmbeddingIndex",
+          "[vector][sqlite]") {
+  SqliteEmbeddingIndex sqlite_index(":memory:");
+  InMemoryEmbeddingIndex memory_index;
+
+  // Small integer components keep both backends' scores exact; few distinct directions
+  // produce many ties, and one short vector exercises the dimension-mismatch path.
+  for (int i = 0; i < 60; ++i) {
+    const Vector vec = {static_cast<float>(i % 4), 1.0f, static_cast<float>(i % 3)};
+    const std::string key = "key-" + std::to_string((i * 7) % 60);
+    sqlite_index.upsert(key, vec, "meta-" + key);
+    memory_index.upsert(key, vec, "meta-" + key);
+  }
+  sqlite_index.upsert("short", Vector{1.0f}, "meta-short");
+  memory_index.upsert("short", Vector{1.0f}, "meta-short");
+
+  const Vector query = {2.0f, 1.0f, 0.0f};
+  for (const size_t k : {size_t{0}, size_t{1}, size_t{9}, size_t{61}, size_t{100}}) {
+    const auto got = sqlite_index.query(query, k);
+    const auto expected = memory_index.query(query, k);
+    REQUIRE(got.size() == expected.size());
+    for (size_t i = 0; i < got.size(); ++i) {
+      CHECK(got[i].key == expected[i].key);
+      CHECK(got[i].metadata == expected[i].metadata);
+    }
+  }
+}
+
+TEST_CASE("SqliteEmbeddingIndex: query_batch returns query() results in order",
+          "[vector][sqlite]") {
+  SqliteEmbeddingIndex index(":memory:");
+  for (int i = 0; i < 30; ++i) {
+    index.upsert("key-" + std::to_string(i),
+                 {static_cast<float>(i % 5), 1.0f, static_cast<float>(i % 3)}, "m");
+  }
+  const std::vector<Vector> queries = {{1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {1.0f}};
+
+  const auto batch = index.query_batch(queries, 4);
+  REQUIRE(batch.size() == queries.size());
+  for (size_t q = 0; q < queries.size(); ++q) {
+    const auto single = index.query(queries[q], 4);
+    REQUIRE(batch[q].size() == single.size());
+    for (size_t i = 0; i < single.size(); ++i) {
+      CHECK(batch[q][i].key == single[i].key);
+      CHECK(batch[q][i].score == single[i].score);
+    }
+  }
+}
+
 TEST_CASE("SqliteEmbeddingIndex: float round-trip via BLOB is exact", "[vector][sqlite]") {
   SqliteEmbeddingIndex index(":memory:");
 
@@ -155,6 +211,139 @@ TEST_CASE("SqliteEmbeddingIndex: zero-magnitude query vector returns zero scores
   CHECK_THAT(results[0].score, Catch::Matchers::WithinAbs(0.0, 1e-9));
 }
 
+TEST_CASE("SqliteEmbeddingIndex: upsert_many matches per-record upsert", "[vector][sqlite]") {
+  SqliteEmbeddingIndex index(":memory:");
+  InMemoryEmbeddingIndex expected;
+
+  std::vector<VectorRecord> records;
+  for (int i = 0; i < 40; ++i) {
+    records.push_back({"key-" + std::to_string(i % 30),  // keys 0..9 repeat: last one wins
+                       Vector{static_cast<float>(i % 4), 1.0f, static_cast<float>(i % 3)},
+                       "meta-" + std::to_string(i)});
+  }
+  records.push_back({"short", Vector{1.0f}, "meta-short"});
+  index.upsert_many(records);
+  for (const auto& r : records) {
+    expected.upsert(r.key, r.embedding, r.metadata);
+  }
+
+  const auto got = index.query({2.0f, 1.0f, 0.0f}, 100);
+  const auto want = expected.query({2.0f, 1.0f, 0.0f}, 100);
+  REQUIRE(got.size() == 31);
+  REQUIRE(got.size() == want.size());
+  for (size_t i = 0; i < got.size(); ++i) {
+    CHECK(got[i].key == want[i].key);
+    CHECK(got[i].score == want[i].score);
+    CHECK(got[i].metadata == want[i].metadata);
+  }
+}
+
+TEST_CASE("SqliteEmbeddingIndex: failed upsert_many rolls back the whole batch",
+          "[vector][sqlite]") {
+  SqliteEmbeddingIndex index(":memory:");
+  index.upsert("kept", {1.0f, 0.0f}, "v1");
+
+  // An empty vector binds NULL into the NOT NULL blob column, failing the third row.
+  const std::vector<VectorRecord> records = {
+      {"kept", {0.0f, 1.0f}, "v2"}, {"added", {1.0f, 1.0f}, "a"}, {"broken", {}, "b"}};
+  index.upsert_many(records);
+
+  CHECK_FALSE(index.get("added").has_value());
+  const auto results = index.query({1.0f, 0.0f}, 5);
+  REQUIRE(results.size() == 1);
+  CHECK(results[0].metadata == "v1");
+
+  // The connection is usable again after the rollback.
+  index.upsert_many(std::span(records).first(2));
+  CHECK(index.query({1.0f, 0.0f}, 5).size() == 2);
+}
+
+TEST_CASE("SqliteEmbeddingIndex: int8 mirror reranks candidates to exact results",
+          "[vector][sqlite]") {
+  SqliteEmbeddingIndex exact(":memory:");
+  SqliteEmbeddingIndex quantized(":memory:", {.mode = VectorQuantization::kInt8,
+                                              .rerank_factor = 100});
+  std::vector<VectorRecord> records;
+  for (int i = 0; i < 80; ++i) {
+    records.push_back({"key-" + std::to_string(i),
+                       Vector{static_cast<float>(i % 7) - 3.0f, 0.5f, static_cast<float>(i % 5)},
+                       "meta-" + std::to_string(i)});
+  }
+  records.push_back({"short", Vector{1.0f}, "meta-short"});
+  exact.upsert_many(records);
+  quantized.upsert_many(std::span(records).first(40));
+  for (const auto& r : std::span(records).subspan(40)) {
+    quantized.upsert(r.key, r.embedding, r.metadata);
+  }
+
+  // rerank_factor · top_k covers the whole index, so the rerank sees every vector: keys,
+  // exact scores and tie order all match the float mirror.
+  const std::vector<Vector> queries = {{2.0f, 1.0f, 0.0f}, {-1.0f, 0.0f, 3.0f}, {1.0f}};
+  const auto batch = quantized.query_batch(queries, 10);
+  REQUIRE(batch.size() == queries.size());
+  for (size_t q = 0; q < queries.size(); ++q) {
+    const auto want = exact.query(queries[q], 10);
+    REQUIRE(batch[q].size() == want.size());
+    for (size_t i = 0; i < want.size(); ++i) {
+      CHECK(batch[q][i].key == want[i].key);
+      CHECK(batch[q][i].score == want[i].score);
+      CHECK(batch[q][i].metadata == want[i].metadata);
+    }
+  }
+
+  // get() returns the stored float32 vector, not its int8 codes.
+  CHECK(quantized.get("key-13") == exact.get("key-13"));
+  CHECK_FALSE(quantized.get("missing").has_value());
+  CHECK(quantized.query(queries[0], 0).empty());
+}
+
+TEST_CASE("SqliteEmbeddingIndex: int8 results carry exact scores in ranking order",
+          "[vector][sqlite]") {
+  SqliteEmbeddingIndex index(":memory:", {.mode = VectorQuantization::kInt8, .rerank_factor = 2});
+  for (int i = 0; i < 50; ++i) {
+    const float x = static_cast<float>(i) * 0.1f;
+    index.upsert("key-" + std::to_string(i), Vector{x, 1.0f - x, 0.3f}, "m");
+  }
+  const Vector query = {1.0f, 0.2f, 0.3f};
+  const auto results = index.query(query, 5);
+  REQUIRE(results.size() == 5);
+  for (size_t i = 0; i < results.size(); ++i) {
+    const auto stored = index.get(results[i].key);
+    REQUIRE(stored.has_value());
+    CHECK(results[i].score == math::cosine_similarity(query, *stored));
+    if (i > 0) {
+      CHECK(ranks_before(results[i - 1].score, results[i - 1].key, results[i].score,
+                         results[i].key));
+    }
+  }
+}
+
+TEST_CASE("SqliteEmbeddingIndex: namespaces are isolated", "[vector][sqlite]") {
+  for (const auto mode : {VectorQuantization::kNone, VectorQuantization::kInt8}) {
+    SqliteEmbeddingIndex index(":memory:", QuantizationConfig{.mode = mode});
+    index.upsert(kAtomNamespace, "id-1", Vector{1.0f, 0.0f}, "atom");
+    index.upsert(kResumeNamespace, "id-1", Vector{0.0f, 1.0f}, "resume");
+    index.upsert_many(kOpportunityNamespace, std::vector<VectorRecord>{
+                                                 {"id-2", Vector{1.0f, 1.0f}, "opp"},
+                                             });
+
+    CHECK(index.get(kAtomNamespace, "id-1") == std::optional<Vector>(Vector{1.0f, 0.0f}));
+    CHECK(index.get(kResumeNamespace, "id-1") == std::optional<Vector>(Vector{0.0f, 1.0f}));
+    CHECK_FALSE(index.get(kAtomNamespace, "id-2").has_value());
+    CHECK_FALSE(index.get("id-1").has_value());
+
+    const auto atoms = index.query(kAtomNamespace, Vector{0.0f, 1.0f}, 10);
+    REQUIRE(atoms.size() == 1);
+    CHECK(atoms[0].key == "id-1");
+    CHECK(atoms[0].metadata == "atom");
+    const auto resumes = index.query_batch(kResumeNamespace, std::vector<Vector>{{0.0f, 1.0f}}, 10);
+    REQUIRE(resumes.size() == 1);
+    REQUIRE(resumes[0].size() == 1);
+    CHECK(resumes[0][0].score == 1.0);
+    CHECK(index.query("unknown", Vector{1.0f, 0.0f}, 10).empty());
+  }
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Integration tests — opt-in via CCMCP_TEST_LANCEDB=1.
 // These use real file paths to verify persistence, path wiring, and tie-breaking
@@ -279,3 +468,91 @@ TEST_CASE("SqliteEmbeddingIndex: file-backed upsert replaces existing vector",
 
   std::filesystem::remove_all(tmp_dir);
 }
+
+TEST_CASE("SqliteEmbeddingIndex: mirror picks up commits from another connection",
+          "[vector][sqlite][integration]") {
+  if (!should_run_lancedb_tests()) {
+    SKIP("SQLite vector integration tests disabled (set CCMCP_TEST_LANCEDB=1 to enable)");
+  }
+
+  const std::filesystem::path tmp_dir =
+      std::filesystem::temp_directory_path() / "ccmcp_test_lancedb_data_version";
+  std::filesystem::remove_all(tmp_dir);
+  std::filesystem::create_directories(tmp_dir);
+  const std::string db_path = (tmp_dir / "vectors.db").string();
+
+  SqliteEmbeddingIndex reader(db_path);
+  SqliteEmbeddingIndex writer(db_path);
+  reader.upsert("atom-own", {1.0f, 0.0f}, "own");
+  CHECK(reader.query({1.0f, 0.0f}, 5).size() == 1);
+
+  // Commits by the other connection become visible on the reader's next query/get.
+  writer.upsert("atom-other", {0.0f, 1.0f}, "other");
+  writer.upsert("atom-own", {0.0f, 1.0f}, "own-v2");
+
+  const auto results = reader.query({0.0f, 1.0f}, 5);
+  REQUIRE(results.size() == 2);
+  CHECK(results[0].key == "atom-other");
+  CHECK(results[1].key == "atom-own");
+  CHECK(results[1].metadata == "own-v2");
+  const auto own = reader.get("atom-own");
+  REQUIRE(own.has_value());
+  CHECK((*own)[1] == 1.0f);
+
+  std::filesystem::remove_all(tmp_dir);
+}
+
+TEST_CASE("SqliteEmbeddingIndex: pre-namespace database is migrated on open",
+          "[vector][sqlite][integration]") {
+  if (!should_run_lancedb_tests()) {
+    SKIP("SQLite vector integration tests disabled (set CCMCP_TEST_LANCEDB=1 to enable)");
+  }
+
+  const std::filesystem::path tmp_dir =
+      std::filesystem::temp_directory_path() / "ccmcp_test_lancedb_migrate";
+  std::filesystem::remove_all(tmp_dir);
+  std::filesystem::create_directories(tmp_dir);
+  const std::string db_path = (tmp_dir / "vectors.db").string();
+
+  // The layout before namespaces: one keyspace, resume and opportunity keys prefixed.
+  {
+    auto db = ccmcp::storage::sqlite::SqliteDb::open(db_path);
+    REQUIRE(db.has_value());
+    REQUIRE(db.value()
+                ->exec(R"(
+CREATE TABLE embedding_vectors (
+  key           TEXT PRIMARY KEY,
+  vector_blob   BLOB NOT NULL,
+  dimension     INTEGER NOT NULL,
+  metadata_json TEXT NOT NULL,
+  created_at    TEXT NOT NULL DEFAULT (datetime('now'))
+);
+INSERT INTO embedding_vectors (key, vector_blob, dimension, metadata_json) VALUES
+  ('atom-1', X'0000803F00000000', 2, 'a'),
+  ('resume:r-1', X'000000000000803F', 2, 'r'),
+  ('opp:o-1', X'0000803F0000803F', 2, 'o');
+)")
+                .has_value());
+  }
+
+  {
+    SqliteEmbeddingIndex index(db_path);
+    CHECK(index.get(kAtomNamespace, "atom-1") == std::optional<Vector>(Vector{1.0f, 0.0f}));
+    CHECK(index.get(kResumeNamespace, "r-1") == std::optional<Vector>(Vector{0.0f, 1.0f}));
+    CHECK(index.get(kOpportunityNamespace, "o-1") == std::optional<Vector>(Vector{1.0f, 1.0f}));
+    CHECK_FALSE(index.get(kAtomNamespace, "resume:r-1").has_value());
+
+    const auto atoms = index.query(kAtomNamespace, Vector{0.0f, 1.0f}, 10);
+    REQUIRE(atoms.size() == 1);
+    CHECK(atoms[0].key == "atom-1");
+    CHECK(atoms[0].metadata == "a");
+  }
+
+  // Reopening the migrated database leaves it as is.
+  {
+    SqliteEmbeddingIndex index(db_path);
+    CHECK(index.query(kResumeNamespace, Vector{0.0f, 1.0f}, 10).size() == 1);
+  }
+
+  std::filesystem::remove_all(tmp_dir);
+}
@@ -4,14 +4,16 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <string>
+
 using namespace ccmcp;
 
-// Helper: open an in-memory DB with schema v6 applied (chained: v1→v6).
+// Helper: open an in-memory DB with schema v10 applied (chained: v1→v10).
 static std::shared_ptr<storage::sqlite::SqliteDb> make_db() {
   auto result = storage::sqlite::SqliteDb::open(":memory:");
   REQUIRE(result.has_value());
   auto db = result.value();
-  auto schema = db->ensure_schema_v6();
+  auto schema = db->ensure_schema_v10();
   REQUIRE(schema.has_value());
   return db;
 }
@@ -197,6 +199,105 @@ TEST_CASE("get_last_source_hash matches provider/model/prompt combination",
   CHECK(!result_c.has_value());
 }
 
+TEST_CASE("artifact state is promoted when a run completes",
+          "[indexing][sqlite][index-run-store]") {
+  auto db = make_db();
+  storage::sqlite::SqliteIndexRunStore store(db);
+
+  store.upsert_run(make_run("run-001"));
+  store.upsert_entry({"run-001", "atom", "atom-x", "hash-1", "vec-1", std::nullopt});
+  store.upsert_entry({"run-001", "resume", "resume-y", "hash-r", "vec-r", std::nullopt});
+
+  // A second run's entries stay invisible until it completes.
+  auto run = make_run("run-002", indexing::IndexRunStatus::kRunning);
+  run.completed_at = std::nullopt;
+  store.upsert_run(run);
+  store.upsert_entry({"run-002", "atom", "atom-x", "hash-2", "vec-2", std::nullopt});
+  CHECK(store.get_last_source_hash("atom-x", "atom", "deterministic-stub", "", "") == "hash-1");
+
+  run.status = indexing::IndexRunStatus::kCompleted;
+  run.completed_at = "2026-01-01T00:02:00Z";
+  store.upsert_run(run);
+  CHECK(store.get_last_source_hash("atom-x", "atom", "deterministic-stub", "", "") == "hash-2");
+
+  const auto all = store.load_artifact_states({}, "deterministic-stub", "", "");
+  REQUIRE(all.size() == 2);
+  const auto& atom = all.at(indexing::artifact_state_key("atom", "atom-x"));
+  CHECK(atom.source_hash == "hash-2");
+  CHECK(atom.vector_hash == "vec-2");
+  CHECK(atom.run_id == "run-002");
+  CHECK(all.at(indexing::artifact_state_key("resume", "resume-y")).run_id == "run-001");
+
+  const auto resumes = store.load_artifact_states({"resume"}, "deterministic-stub", "", "");
+  REQUIRE(resumes.size() == 1);
+  CHECK(resumes.contains(indexing::artifact_state_key("resume", "resume-y")));
+  CHECK(store.load_artifact_states({}, "provider-unknown", "", "").empty());
+}
+
+TEST_CASE("prune_entries keeps the most recent completed runs",
+          "[indexing][sqlite][index-run-store]") {
+  auto db = make_db();
+  storage::sqlite::SqliteIndexRunStore store(db);
+
+  for (int i = 1; i <= 3; ++i) {
+    const std::string run_id = "run-00" + std::to_string(i);
+    auto run = make_run(run_id);
+    run.completed_at = "2026-01-01T00:0" + std::to_string(i) + ":00Z";
+    store.upsert_run(run);
+    store.upsert_entry({run_id, "atom", "atom-" + std::to_string(i), "hash-" + std::to_string(i),
+                        "vec", std::nullopt});
+    store.upsert_entry({run_id, "atom", "atom-shared", "hash-shared-" + std::to_string(i), "vec",
+                        std::nullopt});
+  }
+  auto running = make_run("run-004", indexing::IndexRunStatus::kRunning);
+  running.completed_at = std::nullopt;
+  store.upsert_run(running);
+  store.upsert_entry({"run-004", "atom", "atom-4", "hash-4", "vec", std::nullopt});
+
+  CHECK(store.prune_entries(1) == 4);
+  CHECK(store.get_entries_for_run("run-001").empty());
+  CHECK(store.get_entries_for_run("run-002").empty());
+  CHECK(store.get_entries_for_run("run-003").size() == 2);
+  CHECK(store.get_entries_for_run("run-004").size() == 1);  // not completed: kept
+  CHECK(store.list_runs().size() == 4);                      // runs themselves are kept
+  CHECK(store.prune_entries(1) == 0);
+
+  // Drift detection still sees artifacts last indexed by a pruned run.
+  CHECK(store.get_last_source_hash("atom-1", "atom", "deterministic-stub", "", "") == "hash-1");
+  CHECK(store.get_last_source_hash("atom-shared", "atom", "deterministic-stub", "", "") ==
+        "hash-shared-3");
+}
+
+TEST_CASE("schema v10 backfills artifact state from completed runs",
+          "[indexing][sqlite][index-run-store]") {
+  auto result = storage::sqlite::SqliteDb::open(":memory:");
+  REQUIRE(result.has_value());
+  auto db = result.value();
+  REQUIRE(db->ensure_schema_v9().has_value());
+
+  // Runs recorded before v10: the later-completed run wins regardless of run_id order.
+  auto newer = make_run("run-a");
+  newer.completed_at = "2026-01-01T00:05:00Z";
+  auto older = make_run("run-b");
+  older.completed_at = "2026-01-01T00:01:00Z";
+  auto running = make_run("run-c", indexing::IndexRunStatus::kRunning);
+  running.completed_at = std::nullopt;
+  {
+    storage::sqlite::SqliteIndexRunStore store(db);
+    for (const auto& run : {newer, older, running}) {
+      store.upsert_run(run);
+      store.upsert_entry(
+          {run.run_id, "atom", "atom-x", "hash-" + run.run_id, "vec", std::nullopt});
+    }
+  }
+
+  REQUIRE(db->ensure_schema_v10().has_value());
+  storage::sqlite::SqliteIndexRunStore store(db);
+  CHECK(store.get_last_source_hash("atom-x", "atom", "deterministic-stub", "", "") ==
+        "hash-run-a");
+  CHECK(store.load_artifact_states({"atom"}, "deterministic-stub", "", "").size() == 1);
+}
+
 // ---------------------------------------------------------------------------
 // v0.4 Slice 1 — Monotonic counter tests
 // ---------------------------------------------------------------------------
@@ -0,0 +1,40 @@
+#include "ccmcp/storage/sqlite/sqlite_json.h"
+
+#include <nlohmann/json.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <vector>
+
+using ccmcp::storage::sqlite::parse_string_array;
+
+TEST_CASE("parse_string_array: plain arrays", "[sqlite][json]") {
+  CHECK(parse_string_array("[]").empty());
+  CHECK(parse_string_array(" [ ] ").empty());
+  CHECK(parse_string_array(R"(["cpp"])") == std::vector<std::string>{"cpp"});
+  CHECK(parse_string_array(R"(["a","","b c"])") == std::vector<std::string>{"a", "", "b c"});
+  CHECK(parse_string_array("[ \"a\" ,\n\"b\" ]") == std::vector<std::string>{"a", "b"});
+  CHECK(parse_string_array("[\"caf\xC3\xA9\"]") == std::vector<std::string>{"caf\xC3\xA9"});
+}
+
+TEST_CASE("parse_string_array: round-trips nlohmann::json::dump output", "[sqlite][json]") {
+  const std::vector<std::vector<std::string>> cases = {
+      {},
+      {"systems", "latency"},
+      {"quote\"d", "back\\slash", "new\nline", "tab\t", std::string("nul\0x", 5)},
+      {"\x01 control", "unicode \xE2\x9C\x93"},
+  };
+  for (const auto& values : cases) {
+    CHECK(parse_string_array(nlohmann::json(values).dump()) == values);
+  }
+}
+
+TEST_CASE("parse_string_array: malformed input throws like nlohmann", "[sqlite][json]") {
+  CHECK_THROWS_AS(parse_string_array(""), nlohmann::json::exception);
+  CHECK_THROWS_AS(parse_string_array(R"(["a")"), nlohmann::json::exception);
+  CHECK_THROWS_AS(parse_string_array(R"(["a",])"), nlohmann::json::exception);
+  CHECK_THROWS_AS(parse_string_array(R"(["a"] x)"), nlohmann::json::exception);
+  CHECK_THROWS_AS(parse_string_array(R"([1])"), nlohmann::json::exception);
+  CHECK_THROWS_AS(parse_string_array(R"({"a":"b"})"), nlohmann::json::exception);
+}
@@ -3,6 +3,9 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <string>
+#include <vector>
+
 using namespace ccmcp;
 
 TEST_CASE("SqliteOpportunityRepository roundtrip with requirements", "[sqlite][repository]") {
@@ -107,3 +110,87 @@ TEST_CASE("SqliteOpportunityRepository list_all orders deterministically", "[sql
   CHECK(all[1].opportunity_id.value == "opp-002");
   CHECK(all[2].opportunity_id.value == "opp-003");
 }
+
+TEST_CASE("SqliteOpportunityRepository list_all hydrates requirements from one join",
+          "[sqlite][repository]") {
+  auto db_result = storage::sqlite::SqliteDb::open(":memory:");
+  REQUIRE(db_result.has_value());
+  auto db = db_result.value();
+  REQUIRE(db->ensure_schema_v1().has_value());
+
+  storage::sqlite::SqliteOpportunityRepository repo(db);
+
+  // Interleave opportunities with and without requirements; more than 10 requirements so that
+  // idx order (not text order) is what keeps them in sequence.
+  domain::Opportunity many{core::OpportunityId{"opp-002"}, "B", "Role", {}, ""};
+  for (int i = 0; i < 12; ++i) {
+    many.requirements.push_back({"Req " + std::to_string(i), {"t", "a\"quoted\""}, i % 2 == 0});
+  }
+  repo.upsert({core::OpportunityId{"opp-003"}, "C", "Role", {}, ""});
+  repo.upsert(many);
+  repo.upsert({core::OpportunityId{"opp-001"}, "A", "Role", {{"Only", {}, false}}, "src"});
+  repo.upsert({core::OpportunityId{"opp-004"}, "D", "Role", {}, ""});
+
+  const auto all = repo.list_all();
+  REQUIRE(all.size() == 4);
+  CHECK(all[0].opportunity_id.value == "opp-001");
+  REQUIRE(all[0].requirements.size() == 1);
+  CHECK(all[0].requirements[0].tags.empty());
+  CHECK_FALSE(all[0].requirements[0].required);
+  CHECK(all[0].source == "src");
+
+  REQUIRE(all[1].requirements.size() == 12);
+  for (std::size_t i = 0; i < 12; ++i) {
+    CHECK(all[1].requirements[i].text == "Req " + std::to_string(i));
+    CHECK(all[1].requirements[i].tags == std::vector<std::string>{"t", "a\"quoted\""});
+    CHECK(all[1].requirements[i].required == (i % 2 == 0));
+  }
+  CHECK(all[2].requirements.empty());
+  CHECK(all[3].company == "D");
+
+  // get() goes through the same path.
+  const auto single = repo.get(core::OpportunityId{"opp-002"});
+  REQUIRE(single.has_value());
+  CHECK(single->requirements.size() == 12);
+  CHECK(repo.get(core::OpportunityId{"opp-003"})->requirements.empty());
+  CHECK_FALSE(repo.get(core::OpportunityId{"missing"}).has_value());
+}
+
+TEST_CASE("SqliteOpportunityRepository get_many aligns results with the requested ids",
+          "[sqlite][repository]") {
+  auto db_result = storage::sqlite::SqliteDb::open(":memory:");
+  REQUIRE(db_result.has_value());
+  auto db = db_result.value();
+  REQUIRE(db->ensure_schema_v1().has_value());
+
+  storage::sqlite::SqliteOpportunityRepository repo(db);
+  for (int i = 0; i < 150; ++i) {
+    repo.upsert({core::OpportunityId{"opp-" + std::to_string(i)},
+                 "Co",
+                 "Role " + std::to_string(i),
+                 {{"Req", {"tag"}, true}},
+                 ""});
+  }
+
+  // More distinct ids than one statement binds, in non-sorted order, with a repeat and
+  // a missing id.
+  std::vector<core::OpportunityId> ids;
+  for (int i = 149; i >= 0; --i) {
+    ids.push_back(core::OpportunityId{"opp-" + std::to_string(i)});
+  }
+  ids.push_back(core::OpportunityId{"missing"});
+  ids.push_back(core::OpportunityId{"opp-7"});
+
+  const auto found = repo.get_many(ids);
+  REQUIRE(found.size() == ids.size());
+  for (std::size_t i = 0; i < 150; ++i) {
+    REQUIRE(found[i].has_value());
+    CHECK(found[i]->opportunity_id == ids[i]);
+    CHECK(found[i]->requirements.size() == 1);
+  }
+  CHECK_FALSE(found[150].has_value());
+  REQUIRE(found[151].has_value());
+  CHECK(found[151]->role_title == "Role 7");
+
+  CHECK(repo.get_many({}).empty());
+}
@@ -0,0 +1,129 @@
+#include "ccmcp/storage/sqlite/sqlite_atom_repository.h"
+#include "ccmcp/storage/sqlite/sqlite_db.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sqlite3.h>
+#include <string>
+
+using namespace ccmcp;
+
+namespace {
+
+std::shared_ptr<storage::sqlite::SqliteDb> make_db() {
+  auto result = storage::sqlite::SqliteDb::open(":memory:");
+  REQUIRE(result.has_value());
+  auto db = result.value();
+  REQUIRE(db->exec("CREATE TABLE kv (k TEXT PRIMARY KEY, v INTEGER)").has_value());
+  return db;
+}
+
+constexpr const char* kInsertSql = "INSERT INTO kv (k, v) VALUES (?, ?)";
+constexpr const char* kSelectSql = "SELECT v FROM kv WHERE k = ?";
+
+}  // namespace
+
+TEST_CASE("SqliteDb::prepare reuses one statement per SQL text", "[sqlite][statement-cache]") {
+  auto db = make_db();
+  CHECK(db->cached_statement_count() == 0);
+
+  sqlite3_stmt* first = nullptr;
+  {
+    auto stmt = db->prepare(kInsertSql);
+    REQUIRE(stmt.is_valid());
+    first = stmt.get();
+    sqlite3_bind_text(stmt.get(), 1, "a", -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(stmt.get(), 2, 1);
+    CHECK(sqlite3_step(stmt.get()) == SQLITE_DONE);
+  }
+  CHECK(db->cached_statement_count() == 1);
+
+  // The returned statement is reset with its bindings cleared: an unbound step inserts NULLs.
+  {
+    auto stmt = db->prepare(kInsertSql);
+    CHECK(stmt.get() == first);
+    CHECK(db->cached_statement_count() == 0);
+    CHECK(sqlite3_step(stmt.get()) == SQLITE_DONE);
+  }
+  {
+    auto stmt = db->prepare("SELECT COUNT(*) FROM kv WHERE k IS NULL AND v IS NULL");
+    REQUIRE(sqlite3_step(stmt.get()) == SQLITE_ROW);
+    CHECK(sqlite3_column_int(stmt.get(), 0) == 1);
+  }
+  CHECK(db->cached_statement_count() == 2);
+}
+
+TEST_CASE("SqliteDb::prepare hands nested leases of one SQL distinct statements",
+          "[sqlite][statement-cache]") {
+  auto db = make_db();
+  REQUIRE(db->exec("INSERT INTO kv VALUES ('a', 1), ('b', 2)").has_value());
+
+  auto outer = db->prepare(kSelectSql);
+  sqlite3_bind_text(outer.get(), 1, "a", -1, SQLITE_TRANSIENT);
+  REQUIRE(sqlite3_step(outer.get()) == SQLITE_ROW);
+  {
+    auto inner = db->prepare(kSelectSql);
+    REQUIRE(inner.is_valid());
+    CHECK(inner.get() != outer.get());
+    sqlite3_bind_text(inner.get(), 1, "b", -1, SQLITE_TRANSIENT);
+    REQUIRE(sqlite3_step(inner.get()) == SQLITE_ROW);
+    CHECK(sqlite3_column_int(inner.get(), 0) == 2);
+  }
+  CHECK(sqlite3_column_int(outer.get(), 0) == 1);  // the outer cursor is undisturbed
+
+  // Within a lease, reset() rewinds and clears bindings for the next row.
+  outer.reset();
+  sqlite3_bind_text(outer.get(), 1, "b", -1, SQLITE_TRANSIENT);
+  REQUIRE(sqlite3_step(outer.get()) == SQLITE_ROW);
+  CHECK(sqlite3_column_int(outer.get(), 0) == 2);
+}
+
+TEST_CASE("SqliteDb::prepare reports errors and honours the capacity",
+          "[sqlite][statement-cache]") {
+  auto db = make_db();
+  {
+    auto bad = db->prepare("SELECT * FROM missing_table");
+    CHECK_FALSE(bad.is_valid());
+    CHECK(bad.error().find("missing_table") != std::string::npos);
+  }
+  CHECK(db->cached_statement_count() == 0);
+
+  db->set_statement_cache_capacity(0);
+  {
+    auto stmt = db->prepare(kSelectSql);
+    CHECK(stmt.is_valid());
+  }
+  CHECK(db->cached_statement_count() == 0);  // caching disabled: finalized on release
+
+  db->set_statement_cache_capacity(1);
+  { auto stmt = db->prepare(kSelectSql); }
+  { auto stmt = db->prepare(kInsertSql); }  // a second text beyond the capacity
+  CHECK(db->cached_statement_count() == 1);
+}
+
+TEST_CASE("SQLite repositories run on cached statements", "[sqlite][statement-cache]") {
+  auto result = storage::sqlite::SqliteDb::open(":memory:");
+  REQUIRE(result.has_value());
+  auto db = result.value();
+  REQUIRE(db->ensure_schema_v1().has_value());
+  storage::sqlite::SqliteAtomRepository repo(db);
+
+  for (int i = 0; i < 3; ++i) {
+    const std::string id = "atom-" + std::to_string(i);
+    repo.upsert({core::AtomId{id}, "cpp", "Title", "Claim " + id, {"tag"}, true, {}});
+  }
+  const std::size_t cached = db->cached_statement_count();
+  CHECK(cached > 0);
+
+  for (int i = 0; i < 3; ++i) {
+    const auto atom = repo.get(core::AtomId{"atom-" + std::to_string(i)});
+    REQUIRE(atom.has_value());
+    CHECK(atom->claim == "Claim atom-" + std::to_string(i));
+  }
+  CHECK(repo.list_all().size() == 3);
+  const std::size_t after_reads = db->cached_statement_count();
+  for (int i = 0; i < 3; ++i) {
+    CHECK(repo.get(core::AtomId{"atom-" + std::to_string(i)}).has_value());
+  }
+  CHECK(db->cached_statement_count() == after_reads);  // repeated calls prepare nothing new
+}
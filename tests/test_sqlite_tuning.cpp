@@ -0,0 +1,158 @@
+#include "ccmcp/storage/sqlite/sqlite_db.h"
+#include "ccmcp/storage/sqlite_tuning.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <sqlite3.h>
+#include <string>
+
+using namespace ccmcp::storage;
+
+namespace {
+
+// Fresh directory per test; returns the database file path inside it.
+std::string temp_db_path(const std::string& name) {
+  const auto dir = std::filesystem::temp_directory_path() / "ccmcp_test_sqlite_tuning" / name;
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  return (dir / "ccmcp.db").string();
+}
+
+// Reads a PRAGMA's current value as text.
+std::string pragma_value(sqlite::SqliteDb& db, const std::string& pragma) {
+  auto stmt = db.prepare("PRAGMA " + pragma);
+  REQUIRE(stmt.is_valid());
+  REQUIRE(sqlite3_step(stmt.get()) == SQLITE_ROW);
+  const auto* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 0));
+  return text != nullptr ? std::string(text) : std::string();
+}
+
+}  // namespace
+
+TEST_CASE("SqliteTuning: profiles differ only where documented", "[sqlite][tuning]") {
+  const SqliteTuning balanced = sqlite_tuning_for(SqliteTuningProfile::kBalanced);
+  CHECK(balanced.journal_mode == SqliteJournalMode::kWal);
+  CHECK(balanced.synchronous == SqliteSynchronous::kNormal);
+  CHECK(balanced.mmap_size == std::size_t{256} << 20);
+  CHECK(balanced.temp_store == SqliteTempStore::kMemory);
+  // A default-constructed SqliteTuning holds SQLite's own defaults, not a profile.
+  const SqliteTuning defaults;
+  CHECK(defaults.journal_mode == SqliteJournalMode::kDelete);
+  CHECK(defaults.synchronous == SqliteSynchronous::kFull);
+  CHECK(defaults.mmap_size == 0);
+  CHECK(defaults.busy_timeout_ms == 0);
+  CHECK(SqliteTuningConfig{}.profile == SqliteTuningProfile::kDurable);
+
+  const SqliteTuning durable = sqlite_tuning_for(SqliteTuningProfile::kDurable);
+  CHECK(durable.journal_mode == SqliteJournalMode::kWal);
+  CHECK(durable.synchronous == SqliteSynchronous::kFull);
+  CHECK(durable.mmap_size == 0);
+
+  const SqliteTuning bulk = sqlite_tuning_for(SqliteTuningProfile::kBulkLoad);
+  CHECK(bulk.synchronous == SqliteSynchronous::kOff);
+  CHECK(bulk.mmap_size > balanced.mmap_size);
+  CHECK(bulk.cache_size_kib > balanced.cache_size_kib);
+  CHECK(bulk.wal_autocheckpoint > balanced.wal_autocheckpoint);
+}
+
+TEST_CASE("SqliteTuning: resolve applies overrides on top of the profile", "[sqlite][tuning]") {
+  SqliteTuningConfig config;
+  config.profile = SqliteTuningProfile::kDurable;
+  CHECK(sqlite_tuning_pragmas(resolve(config)) ==
+        sqlite_tuning_pragmas(sqlite_tuning_for(SqliteTuningProfile::kDurable)));
+
+  config.journal_mode = SqliteJournalMode::kTruncate;
+  config.busy_timeout_ms = 250;
+  const SqliteTuning tuning = resolve(config);
+  CHECK(tuning.journal_mode == SqliteJournalMode::kTruncate);
+  CHECK(tuning.busy_timeout_ms == 250);
+  CHECK(tuning.synchronous == SqliteSynchronous::kFull);  // still the profile's
+
+  const std::string pragmas = sqlite_tuning_pragmas(tuning);
+  CHECK(pragmas.rfind("PRAGMA busy_timeout = 250;\n", 0) == 0);  // applied first
+  CHECK(pragmas.find("PRAGMA journal_mode = truncate;\n") != std::string::npos);
+  CHECK(pragmas.find("PRAGMA cache_size = -2000;\n") != std::string::npos);
+}
+
+TEST_CASE("SqliteTuning: parse and to_string round-trip", "[sqlite][tuning]") {
+  for (const auto p : {SqliteTuningProfile::kDurable, SqliteTuningProfile::kBalanced,
+                       SqliteTuningProfile::kBulkLoad}) {
+    CHECK(parse_sqlite_tuning_profile(std::string(to_string(p))) == p);
+  }
+  for (const auto m : {SqliteJournalMode::kDelete, SqliteJournalMode::kTruncate,
+                       SqliteJournalMode::kPersist, SqliteJournalMode::kMemory,
+                       SqliteJournalMode::kWal}) {
+    CHECK(parse_sqlite_journal_mode(std::string(to_string(m))) == m);
+  }
+  for (const auto s : {SqliteSynchronous::kOff, SqliteSynchronous::kNormal,
+                       SqliteSynchronous::kFull, SqliteSynchronous::kExtra}) {
+    CHECK(parse_sqlite_synchronous(std::string(to_string(s))) == s);
+  }
+  for (const auto t : {SqliteTempStore::kDefault, SqliteTempStore::kFile,
+                       SqliteTempStore::kMemory}) {
+    CHECK(parse_sqlite_temp_store(std::string(to_string(t))) == t);
+  }
+  CHECK_FALSE(parse_sqlite_tuning_profile("").has_value());
+  CHECK_FALSE(parse_sqlite_tuning_profile("Balanced").has_value());
+  CHECK_FALSE(parse_sqlite_journal_mode("off").has_value());  // never offered
+  CHECK_FALSE(parse_sqlite_synchronous("1").has_value());
+  CHECK_FALSE(parse_sqlite_temp_store("ram").has_value());
+}
+
+TEST_CASE("SqliteDb::open applies the tuning to a file database", "[sqlite][tuning]") {
+  SqliteTuningConfig config;
+  config.profile = SqliteTuningProfile::kBulkLoad;
+  config.busy_timeout_ms = 1234;
+  config.cache_size_kib = 4096;
+  config.wal_autocheckpoint = 500;
+  auto result = sqlite::SqliteDb::open(temp_db_path("bulk"), resolve(config));
+  REQUIRE(result.has_value());
+  auto& db = *result.value();
+
+  CHECK(pragma_value(db, "journal_mode") == "wal");
+  CHECK(pragma_value(db, "synchronous") == "0");  // off
+  CHECK(pragma_value(db, "cache_size") == "-4096");
+  CHECK(pragma_value(db, "temp_store") == "2");  // memory
+  CHECK(pragma_value(db, "busy_timeout") == "1234");
+  CHECK(pragma_value(db, "wal_autocheckpoint") == "500");
+  CHECK(pragma_value(db, "foreign_keys") == "1");  // set by open() regardless of tuning
+}
+
+TEST_CASE("SqliteDb::open: durable profile and in-memory databases", "[sqlite][tuning]") {
+  auto durable = sqlite::SqliteDb::open(temp_db_path("durable"),
+                                        sqlite_tuning_for(SqliteTuningProfile::kDurable));
+  REQUIRE(durable.has_value());
+  CHECK(pragma_value(*durable.value(), "journal_mode") == "wal");
+  CHECK(pragma_value(*durable.value(), "synchronous") == "2");  // full
+  CHECK(pragma_value(*durable.value(), "mmap_size") == "0");
+
+  // In-memory databases keep journal_mode=memory whatever the tuning asks for.
+  auto memory = sqlite::SqliteDb::open(":memory:",
+                                       sqlite_tuning_for(SqliteTuningProfile::kBalanced));
+  REQUIRE(memory.has_value());
+  CHECK(pragma_value(*memory.value(), "journal_mode") == "memory");
+  CHECK(pragma_value(*memory.value(), "synchronous") == "1");  // normal
+}
+
+TEST_CASE("SqliteDb::open without tuning keeps SQLite's defaults", "[sqlite][tuning]") {
+  const std::string path = temp_db_path("untuned");
+  {
+    auto fresh = sqlite::SqliteDb::open(path);
+    REQUIRE(fresh.has_value());
+    CHECK(pragma_value(*fresh.value(), "journal_mode") == "delete");
+    CHECK(pragma_value(*fresh.value(), "synchronous") == "2");  // full
+    CHECK(pragma_value(*fresh.value(), "mmap_size") == "0");
+  }
+
+  // A file an app switched to WAL stays WAL when reopened without tuning.
+  {
+    auto tuned = sqlite::SqliteDb::open(path, sqlite_tuning_for(SqliteTuningProfile::kBalanced));
+    REQUIRE(tuned.has_value());
+    CHECK(pragma_value(*tuned.value(), "journal_mode") == "wal");
+  }
+  auto reopened = sqlite::SqliteDb::open(path);
+  REQUIRE(reopened.has_value());
+  CHECK(pragma_value(*reopened.value(), "journal_mode") == "wal");
+  CHECK(pragma_value(*reopened.value(), "synchronous") == "2");  // full
+}
@@ -65,6 +65,53 @@ TEST_CASE("validate_mcp_server_config: valid redis + kSqlite without path return
   CHECK_FALSE(error.empty());
 }
 
+// ── kHnsw path constraint ───────────────────────────────────────────────────
+
+TEST_CASE("validate_mcp_server_config: kHnsw requires a vector db path", "[startup][config]") {
+  McpServerConfig config;
+  config.redis_uri = "tcp://127.0.0.1:6379";
+  config.vector_backend = VectorBackend::kHnsw;
+
+  config.vector_db_path = std::nullopt;
+  CHECK_FALSE(validate_mcp_server_config(config).empty());
+
+  config.vector_db_path = "/tmp/vectors";
+  CHECK(validate_mcp_server_config(config).empty());
+}
+
+// ── kMmap path constraint ───────────────────────────────────────────────────
+
+TEST_CASE("validate_mcp_server_config: kMmap requires a vector db path", "[startup][config]") {
+  McpServerConfig config;
+  config.redis_uri = "tcp://127.0.0.1:6379";
+  config.vector_backend = VectorBackend::kMmap;
+
+  config.vector_db_path = std::nullopt;
+  CHECK_FALSE(validate_mcp_server_config(config).empty());
+
+  config.vector_db_path = "/tmp/vectors";
+  CHECK(validate_mcp_server_config(config).empty());
+}
+
+// ── Quantization constraint ─────────────────────────────────────────────────
+
+TEST_CASE("validate_mcp_server_config: int8 quantization requires the sqlite backend",
+          "[startup][config]") {
+  McpServerConfig config;
+  config.redis_uri = "tcp://127.0.0.1:6379";
+  config.vector_db_path = "/tmp/vectors";
+  config.quantization.mode = ccmcp::vector::VectorQuantization::kInt8;
+
+  config.vector_backend = VectorBackend::kSqlite;
+  CHECK(validate_mcp_server_config(config).empty());
+
+  for (const auto backend :
+       {VectorBackend::kInMemory, VectorBackend::kHnsw, VectorBackend::kMmap}) {
+    config.vector_backend = backend;
+    CHECK_FALSE(validate_mcp_server_config(config).empty());
+  }
+}
+
 // ── kLanceDb constraint (pre-existing) ─────────────────────────────────────
 
 TEST_CASE("validate_mcp_server_config: kLanceDb returns error", "[startup][config]") {
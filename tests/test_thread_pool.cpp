@@ -0,0 +1,89 @@
+#include "ccmcp/core/thread_pool.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace ccmcp;
+
+TEST_CASE("ThreadPool parallel_for visits every index exactly once", "[core][thread_pool]") {
+  core::ThreadPool pool(4);
+  REQUIRE(pool.size() == 4);
+
+  std::vector<std::atomic<int>> hits(10'000);
+  pool.parallel_for(hits.size(), 37, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      hits[i].fetch_add(1);
+    }
+  });
+
+  for (const auto& h : hits) {
+    REQUIRE(h.load() == 1);
+  }
+}
+
+TEST_CASE("ThreadPool parallel_for handles empty and single-chunk ranges", "[core][thread_pool]") {
+  core::ThreadPool pool(2);
+
+  int calls = 0;
+  pool.parallel_for(0, 8, [&](std::size_t, std::size_t) { ++calls; });
+  CHECK(calls == 0);
+
+  pool.parallel_for(5, 8, [&](std::size_t begin, std::size_t end) {
+    ++calls;
+    CHECK(begin == 0);
+    CHECK(end == 5);
+  });
+  CHECK(calls == 1);
+}
+
+TEST_CASE("ThreadPool parallel_for rethrows the first task exception", "[core][thread_pool]") {
+  core::ThreadPool pool(3);
+  std::atomic<int> completed{0};
+
+  CHECK_THROWS_AS(pool.parallel_for(64, 1,
+                                    [&](std::size_t begin, std::size_t) {
+                                      if (begin == 13) {
+                                        throw std::runtime_error("boom");
+                                      }
+                                      completed.fetch_add(1);
+                                    }),
+                  std::runtime_error);
+  // All other chunks still ran to completion before the exception surfaced.
+  CHECK(completed.load() == 63);
+}
+
+TEST_CASE("ThreadPool supports nested parallel_for without deadlock", "[core][thread_pool]") {
+  core::ThreadPool pool(2);
+  std::atomic<std::size_t> total{0};
+
+  pool.parallel_for(8, 1, [&](std::size_t, std::size_t) {
+    pool.parallel_for(100, 10, [&](std::size_t begin, std::size_t end) {
+      total.fetch_add(end - begin);
+    });
+  });
+
+  CHECK(total.load() == 800);
+}
+
+TEST_CASE("ThreadPool parallel_for waits for chunks still running on workers",
+          "[core][thread_pool]") {
+  core::ThreadPool pool(3);
+  const auto caller = std::this_thread::get_id();
+  std::atomic<int> finished{0};
+
+  // Chunks picked up by workers outlast the caller's own, so the caller runs out of queued
+  // work and must block until they finish.
+  pool.parallel_for(4, 1, [&](std::size_t, std::size_t) {
+    if (std::this_thread::get_id() != caller) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    finished.fetch_add(1);
+  });
+  CHECK(finished.load() == 4);
+}
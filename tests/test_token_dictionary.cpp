@@ -0,0 +1,100 @@
+#include "ccmcp/matching/token_dictionary.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ccmcp;
+
+TEST_CASE("TokenDictionary interns tokens to stable dense ids", "[matching][token_dictionary]") {
+  matching::TokenDictionary dict;
+
+  const auto a = dict.intern("kafka");
+  const auto b = dict.intern("rust");
+  const auto a_again = dict.intern("kafka");
+
+  CHECK(a == 0);
+  CHECK(b == 1);
+  CHECK(a_again == a);
+  CHECK(dict.size() == 2);
+  CHECK(dict.token(a) == "kafka");
+  CHECK(dict.token(b) == "rust");
+  CHECK(dict.find("rust") == b);
+  CHECK_FALSE(dict.find("golang").has_value());
+  CHECK(dict.size() == 2);  // find() must not intern
+}
+
+TEST_CASE("tokenize_to_ids produces sorted deduplicated id sets", "[matching][token_dictionary]") {
+  matching::TokenDictionary dict;
+
+  // "zeta" is interned first, so its id is smaller than "alpha" despite sorting after it.
+  const auto ids = matching::tokenize_to_ids("Zeta alpha ZETA beta-alpha a", dict);
+
+  REQUIRE(ids.size() == 3);  // "a" is below the minimum token length
+  CHECK(std::is_sorted(ids.begin(), ids.end()));
+  CHECK(dict.token(ids[0]) == "zeta");
+  CHECK(dict.token(ids[1]) == "alpha");
+  CHECK(dict.token(ids[2]) == "beta");
+}
+
+TEST_CASE("lookup_token_ids counts unknown tokens without interning them",
+          "[matching][token_dictionary]") {
+  matching::TokenDictionary dict;
+  const auto kafka = dict.intern("kafka");
+  const auto rust = dict.intern("rust");
+
+  const auto ids = matching::lookup_token_ids("Rust, Kafka and Zig and rust", dict);
+
+  CHECK(ids.known == matching::TokenIdSet{kafka, rust});
+  CHECK(ids.unknown == 2);  // "and", "zig": each distinct token counted once
+  CHECK(ids.size() == 4);
+  CHECK(dict.size() == 2);
+  CHECK(matching::lookup_token_ids("a", dict).empty());
+}
+
+TEST_CASE("Token set operations match string set semantics", "[matching][token_dictionary]") {
+  matching::TokenDictionary dict;
+
+  const auto lhs = matching::tokenize_to_ids("zeta kafka rust", dict);
+  const auto rhs = matching::intern_tokens({"rust", "zeta", "go"}, dict);
+
+  CHECK(matching::intersection_size(lhs, rhs) == 2);
+  CHECK(matching::merge_token_sets(lhs, rhs).size() == 4);
+
+  // Evidence is emitted lexicographically, independent of interning order.
+  const auto evidence = matching::to_sorted_strings(matching::intersect(lhs, rhs), dict);
+  CHECK(evidence == std::vector<std::string>{"rust", "zeta"});
+
+  CHECK(matching::intersection_size(lhs, {}) == 0);
+  CHECK(matching::intersect({}, rhs).empty());
+}
+
+TEST_CASE("TokenDictionary concurrent interning is consistent", "[matching][token_dictionary]") {
+  matching::TokenDictionary dict;
+  const std::vector<std::string> words = {"alpha", "beta", "gamma", "delta", "epsilon"};
+
+  std::vector<std::vector<matching::TokenId>> per_thread(4);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < per_thread.size(); ++t) {
+    threads.emplace_back([&, t]() {
+      for (int round = 0; round < 100; ++round) {
+        for (const auto& w : words) {
+          per_thread[t].push_back(dict.intern(w));
+        }
+      }
+    });
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+
+  CHECK(dict.size() == words.size());
+  for (const auto& ids : per_thread) {
+    for (size_t i = 0; i < ids.size(); ++i) {
+      CHECK(dict.token(ids[i]) == words[i % words.size()]);
+    }
+  }
+}
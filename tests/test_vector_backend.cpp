@@ -1,13 +1,19 @@
 #include "ccmcp/vector/vector_backend.h"
+#include "ccmcp/vector/vector_quantization.h"
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <optional>
+#include <string>
+
 using namespace ccmcp::vector;
 
 TEST_CASE("parse_vector_backend: known flag values map to correct enumerators",
           "[vector][vector_backend]") {
   CHECK(parse_vector_backend("inmemory") == std::optional{VectorBackend::kInMemory});
   CHECK(parse_vector_backend("sqlite") == std::optional{VectorBackend::kSqlite});
+  CHECK(parse_vector_backend("hnsw") == std::optional{VectorBackend::kHnsw});
+  CHECK(parse_vector_backend("mmap") == std::optional{VectorBackend::kMmap});
   CHECK(parse_vector_backend("lancedb") == std::optional{VectorBackend::kLanceDb});
 }
 
@@ -19,6 +25,8 @@ TEST_CASE("parse_vector_backend: unrecognised values return nullopt", "[vector][
   CHECK(!parse_vector_backend("InMemory").has_value());  // case-sensitive
   CHECK(!parse_vector_backend("SQLite").has_value());    // case-sensitive
   CHECK(!parse_vector_backend("LanceDB").has_value());   // case-sensitive
+  CHECK(!parse_vector_backend("HNSW").has_value());      // case-sensitive
+  CHECK(!parse_vector_backend("MMAP").has_value());      // case-sensitive
   CHECK(!parse_vector_backend("lancedb2").has_value());
 }
 
@@ -26,16 +34,31 @@ TEST_CASE("to_string: known enumerators return canonical flag strings",
           "[vector][vector_backend]") {
   CHECK(to_string(VectorBackend::kInMemory) == "inmemory");
   CHECK(to_string(VectorBackend::kSqlite) == "sqlite");
+  CHECK(to_string(VectorBackend::kHnsw) == "hnsw");
+  CHECK(to_string(VectorBackend::kMmap) == "mmap");
   CHECK(to_string(VectorBackend::kLanceDb) == "lancedb");
 }
 
 TEST_CASE("to_string and parse_vector_backend roundtrip for all enumerators",
           "[vector][vector_backend]") {
   // Every enumerator must round-trip through to_string -> parse_vector_backend.
-  for (auto b : {VectorBackend::kInMemory, VectorBackend::kSqlite, VectorBackend::kLanceDb}) {
+  for (auto b : {VectorBackend::kInMemory, VectorBackend::kSqlite, VectorBackend::kHnsw,
+                 VectorBackend::kMmap, VectorBackend::kLanceDb}) {
     const std::string s{to_string(b)};
     const auto parsed = parse_vector_backend(s);
     REQUIRE(parsed.has_value());
     CHECK(parsed.value() == b);
   }
 }
+
+TEST_CASE("parse_vector_quantization: flag values round-trip; others are rejected",
+          "[vector][vector_backend]") {
+  for (auto q : {VectorQuantization::kNone, VectorQuantization::kInt8}) {
+    const std::string s{to_string(q)};
+    CHECK(parse_vector_quantization(s) == std::optional{q});
+  }
+  CHECK(to_string(VectorQuantization::kInt8) == "int8");
+  CHECK(!parse_vector_quantization("").has_value());
+  CHECK(!parse_vector_quantization("INT8").has_value());  // case-sensitive
+  CHECK(!parse_vector_quantization("int4").has_value());
+}
@@ -0,0 +1,173 @@
+#include "ccmcp/vector/vector_math.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace ccmcp::vector;
+
+namespace {
+
+constexpr math::Isa kAllIsas[] = {math::Isa::kScalar, math::Isa::kSse42, math::Isa::kAvx2,
+                                  math::Isa::kAvx512};
+
+// The documented reduction order written out directly: float products, double lanes
+// (element i → lane i % 16), pairwise lane tree.
+double spec_dot(const std::vector<float>& a, const std::vector<float>& b) {
+  double lanes[math::kLanes] = {};
+  for (size_t i = 0; i < a.size(); ++i) {
+    lanes[i % math::kLanes] += static_cast<double>(a[i] * b[i]);
+  }
+  for (size_t width = math::kLanes / 2; width > 0; width /= 2) {
+    for (size_t l = 0; l < width; ++l) {
+      lanes[l] += lanes[l + width];
+    }
+  }
+  return lanes[0];
+}
+
+std::vector<float> random_floats(std::mt19937& rng, size_t n) {
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> v(n);
+  for (auto& x : v) {
+    x = dist(rng);
+  }
+  return v;
+}
+
+}  // namespace
+
+TEST_CASE("vector_math: every supported ISA matches the reduction order bit for bit",
+          "[vector][math]") {
+  std::mt19937 rng(17);
+  for (const size_t n : {size_t{0}, size_t{1}, size_t{7}, size_t{15}, size_t{16}, size_t{17},
+                         size_t{33}, size_t{128}, size_t{383}, size_t{1536}}) {
+    const auto a = random_floats(rng, n);
+    const auto b = random_floats(rng, n);
+    const double expected = spec_dot(a, b);
+    for (const auto isa : kAllIsas) {
+      const auto* kernels = math::kernels_for(isa);
+      if (kernels == nullptr) {
+        continue;
+      }
+      INFO("isa=" << math::to_string(isa) << " n=" << n);
+      CHECK(kernels->isa == isa);
+      CHECK(kernels->dot(a.data(), b.data(), n) == expected);
+    }
+  }
+}
+
+TEST_CASE("vector_math: dot_many scores strided rows like dot", "[vector][math]") {
+  std::mt19937 rng(23);
+  const size_t dim = 37;
+  const size_t stride = 48;
+  const size_t count = 9;
+  const auto query = random_floats(rng, dim);
+  // Padding holds garbage to prove it is never read.
+  const auto rows = random_floats(rng, stride * count);
+
+  for (const auto isa : kAllIsas) {
+    const auto* kernels = math::kernels_for(isa);
+    if (kernels == nullptr) {
+      continue;
+    }
+    INFO("isa=" << math::to_string(isa));
+    std::vector<double> out(count);
+    kernels->dot_many(query.data(), rows.data(), stride, count, dim, out.data());
+    for (size_t r = 0; r < count; ++r) {
+      const std::vector<float> row(rows.begin() + static_cast<long>(r * stride),
+                                   rows.begin() + static_cast<long>(r * stride + dim));
+      CHECK(out[r] == spec_dot(query, row));
+    }
+  }
+}
+
+TEST_CASE("vector_math: int8 kernels are exact on every supported ISA", "[vector][math]") {
+  std::mt19937 rng(31);
+  std::uniform_int_distribution<int> dist(-127, 127);
+  const size_t stride = 1600;
+  const size_t count = 4;
+  std::vector<std::int8_t> query(stride);
+  std::vector<std::int8_t> rows(stride * count);
+  for (auto& x : query) {
+    x = static_cast<std::int8_t>(dist(rng));
+  }
+  for (auto& x : rows) {
+    x = static_cast<std::int8_t>(dist(rng));
+  }
+  // Saturated codes: the largest per-element product.
+  std::fill_n(rows.begin(), 64, std::int8_t{-127});
+  std::fill_n(query.begin(), 64, std::int8_t{-127});
+
+  for (const size_t dim : {size_t{0}, size_t{1}, size_t{7}, size_t{8}, size_t{15}, size_t{17},
+                           size_t{33}, size_t{384}, size_t{1536}}) {
+    std::vector<std::int32_t> expected(count);
+    for (size_t r = 0; r < count; ++r) {
+      for (size_t i = 0; i < dim; ++i) {
+        expected[r] += std::int32_t{query[i]} * std::int32_t{rows[r * stride + i]};
+      }
+    }
+    for (const auto isa : kAllIsas) {
+      const auto* kernels = math::kernels_for(isa);
+      if (kernels == nullptr) {
+        continue;
+      }
+      INFO("isa=" << math::to_string(isa) << " dim=" << dim);
+      CHECK(kernels->dot_i8(query.data(), rows.data(), dim) == expected[0]);
+      std::vector<std::int32_t> out(count);
+      kernels->dot_i8_many(query.data(), rows.data(), stride, count, dim, out.data());
+      CHECK(out == expected);
+    }
+  }
+}
+
+TEST_CASE("vector_math: dot_block scores every query like dot_many", "[vector][math]") {
+  std::mt19937 rng(29);
+  const size_t dim = 300;
+  const size_t stride = 304;  // 1216-byte rows: 107 rows per tile, so count spans three tiles
+  const size_t count = 260;
+  const size_t num_queries = 5;
+  const auto rows = random_floats(rng, stride * count);
+  std::vector<std::vector<float>> queries;
+  std::vector<const float*> query_ptrs;
+  for (size_t q = 0; q < num_queries; ++q) {
+    queries.push_back(random_floats(rng, dim));
+  }
+  for (const auto& q : queries) {
+    query_ptrs.push_back(q.data());
+  }
+
+  std::vector<double> out(num_queries * count);
+  math::dot_block(query_ptrs.data(), num_queries, rows.data(), stride, count, dim, out.data());
+  for (size_t q = 0; q < num_queries; ++q) {
+    std::vector<double> expected(count);
+    math::dot_many(queries[q].data(), rows.data(), stride, count, dim, expected.data());
+    for (size_t r = 0; r < count; ++r) {
+      CHECK(out[q * count + r] == expected[r]);
+    }
+  }
+}
+
+TEST_CASE("vector_math: scalar kernels are always available and dispatch picks one",
+          "[vector][math]") {
+  REQUIRE(math::kernels_for(math::Isa::kScalar) != nullptr);
+  const auto& active = math::kernels();
+  CHECK(math::kernels_for(active.isa) == &active);
+  CHECK_FALSE(math::to_string(active.isa).empty());
+}
+
+TEST_CASE("vector_math: cosine_similarity edge cases", "[vector][math]") {
+  CHECK(math::cosine_similarity(Vector{1.0f, 0.0f}, Vector{1.0f, 0.0f}) == 1.0);
+  CHECK(math::cosine_similarity(Vector{1.0f, 0.0f}, Vector{0.0f, 1.0f}) == 0.0);
+  CHECK(math::cosine_similarity(Vector{1.0f, 0.0f}, Vector{-1.0f, 0.0f}) == -1.0);
+  // Mismatched dimensions, empty vectors and zero vectors score 0.0 (never NaN).
+  CHECK(math::cosine_similarity(Vector{1.0f, 0.0f}, Vector{1.0f, 0.0f, 0.0f}) == 0.0);
+  CHECK(math::cosine_similarity(Vector{}, Vector{}) == 0.0);
+  CHECK(math::cosine_similarity(Vector{0.0f, 0.0f}, Vector{1.0f, 0.0f}) == 0.0);
+
+  CHECK(math::l2_norm(Vector{3.0f, 4.0f}.data(), 2) == 5.0);
+}
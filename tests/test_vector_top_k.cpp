@@ -0,0 +1,71 @@
+#include "ccmcp/vector/top_k.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace ccmcp::vector;
+
+namespace {
+
+// Reference ordering: full sort then truncate (the pre-heap query implementation).
+std::vector<VectorSearchResult> full_sort_top_k(std::vector<VectorSearchResult> all,
+                                                size_t top_k) {
+  std::sort(all.begin(), all.end(), [](const VectorSearchResult& a, const VectorSearchResult& b) {
+    return ranks_before(a.score, a.key, b.score, b.key);
+  });
+  if (all.size() > top_k) {
+    all.resize(top_k);
+  }
+  return all;
+}
+
+}  // namespace
+
+TEST_CASE("ranks_before orders by score then key within epsilon", "[vector][top_k]") {
+  CHECK(ranks_before(0.9, "b", 0.8, "a"));
+  CHECK_FALSE(ranks_before(0.8, "a", 0.9, "b"));
+  // Within 1e-9: key decides.
+  CHECK(ranks_before(0.5, "a", 0.5 + 1e-10, "b"));
+  CHECK_FALSE(ranks_before(0.5 + 1e-10, "b", 0.5, "a"));
+  CHECK_FALSE(ranks_before(0.5, "a", 0.5, "a"));
+}
+
+TEST_CASE("TopKSelector matches full sort and truncate", "[vector][top_k]") {
+  std::vector<VectorSearchResult> all;
+  for (int i = 0; i < 200; ++i) {
+    // Coarse scores force many exact ties; keys are inserted out of lexicographic order.
+    const double score = static_cast<double>((i * 37) % 11) / 10.0;
+    all.push_back(VectorSearchResult{
+        .key = "key-" + std::to_string((i * 53) % 200), .score = score, .metadata = "m"});
+  }
+
+  for (const size_t k : {size_t{0}, size_t{1}, size_t{7}, size_t{50}, size_t{200}, size_t{500}}) {
+    TopKSelector selector(k);
+    for (const auto& r : all) {
+      selector.push(r);
+    }
+    const auto got = selector.take_sorted();
+    const auto expected = full_sort_top_k(all, k);
+    REQUIRE(got.size() == expected.size());
+    for (size_t i = 0; i < got.size(); ++i) {
+      CHECK(got[i].key == expected[i].key);
+      CHECK(got[i].score == expected[i].score);
+    }
+  }
+}
+
+TEST_CASE("TopKSelector::accepts rejects candidates worse than the kept set", "[vector][top_k]") {
+  TopKSelector selector(2);
+  selector.push(VectorSearchResult{.key = "b", .score = 0.9, .metadata = ""});
+  selector.push(VectorSearchResult{.key = "c", .score = 0.5, .metadata = ""});
+
+  CHECK(selector.accepts(0.7, "z"));
+  CHECK(selector.accepts(0.5, "a"));        // tie on score, smaller key wins
+  CHECK_FALSE(selector.accepts(0.5, "d"));  // tie on score, larger key loses
+  CHECK_FALSE(selector.accepts(0.1, "a"));
+
+  CHECK_FALSE(TopKSelector(0).accepts(1.0, "a"));
+}